@@ -0,0 +1,133 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// ROSaic
+#include <septentrio_gnss_driver/abstraction/timestamp.hpp>
+
+/**
+ * @file log_throttle.hpp
+ * @brief Rate limiting of log messages per call site and node
+ */
+
+//! Period in seconds of throttled log messages reporting errors of the data stream
+static const double STREAM_ERROR_LOG_PERIOD_S = 1.0;
+
+/**
+ * @class LogThrottle
+ * @brief Lets one message per period pass and counts the ones suppressed in
+ * between, so that a burst of errors does not cost more than one message per
+ * period. May be used by several threads.
+ */
+class LogThrottle
+{
+public:
+    /**
+     * @brief Class constructor
+     * @param[in] period Minimum time between two messages in nanoseconds
+     */
+    explicit LogThrottle(Timestamp period) : period_(period) {}
+
+    /**
+     * @brief Decides whether a message is output, counts it as suppressed if not
+     * @param[in] now Monotonic time in nanoseconds
+     * @param[out] suppressed Number of messages suppressed since the last one
+     * output, only set if the message is to be output
+     * @return Whether the message is to be output
+     */
+    [[nodiscard]] bool pass(Timestamp now, uint64_t& suppressed) noexcept
+    {
+        Timestamp next = next_.load(std::memory_order_relaxed);
+        if ((now < next) || !next_.compare_exchange_strong(
+                                next, now + period_, std::memory_order_relaxed))
+        {
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    const Timestamp period_;
+    //! Earliest time of the next message
+    std::atomic<Timestamp> next_{0};
+    std::atomic<uint64_t> suppressed_{0};
+};
+
+/**
+ * @class LogThrottleTable
+ * @brief Holds the throttles of one node, one per call site, so that the errors of
+ * one receiver do not suppress those of another one in the same process
+ */
+class LogThrottleTable
+{
+public:
+    /**
+     * @brief Gets the throttle of a call site, creates it on first use
+     * @param[in] site Address identifying the call site
+     * @param[in] period Minimum time between two messages in nanoseconds
+     */
+    [[nodiscard]] LogThrottle& get(const void* site, Timestamp period)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_ptr<LogThrottle>& throttle = throttles_[site];
+        if (!throttle)
+            throttle = std::make_unique<LogThrottle>(period);
+        return *throttle;
+    }
+
+private:
+    std::mutex mutex_;
+    //! Throttles by call site, pointers keep references stable on rehash
+    std::unordered_map<const void*, std::unique_ptr<LogThrottle>> throttles_;
+};
+
+/**
+ * @brief Appends the number of suppressed messages to a log message
+ * @param[in] message Message to be output
+ * @param[in] suppressed Number of messages suppressed before it
+ */
+[[nodiscard]] inline std::string withSuppressed(std::string message,
+                                               uint64_t suppressed)
+{
+    if (suppressed != 0)
+        message += " (" + std::to_string(suppressed) + " similar suppressed)";
+    return message;
+}
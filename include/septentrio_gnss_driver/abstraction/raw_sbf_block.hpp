@@ -0,0 +1,150 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <cstring>
+#include <memory>
+// ROS
+#include <ros/message_traits.h>
+#include <ros/serialization.h>
+#include <std_msgs/Header.h>
+// ROSaic
+#include <septentrio_gnss_driver/RawSbfBlock.h>
+#include <septentrio_gnss_driver/communication/telegram.hpp>
+
+/**
+ * @struct RawSbfBlockView
+ * @brief Publishes an SBF block as septentrio_gnss_driver/RawSbfBlock straight
+ * from the telegram buffer. The telegram is shared, not copied, and the block is
+ * serialized as is, its fields are not decoded. Subscribers receive a
+ * RawSbfBlock, the view is output only.
+ */
+struct RawSbfBlockView
+{
+    std_msgs::Header header;
+    //! Telegram holding the CRC validated block
+    std::shared_ptr<const Telegram> telegram;
+
+    RawSbfBlockView() = default;
+
+    explicit RawSbfBlockView(std::shared_ptr<const Telegram> telegram) :
+        telegram(std::move(telegram))
+    {
+    }
+
+    //! Block number, i.e. ID without revision
+    [[nodiscard]] uint16_t blockId() const
+    {
+        return parsing_utilities::getId(telegram->message);
+    }
+
+    //! Block revision
+    [[nodiscard]] uint8_t revision() const
+    {
+        return parsing_utilities::getRevision(telegram->message);
+    }
+};
+
+namespace ros {
+    namespace message_traits {
+        // The view is published as RawSbfBlock, thus shares its traits
+        template <>
+        struct IsMessage<RawSbfBlockView> : TrueType
+        {
+        };
+
+        template <>
+        struct HasHeader<RawSbfBlockView> : TrueType
+        {
+        };
+
+        template <>
+        struct MD5Sum<RawSbfBlockView>
+        {
+            static const char* value()
+            {
+                return MD5Sum<septentrio_gnss_driver::RawSbfBlock>::value();
+            }
+            static const char* value(const RawSbfBlockView&) { return value(); }
+        };
+
+        template <>
+        struct DataType<RawSbfBlockView>
+        {
+            static const char* value()
+            {
+                return DataType<septentrio_gnss_driver::RawSbfBlock>::value();
+            }
+            static const char* value(const RawSbfBlockView&) { return value(); }
+        };
+
+        template <>
+        struct Definition<RawSbfBlockView>
+        {
+            static const char* value()
+            {
+                return Definition<septentrio_gnss_driver::RawSbfBlock>::value();
+            }
+            static const char* value(const RawSbfBlockView&) { return value(); }
+        };
+    } // namespace message_traits
+
+    namespace serialization {
+        /**
+         * @brief Serializes the view in the wire format of RawSbfBlock, the block
+         * bytes are copied from the telegram in one go
+         */
+        template <>
+        struct Serializer<RawSbfBlockView>
+        {
+            template <typename Stream>
+            inline static void write(Stream& stream, const RawSbfBlockView& m)
+            {
+                const std::vector<uint8_t>& data = m.telegram->message;
+                stream.next(m.header);
+                stream.next(m.blockId());
+                stream.next(m.revision());
+                stream.next(static_cast<uint32_t>(data.size()));
+                if (!data.empty())
+                    std::memcpy(stream.advance(static_cast<uint32_t>(data.size())),
+                                data.data(), data.size());
+            }
+
+            inline static uint32_t serializedLength(const RawSbfBlockView& m)
+            {
+                return serializationLength(m.header) + sizeof(uint16_t) +
+                       sizeof(uint8_t) + sizeof(uint32_t) +
+                       static_cast<uint32_t>(m.telegram->message.size());
+            }
+        };
+    } // namespace serialization
+} // namespace ros
@@ -0,0 +1,81 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @file timestamp.hpp
+ * @brief Time stamps and time conversions that do not depend on ROS
+ */
+
+// Timestamp in nanoseconds (Unix epoch)
+typedef uint64_t Timestamp;
+
+//! Leap seconds value meaning that they are not known yet
+static const int32_t LEAP_SECONDS_UNKNOWN = -128;
+
+/**
+ * @brief Current time of a monotonic clock, suited for measuring durations only
+ * @return Time in nanoseconds since an unspecified epoch
+ */
+[[nodiscard]] inline Timestamp steadyTime() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief Converts GPS time of week and week number to Unix time
+ * @param[in] tow Time of week in milliseconds
+ * @param[in] wnc GPS week number
+ * @param[in] leapSeconds Current leap seconds, LEAP_SECONDS_UNKNOWN to leave the
+ * result in GPS time
+ * @return Time stamp in nanoseconds
+ */
+[[nodiscard]] inline Timestamp gnssToUnixTime(uint32_t tow, uint16_t wnc,
+                                              int32_t leapSeconds) noexcept
+{
+    static const uint64_t secToNSec = 1000000000;
+    static const uint64_t mSec2NSec = 1000000;
+    // GPS week counter starts at 1980-01-06 which is 315964800 seconds since Unix
+    // epoch (1970-01-01 UTC)
+    static const uint64_t nsOfGpsStart = 315964800 * secToNSec;
+    static const uint64_t nsecPerWeek = 7 * 24 * 60 * 60 * secToNSec;
+
+    Timestamp time = nsOfGpsStart + tow * mSec2NSec + wnc * nsecPerWeek;
+    if (leapSeconds != LEAP_SECONDS_UNKNOWN)
+        time -= leapSeconds * secToNSec;
+    return time;
+}
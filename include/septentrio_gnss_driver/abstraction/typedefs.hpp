@@ -31,8 +31,11 @@
 #pragma once
 
 // std includes
+#include <array>
+#include <iterator>
 #include <numeric>
-#include <unordered_map>
+// Boost includes
+#include <boost/make_shared.hpp>
 // ROS includes
 #include <ros/ros.h>
 // tf2 includes
@@ -85,11 +88,11 @@
 #include <septentrio_gnss_driver/INSNavGeod.h>
 #include <septentrio_gnss_driver/VelSensorSetup.h>
 // Rosaic includes
+#include <septentrio_gnss_driver/abstraction/log_throttle.hpp>
+#include <septentrio_gnss_driver/abstraction/timestamp.hpp>
+#include <septentrio_gnss_driver/abstraction/vsm_accumulator.hpp>
 #include <septentrio_gnss_driver/communication/settings.hpp>
 #include <septentrio_gnss_driver/parsers/string_utilities.hpp>
-
-// Timestamp in nanoseconds (Unix epoch)
-typedef uint64_t Timestamp;
 // ROS timestamp
 typedef ros::Time TimestampRos;
 
@@ -177,6 +180,121 @@ namespace log_level {
     };
 } // namespace log_level
 
+/**
+ * @brief Logs via node->log(), but evaluates message only if the level is
+ * enabled, so that messages on the hot path cost nothing otherwise
+ */
+#define ROSAIC_LOG(node, level, message)                                         \
+    do                                                                           \
+    {                                                                            \
+        if ((node)->logEnabled(level))                                           \
+            (node)->log(level, message);                                         \
+    } while (false)
+
+/**
+ * @brief Like ROSAIC_LOG, but outputs at most one message per period_s seconds from
+ * this call site and node, with the number of messages suppressed in between
+ */
+#define ROSAIC_LOG_THROTTLE(node, level, period_s, message)                      \
+    do                                                                           \
+    {                                                                            \
+        static const char rosaicLogSite = 0;                                     \
+        uint64_t rosaicLogSuppressed = 0;                                        \
+        if ((node)->logEnabled(level) &&                                         \
+            (node)                                                               \
+                ->logThrottle(&rosaicLogSite,                                    \
+                              static_cast<Timestamp>((period_s)*1e9))            \
+                .pass(steadyTime(), rosaicLogSuppressed))                        \
+            (node)->log(level, withSuppressed(message, rosaicLogSuppressed));    \
+    } while (false)
+
+/**
+ * @brief Published topics, index of the publisher registry
+ */
+namespace topic {
+    enum Topic : uint8_t
+    {
+        GPGGA,
+        GPRMC,
+        GPGSA,
+        GPGSV,
+        PVT_CARTESIAN,
+        PVT_GEODETIC,
+        BASE_VECTOR_CART,
+        BASE_VECTOR_GEOD,
+        POS_COV_CARTESIAN,
+        POS_COV_GEODETIC,
+        VEL_COV_CARTESIAN,
+        VEL_COV_GEODETIC,
+        ATT_EULER,
+        ATT_COV_EULER,
+        MEAS_EPOCH,
+        GAL_AUTH_STATUS,
+        RF_STATUS,
+        AIM_PLUS_STATUS,
+        INS_NAV_CART,
+        INS_NAV_GEOD,
+        IMU_SETUP,
+        VEL_SENSOR_SETUP,
+        EXT_EVENT_INS_NAV_CART,
+        EXT_EVENT_INS_NAV_GEOD,
+        EXT_SENSOR_MEAS,
+        GPST,
+        NAVSATFIX,
+        GPSFIX,
+        POSE,
+        DIAGNOSTICS,
+        IMU,
+        LOCALIZATION,
+        LOCALIZATION_ECEF,
+        TWIST_GNSS,
+        TWIST_INS,
+        RAW_SBF,
+        COUNT
+    };
+
+    //! Topic names in the order of Topic
+    inline constexpr const char* NAMES[] = {
+        "gpgga",
+        "gprmc",
+        "gpgsa",
+        "gpgsv",
+        "pvtcartesian",
+        "pvtgeodetic",
+        "basevectorcart",
+        "basevectorgeod",
+        "poscovcartesian",
+        "poscovgeodetic",
+        "velcovcartesian",
+        "velcovgeodetic",
+        "atteuler",
+        "attcoveuler",
+        "measepoch",
+        "galauthstatus",
+        "rfstatus",
+        "aimplusstatus",
+        "insnavcart",
+        "insnavgeod",
+        "imusetup",
+        "velsensorsetup",
+        "exteventinsnavcart",
+        "exteventinsnavgeod",
+        "extsensormeas",
+        "gpst",
+        "navsatfix",
+        "gpsfix",
+        "pose",
+        "/diagnostics",
+        "imu",
+        "localization",
+        "localization_ecef",
+        "twist_gnss",
+        "twist_ins",
+        "raw_sbf",
+    };
+    static_assert(std::size(NAMES) == COUNT, "Each topic needs a name");
+} // namespace topic
+
 /**
  * @class ROSaicNodeBase
  * @brief This class is the base class for abstraction
@@ -184,8 +302,21 @@ namespace log_level {
 class ROSaicNodeBase
 {
 public:
-    ROSaicNodeBase() :
-        pNh_(new ros::NodeHandle("~")), tfListener_(tfBuffer_), lastTfStamp_(0)
+    ROSaicNodeBase() : ROSaicNodeBase(ros::NodeHandle("~")) {}
+
+    /**
+     * @brief Constructor
+     * @param[in] pNh Private node handle parameters are read from and topics are
+     * advertised on
+     * @param[in] sharedPublishing Whether to publish messages as shared pointers,
+     * so that subscribers in the same process, e.g. nodelets, receive them
+     * without serialization
+     */
+    explicit ROSaicNodeBase(const ros::NodeHandle& pNh,
+                            bool sharedPublishing = false) :
+        pNh_(new ros::NodeHandle(pNh)),
+        sharedPublishing_(sharedPublishing), tfListener_(tfBuffer_),
+        lastTfStamp_(0)
     {
     }
 
@@ -195,6 +326,18 @@ public:
 
     void registerSubscriber()
     {
+        VsmAccumulator::Config config;
+        for (size_t i = 0; i < config.use.size(); ++i)
+        {
+            config.use[i] = settings_.ins_vsm_ros_config[i];
+            if (settings_.ins_vsm_ros_variances_by_parameter)
+                config.variances[i] = settings_.ins_vsm_ros_variances[i];
+        }
+        config.variancesByParameter = settings_.ins_vsm_ros_variances_by_parameter;
+        config.rosAxisOrientation = settings_.use_ros_axis_orientation;
+        vsmAccumulator_.configure(config);
+        vsmPeriod_ = static_cast<Timestamp>(1e9 / settings_.ins_vsm_ros_rate);
+
         try
         {
             ros::NodeHandle nh;
@@ -254,24 +397,47 @@ public:
      * @param[in] logLevel Log level
      * @param[in] s String to log
      */
+    /**
+     * @brief Whether messages of a log level are output, DEBUG only is if
+     * activate_debug_log is set
+     * @param[in] logLevel Log level
+     */
+    [[nodiscard]] bool logEnabled(log_level::LogLevel logLevel) const
+    {
+        return (logLevel != log_level::DEBUG) || settings_.activate_debug_log;
+    }
+
+    /**
+     * @brief Gets the log throttle of a call site of this node
+     * @param[in] site Address identifying the call site
+     * @param[in] period Minimum time between two messages in nanoseconds
+     */
+    [[nodiscard]] LogThrottle& logThrottle(const void* site, Timestamp period) const
+    {
+        return logThrottles_.get(site, period);
+    }
+
     void log(log_level::LogLevel logLevel, const std::string& s) const
     {
+        // The namespace of the private node handle names the receiver, also if
+        // several of them run in one process
+        const std::string& name = pNh_->getNamespace();
         switch (logLevel)
         {
         case log_level::DEBUG:
-            ROS_DEBUG_STREAM(ros::this_node::getName() << ": " << s);
+            ROS_DEBUG_STREAM(name << ": " << s);
             break;
         case log_level::INFO:
-            ROS_INFO_STREAM(ros::this_node::getName() << ": " << s);
+            ROS_INFO_STREAM(name << ": " << s);
             break;
         case log_level::WARN:
-            ROS_WARN_STREAM(ros::this_node::getName() << ": " << s);
+            ROS_WARN_STREAM(name << ": " << s);
             break;
         case log_level::ERROR:
-            ROS_ERROR_STREAM(ros::this_node::getName() << ": " << s);
+            ROS_ERROR_STREAM(name << ": " << s);
             break;
         case log_level::FATAL:
-            ROS_FATAL_STREAM(ros::this_node::getName() << ": " << s);
+            ROS_FATAL_STREAM(name << ": " << s);
             break;
         default:
             break;
@@ -284,26 +450,61 @@ public:
      */
     Timestamp getTime() const { return ros::Time::now().toNSec(); }
 
+    /**
+     * @brief Advertises a topic unless it is already advertised
+     * @param[in] topic Topic to be advertised
+     */
+    template <typename M>
+    void advertise(topic::Topic topic)
+    {
+        if (!publishers_[topic])
+            publishers_[topic] = pNh_->advertise<M>(topic::NAMES[topic], queueSize_);
+    }
+
+    /**
+     * @brief Checks if anybody listens to a topic, topics that have not been
+     * advertised yet are assumed to be listened to
+     * @param[in] topic Topic to be checked
+     * @return True if the topic has subscribers or is not advertised yet
+     */
+    bool hasSubscribers(topic::Topic topic) const
+    {
+        if (!publishers_[topic])
+            return true;
+        return publishers_[topic].getNumSubscribers() > 0;
+    }
+
     /**
      * @brief Publishing function
-     * @param[in] topic String of topic
+     * @param[in] topic Topic to publish on
      * @param[in] msg ROS message to be published
      */
     template <typename M>
-    void publishMessage(const std::string& topic, const M& msg)
+    void publishMessage(topic::Topic topic, const M& msg)
     {
-        auto it = topicMap_.find(topic);
-        if (it != topicMap_.end())
-        {
-            it->second.publish(msg);
-        } else
-        {
-            ros::Publisher pub = pNh_->advertise<M>(topic, queueSize_);
-            topicMap_.insert(std::make_pair(topic, pub));
-            pub.publish(msg);
-        }
+        advertise<M>(topic);
+        if (sharedPublishing_)
+            publishers_[topic].publish(boost::make_shared<const M>(msg));
+        else
+            publishers_[topic].publish(msg);
     }
 
+    /**
+     * @brief Publishing function for messages already held by a shared pointer,
+     * they are passed on without copy to subscribers in the same process
+     * @param[in] topic Topic to publish on
+     * @param[in] msg ROS message to be published, must not be altered afterwards
+     */
+    template <typename M>
+    void publishMessage(topic::Topic topic, const boost::shared_ptr<const M>& msg)
+    {
+        advertise<M>(topic);
+        publishers_[topic].publish(msg);
+    }
+
+    //! Whether messages are published as shared pointers
+    [[nodiscard]] bool sharedPublishing() const { return sharedPublishing_; }
+
     /**
      * @brief Publishing function for tf
      * @param[in] msg ROS localization message to be converted to tf
@@ -341,22 +542,21 @@ public:
             {
                 try
                 {
-                    ROS_INFO_STREAM_THROTTLE(
-                        10.0,
-                        ros::this_node::getName()
-                            << ": No transform for insertion of local frame at t="
-                            << lastTfStamp_.toNSec()
-                            << ". Exception: " << std::string(ex.what()));
+                    ROSAIC_LOG_THROTTLE(
+                        this, log_level::INFO, 10.0,
+                        "No transform for insertion of local frame at t=" +
+                            std::to_string(lastTfStamp_.toNSec()) +
+                            ". Exception: " + std::string(ex.what()));
                     // try to get latest tf
                     T_l_b = tfBuffer_.lookupTransform(
                         loc.child_frame_id, settings_.local_frame_id, ros::Time(0));
                 } catch (const tf2::TransformException& ex)
                 {
-                    ROS_WARN_STREAM_THROTTLE(
-                        10.0,
-                        ros::this_node::getName()
-                            << ": No most recent transform for insertion of local frame. Exception: "
-                            << std::string(ex.what()));
+                    ROSAIC_LOG_THROTTLE(
+                        this, log_level::WARN, 10.0,
+                        "No most recent transform for insertion of local frame. "
+                        "Exception: " +
+                            std::string(ex.what()));
                     return;
                 }
             }
@@ -425,117 +625,32 @@ private:
         if (stamp == 0)
             stamp = getTime();
 
-        static Eigen::Vector3d vel = Eigen::Vector3d::Zero();
-        static Eigen::Vector3d var = Eigen::Vector3d::Zero();
-        static uint64_t ctr = 0;
-        static Timestamp lastStamp = 0;
-
-        ++ctr;
-        vel[0] += twist.twist.linear.x;
-        vel[1] += twist.twist.linear.y;
-        vel[2] += twist.twist.linear.z;
-        var[0] += twist.covariance[0];
-        var[1] += twist.covariance[7];
-        var[2] += twist.covariance[14];
-
-        // Rx expects averaged velocity at a rate of 2 Hz
-        if ((stamp - lastStamp) >= 495000000) // allow for 5 ms jitter
+        std::array<double, 3> vel = {twist.twist.linear.x, twist.twist.linear.y,
+                                     twist.twist.linear.z};
+        std::array<double, 3> var = {twist.covariance[0], twist.covariance[7],
+                                     twist.covariance[14]};
+
+        // Rx expects averaged velocity at a rate of 2 Hz, higher rates need the
+        // improved VSM handling
+        bool improved = capabilities_.has_improved_vsm_handling;
+        Timestamp period = vsmPeriod_;
+        if (!improved)
+            period = std::max(period, VsmAccumulator::DEFAULT_PERIOD);
+
+        VsmAccumulator::Sentence sentence;
+        uint8_t invalid;
+        std::size_t length = vsmAccumulator_.add(stamp, vel, var, period, improved,
+                                                 sentence, invalid);
+        static const std::array<std::string, 3> axes = {"v_x", "v_y", "v_z"};
+        for (size_t i = 0; i < axes.size(); ++i)
         {
-            vel /= ctr;
-            var /= ctr;
-            time_t epochSeconds = stamp / 1000000000;
-            struct tm* tm_temp = std::gmtime(&epochSeconds);
-            std::stringstream timeUtc;
-            timeUtc << std::setfill('0') << std::setw(2)
-                    << std::to_string(tm_temp->tm_hour) << std::setw(2)
-                    << std::to_string(tm_temp->tm_min) << std::setw(2)
-                    << std::to_string(tm_temp->tm_sec) << "." << std::setw(3)
-                    << std::to_string((stamp - (stamp / 1000000000) * 1000000000) /
-                                      1000000);
-
-            std::string v_x;
-            std::string v_y;
-            std::string v_z;
-            std::string std_x;
-            std::string std_y;
-            std::string std_z;
-            if (settings_.ins_vsm_ros_config[0])
-            {
-                v_x = string_utilities::trimDecimalPlaces(vel[0]);
-                if (settings_.ins_vsm_ros_variances_by_parameter)
-                    std_x = string_utilities::trimDecimalPlaces(
-                        settings_.ins_vsm_ros_variances[0]);
-                else if (var[0] > 0.0)
-                    std_x = string_utilities::trimDecimalPlaces(std::sqrt(var[0]));
-                else if (!capabilities_.has_improved_vsm_handling)
-                {
-                    log(log_level::ERROR, "Invalid covariance value for v_x: " +
-                                              std::to_string(var[0]) +
-                                              ". Ignoring measurement.");
-                    v_x = "";
-                    std_x = string_utilities::trimDecimalPlaces(1000000.0);
-                }
-            } else
-                std_x = std::to_string(1000000.0);
-            if (settings_.ins_vsm_ros_config[1])
-            {
-                if (settings_.use_ros_axis_orientation)
-                    v_y = "-";
-                v_y += string_utilities::trimDecimalPlaces(vel[1]);
-                if (settings_.ins_vsm_ros_variances_by_parameter)
-                    std_y = string_utilities::trimDecimalPlaces(
-                        settings_.ins_vsm_ros_variances[1]);
-                else if (var[1] > 0.0)
-                    std_y = string_utilities::trimDecimalPlaces(std::sqrt(var[1]));
-                else if (!capabilities_.has_improved_vsm_handling)
-                {
-                    log(log_level::ERROR, "Invalid covariance value for v_y: " +
-                                              std::to_string(var[1]) +
-                                              ". Ignoring measurement.");
-                    v_y = "";
-                    std_y = string_utilities::trimDecimalPlaces(1000000.0);
-                }
-            } else
-                std_y = string_utilities::trimDecimalPlaces(1000000.0);
-            if (settings_.ins_vsm_ros_config[2])
-            {
-                if (settings_.use_ros_axis_orientation)
-                    v_z = "-";
-                v_z += string_utilities::trimDecimalPlaces(vel[2]);
-                if (settings_.ins_vsm_ros_variances_by_parameter)
-                    std_z = string_utilities::trimDecimalPlaces(
-                        settings_.ins_vsm_ros_variances[2]);
-                else if (var[2] > 0.0)
-                    std_z = string_utilities::trimDecimalPlaces(std::sqrt(var[2]));
-                else if (!capabilities_.has_improved_vsm_handling)
-                {
-                    log(log_level::ERROR, "Invalid covariance value for v_z: " +
-                                              std::to_string(var[2]) +
-                                              ". Ignoring measurement.");
-                    v_z = "";
-                    std_z = string_utilities::trimDecimalPlaces(1000000.0);
-                }
-            } else
-                std_z = string_utilities::trimDecimalPlaces(1000000.0);
-
-            std::string velNmea = "$PSSN,VSM," + timeUtc.str() + "," + v_x + "," +
-                                  v_y + "," + std_x + "," + std_y + "," + v_z + "," +
-                                  std_z;
-
-            char crc = std::accumulate(velNmea.begin() + 1, velNmea.end(), 0,
-                                       [](char sum, char ch) { return sum ^ ch; });
-
-            std::stringstream crcss;
-            crcss << std::hex << static_cast<int32_t>(crc);
-
-            velNmea += "*" + crcss.str() + "\r\n";
-            sendVelocity(velNmea);
-
-            vel = Eigen::Vector3d::Zero();
-            var = Eigen::Vector3d::Zero();
-            ctr = 0;
-            lastStamp = stamp;
+            if (invalid & (1 << i))
+                log(log_level::ERROR, "Invalid covariance value for " + axes[i] +
+                                          ": " + std::to_string(var[i]) +
+                                          ". Ignoring measurement.");
         }
+        if (length > 0)
+            sendVelocity(std::string_view(sentence.data(), length));
     }
 
 protected:
@@ -544,11 +659,15 @@ protected:
     //! Settings
     Settings settings_;
     //! Send velocity to communication layer (virtual)
-    virtual void sendVelocity(const std::string& velNmea) = 0;
+    virtual void sendVelocity(std::string_view velNmea) = 0;
 
 private:
+    //! Whether messages are published as shared pointers
+    bool sharedPublishing_;
+    //! Throttles of the log messages of this node
+    mutable LogThrottleTable logThrottles_;
     //! Map of topics and publishers
-    std::unordered_map<std::string, ros::Publisher> topicMap_;
+    std::array<ros::Publisher, topic::COUNT> publishers_;
     //! Publisher queue size
     uint32_t queueSize_ = 1;
     //! Transform publisher
@@ -557,6 +676,10 @@ private:
     ros::Subscriber odometrySubscriber_;
     //! Twist subscriber
     ros::Subscriber twistSubscriber_;
+    //! Averages the velocities of odometry or twist and formats them for the Rx
+    VsmAccumulator vsmAccumulator_;
+    //! Output period of the velocity sentences in nanoseconds
+    Timestamp vsmPeriod_ = VsmAccumulator::DEFAULT_PERIOD;
     //! Last tf stamp
     TimestampRos lastTfStamp_;
     //! tf buffer
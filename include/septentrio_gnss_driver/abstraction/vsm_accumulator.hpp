@@ -0,0 +1,234 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+
+// ROSaic, no ROS dependencies
+#include <septentrio_gnss_driver/abstraction/timestamp.hpp>
+
+/**
+ * @file vsm_accumulator.hpp
+ * @brief Averages velocity measurements and formats them as VSM NMEA sentences
+ * for velocity aiding of the INS
+ */
+
+/**
+ * @class VsmAccumulator
+ * @brief Averages the velocities and variances received during one output period
+ * and formats them as PSSN,VSM sentence into a fixed buffer, without allocating.
+ * Thread-safe, so measurements may arrive from several subscriber callbacks.
+ */
+class VsmAccumulator
+{
+public:
+    //! Size of the buffer of a sentence, large enough for any clamped value
+    static constexpr std::size_t MAX_SENTENCE_SIZE = 192;
+    typedef std::array<char, MAX_SENTENCE_SIZE> Sentence;
+    //! Output period the Rx expects by default, 2 Hz
+    static constexpr Timestamp DEFAULT_PERIOD = 500000000;
+    //! Standard deviation marking an axis as not measured
+    static constexpr double STD_NOT_MEASURED = 1000000.0;
+
+    //! Configuration of the axes, see ins_vsm/ros parameters
+    struct Config
+    {
+        //! Whether the measurements of an axis are forwarded
+        std::array<bool, 3> use = {false, false, false};
+        //! Whether the standard deviations are given by the variances below
+        bool variancesByParameter = false;
+        std::array<double, 3> variances = {0.0, 0.0, 0.0};
+        //! Whether y and z are flipped from ROS to Rx axis orientation
+        bool rosAxisOrientation = false;
+    };
+
+    void configure(const Config& config)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        config_ = config;
+    }
+
+    /**
+     * @brief Adds a measurement and formats the averaged sentence once the output
+     * period has passed since the last one, allowing for 1 % jitter
+     * @param[in] stamp Time stamp of the measurement
+     * @param[in] vel Velocity in m/s
+     * @param[in] var Variances of the velocity
+     * @param[in] period Output period in nanoseconds
+     * @param[in] improvedVsmHandling Whether the Rx handles axes without valid
+     * variance itself
+     * @param[out] sentence Buffer the sentence is written to
+     * @param[out] invalid Bit mask of the axes dropped for their invalid variance
+     * @return Length of the sentence, 0 if none is due yet
+     */
+    [[nodiscard]] std::size_t add(Timestamp stamp, const std::array<double, 3>& vel,
+                                  const std::array<double, 3>& var, Timestamp period,
+                                  bool improvedVsmHandling, Sentence& sentence,
+                                  uint8_t& invalid)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++count_;
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            vel_[i] += vel[i];
+            var_[i] += var[i];
+        }
+        invalid = 0;
+        if ((stamp - lastStamp_) < (period - period / 100))
+            return 0;
+
+        char* it = sentence.data();
+        char* end = it + sentence.size();
+        it = append(it, "$PSSN,VSM,");
+        it = appendTime(it, stamp);
+
+        std::array<Field, 3> v;
+        std::array<Field, 3> sd;
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            double mean = vel_[i] / count_;
+            double meanVar = var_[i] / count_;
+            if (!config_.use[i])
+            {
+                sd[i] = {true, STD_NOT_MEASURED};
+                continue;
+            }
+            if (config_.rosAxisOrientation && (i > 0))
+                mean = -mean;
+            v[i] = {std::isfinite(mean), mean};
+            if (config_.variancesByParameter)
+                sd[i] = {true, config_.variances[i]};
+            else if (meanVar > 0.0)
+                sd[i] = {true, std::sqrt(meanVar)};
+            else if (!improvedVsmHandling)
+            {
+                invalid |= 1 << i;
+                v[i].set = false;
+                sd[i] = {true, STD_NOT_MEASURED};
+            }
+        }
+        it = appendField(it, end, v[0]);
+        it = appendField(it, end, v[1]);
+        it = appendField(it, end, sd[0]);
+        it = appendField(it, end, sd[1]);
+        it = appendField(it, end, v[2]);
+        it = appendField(it, end, sd[2]);
+
+        uint8_t crc = 0;
+        for (const char* c = sentence.data() + 1; c != it; ++c)
+            crc ^= static_cast<uint8_t>(*c);
+        static const char hex[] = "0123456789ABCDEF";
+        *it++ = '*';
+        *it++ = hex[crc >> 4];
+        *it++ = hex[crc & 0x0F];
+        *it++ = '\r';
+        *it++ = '\n';
+
+        vel_ = {0.0, 0.0, 0.0};
+        var_ = {0.0, 0.0, 0.0};
+        count_ = 0;
+        lastStamp_ = stamp;
+        return it - sentence.data();
+    }
+
+private:
+    //! Value of a field, left empty if not set
+    struct Field
+    {
+        bool set = false;
+        double value = 0.0;
+    };
+
+    template <std::size_t N>
+    [[nodiscard]] static char* append(char* it, const char (&s)[N])
+    {
+        for (std::size_t i = 0; i + 1 < N; ++i)
+            *it++ = s[i];
+        return it;
+    }
+
+    //! Appends an integer zero-padded to two or three digits
+    [[nodiscard]] static char* appendDigits(char* it, uint32_t value,
+                                            uint32_t digits)
+    {
+        if (digits == 3)
+            *it++ = '0' + (value / 100) % 10;
+        *it++ = '0' + (value / 10) % 10;
+        *it++ = '0' + value % 10;
+        return it;
+    }
+
+    //! Appends UTC time of day as hhmmss.sss
+    [[nodiscard]] static char* appendTime(char* it, Timestamp stamp)
+    {
+        uint64_t secondsOfDay = (stamp / 1000000000) % 86400;
+        it = appendDigits(it, secondsOfDay / 3600, 2);
+        it = appendDigits(it, (secondsOfDay / 60) % 60, 2);
+        it = appendDigits(it, secondsOfDay % 60, 2);
+        *it++ = '.';
+        return appendDigits(it, (stamp % 1000000000) / 1000000, 3);
+    }
+
+    //! Appends a comma and the value with three decimal places if set
+    [[nodiscard]] static char* appendField(char* it, char* end, const Field& field)
+    {
+        *it++ = ',';
+        if (!field.set)
+            return it;
+
+        // Clamped such that all fields fit into the sentence
+        double value = std::max(-1e12, std::min(field.value, 1e12));
+        int64_t milli = std::llround(value * 1000.0);
+        if (milli < 0)
+        {
+            *it++ = '-';
+            milli = -milli;
+        }
+        it = std::to_chars(it, end, milli / 1000).ptr;
+        *it++ = '.';
+        return appendDigits(it, milli % 1000, 3);
+    }
+
+    Config config_;
+    //! Sums of the measurements of the current period
+    std::array<double, 3> vel_ = {0.0, 0.0, 0.0};
+    std::array<double, 3> var_ = {0.0, 0.0, 0.0};
+    uint64_t count_ = 0;
+    //! Time stamp of the last sentence
+    Timestamp lastStamp_ = 0;
+    std::mutex mutex_;
+};
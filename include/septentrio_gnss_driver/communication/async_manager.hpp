@@ -58,6 +58,11 @@
 
 #pragma once
 
+// C++ includes
+#include <functional>
+#include <memory>
+#include <optional>
+
 // Boost includes
 #include <boost/asio.hpp>
 #include <boost/bind.hpp>
@@ -68,8 +73,13 @@
 #include <septentrio_gnss_driver/parsers/parsing_utilities.hpp>
 
 // local includes
+#include <septentrio_gnss_driver/communication/connection_supervisor.hpp>
 #include <septentrio_gnss_driver/communication/io.hpp>
+#include <septentrio_gnss_driver/communication/latency_statistics.hpp>
 #include <septentrio_gnss_driver/communication/telegram.hpp>
+#include <septentrio_gnss_driver/communication/telegram_framer.hpp>
+#include <septentrio_gnss_driver/communication/thread_pool.hpp>
+#include <septentrio_gnss_driver/communication/write_queue.hpp>
 
 /**
  * @file async_manager.hpp
@@ -95,6 +105,10 @@ namespace io {
         [[nodiscard]] virtual bool connect() = 0;
         //! Sends commands to the receiver
         virtual void send(const std::string& cmd) = 0;
+        //! Sends data to the receiver without copying it
+        virtual void send(OutboundBuffer data) = 0;
+        //! Sets the handler called after reconnecting, call before connect()
+        virtual void setReconnectHandler(std::function<void()> handler) = 0;
     };
 
     /**
@@ -105,15 +119,23 @@ namespace io {
      * IoType is either boost::asio::serial_port or boost::asio::tcp::ip
      */
     template <typename IoType>
-    class AsyncManager : public AsyncManagerBase
+    class AsyncManager : public AsyncManagerBase, private TelegramSink
     {
     public:
         /**
          * @brief Class constructor
          * @param[in] node Pointer to node
          * @param[in] telegramQueue Telegram queue
+         * @param[in] telegramPool Pool telegrams are taken from
+         * @param[in] statistics Latency statistics to update, nullptr to skip
+         * instrumentation
+         * @param[in] ioService io_service shared with other receivers and run by
+         * a ThreadPool, nullptr to run an io_service on a thread of its own
          */
-        AsyncManager(ROSaicNodeBase* node, TelegramQueue* telegramQueue);
+        AsyncManager(ROSaicNodeBase* node, TelegramQueue* telegramQueue,
+                     TelegramPool* telegramPool,
+                     LatencyStatistics* statistics = nullptr,
+                     std::shared_ptr<boost::asio::io_service> ioService = nullptr);
 
         ~AsyncManager();
 
@@ -123,45 +145,102 @@ namespace io {
 
         void send(const std::string& cmd);
 
+        void send(OutboundBuffer data);
+
+        void setReconnectHandler(std::function<void()> handler);
+
     private:
         void receive();
         void close();
         void runIoService();
-        void runWatchdog();
-        void write(const std::string& cmd);
-        void resync();
-        template <uint8_t index>
-        void readSync();
-        void readSbfHeader();
-        void readSbf(std::size_t length);
-        void readUnknown();
-        void readString();
-        void readStringElements();
+        void supervise();
+        void linkLost(uint64_t connection, const std::string& reason);
+        void write();
+        void read();
+        void readStream();
+        void readTimestamped();
+        void onTelegram(std::shared_ptr<Telegram>&& telegram) override;
+        void onCrcFailure(const Telegram& telegram) override;
+        void onFramingError(framing_error::FramingError error,
+                            const Telegram& telegram) override;
+        //! Framer of a flow of a pcap file, created on first use
+        [[nodiscard]] TelegramFramer& framerOf(size_t flow);
+
+        //! Number of bytes requested from the stream per read
+        static constexpr std::size_t READ_BUFFER_SIZE = 16384;
+        //! Number of bytes framed per handler from a mapped file
+        static constexpr std::size_t MAPPED_CHUNK_SIZE = 1048576;
+        //! Whether the input is a file read chunkwise instead of a stream
+        static constexpr bool FILE_IO = std::is_same<SbfFileIo, IoType>::value ||
+                                       std::is_same<PcapFileIo, IoType>::value;
 
         //! Pointer to the node
         ROSaicNodeBase* node_;
+        //! Whether ioService_ is run by ioThread_ instead of a shared pool
+        bool ownsIoService_;
         std::shared_ptr<boost::asio::io_service> ioService_;
+        //! Keeps ioThread_ running while reconnecting
+        std::optional<boost::asio::executor_work_guard<
+            boost::asio::io_service::executor_type>>
+            work_;
+        //! Runs the handlers one at a time, all access to the stream is done by
+        //! them except for reconnecting
+        HandlerGroup handlers_;
         IoType ioInterface_;
         std::atomic<bool> running_;
+        //! Whether the stream is in use, only accessed by handlers_
+        bool connected_ = false;
+        //! Whether connect() succeeded once
+        bool started_ = false;
         std::thread ioThread_;
-        std::thread watchdogThread_;
-
-        std::array<uint8_t, 1> buf_;
-        //! Timestamp of receiving buffer
-        Timestamp recvStamp_;
-        //! Telegram
-        std::shared_ptr<Telegram> telegram_;
+        std::thread supervisorThread_;
+        //! Reports lost connections, paces reconnecting and records the outages
+        ConnectionSupervisor supervisor_;
+        //! Number of the current connection, handlers of older ones are ignored
+        std::atomic<uint64_t> connection_;
+        //! Called after reconnecting
+        std::function<void()> reconnectHandler_;
+        //! Outbound data, only accessed from the I/O thread
+        WriteQueue writeQueue_;
+
+        //! Buffer the stream is read into in chunks
+        std::array<uint8_t, READ_BUFFER_SIZE> readBuffer_;
+        //! Timestamp of receiving the last byte of the buffer
+        Timestamp readStamp_;
+        //! Extracts the telegrams from the stream
+        TelegramFramer framer_;
+        //! Framers of the further flows of a pcap file, the first uses framer_
+        std::vector<std::unique_ptr<TelegramFramer>> flowFramers_;
+        //! Pool the telegrams are taken from
+        TelegramPool* telegramPool_;
         //! TelegramQueue
         TelegramQueue* telegramQueue_;
+        //! Latency statistics, nullptr if not instrumented
+        LatencyStatistics* statistics_;
     };
 
     template <typename IoType>
     AsyncManager<IoType>::AsyncManager(ROSaicNodeBase* node,
-                                       TelegramQueue* telegramQueue) :
-        node_(node),
-        ioService_(new boost::asio::io_service), ioInterface_(node, ioService_),
-        telegramQueue_(telegramQueue)
+                                       TelegramQueue* telegramQueue,
+                                       TelegramPool* telegramPool,
+                                       LatencyStatistics* statistics,
+                                       std::shared_ptr<boost::asio::io_service> ioService) :
+        node_(node), ownsIoService_(ioService == nullptr),
+        ioService_(ownsIoService_ ? std::make_shared<boost::asio::io_service>()
+                                  : ioService),
+        handlers_(*ioService_), ioInterface_(node, ioService_),
+        supervisor_(
+            static_cast<Timestamp>(node->settings()->reconnect_backoff_min_s * 1e9),
+            static_cast<Timestamp>(node->settings()->reconnect_backoff_max_s * 1e9)),
+        connection_(0), framer_(this, telegramPool), telegramPool_(telegramPool),
+        telegramQueue_(telegramQueue), statistics_(statistics)
     {
+        if constexpr (std::is_same<SerialIo, IoType>::value)
+        {
+            if (node_->settings()->receive_timestamps != "software")
+                framer_.setByteDuration(ioInterface_.byteDuration());
+        }
+        framer_.setInstrumented(statistics_ != nullptr);
         node_->log(log_level::DEBUG, "AsyncManager created.");
     }
 
@@ -169,24 +248,60 @@ namespace io {
     AsyncManager<IoType>::~AsyncManager()
     {
         running_ = false;
-        close();
+        supervisor_.stop();
         node_->log(log_level::DEBUG, "AsyncManager shutting down threads");
-        ioService_->stop();
-        ioThread_.join();
-        watchdogThread_.join();
+        if (supervisorThread_.joinable())
+            supervisorThread_.join();
+        if (ownsIoService_)
+        {
+            close();
+            work_.reset();
+            ioService_->stop();
+            if (ioThread_.joinable())
+                ioThread_.join();
+        } else
+        {
+            // The shared io_service keeps running, no handler may be left
+            handlers_.run([this]() {
+                connected_ = false;
+                ioInterface_.close();
+            });
+            handlers_.drain();
+        }
         node_->log(log_level::DEBUG, "AsyncManager threads stopped");
+        if (supervisor_.outages() > 0)
+            node_->log(log_level::DEBUG,
+                       "AsyncManager outages: " +
+                           std::to_string(supervisor_.outages()) + ", longest " +
+                           std::to_string(supervisor_.longestOutage() / 1000000) +
+                           " ms, total " +
+                           std::to_string(supervisor_.totalOutage() / 1000000) +
+                           " ms");
     }
 
     template <typename IoType>
     [[nodiscard]] bool AsyncManager<IoType>::connect()
     {
+        // Once connected, reconnecting is up to the supervisor
+        if (started_)
+            return true;
+
         running_ = true;
 
         if (!ioInterface_.connect())
         {
             return false;
         }
+        started_ = true;
+        if (ownsIoService_)
+        {
+            work_.emplace(boost::asio::make_work_guard(*ioService_));
+            ioThread_ =
+                std::thread(std::bind(&AsyncManager<IoType>::runIoService, this));
+        }
         receive();
+        if constexpr (!FILE_IO)
+            supervisorThread_ = std::thread(std::bind(&AsyncManager::supervise, this));
 
         return true;
     }
@@ -200,31 +315,58 @@ namespace io {
     template <typename IoType>
     void AsyncManager<IoType>::send(const std::string& cmd)
     {
-        if (cmd.size() == 0)
+        send(OutboundBuffer::fromString(cmd, write_priority::COMMAND));
+    }
+
+    template <typename IoType>
+    void AsyncManager<IoType>::send(OutboundBuffer data)
+    {
+        if (data.buffer.size() == 0)
         {
             node_->log(log_level::ERROR,
                        "AsyncManager message size to be sent to the Rx would be 0");
             return;
         }
+        if constexpr (FILE_IO)
+        {
+            node_->log(log_level::ERROR,
+                       "AsyncManager cannot send to a file: " +
+                           std::string(static_cast<const char*>(data.buffer.data()),
+                                       data.buffer.size()));
+        } else
+        {
+            handlers_.post([this, data = std::move(data)]() mutable {
+                writeQueue_.push(std::move(data));
+                write();
+            });
+        }
+    }
 
-        ioService_->post(boost::bind(&AsyncManager<IoType>::write, this, cmd));
+    template <typename IoType>
+    void AsyncManager<IoType>::setReconnectHandler(std::function<void()> handler)
+    {
+        reconnectHandler_ = std::move(handler);
     }
 
     template <typename IoType>
     void AsyncManager<IoType>::receive()
     {
-        resync();
-        ioThread_ =
-            std::thread(std::bind(&AsyncManager<IoType>::runIoService, this));
-        if (!watchdogThread_.joinable())
-            watchdogThread_ =
-                std::thread(std::bind(&AsyncManager::runWatchdog, this));
+        handlers_.post([this]() {
+            ++connection_;
+            connected_ = true;
+            framer_.resync();
+            flowFramers_.clear();
+            read();
+            // Data sent while reconnecting
+            if constexpr (!FILE_IO)
+                write();
+        });
     }
 
     template <typename IoType>
     void AsyncManager<IoType>::close()
     {
-        ioService_->post([this]() { ioInterface_.close(); });
+        handlers_.post([this]() { ioInterface_.close(); });
     }
 
     template <typename IoType>
@@ -234,397 +376,252 @@ namespace io {
         node_->log(log_level::DEBUG, "AsyncManager ioService terminated.");
     }
 
+    /**
+     * Sleeps until a completion handler reports the connection as lost, then takes
+     * the stream out of use and reconnects. The I/O threads keep running, as they
+     * may be shared with other receivers. The first attempt is immediate, so the
+     * gap in the data is limited to the time of detecting the loss and
+     * reconnecting.
+     */
     template <typename IoType>
-    void AsyncManager<IoType>::runWatchdog()
+    void AsyncManager<IoType>::supervise()
     {
-        while (running_)
+        while (supervisor_.waitForLoss())
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-            if (running_ && ioService_->stopped())
-            {
-                if (node_->settings()->read_from_sbf_log ||
-                    node_->settings()->read_from_pcap)
-                {
-                    node_->log(
-                        log_level::INFO,
-                        "AsyncManager finished reading file. Node will continue to publish queued messages.");
-                    break;
-                } else
-                {
-                    node_->log(log_level::ERROR,
-                               "AsyncManager connection lost. Trying to reconnect.");
-                    ioService_->reset();
-                    ioThread_.join();
-                    while (!ioInterface_.connect())
-                        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-                    receive();
-                }
-            } else if (running_ && std::is_same<TcpIo, IoType>::value)
-            {
-                // Send to check if TCP connection still alive
-                std::string empty = " ";
-                boost::asio::async_write(
-                    *(ioInterface_.stream_), boost::asio::buffer(empty.data(), 1),
-                    [](boost::system::error_code ec, std::size_t /*length*/) {});
-            }
+            // Stale corrections and commands are of no use after reconnecting.
+            // Handlers aborted by closing complete after the stream is
+            // reconnected, they belong to the previous connection already.
+            handlers_.run([this]() {
+                connected_ = false;
+                ++connection_;
+                ioInterface_.close();
+                writeQueue_.clear();
+            });
+
+            bool connected = false;
+            while (!connected && supervisor_.backoff())
+                connected = ioInterface_.connect();
+            if (!connected)
+                break;
+
+            Timestamp outage = supervisor_.restored(steadyTime());
+            node_->log(log_level::INFO,
+                       "AsyncManager reconnected after " +
+                           std::to_string(outage / 1000000) + " ms, outage " +
+                           std::to_string(supervisor_.outages()) + ", longest " +
+                           std::to_string(supervisor_.longestOutage() / 1000000) +
+                           " ms.");
+            receive();
+            if (reconnectHandler_)
+                reconnectHandler_();
         }
     }
 
+    /**
+     * Handlers of previous connections may still complete with errors once the
+     * I/O thread runs again, they are ignored. So are losses while the stream is
+     * out of use, as it is being reconnected already.
+     */
+    template <typename IoType>
+    void AsyncManager<IoType>::linkLost(uint64_t connection,
+                                        const std::string& reason)
+    {
+        if (!running_ || !connected_ || (connection != connection_))
+            return;
+        if (supervisor_.lost(steadyTime()))
+            node_->log(log_level::ERROR, "AsyncManager connection lost: " + reason +
+                                             ". Trying to reconnect.");
+    }
+
+    /**
+     * Writes all pending data at once unless a write is in flight already, in
+     * which case its completion writes the data pending then.
+     */
     template <typename IoType>
-    void AsyncManager<IoType>::write(const std::string& cmd)
+    void AsyncManager<IoType>::write()
     {
+        if (!connected_ || writeQueue_.writing() || !writeQueue_.pending())
+            return;
+
         boost::asio::async_write(
-            *(ioInterface_.stream_), boost::asio::buffer(cmd.data(), cmd.size()),
-            [this, cmd](boost::system::error_code ec, std::size_t /*length*/) {
+            *(ioInterface_.stream_), writeQueue_.gather(),
+            handlers_.wrap([this, connection = connection_.load()](
+                               boost::system::error_code ec, std::size_t length) {
+                // The queue of a previous connection was discarded
+                if (connection != connection_)
+                    return;
                 if (!ec)
                 {
-                    // Prints the data that was sent
-                    node_->log(log_level::DEBUG, "AsyncManager sent the following " +
-                                                     std::to_string(cmd.size()) +
-                                                     " bytes to the Rx: " + cmd);
+                    // Prints the commands that were sent
+                    for (const auto& data : writeQueue_.inFlight())
+                    {
+                        if (data.priority != write_priority::COMMAND)
+                            continue;
+                        ROSAIC_LOG(
+                            node_, log_level::DEBUG,
+                            "AsyncManager sent the following " +
+                                std::to_string(data.buffer.size()) +
+                                " bytes to the Rx: " +
+                                std::string(
+                                    static_cast<const char*>(data.buffer.data()),
+                                    data.buffer.size()));
+                    }
+                    writeQueue_.written();
+                    write();
                 } else
                 {
                     node_->log(log_level::ERROR,
-                               "AsyncManager was unable to send the following " +
-                                   std::to_string(cmd.size()) +
-                                   " bytes to the Rx: " + cmd);
+                               "AsyncManager was unable to send " +
+                                   std::to_string(writeQueue_.inFlight().size()) +
+                                   " buffers to the Rx, " + std::to_string(length) +
+                                   " bytes were sent: " + ec.message());
+                    writeQueue_.clear();
+                    linkLost(connection, ec.message());
                 }
-            });
+            }));
     }
 
     template <typename IoType>
-    void AsyncManager<IoType>::resync()
+    void AsyncManager<IoType>::read()
     {
-        telegram_.reset(new Telegram);
-        readSync<0>();
+        if (!connected_)
+            return;
+        if constexpr (FILE_IO)
+        {
+            // Frame the file chunkwise, so that close() can interleave
+            handlers_.post([this]() {
+                if (!connected_)
+                    return;
+                boost::asio::const_buffer chunk =
+                    ioInterface_.nextChunk(MAPPED_CHUNK_SIZE);
+                if (chunk.size() == 0)
+                {
+                    node_->log(
+                        log_level::INFO,
+                        "AsyncManager finished reading file. Node will continue to publish queued messages.");
+                    return;
+                }
+                readStamp_ = node_->getTime();
+                // Segments of different flows must not be spliced into one block
+                TelegramFramer* framer = &framer_;
+                if constexpr (std::is_same<PcapFileIo, IoType>::value)
+                    framer = &framerOf(ioInterface_.flow());
+                framer->frame(static_cast<const uint8_t*>(chunk.data()),
+                              chunk.size(), readStamp_);
+                read();
+            });
+        } else if constexpr (std::is_same<TcpIo, IoType>::value)
+        {
+            if (ioInterface_.timestamped())
+                readTimestamped();
+            else
+                readStream();
+        } else
+            readStream();
     }
 
     template <typename IoType>
-    template <uint8_t index>
-    void AsyncManager<IoType>::readSync()
+    void AsyncManager<IoType>::readStream()
     {
-        static_assert(index < 3);
-
-        boost::asio::async_read(
-            *(ioInterface_.stream_),
-            boost::asio::buffer(telegram_->message.data() + index, 1),
-            [this](boost::system::error_code ec, std::size_t numBytes) {
-                Timestamp stamp = node_->getTime();
-
+        ioInterface_.stream_->async_read_some(
+            boost::asio::buffer(readBuffer_.data(), readBuffer_.size()),
+            handlers_.wrap([this, connection = connection_.load()](
+                               boost::system::error_code ec, std::size_t numBytes) {
                 if (!ec)
                 {
-                    if (numBytes == 1)
-                    {
-                        uint8_t& currByte = telegram_->message[index];
-
-                        if (currByte == SYNC_BYTE_1)
-                        {
-                            telegram_->stamp = stamp;
-                            readSync<1>();
-                        } else
-                        {
-                            switch (index)
-                            {
-                            case 0:
-                            {
-                                telegram_->type = telegram_type::UNKNOWN;
-                                readUnknown();
-                                break;
-                            }
-                            case 1:
-                            {
-                                switch (currByte)
-                                {
-                                case SBF_SYNC_BYTE_2:
-                                {
-                                    telegram_->type = telegram_type::SBF;
-                                    readSbfHeader();
-                                    break;
-                                }
-                                case NMEA_SYNC_BYTE_2:
-                                {
-                                    telegram_->type = telegram_type::NMEA;
-                                    readSync<2>();
-                                    break;
-                                }
-                                case NMEA_INS_SYNC_BYTE_2:
-                                {
-                                    telegram_->type = telegram_type::NMEA_INS;
-                                    readSync<2>();
-                                    break;
-                                }
-                                case RESPONSE_SYNC_BYTE_2:
-                                {
-                                    telegram_->type = telegram_type::RESPONSE;
-                                    readSync<2>();
-                                    break;
-                                }
-                                default:
-                                {
-                                    std::stringstream ss;
-                                    ss << std::hex << currByte;
-                                    node_->log(
-                                        log_level::DEBUG,
-                                        "AsyncManager sync byte 2 read fault, should never come here.. Received byte was " +
-                                            ss.str());
-                                    resync();
-                                    break;
-                                }
-                                }
-                                break;
-                            }
-                            case 2:
-                            {
-                                switch (currByte)
-                                {
-                                case NMEA_SYNC_BYTE_3:
-                                {
-                                    if (telegram_->type == telegram_type::NMEA)
-                                        readString();
-                                    else
-                                        resync();
-                                    break;
-                                }
-                                case NMEA_INS_SYNC_BYTE_3:
-                                {
-                                    if (telegram_->type == telegram_type::NMEA_INS)
-                                        readString();
-                                    else
-                                        resync();
-                                    break;
-                                }
-                                case RESPONSE_SYNC_BYTE_3:
-                                {
-                                    if (telegram_->type == telegram_type::RESPONSE)
-                                        readString();
-                                    else
-                                        resync();
-                                    break;
-                                }
-                                case RESPONSE_SYNC_BYTE_3a:
-                                {
-                                    if (telegram_->type == telegram_type::RESPONSE)
-                                        readString();
-                                    else
-                                        resync();
-                                    break;
-                                }
-                                case ERROR_SYNC_BYTE_3:
-                                {
-                                    if (telegram_->type == telegram_type::RESPONSE)
-                                    {
-                                        telegram_->type =
-                                            telegram_type::ERROR_RESPONSE;
-                                        readString();
-                                    } else
-                                        resync();
-                                    break;
-                                }
-                                default:
-                                {
-                                    std::stringstream ss;
-                                    ss << std::hex << currByte;
-                                    node_->log(
-                                        log_level::DEBUG,
-                                        "AsyncManager sync byte 3 read fault, should never come here. Received byte was " +
-                                            ss.str());
-                                    resync();
-                                    break;
-                                }
-                                }
-                                break;
-                            }
-                            default:
-                            {
-                                node_->log(
-                                    log_level::DEBUG,
-                                    "AsyncManager sync read fault, should never come here.");
-                                resync();
-                                break;
-                            }
-                            }
-                        }
-                    } else
-                    {
-                        node_->log(
-                            log_level::DEBUG,
-                            "AsyncManager sync read fault, wrong number of bytes read: " +
-                                std::to_string(numBytes));
-                        resync();
-                    }
+                    readStamp_ = node_->getTime();
+                    framer_.frame(readBuffer_.data(), numBytes, readStamp_);
+                    read();
                 } else
                 {
-                    node_->log(log_level::DEBUG,
-                               "AsyncManager sync read error: " + ec.message());
+                    ROSAIC_LOG(node_, log_level::DEBUG,
+                               "AsyncManager read error: " + ec.message());
+                    linkLost(connection, ec.message());
                 }
-            });
+            }));
     }
 
+    /**
+     * Waits for the socket to become readable and reads the available bytes
+     * together with the time stamp the kernel or network interface attached to
+     * them.
+     */
     template <typename IoType>
-    void AsyncManager<IoType>::readSbfHeader()
+    void AsyncManager<IoType>::readTimestamped()
     {
-        telegram_->message.resize(SBF_HEADER_SIZE);
-
-        boost::asio::async_read(
-            *(ioInterface_.stream_),
-            boost::asio::buffer(telegram_->message.data() + 2, SBF_HEADER_SIZE - 2),
-            [this](boost::system::error_code ec, std::size_t numBytes) {
-                if (!ec)
+        ioInterface_.stream_->async_wait(
+            boost::asio::socket_base::wait_read,
+            handlers_.wrap([this, connection = connection_.load()](
+                               boost::system::error_code ec) {
+                if (ec)
                 {
-                    if (numBytes == (SBF_HEADER_SIZE - 2))
-                    {
-                        uint16_t length =
-                            parsing_utilities::getLength(telegram_->message);
-                        if (length > MAX_SBF_SIZE)
-                        {
-                            node_->log(
-                                log_level::DEBUG,
-                                "AsyncManager SBF header read fault, length of block exceeds " +
-                                    std::to_string(MAX_SBF_SIZE) + ": " +
-                                    std::to_string(length));
-                        } else
-                            readSbf(length);
-                    } else
-                    {
-                        node_->log(
-                            log_level::DEBUG,
-                            "AsyncManager SBF header read fault, wrong number of bytes read: " +
-                                std::to_string(numBytes));
-                        resync();
-                    }
-                } else
+                    ROSAIC_LOG(node_, log_level::DEBUG,
+                               "AsyncManager read error: " + ec.message());
+                    linkLost(connection, ec.message());
+                    return;
+                }
+                readStamp_ = node_->getTime();
+                ssize_t numBytes = ioInterface_.receive(
+                    readBuffer_.data(), readBuffer_.size(), readStamp_);
+                if (numBytes > 0)
                 {
-                    node_->log(log_level::DEBUG,
-                               "AsyncManager SBF header read error: " +
-                                   ec.message());
+                    framer_.frame(readBuffer_.data(), numBytes, readStamp_);
+                } else if (numBytes == 0)
+                {
+                    ROSAIC_LOG(node_, log_level::DEBUG,
+                               "AsyncManager read error: End of file");
+                    linkLost(connection, "End of file");
+                    return;
+                } else if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+                {
+                    std::string reason(std::strerror(errno));
+                    ROSAIC_LOG(node_, log_level::DEBUG,
+                               "AsyncManager read error: " + reason);
+                    linkLost(connection, reason);
+                    return;
                 }
-            });
+                read();
+            }));
     }
 
     template <typename IoType>
-    void AsyncManager<IoType>::readSbf(std::size_t length)
+    void AsyncManager<IoType>::onTelegram(std::shared_ptr<Telegram>&& telegram)
     {
-        telegram_->message.resize(length);
-
-        boost::asio::async_read(
-            *(ioInterface_.stream_),
-            boost::asio::buffer(telegram_->message.data() + SBF_HEADER_SIZE,
-                                length - SBF_HEADER_SIZE),
-            [this, length](boost::system::error_code ec, std::size_t numBytes) {
-                if (!ec)
-                {
-                    if (numBytes == (length - SBF_HEADER_SIZE))
-                    {
-                        if (crc::isValid(telegram_->message))
-                        {
-                            telegramQueue_->push(telegram_);
-                        } else
-                            node_->log(log_level::DEBUG,
-                                       "AsyncManager crc failed for SBF  " +
-                                           std::to_string(parsing_utilities::getId(
-                                               telegram_->message)) +
-                                           ".");
-                    } else
-                    {
-                        node_->log(
-                            log_level::DEBUG,
-                            "AsyncManager SBF read fault, wrong number of bytes read: " +
-                                std::to_string(numBytes));
-                    }
-                    resync();
-                } else
-                {
-                    node_->log(log_level::DEBUG,
-                               "AsyncManager SBF read error: " + ec.message());
-                }
-            });
+        telegramQueue_->push(std::move(telegram));
     }
 
     template <typename IoType>
-    void AsyncManager<IoType>::readUnknown()
+    void AsyncManager<IoType>::onCrcFailure(const Telegram& telegram)
     {
-        telegram_->message.resize(1);
-        telegram_->message.reserve(256);
-        readStringElements();
+        ROSAIC_LOG_THROTTLE(
+            node_, log_level::DEBUG, STREAM_ERROR_LOG_PERIOD_S,
+            "AsyncManager crc failed for SBF  " +
+                std::to_string(parsing_utilities::getId(telegram.message)) + ".");
+        if (statistics_)
+            statistics_->countCrcFailure();
     }
 
     template <typename IoType>
-    void AsyncManager<IoType>::readString()
+    void AsyncManager<IoType>::onFramingError(framing_error::FramingError error,
+                                              const Telegram& telegram)
     {
-        telegram_->message.resize(3);
-        telegram_->message.reserve(256);
-        readStringElements();
+        ROSAIC_LOG_THROTTLE(node_, log_level::DEBUG, STREAM_ERROR_LOG_PERIOD_S,
+                            "AsyncManager " +
+                                TelegramFramer::describe(error, telegram));
+        if (statistics_)
+            statistics_->countFramingError();
     }
 
     template <typename IoType>
-    void AsyncManager<IoType>::readStringElements()
+    TelegramFramer& AsyncManager<IoType>::framerOf(size_t flow)
     {
-        boost::asio::async_read(
-            *(ioInterface_.stream_), boost::asio::buffer(buf_.data(), 1),
-            [this](boost::system::error_code ec, std::size_t numBytes) {
-                if (!ec)
-                {
-                    if (numBytes == 1)
-                    {
-                        telegram_->message.push_back(buf_[0]);
-                        /*node_->log(log_level::DEBUG,
-                                   "Buffer: " +
-                                       std::string(telegram_->message.begin(),
-                                                   telegram_->message.end()));*/
-
-                        switch (buf_[0])
-                        {
-                        case SYNC_BYTE_1:
-                        {
-                            telegram_.reset(new Telegram);
-                            telegram_->message[0] = buf_[0];
-                            telegram_->stamp = node_->getTime();
-                            node_->log(
-                                log_level::DEBUG,
-                                "AsyncManager string read fault, sync 1 found.");
-                            readSync<1>();
-                            break;
-                        }
-                        case LF:
-                        {
-                            if (telegram_->message[telegram_->message.size() - 2] ==
-                                CR)
-                                telegramQueue_->push(telegram_);
-                            else
-                                node_->log(
-                                    log_level::DEBUG,
-                                    "LF wo CR: " +
-                                        std::string(telegram_->message.begin(),
-                                                    telegram_->message.end()));
-                            resync();
-                            break;
-                        }
-                        case CONNECTION_DESCRIPTOR_FOOTER:
-                        {
-                            telegram_->type = telegram_type::CONNECTION_DESCRIPTOR;
-                            telegramQueue_->push(telegram_);
-                            resync();
-                            break;
-                        }
-                        default:
-                        {
-                            readStringElements();
-                            break;
-                        }
-                        }
-                    } else
-                    {
-                        node_->log(
-                            log_level::DEBUG,
-                            "AsyncManager string read fault, wrong number of bytes read: " +
-                                std::to_string(numBytes));
-                        resync();
-                    }
-                } else
-                {
-                    node_->log(log_level::DEBUG,
-                               "AsyncManager string read error: " + ec.message());
-                }
-            });
+        if (flow == 0)
+            return framer_;
+        while (flowFramers_.size() < flow)
+        {
+            flowFramers_.emplace_back(new TelegramFramer(this, telegramPool_));
+            flowFramers_.back()->setInstrumented(statistics_ != nullptr);
+        }
+        return *flowFramers_[flow - 1];
     }
 } // namespace io
\ No newline at end of file
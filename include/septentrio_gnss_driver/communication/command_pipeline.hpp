@@ -0,0 +1,189 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+
+/**
+ * @file command_pipeline.hpp
+ * @brief Keeps track of the commands sent to the Rx and their replies
+ */
+
+namespace io {
+
+    /**
+     * @class CommandPipeline
+     * @brief Lets up to depth commands be in flight at once instead of waiting for
+     * the reply to each command before sending the next one. The Rx processes its
+     * commands in order, so replies are matched in order as well. A reply naming a
+     * later command in flight means the replies to the ones before it were lost.
+     */
+    class CommandPipeline
+    {
+    public:
+        //! Commands in flight by default, small enough for the Rx input buffer
+        static constexpr std::size_t DEFAULT_DEPTH = 8;
+        //! Time waited for a reply before giving up on the command
+        static constexpr std::chrono::milliseconds DEFAULT_TIMEOUT =
+            std::chrono::milliseconds(5000);
+
+        explicit CommandPipeline(std::size_t depth = DEFAULT_DEPTH) : depth_(depth)
+        {
+        }
+
+        /**
+         * @brief Waits until less than depth commands are in flight and registers
+         * the command, call before sending it. If no reply arrives in time the
+         * oldest command is given up on.
+         * @param[in] cmd Command to be sent
+         * @param[in] timeout Time to wait for a reply at full depth
+         * @return Whether no command had to be given up on
+         */
+        [[nodiscard]] bool push(const std::string& cmd,
+                                std::chrono::milliseconds timeout = DEFAULT_TIMEOUT)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            bool replied = cv_.wait_for(lock, timeout, [this] {
+                return inFlight_.size() < depth_;
+            });
+            if (!replied)
+            {
+                inFlight_.pop_front();
+                ++unanswered_;
+            }
+            inFlight_.push_back(cmd);
+            return replied;
+        }
+
+        /**
+         * @brief Matches a reply of the Rx with the command it answers
+         * @param[in] reply Reply starting with "$R: " or "$R? "
+         * @return The command replied to, empty if none was in flight
+         */
+        [[nodiscard]] std::string reply(const std::string& reply)
+        {
+            std::string name = commandName(reply, 4);
+            std::string cmd;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (inFlight_.empty())
+                    return cmd;
+
+                std::size_t match = 0;
+                for (std::size_t i = 0; i < inFlight_.size(); ++i)
+                {
+                    if (commandName(inFlight_[i], 0) == name)
+                    {
+                        match = i;
+                        break;
+                    }
+                }
+                unanswered_ += match;
+                inFlight_.erase(inFlight_.begin(), inFlight_.begin() + match);
+                cmd = std::move(inFlight_.front());
+                inFlight_.pop_front();
+            }
+            cv_.notify_all();
+            return cmd;
+        }
+
+        /**
+         * @brief Waits until all commands in flight are replied to
+         * @param[in] timeout Time to wait for each reply
+         * @return Whether all commands were replied to, the remaining ones are given
+         * up on otherwise
+         */
+        [[nodiscard]] bool flush(std::chrono::milliseconds timeout = DEFAULT_TIMEOUT)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!inFlight_.empty())
+            {
+                std::size_t inFlight = inFlight_.size();
+                if (!cv_.wait_for(lock, timeout, [this, inFlight] {
+                        return inFlight_.size() < inFlight;
+                    }))
+                {
+                    unanswered_ += inFlight_.size();
+                    inFlight_.clear();
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        //! Gives up on all commands in flight and wakes up all waiting threads
+        void clear()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                inFlight_.clear();
+            }
+            cv_.notify_all();
+        }
+
+        //! Number of commands given up on or whose reply was lost
+        [[nodiscard]] uint64_t unanswered() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return unanswered_;
+        }
+
+    private:
+        /**
+         * @brief Name of a command, as echoed by the Rx in its reply
+         * @param[in] s Command or reply
+         * @param[in] pos Position to start from
+         */
+        [[nodiscard]] static std::string commandName(const std::string& s,
+                                                     std::size_t pos)
+        {
+            pos = s.find_first_not_of(" \x0D", pos);
+            if (pos == std::string::npos)
+                return std::string();
+            return s.substr(pos, s.find_first_of(",: \x0D\n", pos) - pos);
+        }
+
+        //! Maximum number of commands in flight
+        std::size_t depth_;
+        //! Commands sent but not replied to yet, oldest first
+        std::deque<std::string> inFlight_;
+        //! Number of commands given up on or whose reply was lost
+        uint64_t unanswered_ = 0;
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+    };
+} // namespace io
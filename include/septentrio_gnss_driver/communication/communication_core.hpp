@@ -62,12 +62,16 @@
 #include <boost/asio.hpp>
 #include <boost/asio/serial_port.hpp>
 // C++ library includes
+#include <atomic>
 #include <fstream>
 #include <memory>
 #include <sstream>
+#include <vector>
 // ROSaic includes
 #include <septentrio_gnss_driver/communication/async_manager.hpp>
+#include <septentrio_gnss_driver/communication/raw_recorder.hpp>
 #include <septentrio_gnss_driver/communication/telegram_handler.hpp>
+#include <septentrio_gnss_driver/communication/thread_pool.hpp>
 
 /**
  * @file communication_core.hpp
@@ -99,8 +103,17 @@ namespace io {
         /**
          * @brief Constructor of the class CommunicationCore
          * @param[in] node Pointer to node
+         * @param[in] ioPool Threads running the I/O of several receivers, nullptr
+         * for threads of its own
+         * @param[in] processingPool Threads processing the telegrams of several
+         * receivers, nullptr for a thread of its own
+         * @param[in] stop Set by the owner to stop connecting, e.g. on shutdown
+         * while another thread is still trying to reach the Rx, nullptr if the
+         * owner does not stop it
          */
-        CommunicationCore(ROSaicNodeBase* node);
+        CommunicationCore(ROSaicNodeBase* node, ThreadPool* ioPool = nullptr,
+                          ThreadPool* processingPool = nullptr,
+                          const std::atomic<bool>* stop = nullptr);
         /**
          * @brief Default destructor of the class CommunicationCore
          */
@@ -122,13 +135,17 @@ namespace io {
          * manager_
          * @param cmd The command to hand over
          */
-        void sendVelocity(const std::string& velNmea);
+        void sendVelocity(std::string_view velNmea);
 
-                        /**
-         * @brief Hands over to the send() method of manager_ Used for rtcm data does not require a response
-         * @param cmd The command to hand over
+        /**
+         * @brief Hands over RTCM corrections to manager_ without copying them,
+         * they are written ahead of velocity aiding and commands
+         * @param owner Keeps the corrections alive until written
+         * @param data The corrections
+         * @param size Number of bytes of the corrections
          */
-        void sendRtcm(const std::string&);
+        void sendRtcm(std::shared_ptr<const void> owner, const uint8_t* data,
+                      std::size_t size);
 
     private:
         /**
@@ -151,22 +168,100 @@ namespace io {
         void processTelegrams();
 
         /**
-         * @brief Hands over to the send() method of manager_
+         * @brief Processes the telegrams queued so far on the processing pool,
+         * scheduled by the queue on push
+         */
+        void processAvailable();
+
+        //! Schedules processAvailable() unless it is already scheduled
+        void scheduleProcessing();
+
+        /**
+         * @brief Records, handles and recycles telegrams, publishes the latency
+         * statistics when due
+         * @param telegrams Telegrams to be processed, cleared afterwards
+         */
+        void processBatch(std::vector<std::shared_ptr<Telegram>>& telegrams);
+
+        /**
+         * @brief Configures the Rx again each time the main connection was
+         * re-established
+         */
+        void reconfigureRx();
+
+        /**
+         * @brief Handles a telegram and measures the latencies of its stages
+         * @param telegram Telegram to be handled
+         */
+        void handleInstrumented(const std::shared_ptr<Telegram>& telegram);
+
+        /**
+         * @brief Hands over to the send() method of manager_ once the command
+         * pipeline has room for it, does not wait for the reply
          * @param cmd The command to hand over
          */
         void send(const std::string&);
 
+        /**
+         * @brief Waits for the replies to all commands sent
+         */
+        void flush();
+
+        /**
+         * @brief Adds a command to the desired configuration of the Rx
+         * @param cmd The command to add
+         */
+        void configure(const std::string& cmd);
+
+        /**
+         * @brief Sends the desired configuration, only the part differing from the
+         * applied one if the Rx kept its configuration
+         */
+        void applyConfiguration();
+
+        /**
+         * @brief Queries whether the Rx still has the configuration applied last
+         * @return Whether the Rx kept its configuration
+         */
+        [[nodiscard]] bool rxKeptConfiguration();
+
 
         //! Pointer to Node
         ROSaicNodeBase* node_;
         //! Settings
         const Settings* settings_;
+        //! Threads running the I/O, nullptr if each connection has a thread
+        ThreadPool* ioPool_;
+        //! Threads processing the telegrams, nullptr if processingThread_ does
+        ThreadPool* processingPool_;
+        //! TelegramPool, declared first so it outlives all telegram users
+        TelegramPool telegramPool_;
+        //! Latency statistics, only allocated if enabled, outlives their users
+        std::unique_ptr<LatencyStatistics> statistics_;
+        //! Period of publishing the latency statistics in nanoseconds
+        Timestamp statisticsPeriod_ = 0;
+        //! Monotonic time the latency statistics are published next
+        Timestamp nextStatistics_ = 0;
         //! TelegramQueue
         TelegramQueue telegramQueue_;
         //! TelegramHandler
         TelegramHandler telegramHandler_;
+        //! Recorder of the raw stream, only allocated if enabled
+        std::unique_ptr<RawRecorder> rawRecorder_;
         //! Processing thread
         std::thread processingThread_;
+        //! Runs processAvailable() on processingPool_, one at a time
+        std::unique_ptr<HandlerGroup> processing_;
+        //! Whether processAvailable() is scheduled and has not started draining
+        std::atomic<bool> processingScheduled_;
+        //! Telegrams drained by processAvailable()
+        std::vector<std::shared_ptr<Telegram>> scheduledTelegrams_;
+        //! Thread configuring the Rx after reconnecting, notified by manager_
+        std::thread reconfigureThread_;
+        Semaphore reconfigureSemaphore_;
+        std::atomic<bool> reconfiguring_;
+        //! Serializes configuring the Rx
+        std::mutex configMutex_;
         //! Whether connecting was successful
         bool initializedIo_ = false;
         //! Processes I/O stream data
@@ -178,8 +273,23 @@ namespace io {
 
         bool nmeaActivated_ = false;
 
+        //! Commands configuring the Rx as desired, collected by configureRx()
+        std::vector<std::string> desiredConfig_;
+        //! Commands of the configuration applied last
+        std::vector<std::string> appliedConfig_;
+        //! Stream outputting the ReceiverSetup block
+        uint8_t restStream_ = 0;
+
         //! Indicator for threads to run
         std::atomic<bool> running_;
+        //! Set by the owner to stop connecting, may be nullptr
+        const std::atomic<bool>* stop_;
+
+        //! Whether connecting shall be given up, on destruction or shutdown
+        [[nodiscard]] bool stopped() const
+        {
+            return !running_ || !ros::ok() || ((stop_ != nullptr) && *stop_);
+        }
 
         //! Main communication port
         std::string mainConnectionPort_;
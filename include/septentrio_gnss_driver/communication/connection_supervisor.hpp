@@ -0,0 +1,211 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+// ROSaic, no ROS dependencies
+#include <septentrio_gnss_driver/abstraction/timestamp.hpp>
+
+/**
+ * @file connection_supervisor.hpp
+ * @brief Signals the loss of a connection, paces the attempts to reconnect and
+ * records the outages
+ */
+
+namespace io {
+
+    /**
+     * @class ConnectionSupervisor
+     * @brief The completion handlers report a lost link with lost(), which wakes up
+     * the thread waiting in waitForLoss() right away. The first attempt to
+     * reconnect is immediate, further ones back off exponentially from the minimum
+     * to the maximum delay.
+     */
+    class ConnectionSupervisor
+    {
+    public:
+        //! Delay before the second attempt to reconnect by default
+        static constexpr Timestamp DEFAULT_MIN_DELAY = 100000000;
+        //! Upper bound of the delay between attempts to reconnect by default
+        static constexpr Timestamp DEFAULT_MAX_DELAY = 5000000000;
+
+        explicit ConnectionSupervisor(Timestamp minDelay = DEFAULT_MIN_DELAY,
+                                      Timestamp maxDelay = DEFAULT_MAX_DELAY) :
+            minDelay_(std::max<Timestamp>(minDelay, 1)),
+            maxDelay_(std::max(maxDelay, minDelay))
+        {
+        }
+
+        /**
+         * @brief Reports the loss of the connection, repeated reports during the
+         * same outage are ignored
+         * @param[in] now Monotonic time of detecting the loss
+         * @return Whether this report started a new outage
+         */
+        [[nodiscard]] bool lost(Timestamp now)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (lost_ || stopped_)
+                    return false;
+                lost_ = true;
+                lostSince_ = now;
+                attempts_ = 0;
+            }
+            cv_.notify_all();
+            return true;
+        }
+
+        /**
+         * @brief Waits until the connection is lost
+         * @return Whether it was lost, false if stopped
+         */
+        [[nodiscard]] bool waitForLoss()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return lost_ || stopped_; });
+            return !stopped_;
+        }
+
+        /**
+         * @brief Delay before the next attempt to reconnect, 0 for the first one
+         */
+        [[nodiscard]] Timestamp nextDelay()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Timestamp delay = 0;
+            if (attempts_ > 0)
+            {
+                delay = minDelay_;
+                for (uint32_t i = 1; (i < attempts_) && (delay < maxDelay_); ++i)
+                    delay *= 2;
+                delay = std::min(delay, maxDelay_);
+            }
+            ++attempts_;
+            return delay;
+        }
+
+        /**
+         * @brief Waits for the delay before the next attempt to reconnect
+         * @return Whether to attempt, false if stopped
+         */
+        [[nodiscard]] bool backoff()
+        {
+            std::chrono::nanoseconds delay(nextDelay());
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait_for(lock, delay, [this] { return stopped_; });
+            return !stopped_;
+        }
+
+        /**
+         * @brief Reports that the connection is established again
+         * @param[in] now Monotonic time of reconnecting
+         * @return Duration of the outage in nanoseconds
+         */
+        Timestamp restored(Timestamp now)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!lost_)
+                return 0;
+            lost_ = false;
+            lastOutage_ = (now > lostSince_) ? (now - lostSince_) : 0;
+            longestOutage_ = std::max(longestOutage_, lastOutage_);
+            totalOutage_ += lastOutage_;
+            ++outages_;
+            return lastOutage_;
+        }
+
+        //! Wakes up all waiting threads for shutdown
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopped_ = true;
+            }
+            cv_.notify_all();
+        }
+
+        //! Number of outages recovered from
+        [[nodiscard]] uint64_t outages() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return outages_;
+        }
+
+        //! Duration of the last outage in nanoseconds
+        [[nodiscard]] Timestamp lastOutage() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return lastOutage_;
+        }
+
+        //! Duration of the longest outage in nanoseconds
+        [[nodiscard]] Timestamp longestOutage() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return longestOutage_;
+        }
+
+        //! Summed up duration of all outages in nanoseconds
+        [[nodiscard]] Timestamp totalOutage() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return totalOutage_;
+        }
+
+    private:
+        //! Delay before the second attempt to reconnect
+        Timestamp minDelay_;
+        //! Upper bound of the delay between attempts to reconnect
+        Timestamp maxDelay_;
+        //! Whether the connection is lost and not established again yet
+        bool lost_ = false;
+        //! Whether supervision is shut down
+        bool stopped_ = false;
+        //! Monotonic time the current outage was detected
+        Timestamp lostSince_ = 0;
+        //! Attempts to reconnect during the current outage
+        uint32_t attempts_ = 0;
+        //! Outage statistics
+        uint64_t outages_ = 0;
+        Timestamp lastOutage_ = 0;
+        Timestamp longestOutage_ = 0;
+        Timestamp totalOutage_ = 0;
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+    };
+} // namespace io
@@ -0,0 +1,279 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// ROSaic, no ROS dependencies
+#include <septentrio_gnss_driver/abstraction/timestamp.hpp>
+
+/**
+ * @file epoch_aggregator.hpp
+ * @brief Collects the SBF blocks of one epoch and triggers the assembly of the
+ * outputs combining them
+ */
+
+namespace epoch_block {
+    //! SBF blocks combined into composite outputs, to be combined as bit mask
+    enum EpochBlock : uint16_t
+    {
+        NONE = 0,
+        PVT_GEODETIC = 1 << 0,
+        POS_COV_GEODETIC = 1 << 1,
+        ATT_EULER = 1 << 2,
+        ATT_COV_EULER = 1 << 3,
+        VEL_COV_GEODETIC = 1 << 4,
+        INS_NAV_CART = 1 << 5,
+        INS_NAV_GEOD = 1 << 6,
+        MEAS_EPOCH = 1 << 7,
+        CHANNEL_STATUS = 1 << 8,
+        DOP = 1 << 9,
+        RECEIVER_STATUS = 1 << 10,
+        QUALITY_IND = 1 << 11
+    };
+} // namespace epoch_block
+
+namespace io {
+
+    /**
+     * @class EpochAggregator
+     * @brief Fires the assembler of each composite output exactly once per epoch,
+     * identified by WNc and TOW. An epoch is complete for a composite once all of
+     * its inputs that arrived in both of its previous two epochs have arrived, so
+     * blocks output at a lower rate than the others do not delay it. An epoch that
+     * is not complete is closed when a block of a newer epoch arrives or the
+     * timeout passes, the assembler is fired then if all required inputs have
+     * arrived. A block more than BACKWARD_JUMP_TOLERANCE older than the epoch of
+     * a composite, e.g. after the Rx was reset or a replay restarted, starts the
+     * history of that composite anew.
+     */
+    class EpochAggregator
+    {
+    public:
+        //! Assembles and publishes a composite output from the stored blocks
+        typedef std::function<void()> Assembler;
+
+        /**
+         * @brief Class constructor
+         * @param[in] timeout Nanoseconds after the first block of an epoch after
+         * which it is closed. It is evaluated lazily, only when a later block
+         * arrives, so without further blocks an incomplete epoch stays open.
+         */
+        explicit EpochAggregator(Timestamp timeout = DEFAULT_TIMEOUT) :
+            timeout_(timeout)
+        {
+        }
+
+        /**
+         * @brief Registers a composite output
+         * @param[in] inputs Blocks used by the assembler as mask of
+         * epoch_block::EpochBlock
+         * @param[in] required Subset of inputs without which there is no output
+         * @param[in] assembler Assembler to be fired per epoch
+         */
+        void add(uint16_t inputs, uint16_t required, Assembler assembler)
+        {
+            Composite composite;
+            composite.inputs = inputs;
+            composite.required = required & inputs;
+            composite.expected = composite.required;
+            composite.assemble = std::move(assembler);
+            composites_.push_back(std::move(composite));
+        }
+
+        //! Removes all composite outputs and forgets the epochs seen
+        void clear()
+        {
+            composites_.clear();
+            reset();
+        }
+
+        /**
+         * @brief Forgets the epochs seen, e.g. after reconnecting. Open epochs are
+         * discarded without firing their assemblers.
+         */
+        void reset()
+        {
+            for (auto& composite : composites_)
+            {
+                composite.expected = composite.required;
+                composite.received = 0;
+                composite.previous = 0;
+                composite.epoch = 0;
+                composite.open = false;
+                composite.opened = 0;
+            }
+            block_ = epoch_block::NONE;
+            epoch_ = 0;
+        }
+
+        /**
+         * @brief To be called for every SBF block before it is parsed. Closes
+         * epochs timed out and, if the block belongs to a newer epoch, the epochs
+         * of the composites using it, as the block is about to overwrite their
+         * data.
+         * @param[in] block Block as epoch_block::EpochBlock, NONE if not used
+         * @param[in] tow TOW of the block in ms
+         * @param[in] wnc WNc of the block
+         * @param[in] now Monotonic time in ns
+         */
+        void begin(uint16_t block, uint32_t tow, uint16_t wnc, Timestamp now)
+        {
+            for (auto& composite : composites_)
+            {
+                if (composite.open && ((now - composite.opened) > timeout_))
+                    close(composite);
+            }
+
+            block_ = epoch_block::NONE;
+            // Do-not-use TOW or WNc, the block cannot be assigned to an epoch
+            if ((block == epoch_block::NONE) || (tow == 4294967295UL) ||
+                (wnc == 65535))
+                return;
+            block_ = block;
+            epoch_ = static_cast<uint64_t>(wnc) * MS_PER_WEEK + tow;
+
+            for (auto& composite : composites_)
+            {
+                if ((composite.inputs & block) == 0)
+                    continue;
+                // Late blocks of closed epochs are ignored, larger jumps back in
+                // time restart the history
+                bool rewound = composite.epoch > (epoch_ + BACKWARD_JUMP_TOLERANCE);
+                if ((composite.epoch >= epoch_) && !rewound)
+                    continue;
+                if (composite.open)
+                    close(composite);
+                if (rewound)
+                {
+                    composite.received = 0;
+                    composite.previous = 0;
+                }
+                composite.expected = (composite.received & composite.previous) |
+                                     composite.required;
+                composite.previous = composite.received;
+                composite.epoch = epoch_;
+                composite.received = 0;
+                composite.open = true;
+                composite.opened = now;
+            }
+        }
+
+        /**
+         * @brief To be called once the block announced by begin() has been parsed
+         * successfully. Fires the assemblers of the composites whose epoch is
+         * complete with it.
+         */
+        void received()
+        {
+            for (auto& composite : composites_)
+            {
+                if (((composite.inputs & block_) == 0) ||
+                    (composite.epoch != epoch_))
+                    continue;
+                composite.received |= block_;
+                if (composite.open && ((composite.received & composite.expected) ==
+                                       composite.expected))
+                    close(composite);
+            }
+            block_ = epoch_block::NONE;
+        }
+
+        /**
+         * @brief To be called instead of received() if the block announced by
+         * begin() is not parsed, as none of the outputs using it is due in this
+         * epoch. Records its arrival, so that the composites keep waiting for it
+         * in the next epochs, and closes their epochs without firing the
+         * assemblers, as their data is not updated.
+         */
+        void skipped()
+        {
+            for (auto& composite : composites_)
+            {
+                if (((composite.inputs & block_) == 0) ||
+                    (composite.epoch != epoch_))
+                    continue;
+                composite.received |= block_;
+                composite.open = false;
+            }
+            block_ = epoch_block::NONE;
+        }
+
+        //! Default timeout in ns
+        static constexpr Timestamp DEFAULT_TIMEOUT = 50000000;
+        //! Age in ms beyond which a block is taken as jump back in time
+        static constexpr uint64_t BACKWARD_JUMP_TOLERANCE = 3000;
+
+    private:
+        struct Composite
+        {
+            //! Blocks used by the assembler
+            uint16_t inputs = 0;
+            //! Blocks without which there is no output
+            uint16_t required = 0;
+            //! Blocks to wait for, the ones received in the previous two epochs
+            uint16_t expected = 0;
+            //! Blocks received in the current epoch
+            uint16_t received = 0;
+            //! Blocks received in the previous epoch
+            uint16_t previous = 0;
+            //! Current epoch in ms since the start of the GPS time scale
+            uint64_t epoch = 0;
+            //! Whether the current epoch has not yet been closed
+            bool open = false;
+            //! Monotonic time the current epoch was opened
+            Timestamp opened = 0;
+            Assembler assemble;
+        };
+
+        //! Duration of a GPS week in ms
+        static constexpr uint64_t MS_PER_WEEK = 604800000;
+
+        void close(Composite& composite)
+        {
+            composite.open = false;
+            if ((composite.received & composite.required) == composite.required)
+                composite.assemble();
+        }
+
+        //! Timeout in ns
+        Timestamp timeout_;
+        //! Composite outputs
+        std::vector<Composite> composites_;
+        //! Block announced by begin()
+        uint16_t block_ = epoch_block::NONE;
+        //! Epoch of the block announced by begin()
+        uint64_t epoch_ = 0;
+    };
+} // namespace io
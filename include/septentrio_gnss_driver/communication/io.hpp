@@ -31,21 +31,37 @@
 #pragma once
 
 // C++
+#include <algorithm>
+#include <cstring>
+#include <map>
 #include <thread>
+#include <tuple>
 
 // Linux
+#include <linux/errqueue.h>
 #include <linux/input.h>
+#include <linux/net_tstamp.h>
 #include <linux/serial.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
 
 // Boost
 #include <boost/asio.hpp>
+#include <boost/bind.hpp>
 
 // pcap
 #include <pcap.h>
 
 // ROSaic
 #include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+#include <septentrio_gnss_driver/communication/connection_supervisor.hpp>
+#include <septentrio_gnss_driver/communication/latency_statistics.hpp>
 #include <septentrio_gnss_driver/communication/telegram.hpp>
+#include <septentrio_gnss_driver/communication/thread_pool.hpp>
+#include <septentrio_gnss_driver/crc/crc.hpp>
 
 //! Possible baudrates for the Rx
 const static std::array<uint32_t, 21> baudrates = {
@@ -53,17 +69,151 @@ const static std::array<uint32_t, 21> baudrates = {
     115200,  230400,  460800,  500000,  576000,  921600,  1000000,
     1152000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000};
 
+//! Maximum number of datagrams fetched from the UDP socket per system call
+static const size_t UDP_BATCH_SIZE = 16;
+//! Size of the ancillary data carrying the receive time stamps of a read
+static const size_t TIMESTAMP_CONTROL_SIZE = CMSG_SPACE(sizeof(scm_timestamping));
+
 namespace io {
 
+    /**
+     * @brief Enables receive time stamps on a socket
+     * @param[in] fd Socket
+     * @param[in] mode "kernel" for kernel time stamps, "hardware" for time stamps
+     * of the network interface with kernel time stamps as fallback
+     * @return Whether the time stamps could be enabled
+     */
+    [[nodiscard]] inline bool enableReceiveTimestamps(int fd,
+                                                      const std::string& mode)
+    {
+        if (mode == "hardware")
+        {
+            int flags =
+                SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE |
+                SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+            return setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags,
+                              sizeof(flags)) == 0;
+        }
+        int enable = 1;
+        return setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &enable,
+                          sizeof(enable)) == 0;
+    }
+
+    /**
+     * @brief Enables TCP keepalive probes, so that a silent connection is detected
+     * as lost too, and bounds the time sent data may stay unacknowledged
+     * @param[in] fd Socket
+     * @param[in] timeoutMs Time in milliseconds until the connection is lost
+     * @return Whether the options could be set
+     */
+    [[nodiscard]] inline bool enableKeepalive(int fd, uint32_t timeoutMs)
+    {
+        // Probe every second after one second of silence
+        int enable = 1;
+        int idle = 1;
+        int interval = 1;
+        int count = std::max<int>(1, timeoutMs / 1000);
+        unsigned int timeout = timeoutMs;
+        return (setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &enable,
+                           sizeof(enable)) == 0) &&
+               (setsockopt(fd, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle)) ==
+                0) &&
+               (setsockopt(fd, IPPROTO_TCP, TCP_KEEPINTVL, &interval,
+                           sizeof(interval)) == 0) &&
+               (setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT, &count, sizeof(count)) ==
+                0) &&
+               (setsockopt(fd, IPPROTO_TCP, TCP_USER_TIMEOUT, &timeout,
+                           sizeof(timeout)) == 0);
+    }
+
+    //! Largest deviation in ns of a hardware time stamp from the system clock
+    static const Timestamp MAX_HARDWARE_STAMP_OFFSET = 100000000;
+
+    /**
+     * @brief Extracts the receive time stamp from the ancillary data of a read
+     *
+     * A hardware time stamp is preferred over a kernel one, which the interface
+     * leaves zero if it does not support time stamping. The hardware time stamp
+     * is the raw time of the clock of the interface, so it is only used if it is
+     * within MAX_HARDWARE_STAMP_OFFSET of the kernel time stamp, or of the
+     * fallback without one, i.e. if that clock is synchronized to the system
+     * clock. Otherwise the kernel time stamp is used and a warning is logged.
+     * @param[in] node Node to log to
+     * @param[in] hdr Message header filled by recvmsg or recvmmsg
+     * @param[in] fallback Time stamp to use if there is none
+     * @return Receive time stamp
+     */
+    [[nodiscard]] inline Timestamp
+    receiveTimestamp(ROSaicNodeBase* node, const msghdr& hdr, Timestamp fallback)
+    {
+        auto toTimestamp = [](const timespec& ts) {
+            return static_cast<Timestamp>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+        };
+        auto isSet = [](const timespec& ts) {
+            return (ts.tv_sec != 0) || (ts.tv_nsec != 0);
+        };
+
+        for (const cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr;
+             cmsg = CMSG_NXTHDR(const_cast<msghdr*>(&hdr),
+                                const_cast<cmsghdr*>(cmsg)))
+        {
+            if (cmsg->cmsg_level != SOL_SOCKET)
+                continue;
+            if (cmsg->cmsg_type == SCM_TIMESTAMPNS)
+            {
+                timespec ts;
+                std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                return toTimestamp(ts);
+            }
+            if (cmsg->cmsg_type == SCM_TIMESTAMPING)
+            {
+                scm_timestamping tss;
+                std::memcpy(&tss, CMSG_DATA(cmsg), sizeof(tss));
+                Timestamp system =
+                    isSet(tss.ts[0]) ? toTimestamp(tss.ts[0]) : fallback;
+                if (!isSet(tss.ts[2]))
+                    return system;
+                Timestamp hardware = toTimestamp(tss.ts[2]);
+                Timestamp offset = (hardware > system) ? (hardware - system)
+                                                       : (system - hardware);
+                if (offset <= MAX_HARDWARE_STAMP_OFFSET)
+                    return hardware;
+                ROSAIC_LOG_THROTTLE(
+                    node, log_level::WARN, STREAM_ERROR_LOG_PERIOD_S,
+                    "Hardware receive time stamp is " +
+                        std::to_string(offset / 1000000) +
+                        " ms off the system clock, using the kernel time stamp. Synchronize the clock of the network interface, e.g. with phc2sys.");
+                return system;
+            }
+        }
+        return fallback;
+    }
+
     class UdpClient
     {
     public:
-        UdpClient(ROSaicNodeBase* node, int16_t port, TelegramQueue* telegramQueue) :
-            node_(node), running_(true), port_(port), telegramQueue_(telegramQueue)
+        /**
+         * @param[in] ioService io_service shared with other receivers and run by
+         * a ThreadPool, nullptr to run an io_service on a thread of its own
+         */
+        UdpClient(ROSaicNodeBase* node, int16_t port, TelegramQueue* telegramQueue,
+                  TelegramPool* telegramPool, LatencyStatistics* statistics = nullptr,
+                  std::shared_ptr<boost::asio::io_service> ioService = nullptr) :
+            node_(node), running_(true), port_(port),
+            ownsIoService_(ioService == nullptr),
+            ioService_(ownsIoService_ ? std::make_shared<boost::asio::io_service>()
+                                      : ioService),
+            handlers_(*ioService_), reopenTimer_(*ioService_),
+            supervisor_(static_cast<Timestamp>(
+                            node->settings()->reconnect_backoff_min_s * 1e9),
+                        static_cast<Timestamp>(
+                            node->settings()->reconnect_backoff_max_s * 1e9)),
+            telegramQueue_(telegramQueue), telegramPool_(telegramPool),
+            statistics_(statistics)
         {
-            connect();
-            watchdogThread_ =
-                std::thread(boost::bind(&UdpClient::runWatchdog, this));
+            open();
+            if (ownsIoService_)
+                ioThread_ = std::thread(boost::bind(&UdpClient::runIoService, this));
         }
 
         ~UdpClient()
@@ -71,167 +221,303 @@ namespace io {
             running_ = false;
 
             node_->log(log_level::INFO, "UDP client shutting down threads");
-            ioService_.stop();
-            ioThread_.join();
-            watchdogThread_.join();
+            if (ownsIoService_)
+            {
+                ioService_->stop();
+                ioThread_.join();
+            } else
+            {
+                // The shared io_service keeps running, no handler may be left
+                handlers_.run([this]() {
+                    reopenTimer_.cancel();
+                    socket_->close();
+                });
+                handlers_.drain();
+            }
             node_->log(log_level::INFO, " UDP client threads stopped");
         }
 
     private:
-        void connect()
+        void open()
         {
             socket_.reset(new boost::asio::ip::udp::socket(
-                ioService_,
+                *ioService_,
                 boost::asio::ip::udp::endpoint(boost::asio::ip::udp::v4(), port_)));
 
-            asyncReceive();
+            timestamped_ = (node_->settings()->receive_timestamps != "software");
+            if (timestamped_ &&
+                !enableReceiveTimestamps(socket_->native_handle(),
+                                         node_->settings()->receive_timestamps))
+                node_->log(log_level::WARN,
+                           "UDP client could not enable receive time stamps: " +
+                               std::string(std::strerror(errno)));
+
+            for (size_t i = 0; i < UDP_BATCH_SIZE; ++i)
+            {
+                iovecs_[i].iov_base = &buffer_[i * MAX_UDP_PACKET_SIZE];
+                iovecs_[i].iov_len = MAX_UDP_PACKET_SIZE;
+                msgs_[i].msg_hdr = msghdr{};
+                msgs_[i].msg_hdr.msg_iov = &iovecs_[i];
+                msgs_[i].msg_hdr.msg_iovlen = 1;
+            }
 
-            ioThread_ = std::thread(boost::bind(&UdpClient::runIoService, this));
+            asyncReceive();
 
             node_->log(log_level::INFO,
                        "Listening on UDP port " + std::to_string(port_));
         }
 
+        /**
+         * Waits for the socket to become readable, the datagrams are then fetched
+         * in batches by handleReceive.
+         */
         void asyncReceive()
+        {
+            socket_->async_wait(
+                boost::asio::ip::udp::socket::wait_read,
+                handlers_.wrap(boost::bind(&UdpClient::handleReceive, this,
+                                           boost::asio::placeholders::error)));
+        }
 
+        /**
+         * Fetches up to UDP_BATCH_SIZE datagrams per recvmmsg call until the socket
+         * is drained. The blocks of each batch are handed over to the queue at
+         * once.
+         */
+        void handleReceive(const boost::system::error_code& error)
         {
-            socket_->async_receive_from(
-                boost::asio::buffer(buffer_, MAX_UDP_PACKET_SIZE), eP_,
-                boost::bind(&UdpClient::handleReceive, this,
-                            boost::asio::placeholders::error,
-                            boost::asio::placeholders::bytes_transferred));
+            if (error)
+            {
+                if (!running_ || (error == boost::asio::error::operation_aborted))
+                    return;
+                node_->log(log_level::ERROR,
+                           "UDP client receive error: " + error.message());
+                if (supervisor_.lost(steadyTime()))
+                    reopen();
+                return;
+            }
+
+            int received;
+            do
+            {
+                for (size_t i = 0; i < UDP_BATCH_SIZE; ++i)
+                {
+                    msgs_[i].msg_hdr.msg_control =
+                        timestamped_ ? controls_[i].data() : nullptr;
+                    msgs_[i].msg_hdr.msg_controllen =
+                        timestamped_ ? controls_[i].size() : 0;
+                }
+                received = recvmmsg(socket_->native_handle(), msgs_.data(),
+                                    UDP_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+                if (received <= 0)
+                    break;
+
+                Timestamp stamp = node_->getTime();
+                for (int i = 0; i < received; ++i)
+                {
+                    if (msgs_[i].msg_hdr.msg_flags & MSG_TRUNC)
+                        ROSAIC_LOG_THROTTLE(node_, log_level::DEBUG,
+                                            STREAM_ERROR_LOG_PERIOD_S,
+                                            "UDP datagram truncated.");
+                    frameDatagram(
+                        &buffer_[i * MAX_UDP_PACKET_SIZE], msgs_[i].msg_len,
+                        timestamped_
+                            ? receiveTimestamp(node_, msgs_[i].msg_hdr, stamp)
+                            : stamp);
+                }
+                // Hand over all blocks of the batch at once
+                telegramQueue_->push_all(telegrams_);
+            } while (received == static_cast<int>(UDP_BATCH_SIZE));
+
+            if ((received < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK))
+                node_->log(log_level::ERROR, "UDP client receive error: " +
+                                                 std::string(std::strerror(errno)));
+
+            asyncReceive();
         }
 
-        void handleReceive(const boost::system::error_code& error,
-                           size_t bytes_recvd)
+        /**
+         * Splits a datagram into SBF blocks and NMEA sentences. Blocks whose
+         * announced length exceeds the datagram are discarded, framing then
+         * resyncs on the next byte.
+         */
+        void frameDatagram(const uint8_t* data, size_t size, Timestamp stamp)
         {
-            Timestamp stamp = node_->getTime();
             size_t idx = 0;
-
-            if (!error && (bytes_recvd > 0))
+            while ((size - idx) > 2)
             {
-                while ((bytes_recvd - idx) > 2)
+                if (data[idx] == SYNC_BYTE_1)
                 {
-                    std::shared_ptr<Telegram> telegram(new Telegram);
-                    telegram->stamp = stamp;
-                    /*node_->log(log_level::DEBUG,
-                               "Buffer: " + std::string(telegram->message.begin(),
-                                                        telegram->message.end()));*/
-                    if (buffer_[idx] == SYNC_BYTE_1)
+                    if (data[idx + 1] == SBF_SYNC_BYTE_2)
                     {
-                        if (buffer_[idx + 1] == SBF_SYNC_BYTE_2)
-                        {
-                            if ((bytes_recvd - idx) > SBF_HEADER_SIZE)
-                            {
-                                uint16_t length = parsing_utilities::parseUInt16(
-                                    &buffer_[idx + 6]);
-                                telegram->message.assign(&buffer_[idx],
-                                                         &buffer_[idx + length]);
-                                if (crc::isValid(telegram->message))
-                                {
-                                    telegram->type = telegram_type::SBF;
-                                    telegramQueue_->push(telegram);
-                                } else
-                                    node_->log(
-                                        log_level::DEBUG,
-                                        "AsyncManager crc failed for SBF  " +
-                                            std::to_string(parsing_utilities::getId(
-                                                telegram->message)) +
-                                            ".");
-
-                                idx += length;
-                            }
-
-                        } else if ((buffer_[idx + 1] == NMEA_SYNC_BYTE_2) &&
-                                   (buffer_[idx + 2] == NMEA_SYNC_BYTE_3))
+                        uint16_t length = 0;
+                        if ((size - idx) >= SBF_HEADER_SIZE)
+                            length = parsing_utilities::parseUInt16(&data[idx + 6]);
+                        if ((length < SBF_HEADER_SIZE) || (length > (size - idx)))
                         {
-                            size_t idx_end = findNmeaEnd(idx, bytes_recvd);
-                            telegram->message.assign(&buffer_[idx],
-                                                     &buffer_[idx_end + 1]);
-                            telegram->type = telegram_type::NMEA;
-                            telegramQueue_->push(telegram);
-                            idx = idx_end + 1;
-
-                        } else if ((buffer_[idx + 1] == NMEA_INS_SYNC_BYTE_2) &&
-                                   (buffer_[idx + 2] == NMEA_INS_SYNC_BYTE_3))
+                            ROSAIC_LOG_THROTTLE(node_, log_level::DEBUG,
+                                                STREAM_ERROR_LOG_PERIOD_S,
+                                                "UDP SBF block of invalid length " +
+                                                    std::to_string(length) + ".");
+                            if (statistics_)
+                                statistics_->countFramingError();
+                            ++idx;
+                            continue;
+                        }
+                        std::shared_ptr<Telegram> telegram =
+                            telegramPool_->acquire();
+                        telegram->stamp = stamp;
+                        telegram->message.assign(&data[idx], &data[idx + length]);
+                        if (statistics_)
+                            telegram->framed = LatencyStatistics::now();
+                        if (crc::isValid(telegram->message))
                         {
-                            size_t idx_end = findNmeaEnd(idx, bytes_recvd);
-                            telegram->message.assign(&buffer_[idx],
-                                                     &buffer_[idx_end + 1]);
-                            telegram->type = telegram_type::NMEA_INS;
-                            telegramQueue_->push(telegram);
-                            idx = idx_end + 1;
+                            if (statistics_)
+                                telegram->validated = LatencyStatistics::now();
+                            telegram->type = telegram_type::SBF;
+                            telegrams_.push_back(std::move(telegram));
                         } else
                         {
-                            node_->log(log_level::DEBUG,
-                                       "head: " +
-                                           std::string(std::string(
-                                               telegram->message.begin(),
-                                               telegram->message.begin() + 2)));
+                            ROSAIC_LOG_THROTTLE(
+                                node_, log_level::DEBUG, STREAM_ERROR_LOG_PERIOD_S,
+                                "AsyncManager crc failed for SBF  " +
+                                    std::to_string(parsing_utilities::getId(
+                                        telegram->message)) +
+                                    ".");
+                            if (statistics_)
+                                statistics_->countCrcFailure();
+                            telegramPool_->recycle(std::move(telegram));
                         }
+
+                        idx += length;
+                    } else if (((data[idx + 1] == NMEA_SYNC_BYTE_2) &&
+                                (data[idx + 2] == NMEA_SYNC_BYTE_3)) ||
+                               ((data[idx + 1] == NMEA_INS_SYNC_BYTE_2) &&
+                                (data[idx + 2] == NMEA_INS_SYNC_BYTE_3)))
+                    {
+                        size_t idx_end = findNmeaEnd(data, idx, size);
+                        std::shared_ptr<Telegram> telegram =
+                            telegramPool_->acquire();
+                        telegram->stamp = stamp;
+                        telegram->type = (data[idx + 1] == NMEA_SYNC_BYTE_2)
+                                             ? telegram_type::NMEA
+                                             : telegram_type::NMEA_INS;
+                        telegram->message.assign(&data[idx], &data[idx_end]);
+                        if (statistics_)
+                        {
+                            telegram->framed = LatencyStatistics::now();
+                            telegram->validated = telegram->framed;
+                        }
+                        telegrams_.push_back(std::move(telegram));
+                        idx = idx_end;
                     } else
                     {
-                        node_->log(log_level::DEBUG, "UDP msg resync.");
+                        ROSAIC_LOG_THROTTLE(
+                            node_, log_level::DEBUG, STREAM_ERROR_LOG_PERIOD_S,
+                            "head: " + std::string(&data[idx], &data[idx + 2]));
                         ++idx;
                     }
+                } else
+                {
+                    ROSAIC_LOG_THROTTLE(node_, log_level::DEBUG,
+                                        STREAM_ERROR_LOG_PERIOD_S,
+                                        "UDP msg resync.");
+                    if (statistics_)
+                        statistics_->countFramingError();
+                    ++idx;
                 }
-            } else
-            {
-                node_->log(log_level::ERROR,
-                           "UDP client receive error: " + error.message());
             }
-
-            asyncReceive();
         }
 
         void runIoService()
         {
-            ioService_.run();
+            ioService_->run();
             node_->log(log_level::INFO, "UDP client ioService terminated.");
         }
 
-        void runWatchdog()
+        /**
+         * Reopens the socket from the I/O thread after the backoff delay, retrying
+         * until it succeeds.
+         */
+        void reopen()
         {
-            while (running_)
-            {
-                std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-
-                if (running_ && ioService_.stopped())
-                {
-                    node_->log(log_level::ERROR,
-                               "UDP client connection lost. Trying to reconnect.");
-                    ioService_.reset();
-                    ioThread_.join();
-                    connect();
-                }
-            }
+            reopenTimer_.expires_after(
+                std::chrono::nanoseconds(supervisor_.nextDelay()));
+            reopenTimer_.async_wait(
+                handlers_.wrap([this](const boost::system::error_code& ec) {
+                    if (ec || !running_)
+                        return;
+                    try
+                    {
+                        socket_->close();
+                        open();
+                    } catch (const boost::system::system_error& e)
+                    {
+                        node_->log(log_level::ERROR,
+                                   "UDP client could not reopen socket: " +
+                                       std::string(e.what()));
+                        reopen();
+                        return;
+                    }
+                    Timestamp outage = supervisor_.restored(steadyTime());
+                    node_->log(log_level::INFO,
+                               "UDP client reopened socket after " +
+                                   std::to_string(outage / 1000000) +
+                                   " ms, outage " +
+                                   std::to_string(supervisor_.outages()) +
+                                   ", longest " +
+                                   std::to_string(supervisor_.longestOutage() /
+                                                  1000000) +
+                                   " ms.");
+                }));
         }
 
     private:
-        size_t findNmeaEnd(size_t idx, size_t bytes_recvd)
+        /**
+         * @return Index one past the LF terminating the sentence, or size if there
+         * is none
+         */
+        [[nodiscard]] static size_t findNmeaEnd(const uint8_t* data, size_t idx,
+                                                size_t size)
         {
-            size_t idx_end = idx + 2;
-
-            while (idx_end < bytes_recvd)
+            for (size_t idx_end = idx + 3; idx_end < size; ++idx_end)
             {
-                if ((buffer_[idx_end] == LF) && (buffer_[idx_end - 1] == CR))
-                    break;
-
-                ++idx_end;
+                if ((data[idx_end] == LF) && (data[idx_end - 1] == CR))
+                    return idx_end + 1;
             }
-            return idx_end;
+            return size;
         }
         //! Pointer to the node
         ROSaicNodeBase* node_;
         std::atomic<bool> running_;
         int16_t port_;
-        boost::asio::io_service ioService_;
+        //! Whether ioService_ is run by ioThread_ instead of a shared pool
+        bool ownsIoService_;
+        std::shared_ptr<boost::asio::io_service> ioService_;
+        //! Runs the handlers one at a time
+        HandlerGroup handlers_;
         std::thread ioThread_;
-        std::thread watchdogThread_;
-        boost::asio::ip::udp::endpoint eP_;
         std::unique_ptr<boost::asio::ip::udp::socket> socket_;
-        std::array<uint8_t, MAX_UDP_PACKET_SIZE> buffer_;
+        //! Delays reopening the socket after an error
+        boost::asio::steady_timer reopenTimer_;
+        //! Paces reopening and records the outages
+        ConnectionSupervisor supervisor_;
+        //! One slot of MAX_UDP_PACKET_SIZE bytes per datagram of a batch
+        std::vector<uint8_t> buffer_ =
+            std::vector<uint8_t>(UDP_BATCH_SIZE * MAX_UDP_PACKET_SIZE);
+        std::array<iovec, UDP_BATCH_SIZE> iovecs_;
+        std::array<mmsghdr, UDP_BATCH_SIZE> msgs_;
+        //! Whether datagrams are stamped with their receive time stamps
+        bool timestamped_ = false;
+        //! Ancillary data of each datagram, holds the receive time stamp
+        std::array<std::array<uint8_t, TIMESTAMP_CONTROL_SIZE>, UDP_BATCH_SIZE>
+            controls_;
+        //! Telegrams framed from the current batch
+        std::vector<std::shared_ptr<Telegram>> telegrams_;
         TelegramQueue* telegramQueue_;
+        TelegramPool* telegramPool_;
+        //! Latency statistics, nullptr if not instrumented
+        LatencyStatistics* statistics_;
     };
 
     class TcpIo
@@ -281,6 +567,25 @@ namespace io {
 
                 stream_->set_option(boost::asio::ip::tcp::no_delay(true));
 
+                uint32_t userTimeout = node_->settings()->tcp_user_timeout_ms;
+                if ((userTimeout != 0) &&
+                    !enableKeepalive(stream_->native_handle(), userTimeout))
+                    node_->log(log_level::WARN,
+                               "Could not enable TCP keepalive: " +
+                                   std::string(std::strerror(errno)));
+
+                timestamped_ =
+                    (node_->settings()->receive_timestamps != "software");
+                if (timestamped_ &&
+                    !enableReceiveTimestamps(stream_->native_handle(),
+                                             node_->settings()->receive_timestamps))
+                {
+                    node_->log(log_level::WARN,
+                               "Could not enable receive time stamps: " +
+                                   std::string(std::strerror(errno)));
+                    timestamped_ = false;
+                }
+
                 node_->log(log_level::INFO,
                            "Connected to " + endpointIterator->host_name() + ":" +
                                endpointIterator->service_name() + ".");
@@ -295,11 +600,41 @@ namespace io {
             return true;
         }
 
+        //! Whether reads carry receive time stamps, see receive()
+        [[nodiscard]] bool timestamped() const { return timestamped_; }
+
+        /**
+         * @brief Reads the available bytes without waiting, together with the
+         * receive time stamp of the last of them
+         * @param[in] data Buffer to read into
+         * @param[in] size Size of the buffer
+         * @param[in,out] stamp Receive time stamp, left unchanged if there is none
+         * @return Number of bytes read, 0 at end of stream, -1 on error
+         */
+        [[nodiscard]] ssize_t receive(uint8_t* data, std::size_t size,
+                                      Timestamp& stamp)
+        {
+            iovec iov{data, size};
+            std::array<uint8_t, TIMESTAMP_CONTROL_SIZE> control;
+            msghdr hdr{};
+            hdr.msg_iov = &iov;
+            hdr.msg_iovlen = 1;
+            hdr.msg_control = control.data();
+            hdr.msg_controllen = control.size();
+
+            ssize_t numBytes =
+                recvmsg(stream_->native_handle(), &hdr, MSG_DONTWAIT);
+            if (numBytes > 0)
+                stamp = receiveTimestamp(node_, hdr, stamp);
+            return numBytes;
+        }
+
     private:
         ROSaicNodeBase* node_;
         std::shared_ptr<boost::asio::io_service> ioService_;
 
         std::string port_;
+        bool timestamped_ = false;
 
     public:
         std::unique_ptr<boost::asio::ip::tcp::socket> stream_;
@@ -328,29 +663,20 @@ namespace io {
                 stream_->close();
             }
 
-            bool opened = false;
-
-            while (!opened)
+            // Retries are paced by the caller
+            try
             {
-                try
-                {
-                    node_->log(log_level::INFO,
-                               "Connecting serially to device " +
-                                   node_->settings()->device +
-                                   ", targeted baudrate: " +
-                                   std::to_string(node_->settings()->baudrate));
-                    stream_->open(node_->settings()->device);
-                    opened = true;
-                } catch (const boost::system::system_error& err)
-                {
-                    node_->log(log_level::ERROR, "Could not open serial port " +
-                                                     node_->settings()->device +
-                                                     ". Error: " + err.what() +
-                                                     ". Will retry every second.");
-
-                    using namespace std::chrono_literals;
-                    std::this_thread::sleep_for(1s);
-                }
+                node_->log(log_level::INFO,
+                           "Connecting serially to device " +
+                               node_->settings()->device + ", targeted baudrate: " +
+                               std::to_string(node_->settings()->baudrate));
+                stream_->open(node_->settings()->device);
+            } catch (const boost::system::system_error& err)
+            {
+                node_->log(log_level::ERROR, "Could not open serial port " +
+                                                 node_->settings()->device +
+                                                 ". Error: " + err.what() + ".");
+                return false;
             }
 
             // No Parity, 8bits data, 1 stop Bit
@@ -375,9 +701,16 @@ namespace io {
             // Set low latency
             int fd = stream_->native_handle();
             struct serial_struct serialInfo;
-            ioctl(fd, TIOCGSERIAL, &serialInfo);
-            serialInfo.flags |= ASYNC_LOW_LATENCY;
-            ioctl(fd, TIOCSSERIAL, &serialInfo);
+            bool lowLatency = (ioctl(fd, TIOCGSERIAL, &serialInfo) == 0);
+            if (lowLatency)
+            {
+                serialInfo.flags |= ASYNC_LOW_LATENCY;
+                lowLatency = (ioctl(fd, TIOCSSERIAL, &serialInfo) == 0);
+            }
+            if (!lowLatency)
+                node_->log(log_level::DEBUG,
+                           "Could not set serial port to low latency: " +
+                               std::string(std::strerror(errno)));
 
             return setBaudrate();
         }
@@ -485,6 +818,19 @@ namespace io {
             return true;
         }
 
+        /**
+         * @brief Transmission time of one byte at the configured baudrate, 8N1
+         * framing taking 10 bits per byte
+         *
+         * With the port set to low latency a read completes right after its last
+         * byte arrived, so earlier bytes can be back-dated by this duration.
+         * @return Duration in nanoseconds
+         */
+        [[nodiscard]] Timestamp byteDuration() const
+        {
+            return (baudrate_ > 0) ? 10000000000ull / baudrate_ : 0;
+        }
+
     private:
         ROSaicNodeBase* node_;
         std::shared_ptr<boost::asio::io_service> ioService_;
@@ -495,6 +841,21 @@ namespace io {
         std::unique_ptr<boost::asio::serial_port> stream_;
     };
 
+    //! Entry of the block index of an SBF file
+    struct SbfIndexEntry
+    {
+        //! Offset of the block within the file
+        size_t offset;
+        uint16_t id;
+        uint32_t tow;
+        uint16_t wnc;
+    };
+
+    /**
+     * @class SbfFileIo
+     * @brief Maps an SBF file into memory, the framer reads the mapping directly.
+     * On connect the file is indexed by its valid SBF blocks.
+     */
     class SbfFileIo
     {
     public:
@@ -505,13 +866,21 @@ namespace io {
         {
         }
 
-        ~SbfFileIo() { stream_->close(); }
+        ~SbfFileIo() { close(); }
 
-        void close() { stream_->close(); }
+        void close()
+        {
+            if (data_ != nullptr)
+            {
+                munmap(const_cast<uint8_t*>(data_), size_);
+                data_ = nullptr;
+            }
+        }
 
         [[nodiscard]] bool connect()
         {
-            node_->log(log_level::INFO, "Opening SBF file stream" +
+            close();
+            node_->log(log_level::INFO, "Opening SBF file " +
                                             node_->settings()->device + "...");
 
             int fd = open(node_->settings()->device.c_str(), O_RDONLY);
@@ -521,29 +890,162 @@ namespace io {
                 return false;
             }
 
-            try
+            struct stat fileStat;
+            if ((fstat(fd, &fileStat) == -1) || (fileStat.st_size == 0))
             {
-                stream_.reset(
-                    new boost::asio::posix::stream_descriptor(*ioService_));
-                stream_->assign(fd);
+                node_->log(log_level::ERROR, "SBF file is empty or unreadable.");
+                ::close(fd);
+                return false;
+            }
+            size_ = fileStat.st_size;
 
-            } catch (std::runtime_error& e)
+            void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            // The mapping stays valid after closing the file
+            ::close(fd);
+            if (data == MAP_FAILED)
             {
-                node_->log(log_level::ERROR, "assigning SBF file failed due to " +
-                                                 static_cast<std::string>(e.what()));
+                node_->log(log_level::ERROR, "mapping SBF file failed due to " +
+                                                 std::string(strerror(errno)));
                 return false;
             }
+            madvise(data, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const uint8_t*>(data);
+
+            buildIndex();
+            pos_ = startOffset();
             return true;
         }
 
+        /**
+         * @brief Takes the next chunk of the mapped file
+         * @param[in] maxBytes Maximum size of the chunk
+         * @return Chunk of the mapping, empty at the end of the file
+         */
+        [[nodiscard]] boost::asio::const_buffer nextChunk(size_t maxBytes)
+        {
+            if (data_ == nullptr)
+                return boost::asio::const_buffer();
+
+            size_t numBytes = std::min(maxBytes, size_ - pos_);
+            boost::asio::const_buffer chunk(data_ + pos_, numBytes);
+            pos_ += numBytes;
+            return chunk;
+        }
+
+        //! Valid SBF blocks of the file in order of appearance
+        [[nodiscard]] const std::vector<SbfIndexEntry>& index() const
+        {
+            return index_;
+        }
+
+        //! Mapping of the file, nullptr if not connected
+        [[nodiscard]] const uint8_t* data() const { return data_; }
+
+        /**
+         * @brief Looks up the first block after the time to be skipped
+         * @return Offset to start reading at
+         */
+        [[nodiscard]] size_t startOffset() const
+        {
+            double skip = node_->settings()->replay_skip_s;
+            if (skip <= 0.0)
+                return 0;
+
+            auto start = std::find_if(index_.begin(), index_.end(), validTime);
+            if (start == index_.end())
+                return 0;
+            double startTime = gpsTime(*start) + skip;
+            start = std::find_if(start, index_.end(), [&](const auto& entry) {
+                return validTime(entry) && (gpsTime(entry) >= startTime);
+            });
+            if (start == index_.end())
+            {
+                node_->log(log_level::WARN,
+                           "SBF file is shorter than the time to be skipped.");
+                return size_;
+            }
+            return start->offset;
+        }
+
+        //! Whether the time of an index entry is set
+        [[nodiscard]] static bool validTime(const SbfIndexEntry& entry)
+        {
+            return (entry.tow != 4294967295UL) && (entry.wnc != 65535);
+        }
+
+        //! GPS time of an index entry in seconds
+        [[nodiscard]] static double gpsTime(const SbfIndexEntry& entry)
+        {
+            return entry.wnc * 604800.0 + entry.tow / 1000.0;
+        }
+
     private:
+        /**
+         * @brief Indexes all SBF blocks with a valid length and CRC. Other data,
+         * e.g. NMEA, is not indexed but still framed on reading.
+         */
+        void buildIndex()
+        {
+            index_.clear();
+            size_t pos = 0;
+            while (pos + SBF_HEADER_SIZE <= size_)
+            {
+                const uint8_t* sync = static_cast<const uint8_t*>(
+                    memchr(data_ + pos, SYNC_BYTE_1, size_ - pos));
+                if (sync == nullptr)
+                    break;
+                pos = sync - data_;
+                if ((pos + SBF_HEADER_SIZE > size_) ||
+                    (sync[1] != SBF_SYNC_BYTE_2))
+                {
+                    ++pos;
+                    continue;
+                }
+
+                uint16_t length = parsing_utilities::parseUInt16(sync + 6);
+                if ((length < SBF_HEADER_SIZE) || (length > MAX_SBF_SIZE) ||
+                    (pos + length > size_) ||
+                    (parsing_utilities::parseUInt16(sync + 2) !=
+                     crc::compute16CCITT(sync + 4, length - 4)))
+                {
+                    ++pos;
+                    continue;
+                }
+
+                SbfIndexEntry entry;
+                entry.offset = pos;
+                entry.id = parsing_utilities::parseUInt16(sync + 4) & 8191;
+                entry.tow = parsing_utilities::parseUInt32(sync + 8);
+                entry.wnc = parsing_utilities::parseUInt16(sync + 12);
+                index_.push_back(entry);
+                pos += length;
+            }
+
+            std::stringstream ss;
+            ss << "Indexed " << index_.size() << " SBF blocks in " << size_
+               << " bytes.";
+            node_->log(log_level::INFO, ss.str());
+        }
+
         ROSaicNodeBase* node_;
         std::shared_ptr<boost::asio::io_service> ioService_;
-
-    public:
-        std::unique_ptr<boost::asio::posix::stream_descriptor> stream_;
+        //! Mapping of the file
+        const uint8_t* data_ = nullptr;
+        //! Size of the file
+        size_t size_ = 0;
+        //! Current read position in the mapping
+        size_t pos_ = 0;
+        //! Block index of the file
+        std::vector<SbfIndexEntry> index_;
     };
 
+    /**
+     * @class PcapFileIo
+     * @brief Reads the payloads of UDP and TCP packets of a pcap file. Link layer,
+     * IP, UDP and TCP headers are stripped and TCP streams are reassembled, so
+     * that the framer receives the byte stream as sent by the Rx. Each flow, i.e.
+     * each connection and direction, is to be framed on its own, cf. flow().
+     */
     class PcapFileIo
     {
     public:
@@ -554,48 +1056,326 @@ namespace io {
         {
         }
 
-        ~PcapFileIo()
-        {
-            pcap_close(pcap_);
-            stream_->close();
-        }
+        ~PcapFileIo() { close(); }
 
         void close()
         {
-            pcap_close(pcap_);
-            stream_->close();
+            if (pcap_ != nullptr)
+            {
+                pcap_close(pcap_);
+                pcap_ = nullptr;
+            }
+            tcpFlows_.clear();
+            flows_.clear();
+            flow_ = 0;
         }
 
         [[nodiscard]] bool connect()
         {
-            try
-            {
-                node_->log(log_level::INFO, "Opening pcap file stream" +
-                                                node_->settings()->device + "...");
-
-                stream_.reset(
-                    new boost::asio::posix::stream_descriptor(*ioService_));
+            close();
+            node_->log(log_level::INFO,
+                       "Opening pcap file " + node_->settings()->device + "...");
 
-                pcap_ = pcap_open_offline(node_->settings()->device.c_str(),
-                                          errBuff_.data());
-                stream_->assign(pcap_get_selectable_fd(pcap_));
+            pcap_ = pcap_open_offline(node_->settings()->device.c_str(),
+                                      errBuff_.data());
+            if (pcap_ == nullptr)
+            {
+                node_->log(log_level::ERROR, "opening pcap file failed due to " +
+                                                 std::string(errBuff_.data()));
+                return false;
+            }
 
-            } catch (std::runtime_error& e)
+            linkType_ = pcap_datalink(pcap_);
+            if ((linkType_ != DLT_EN10MB) && (linkType_ != DLT_LINUX_SLL) &&
+                (linkType_ != DLT_RAW) && (linkType_ != DLT_NULL))
             {
-                node_->log(log_level::ERROR, "assigning PCAP file failed due to " +
-                                                 static_cast<std::string>(e.what()));
+                node_->log(log_level::ERROR, "unsupported link type " +
+                                                 std::to_string(linkType_) +
+                                                 " of pcap file.");
+                close();
                 return false;
             }
             return true;
         }
 
+        /**
+         * @brief Reads packets until one carries payload
+         * @param[in] maxBytes Unused, a chunk is the payload of one packet
+         * @return Payload of the next packet, valid until the next call, empty at
+         * the end of the file
+         */
+        [[nodiscard]] boost::asio::const_buffer nextChunk(size_t /*maxBytes*/)
+        {
+            while (pcap_ != nullptr)
+            {
+                struct pcap_pkthdr* header;
+                const u_char* packet;
+                int result = pcap_next_ex(pcap_, &header, &packet);
+                if (result == 0)
+                    continue;
+                if (result == PCAP_ERROR_BREAK)
+                    break;
+                if (result < 0)
+                {
+                    node_->log(log_level::ERROR,
+                               "reading pcap file failed due to " +
+                                   std::string(pcap_geterr(pcap_)));
+                    break;
+                }
+
+                boost::asio::const_buffer payload =
+                    extractPayload(packet, header->caplen);
+                if (payload.size() > 0)
+                    return payload;
+            }
+            return boost::asio::const_buffer();
+        }
+
+        /**
+         * @brief Flow of the payload returned last by nextChunk(), numbered in
+         * order of appearance. Payloads of different flows interleave, e.g. both
+         * directions of a connection or several Rx connections.
+         */
+        [[nodiscard]] size_t flow() const { return flow_; }
+
     private:
+        //! Endpoints of a TCP connection or UDP flow in one direction
+        struct FlowKey
+        {
+            std::array<uint8_t, 16> srcIp{};
+            std::array<uint8_t, 16> dstIp{};
+            uint16_t srcPort;
+            uint16_t dstPort;
+
+            bool operator<(const FlowKey& other) const
+            {
+                return std::tie(srcIp, dstIp, srcPort, dstPort) <
+                       std::tie(other.srcIp, other.dstIp, other.srcPort,
+                                other.dstPort);
+            }
+        };
+
+        //! Reassembly state of a TCP stream
+        struct TcpFlow
+        {
+            //! Whether the next sequence number is known
+            bool synced = false;
+            //! Sequence number of the next byte in order
+            uint32_t nextSeq = 0;
+            //! Segments received ahead of a missing one
+            std::map<uint32_t, std::vector<uint8_t>> outOfOrder;
+        };
+
+        /**
+         * @brief Strips the headers of a packet
+         * @return Payload in stream order, empty if there is none
+         */
+        [[nodiscard]] boost::asio::const_buffer extractPayload(const u_char* packet,
+                                                               size_t length)
+        {
+            const u_char* end = packet + length;
+            const u_char* it = packet;
+            uint16_t etherType;
+            switch (linkType_)
+            {
+            case DLT_EN10MB:
+            {
+                if (length < 14)
+                    return boost::asio::const_buffer();
+                etherType = (it[12] << 8) | it[13];
+                it += 14;
+                // VLAN tags
+                while (((etherType == 0x8100) || (etherType == 0x88A8)) &&
+                       (end - it >= 4))
+                {
+                    etherType = (it[2] << 8) | it[3];
+                    it += 4;
+                }
+                break;
+            }
+            case DLT_LINUX_SLL:
+            {
+                if (length < 16)
+                    return boost::asio::const_buffer();
+                etherType = (it[14] << 8) | it[15];
+                it += 16;
+                break;
+            }
+            case DLT_NULL:
+            {
+                if (length < 4)
+                    return boost::asio::const_buffer();
+                // Address family in host byte order, IPv6 has several values
+                etherType = ((it[0] == 2) || (it[3] == 2)) ? 0x0800 : 0x86DD;
+                it += 4;
+                break;
+            }
+            default:
+            {
+                if (length < 1)
+                    return boost::asio::const_buffer();
+                etherType = ((it[0] >> 4) == 6) ? 0x86DD : 0x0800;
+                break;
+            }
+            }
+
+            FlowKey key;
+            uint8_t protocol;
+            if (etherType == 0x0800)
+            {
+                if ((end - it < 20) || ((it[0] >> 4) != 4))
+                    return boost::asio::const_buffer();
+                size_t headerLength = (it[0] & 0x0F) * 4;
+                size_t totalLength = (it[2] << 8) | it[3];
+                // Fragments are not reassembled
+                if ((((it[6] & 0x3F) << 8) | it[7]) != 0)
+                    return boost::asio::const_buffer();
+                if ((headerLength < 20) || (totalLength < headerLength) ||
+                    (static_cast<size_t>(end - it) < headerLength))
+                    return boost::asio::const_buffer();
+                protocol = it[9];
+                std::copy(it + 12, it + 16, key.srcIp.begin());
+                std::copy(it + 16, it + 20, key.dstIp.begin());
+                // Ethernet may pad short frames
+                end = std::min(end, it + totalLength);
+                it += headerLength;
+            } else if (etherType == 0x86DD)
+            {
+                if ((end - it < 40) || ((it[0] >> 4) != 6))
+                    return boost::asio::const_buffer();
+                size_t payloadLength = (it[4] << 8) | it[5];
+                // Extension headers are not supported
+                protocol = it[6];
+                std::copy(it + 8, it + 24, key.srcIp.begin());
+                std::copy(it + 24, it + 40, key.dstIp.begin());
+                it += 40;
+                end = std::min(end, it + payloadLength);
+            } else
+                return boost::asio::const_buffer();
+
+            if (protocol == IPPROTO_UDP)
+            {
+                if (end - it < 8)
+                    return boost::asio::const_buffer();
+                key.srcPort = (it[0] << 8) | it[1];
+                key.dstPort = (it[2] << 8) | it[3];
+                it += 8;
+                flow_ = flows_.emplace(key, flows_.size()).first->second;
+                return boost::asio::const_buffer(it, end - it);
+            } else if (protocol == IPPROTO_TCP)
+            {
+                if (end - it < 20)
+                    return boost::asio::const_buffer();
+                size_t headerLength = (it[12] >> 4) * 4;
+                if ((headerLength < 20) ||
+                    (static_cast<size_t>(end - it) < headerLength))
+                    return boost::asio::const_buffer();
+                key.srcPort = (it[0] << 8) | it[1];
+                key.dstPort = (it[2] << 8) | it[3];
+                uint32_t seq = (static_cast<uint32_t>(it[4]) << 24) | (it[5] << 16) |
+                               (it[6] << 8) | it[7];
+                uint8_t flags = it[13];
+                it += headerLength;
+                flow_ = flows_.emplace(key, flows_.size()).first->second;
+                return reassemble(key, seq, flags, it, end);
+            }
+            return boost::asio::const_buffer();
+        }
+
+        /**
+         * @brief Puts the payload of a TCP segment in stream order. Retransmitted
+         * bytes are discarded, segments ahead of a missing one are held back.
+         * @return Bytes now in order, empty if there are none
+         */
+        [[nodiscard]] boost::asio::const_buffer
+        reassemble(const FlowKey& key, uint32_t seq, uint8_t flags,
+                   const u_char* payload, const u_char* end)
+        {
+            static const uint8_t TCP_SYN = 0x02;
+            static const uint8_t TCP_FIN = 0x01;
+            static const uint8_t TCP_RST = 0x04;
+
+            TcpFlow& flow = tcpFlows_[key];
+            if (flags & TCP_SYN)
+            {
+                flow = TcpFlow();
+                flow.synced = true;
+                flow.nextSeq = seq + 1;
+                return boost::asio::const_buffer();
+            }
+            if (flags & TCP_RST)
+            {
+                tcpFlows_.erase(key);
+                return boost::asio::const_buffer();
+            }
+            if (!flow.synced)
+            {
+                // Capture started within the connection
+                flow.synced = true;
+                flow.nextSeq = seq;
+            }
+
+            streamBuffer_.clear();
+            if (end > payload)
+            {
+                int32_t ahead = static_cast<int32_t>(seq - flow.nextSeq);
+                if (ahead > 0)
+                {
+                    flow.outOfOrder[seq].assign(payload, end);
+                    if (flow.outOfOrder.size() > PCAP_MAX_OUT_OF_ORDER_SEGMENTS)
+                    {
+                        ROSAIC_LOG(node_, log_level::DEBUG,
+                                   "TCP segment missing in pcap file, skipping " +
+                                       std::to_string(ahead) + " bytes.");
+                        flow.nextSeq = flow.outOfOrder.begin()->first;
+                    }
+                } else
+                    appendInOrder(flow, seq, payload, end);
+            }
+
+            while (!flow.outOfOrder.empty() &&
+                   (static_cast<int32_t>(flow.outOfOrder.begin()->first -
+                                         flow.nextSeq) <= 0))
+            {
+                auto segment = flow.outOfOrder.begin();
+                appendInOrder(flow, segment->first, segment->second.data(),
+                              segment->second.data() + segment->second.size());
+                flow.outOfOrder.erase(segment);
+            }
+
+            if (flags & TCP_FIN)
+                tcpFlows_.erase(key);
+
+            return boost::asio::const_buffer(streamBuffer_.data(),
+                                             streamBuffer_.size());
+        }
+
+        void appendInOrder(TcpFlow& flow, uint32_t seq, const u_char* payload,
+                           const u_char* end)
+        {
+            size_t overlap = flow.nextSeq - seq;
+            if (overlap >= static_cast<size_t>(end - payload))
+                return;
+            streamBuffer_.insert(streamBuffer_.end(), payload + overlap, end);
+            flow.nextSeq += (end - payload) - overlap;
+        }
+
+        //! Held back segments per TCP stream until a missing one is skipped
+        static const size_t PCAP_MAX_OUT_OF_ORDER_SEGMENTS = 64;
+
         ROSaicNodeBase* node_;
         std::shared_ptr<boost::asio::io_service> ioService_;
-        std::array<char, 100> errBuff_;
-        pcap_t* pcap_;
-
-    public:
-        std::unique_ptr<boost::asio::posix::stream_descriptor> stream_;
+        std::array<char, PCAP_ERRBUF_SIZE> errBuff_;
+        pcap_t* pcap_ = nullptr;
+        //! Link type of the pcap file
+        int linkType_ = DLT_EN10MB;
+        //! Reassembly state of the TCP streams
+        std::map<FlowKey, TcpFlow> tcpFlows_;
+        //! Index of each flow in order of appearance
+        std::map<FlowKey, size_t> flows_;
+        //! Flow of the payload returned last
+        size_t flow_ = 0;
+        //! Reassembled TCP payload
+        std::vector<uint8_t> streamBuffer_;
     };
 } // namespace io
\ No newline at end of file
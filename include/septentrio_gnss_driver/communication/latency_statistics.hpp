@@ -0,0 +1,260 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// ROSaic
+#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+#include <septentrio_gnss_driver/communication/telegram.hpp>
+
+//! Number of buckets per power of two of a latency histogram
+static const uint32_t LATENCY_SUB_BUCKETS = 4;
+//! Number of buckets of a latency histogram, covering up to 2^24 microseconds
+static const uint32_t LATENCY_BUCKETS = 96;
+
+namespace latency_stage {
+    //! Stages a telegram passes between reception and publication
+    enum LatencyStage : uint8_t
+    {
+        //! From completing the frame to passing the CRC check
+        CRC,
+        //! From passing the CRC check to being dequeued for processing
+        QUEUE,
+        //! From being dequeued to being processed, including the publishing of the
+        //! messages it completes if there is no publish pipeline
+        PROCESSING,
+        COUNT
+    };
+
+    inline constexpr const char* NAMES[] = {"crc", "queue", "processing"};
+    static_assert(std::size(NAMES) == COUNT);
+} // namespace latency_stage
+
+/**
+ * @class LatencyHistogram
+ * @brief Lock-free histogram of durations with logarithmic buckets, each power of
+ * two of microseconds being split into LATENCY_SUB_BUCKETS buckets. Quantiles are
+ * thus accurate to about 20 %. Any thread may add, one thread collects.
+ */
+class LatencyHistogram
+{
+public:
+    struct Summary
+    {
+        uint64_t count = 0;
+        //! Median in microseconds
+        uint64_t p50 = 0;
+        //! 99th percentile in microseconds
+        uint64_t p99 = 0;
+        //! Maximum in microseconds
+        uint64_t max = 0;
+    };
+
+    /**
+     * @brief Adds a duration
+     * @param[in] duration Duration in nanoseconds
+     */
+    void add(Timestamp duration) noexcept
+    {
+        uint64_t us = duration / 1000;
+        buckets_[bucketOf(us)].fetch_add(1, std::memory_order_relaxed);
+        uint64_t max = max_.load(std::memory_order_relaxed);
+        while ((us > max) &&
+               !max_.compare_exchange_weak(max, us, std::memory_order_relaxed))
+            ;
+    }
+
+    /**
+     * @brief Summarizes the durations added since the last call and resets the
+     * histogram
+     * @return Summary, quantiles are the upper bounds of their buckets
+     */
+    [[nodiscard]] Summary collect() noexcept
+    {
+        std::array<uint32_t, LATENCY_BUCKETS> counts;
+        Summary summary;
+        for (uint32_t i = 0; i < LATENCY_BUCKETS; ++i)
+        {
+            counts[i] = buckets_[i].exchange(0, std::memory_order_relaxed);
+            summary.count += counts[i];
+        }
+        summary.max = max_.exchange(0, std::memory_order_relaxed);
+        if (summary.count == 0)
+            return summary;
+
+        uint64_t rank50 = (summary.count + 1) / 2;
+        uint64_t rank99 = summary.count - summary.count / 100;
+        uint64_t cumulated = 0;
+        for (uint32_t i = 0; i < LATENCY_BUCKETS; ++i)
+        {
+            uint64_t previous = cumulated;
+            cumulated += counts[i];
+            if ((previous < rank50) && (cumulated >= rank50))
+                summary.p50 = std::min(upperBound(i), summary.max);
+            if ((previous < rank99) && (cumulated >= rank99))
+                summary.p99 = std::min(upperBound(i), summary.max);
+        }
+        return summary;
+    }
+
+private:
+    [[nodiscard]] static uint32_t bucketOf(uint64_t us) noexcept
+    {
+        if (us < LATENCY_SUB_BUCKETS)
+            return static_cast<uint32_t>(us);
+        uint32_t msb = 63 - __builtin_clzll(us);
+        uint32_t sub = (us >> (msb - 2)) & (LATENCY_SUB_BUCKETS - 1);
+        return std::min((msb - 1) * LATENCY_SUB_BUCKETS + sub, LATENCY_BUCKETS - 1);
+    }
+
+    //! Smallest duration in microseconds of the bucket following bucket
+    [[nodiscard]] static uint64_t upperBound(uint32_t bucket) noexcept
+    {
+        ++bucket;
+        if (bucket < LATENCY_SUB_BUCKETS)
+            return bucket;
+        uint32_t msb = bucket / LATENCY_SUB_BUCKETS + 1;
+        return static_cast<uint64_t>(LATENCY_SUB_BUCKETS +
+                                     bucket % LATENCY_SUB_BUCKETS)
+               << (msb - 2);
+    }
+
+    std::array<std::atomic<uint32_t>, LATENCY_BUCKETS> buckets_{};
+    std::atomic<uint64_t> max_{0};
+};
+
+//! Histograms of one SBF block
+struct SbfLatencies
+{
+    //! From reception to being processed
+    LatencyHistogram received;
+    //! Duration of processing, i.e. parsing and assembling the messages
+    LatencyHistogram processing;
+};
+
+/**
+ * @class LatencyStatistics
+ * @brief Latencies of the stages of telegrams, per SBF block and per topic, and
+ * error counters of the framers. Stage and processing latencies are measured with
+ * a monotonic clock, latencies per SBF block and per topic from the receive time
+ * stamp of the telegram with the node clock. Processing durations per SBF block
+ * and of NMEA sentences allow to benchmark the parsers by replaying a recorded
+ * file as fast as possible. Instrumentation is skipped entirely if no
+ * statistics are handed to the framers and the message handler.
+ */
+class LatencyStatistics
+{
+public:
+    LatencyStatistics() = default;
+    LatencyStatistics(const LatencyStatistics&) = delete;
+    LatencyStatistics& operator=(const LatencyStatistics&) = delete;
+
+    //! Current time of the monotonic clock stages are stamped with
+    [[nodiscard]] static Timestamp now() noexcept { return steadyTime(); }
+
+    //! Duration between two time stamps, 0 if they are out of order
+    [[nodiscard]] static Timestamp elapsed(Timestamp from, Timestamp to) noexcept
+    {
+        return (to > from) ? (to - from) : 0;
+    }
+
+    [[nodiscard]] LatencyHistogram& stage(latency_stage::LatencyStage stage)
+    {
+        return stages_[stage];
+    }
+
+    [[nodiscard]] LatencyHistogram& topic(topic::Topic topic)
+    {
+        return topics_[topic];
+    }
+
+    //! Histogram of processing NMEA sentences
+    [[nodiscard]] LatencyHistogram& nmea() { return nmea_; }
+
+    /**
+     * @brief Histograms of an SBF block, created on first use. Only to be called
+     * from the processing thread.
+     * @param[in] id SBF ID
+     * @return Histograms of the SBF block
+     */
+    [[nodiscard]] SbfLatencies& sbf(uint16_t id)
+    {
+        SbfLatencies* histograms = sbf_[id].load(std::memory_order_acquire);
+        if (histograms == nullptr)
+        {
+            sbfHistograms_.emplace_back(new SbfLatencies);
+            histograms = sbfHistograms_.back().get();
+            sbf_[id].store(histograms, std::memory_order_release);
+        }
+        return *histograms;
+    }
+
+    //! Histograms of an SBF block if it has been received, nullptr otherwise
+    [[nodiscard]] SbfLatencies* sbfIfReceived(uint16_t id)
+    {
+        return sbf_[id].load(std::memory_order_acquire);
+    }
+
+    void countCrcFailure() noexcept
+    {
+        crcFailures_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void countFramingError() noexcept
+    {
+        framingErrors_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //! Number of SBF blocks with invalid CRC since start
+    [[nodiscard]] uint64_t crcFailures() const noexcept { return crcFailures_; }
+
+    //! Number of times the framers lost sync since start
+    [[nodiscard]] uint64_t framingErrors() const noexcept
+    {
+        return framingErrors_;
+    }
+
+private:
+    std::array<LatencyHistogram, latency_stage::COUNT> stages_;
+    std::array<LatencyHistogram, topic::COUNT> topics_;
+    LatencyHistogram nmea_;
+    std::array<std::atomic<SbfLatencies*>, SBF_ID_COUNT> sbf_{};
+    //! Owns the histograms of sbf_, only touched by the processing thread
+    std::vector<std::unique_ptr<SbfLatencies>> sbfHistograms_;
+    std::atomic<uint64_t> crcFailures_{0};
+    std::atomic<uint64_t> framingErrors_{0};
+};
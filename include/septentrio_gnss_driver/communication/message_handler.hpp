@@ -59,23 +59,37 @@
 #pragma once
 
 // C++ libraries
+#include <array>
+#include <atomic>
+#include <bitset>
 #include <cassert> // for assert
 #include <cstddef>
 #include <map>
 #include <sstream>
+#include <string_view>
+#include <unordered_map>
 // Boost includes
 #include <boost/call_traits.hpp>
 #include <boost/format.hpp>
 #include <boost/math/constants/constants.hpp>
 #include <boost/tokenizer.hpp>
 // ROSaic includes
+#include <septentrio_gnss_driver/abstraction/raw_sbf_block.hpp>
 #include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+#include <septentrio_gnss_driver/communication/epoch_aggregator.hpp>
+#include <septentrio_gnss_driver/communication/latency_statistics.hpp>
+#include <septentrio_gnss_driver/communication/message_recorder.hpp>
+#include <septentrio_gnss_driver/communication/publish_pipeline.hpp>
 #include <septentrio_gnss_driver/communication/telegram.hpp>
+#include <septentrio_gnss_driver/communication/topic_decimator.hpp>
 #include <septentrio_gnss_driver/crc/crc.hpp>
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gpgga.hpp>
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gpgsa.hpp>
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gpgsv.hpp>
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gprmc.hpp>
+#include <septentrio_gnss_driver/parsers/local_frame_cache.hpp>
+#include <septentrio_gnss_driver/parsers/satellite_tables.hpp>
+#include <septentrio_gnss_driver/parsers/sbf_blocks.hpp>
 #include <septentrio_gnss_driver/parsers/string_utilities.hpp>
 
 /**
@@ -129,6 +143,36 @@ enum SbfId
     RF_STATUS = 4092
 };
 
+namespace sbf_consumer {
+    //! Outputs that may need an SBF block, to be combined as bit mask
+    enum SbfConsumer : uint16_t
+    {
+        NONE = 0,
+        //! The topic of the block itself
+        TOPIC = 1 << 0,
+        NAVSATFIX = 1 << 1,
+        GPSFIX = 1 << 2,
+        POSE = 1 << 3,
+        TWIST = 1 << 4,
+        IMU = 1 << 5,
+        //! Localization and tf in UTM
+        LOCALIZATION = 1 << 6,
+        //! Localization and tf in ECEF
+        LOCALIZATION_ECEF = 1 << 7,
+        DIAGNOSTICS = 1 << 8,
+        TIME_REFERENCE = 1 << 9,
+        //! NMEA messages stamped with GNSS time
+        NMEA = 1 << 10,
+        //! Driver internals such as leap seconds, firmware version, and latency
+        DRIVER = 1 << 11,
+        //! The raw block topic
+        RAW = 1 << 12
+    };
+} // namespace sbf_consumer
+
+//! Times the assemblers of the MessageHandler in isolation
+class MessageHandlerBenchmark;
+
 namespace io {
 
     /**
@@ -154,6 +198,70 @@ namespace io {
                 current_leap_seconds_ = settings_->leap_seconds;
         }
 
+        /**
+         * @brief Determines from the settings which outputs consume which SBF
+         * blocks, blocks without consumer are discarded unparsed. Sets up the
+         * decimation of the topics, blocks whose consumers are all decimated in
+         * an epoch are discarded unparsed as well. To be called once the settings
+         * are loaded and before the first block is parsed.
+         */
+        void setupSbfConsumers();
+
+        /**
+         * @brief Registers the outputs combining several SBF blocks of an epoch
+         * with the epoch aggregator according to the settings. To be called once
+         * the settings are loaded and before the first block is parsed.
+         */
+        void setupEpochAggregator();
+
+        /**
+         * @brief Discards the epochs aggregated so far before the next block is
+         * parsed, e.g. after reconnecting. May be called from any thread.
+         */
+        void resetEpochs() { epochsReset_ = true; }
+
+        //! Number of messages dropped since the publish pipeline lagged behind
+        [[nodiscard]] uint64_t publishDropped() const
+        {
+            return publishPipeline_.dropped();
+        }
+
+        /**
+         * @brief Advertises all topics enabled in the settings, so that
+         * subscribers can connect before the first message and no advertisement
+         * happens while parsing
+         */
+        void advertiseTopics();
+
+        /**
+         * @brief Starts the publishing threads as set in the settings
+         */
+        void startPublishPipeline();
+
+        /**
+         * @brief Records the messages instead of publishing them
+         * @param[in] recorder Recorder to be used, nullptr to publish
+         */
+        void setRecorder(MessageRecorder* recorder) { recorder_ = recorder; }
+
+        /**
+         * @brief Measures the latency from reception to publication per topic
+         * @param[in] statistics Statistics to be updated, nullptr to skip
+         */
+        void setStatistics(LatencyStatistics* statistics)
+        {
+            statistics_ = statistics;
+        }
+
+        /**
+         * @brief Publishes the latency statistics collected since the last call
+         * as DiagnosticArrayMsg and resets them
+         * @param[in] statistics Statistics to be published
+         * @param[in] telegramQueue Queue whose fill level is reported
+         */
+        void publishStatistics(LatencyStatistics& statistics,
+                               const TelegramQueue& telegramQueue);
+
         /**
          * @brief Parse SBF block
          * @param[in] telegram Telegram to be parsed
@@ -167,6 +275,8 @@ namespace io {
         void parseNmea(const std::shared_ptr<Telegram>& telegram);
 
     private:
+        friend class ::MessageHandlerBenchmark;
+
         /**
          * @brief Header assembling
          * @param[in] frameId String of frame ID
@@ -178,11 +288,36 @@ namespace io {
                             const std::shared_ptr<Telegram>& telegram, T& msg) const;
         /**
          * @brief Publishing function
-         * @param[in] topic String of topic
+         * @param[in] topic Topic to publish on
          * @param[in] msg ROS message to be published
          */
         template <typename M>
-        void publish(const std::string& topic, const M& msg);
+        void publish(topic::Topic topic, const M& msg);
+
+        /**
+         * @brief Publishes right away or via the publish pipeline
+         * @param[in] topic Topic to publish on
+         * @param[in] msg ROS message to be published
+         * @param[in] received Receive time stamp of the telegram the message
+         * was assembled from, 0 if its latency is not to be measured
+         */
+        template <typename M>
+        void dispatch(topic::Topic topic, const M& msg, Timestamp received);
+
+        /**
+         * @brief Hands a job to the publish pipeline, warns if a lagging worker
+         * dropped a job for it
+         * @param[in] lane Lane of the job
+         * @param[in] job Job to be run
+         */
+        void post(publish_lane::PublishLane lane, std::function<void()>&& job);
+
+        /**
+         * @brief Checks if a topic has to be assembled, i.e. has subscribers
+         * @param[in] topic Topic to be checked
+         * @return True if the topic has subscribers
+         */
+        [[nodiscard]] bool hasSubscribers(topic::Topic topic) const;
 
         /**
          * @brief Publishing function
@@ -191,6 +326,12 @@ namespace io {
 
         void publishTf(const LocalizationMsg& msg);
 
+        /**
+         * @brief Publishes an SBF block as is on the raw block topic
+         * @param[in] telegram Telegram holding the block, shared with the message
+         */
+        void publishRawSbf(const std::shared_ptr<Telegram>& telegram);
+
         /**
          * @brief Pointer to the node
          */
@@ -204,7 +345,7 @@ namespace io {
         /**
          * @brief Map of NMEA messgae IDs and uint8_t
          */
-        std::unordered_map<std::string, uint8_t> nmeaMap_{
+        std::unordered_map<std::string_view, uint8_t> nmeaMap_{
             {"$GPGGA", 0}, {"$INGGA", 0}, {"$GPRMC", 1}, {"$INRMC", 1},
             {"$GPGSA", 2}, {"$INGSA", 2}, {"$GAGSV", 3}, {"$INGSV", 3}};
 
@@ -256,12 +397,18 @@ namespace io {
          */
         ChannelStatus last_channelstatus_;
 
+        //! Satellites of last_channelstatus_ as table
+        ChannelSatellites channelSatellites_;
+
         /**
          * @brief Since GPSFix needs MeasEpoch (for SNRs), incoming MeasEpoch blocks
          * need to be stored
          */
         MeasEpochMsg last_measepoch_;
 
+        //! Satellites of last_measepoch_ as table, filled if GPSFix is published
+        TrackedSatellites trackedSatellites_;
+
         /**
          * @brief Since GPSFix needs DOP, incoming DOP blocks need to be stored
          */
@@ -306,6 +453,35 @@ namespace io {
          */
         RfStatusMsg last_rf_status_;
 
+        //! Consumers of each SBF ID as bit mask of sbf_consumer::SbfConsumer
+        std::array<uint16_t, SBF_ID_COUNT> sbfConsumers_{};
+
+        //! Triggers the outputs combining the blocks stored above once per epoch
+        EpochAggregator epochAggregator_;
+        //! Whether the epoch aggregator is to be reset before the next block
+        std::atomic<bool> epochsReset_{false};
+
+        //! Decides per epoch which topics are published
+        TopicDecimator decimator_;
+        static_assert(topic::COUNT <= TopicDecimator::MAX_TOPICS,
+                      "Topics do not fit into a mask of the decimator");
+
+        //! Topics consuming each SBF ID that may be discarded if none of them is
+        //! due
+        std::unordered_map<uint16_t, TopicDecimator::TopicMask> sbfTopics_;
+
+        //! Last ReceiverStatus or QualityInd telegram, the header of the
+        //! diagnostics is taken from
+        std::shared_ptr<Telegram> diagnosticsTelegram_;
+
+        //! Recorder of the messages if not published
+        MessageRecorder* recorder_ = nullptr;
+
+        //! Latency statistics, nullptr if not instrumented
+        LatencyStatistics* statistics_ = nullptr;
+        //! Receive time stamp of the telegram being parsed
+        Timestamp telegramStamp_ = 0;
+
         //! When reading from an SBF file, the ROS publishing frequency is governed
         //! by the time stamps found in the SBF blocks therein.
         Timestamp unix_time_;
@@ -316,6 +492,21 @@ namespace io {
         //! Current leap seconds as received, do not use value is -128
         int32_t current_leap_seconds_ = -128;
 
+        /**
+         * @brief Maps SBF IDs to the blocks handled by the epoch aggregator
+         * @param[in] sbfId SBF ID
+         * @return Block as epoch_block::EpochBlock, NONE if not combined with
+         * others
+         */
+        [[nodiscard]] static uint16_t epochBlock(uint16_t sbfId);
+
+        /**
+         * @brief Maps SBF IDs to the topics publishing the block itself
+         * @param[in] sbfId SBF ID
+         * @return Topic, topic::COUNT if the block has no topic of its own
+         */
+        [[nodiscard]] static topic::Topic blockTopic(uint16_t sbfId);
+
         /**
          * @brief "Callback" function when constructing NavSatFix messages
          */
@@ -335,9 +526,8 @@ namespace io {
         /**
          * @brief "Callback" function when constructing
          * DiagnosticArrayMsg messages
-         * @param[in] telegram telegram from which the msg was assembled
          */
-        void assembleDiagnosticArray(const std::shared_ptr<Telegram>& telegram);
+        void assembleDiagnosticArray();
 
         /**
          * @brief "Callback" function when constructing
@@ -404,6 +594,18 @@ namespace io {
          */
         std::shared_ptr<std::string> fixedUtmZone_;
 
+        //! Rotations between local frame and ECEF at the last INS position
+        parsing_utilities::LocalFrameCache localFrame_;
+        //! Generation of localFrame_ the UTM zone was determined at
+        uint64_t utmGeneration_ = 0;
+        //! UTM zone in use, negative if not yet determined
+        int utmZone_ = -1;
+        //! Name of the UTM zone in use
+        std::string utmZoneString_;
+        //! Cosine and sine of the meridian convergence in the UTM zone
+        double utmConvergenceCos_ = 1.0;
+        double utmConvergenceSin_ = 0.0;
+
         /**
          * @brief Calculates the timestamp, in the Unix Epoch time format
          * This is either done using the TOW as transmitted with the SBF block (if
@@ -426,5 +628,9 @@ namespace io {
          * epoch
          */
         Timestamp timestampSBF(uint32_t tow, uint16_t wnc) const;
+
+        //! Publishing threads, declared last to be stopped before the other
+        //! members are destroyed
+        PublishPipeline publishPipeline_;
     };
 } // namespace io
\ No newline at end of file
@@ -0,0 +1,124 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <cmath>
+#include <functional>
+#include <vector>
+
+// ROS
+#include <rosbag/bag.h>
+#include <tf2_msgs/TFMessage.h>
+
+// ROSaic
+#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+
+/**
+ * @class MessageRecorder
+ * @brief Collects messages instead of publishing them, to be written to a rosbag
+ * later in the order of recording
+ */
+class MessageRecorder
+{
+public:
+    /**
+     * @brief Records a message
+     * @param[in] topic Topic of the message
+     * @param[in] msg Message to be recorded
+     */
+    template <typename M>
+    void record(topic::Topic topic, const M& msg)
+    {
+        records_.emplace_back([topic, msg](rosbag::Bag& bag) {
+            bag.write(bagTopic(topic::NAMES[topic]), msg.header.stamp, msg);
+        });
+    }
+
+    /**
+     * @brief Records the tf of a localization, without insertion of a local frame
+     * @param[in] loc Localization to be recorded as tf
+     */
+    void recordTf(const LocalizationMsg& loc)
+    {
+        if (std::isnan(loc.pose.pose.orientation.w))
+            return;
+
+        geometry_msgs::TransformStamped transformStamped;
+        transformStamped.header = loc.header;
+        transformStamped.child_frame_id = loc.child_frame_id;
+        transformStamped.transform.translation.x = loc.pose.pose.position.x;
+        transformStamped.transform.translation.y = loc.pose.pose.position.y;
+        transformStamped.transform.translation.z = loc.pose.pose.position.z;
+        transformStamped.transform.rotation = loc.pose.pose.orientation;
+
+        tf2_msgs::TFMessage tf;
+        tf.transforms.push_back(transformStamped);
+        records_.emplace_back([tf, stamp = loc.header.stamp](rosbag::Bag& bag) {
+            bag.write("/tf", stamp, tf);
+        });
+    }
+
+    /**
+     * @brief Writes all recorded messages to the bag and clears the recording
+     * @param[in] bag Bag opened for writing
+     */
+    void writeTo(rosbag::Bag& bag)
+    {
+        for (auto& record : records_)
+            record(bag);
+        clear();
+    }
+
+    //! Discards all recorded messages
+    void clear()
+    {
+        records_.clear();
+        records_.shrink_to_fit();
+    }
+
+    //! Number of recorded messages
+    [[nodiscard]] size_t size() const { return records_.size(); }
+
+private:
+    /**
+     * @brief Topic as published by the node, relative names are in the private
+     * namespace of the node
+     */
+    static std::string bagTopic(const std::string& name)
+    {
+        if (!name.empty() && (name[0] == '/'))
+            return name;
+        return ros::this_node::getName() + "/" + name;
+    }
+
+    std::vector<std::function<void(rosbag::Bag&)>> records_;
+};
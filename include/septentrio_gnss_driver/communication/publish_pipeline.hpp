@@ -0,0 +1,233 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ROSaic
+#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+
+//! Maximum number of messages waiting for publishing per worker
+static const uint32_t PUBLISH_QUEUE_CAPACITY = 256;
+
+namespace publish_lane {
+    //! Outputs in one lane are published in order by the same worker
+    enum PublishLane : uint8_t
+    {
+        //! INS based navigation, localization and tf
+        LOW_LATENCY,
+        //! Receiver and authentication status
+        DIAGNOSTICS,
+        //! Everything else, e.g. raw SBF topics and GPSFix
+        DEFAULT,
+        COUNT
+    };
+
+    inline constexpr const char* NAMES[] = {"low latency", "diagnostics",
+                                            "default"};
+    static_assert(std::size(NAMES) == COUNT);
+
+    /**
+     * @brief Lane of a topic
+     * @param[in] topic Topic to be published
+     * @return Lane the topic is published in
+     */
+    inline PublishLane laneOf(topic::Topic topic)
+    {
+        switch (topic)
+        {
+        case topic::INS_NAV_CART:
+        case topic::INS_NAV_GEOD:
+        case topic::IMU:
+        case topic::POSE:
+        case topic::LOCALIZATION:
+        case topic::LOCALIZATION_ECEF:
+        case topic::TWIST_INS:
+            return LOW_LATENCY;
+        case topic::DIAGNOSTICS:
+        case topic::AIM_PLUS_STATUS:
+        case topic::GAL_AUTH_STATUS:
+        case topic::RF_STATUS:
+            return DIAGNOSTICS;
+        default:
+            return DEFAULT;
+        }
+    }
+} // namespace publish_lane
+
+/**
+ * @class PublishPipeline
+ * @brief Workers publishing messages decoupled from parsing. Lanes are
+ * distributed over the workers, each worker publishes in order, thus the order
+ * per topic is preserved. Without workers, jobs are run by the caller.
+ */
+class PublishPipeline
+{
+public:
+    PublishPipeline() = default;
+    PublishPipeline(const PublishPipeline&) = delete;
+    PublishPipeline& operator=(const PublishPipeline&) = delete;
+
+    ~PublishPipeline() { stop(); }
+
+    /**
+     * @brief Starts the workers
+     * @param[in] numWorkers Number of workers, 0 to publish in the calling thread,
+     * limited to the number of lanes
+     * @param[in] lossless Whether posting waits for a lagging worker instead of
+     * dropping its oldest job
+     */
+    void start(uint32_t numWorkers, bool lossless)
+    {
+        stop();
+        lossless_ = lossless;
+        numWorkers = std::min<uint32_t>(numWorkers, publish_lane::COUNT);
+        for (uint32_t i = 0; i < numWorkers; ++i)
+        {
+            workers_.emplace_back(new Worker);
+            Worker* worker = workers_.back().get();
+            worker->thread = std::thread([worker]() { worker->run(); });
+        }
+    }
+
+    /**
+     * @brief Publishes the remaining messages and stops the workers
+     */
+    void stop()
+    {
+        for (auto& worker : workers_)
+        {
+            {
+                std::lock_guard<std::mutex> lock(worker->mutex);
+                worker->running = false;
+            }
+            worker->cond.notify_one();
+            worker->thread.join();
+        }
+        workers_.clear();
+    }
+
+    /**
+     * @brief Hands a job to the worker of the lane or runs it if there are no
+     * workers. If the worker lags behind, posting waits in lossless mode, otherwise
+     * the oldest job is dropped.
+     * @param[in] lane Lane of the job
+     * @param[in] job Job to be run
+     * @return False if the oldest job of the worker was dropped for this one
+     */
+    [[nodiscard]] bool post(publish_lane::PublishLane lane,
+                            std::function<void()>&& job)
+    {
+        if (workers_.empty())
+        {
+            job();
+            return true;
+        }
+
+        Worker* worker = workers_[lane % workers_.size()].get();
+        bool dropped = false;
+        {
+            std::unique_lock<std::mutex> lock(worker->mutex);
+            if (lossless_)
+            {
+                worker->notFull.wait(lock, [worker]() {
+                    return worker->jobs.size() < PUBLISH_QUEUE_CAPACITY;
+                });
+            } else if (worker->jobs.size() == PUBLISH_QUEUE_CAPACITY)
+            {
+                worker->jobs.pop_front();
+                ++worker->dropped;
+                dropped = true;
+            }
+            worker->jobs.push_back(std::move(job));
+        }
+        worker->cond.notify_one();
+        return !dropped;
+    }
+
+    //! Number of workers
+    [[nodiscard]] size_t workers() const { return workers_.size(); }
+
+    //! Number of messages dropped since the workers lagged behind
+    [[nodiscard]] uint64_t dropped() const
+    {
+        uint64_t dropped = 0;
+        for (const auto& worker : workers_)
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            dropped += worker->dropped;
+        }
+        return dropped;
+    }
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::condition_variable notFull;
+        std::deque<std::function<void()>> jobs;
+        uint64_t dropped = 0;
+        bool running = true;
+        std::thread thread;
+
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (running || !jobs.empty())
+            {
+                cond.wait(lock, [this]() { return !running || !jobs.empty(); });
+                while (!jobs.empty())
+                {
+                    std::function<void()> job = std::move(jobs.front());
+                    jobs.pop_front();
+                    lock.unlock();
+                    notFull.notify_one();
+                    job();
+                    lock.lock();
+                }
+            }
+        }
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    bool lossless_ = false;
+};
@@ -0,0 +1,197 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ROSaic
+#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+#include <septentrio_gnss_driver/communication/telegram.hpp>
+
+/**
+ * @file raw_recorder.hpp
+ * @brief Records the raw SBF and NMEA stream of the Rx to disk
+ */
+
+namespace io {
+
+    /**
+     * @class RawRecorder
+     * @brief Writes the framed SBF and NMEA telegrams to files readable with
+     * read_from_sbf_log. Telegrams are copied into large aligned buffers, which a
+     * writer thread writes to disk, optionally bypassing the page cache with
+     * O_DIRECT. Recording never blocks the caller, telegrams are dropped if all
+     * buffers are waiting to be written. Files are rotated by size or time,
+     * always at telegram boundaries.
+     */
+    class RawRecorder
+    {
+    public:
+        /**
+         * @brief Constructor of the class RawRecorder
+         * @param[in] node Pointer to the node, the settings are taken from
+         */
+        explicit RawRecorder(ROSaicNodeBase* node);
+
+        ~RawRecorder();
+
+        /**
+         * @brief Allocates the buffers, opens the first file and starts the
+         * writer thread
+         * @return Whether the first file could be opened
+         */
+        [[nodiscard]] bool start();
+
+        //! Writes all recorded telegrams and closes the file
+        void stop();
+
+        /**
+         * @brief Copies SBF and NMEA telegrams into the current buffer, other
+         * telegrams are ignored
+         * @param[in] telegram Telegram to be recorded
+         */
+        void record(const Telegram& telegram);
+
+        //! Alignment of buffers and writes with O_DIRECT
+        static constexpr std::size_t ALIGNMENT = 4096;
+        //! Minimum size of a buffer, fits the largest SBF block and a carried block
+        static constexpr std::size_t MIN_BUFFER_SIZE = 128 * 1024;
+        //! Period after which partly filled buffers are written
+        static constexpr std::chrono::milliseconds FLUSH_PERIOD{1000};
+
+    private:
+        struct FreeDeleter
+        {
+            void operator()(uint8_t* data) const { std::free(data); }
+        };
+
+        struct Buffer
+        {
+            std::unique_ptr<uint8_t, FreeDeleter> data;
+            //! Number of bytes used
+            std::size_t size = 0;
+            //! Whether the file is to be closed after this buffer
+            bool last = false;
+        };
+
+        //! Writes the buffers handed over by record()
+        void run();
+
+        /**
+         * @brief Hands the current buffer to the writer thread, to be called with
+         * mutex_ locked. Without O_DIRECT or for the last buffer of a file all
+         * bytes are handed over, else the bytes beyond whole blocks are carried to
+         * the next buffer.
+         * @return False if there is no free buffer
+         */
+        [[nodiscard]] bool submit();
+
+        /**
+         * @brief Writes a buffer to the current file, opening one if needed
+         * @param[in] buffer Buffer to be written
+         * @param[in] reopen Whether to start a new file if the buffer is the last
+         * of a file
+         */
+        void write(const Buffer& buffer, bool reopen);
+
+        //! Opens a new file named by prefix, time, and sequence number
+        [[nodiscard]] bool open();
+
+        //! Closes the current file
+        void close();
+
+        //! @return Whether the current file is to be rotated
+        [[nodiscard]] bool rotationDue() const;
+
+        /**
+         * @brief Writes all bytes, retrying on interruption and partial writes
+         * @return Whether all bytes were written
+         */
+        [[nodiscard]] bool writeAll(const uint8_t* data, std::size_t size);
+
+        //! Pointer to the node
+        ROSaicNodeBase* node_;
+        //! Prefix of the file names
+        std::string prefix_;
+        //! Whether O_DIRECT is used
+        bool directIo_;
+        //! Alignment of the bytes handed to the writer, 1 without O_DIRECT
+        std::size_t alignment_ = 1;
+        //! Size of each buffer
+        std::size_t capacity_;
+        //! Bytes after which files are rotated, 0 to not rotate by size
+        uint64_t rotateSize_;
+        //! Duration after which files are rotated, 0 to not rotate by time
+        std::chrono::steady_clock::duration rotatePeriod_;
+
+        //! Protects the buffers and the flags below
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::vector<Buffer> buffers_;
+        //! Buffer being filled by record()
+        Buffer* fill_ = nullptr;
+        //! Buffers waiting to be written, in order
+        std::deque<Buffer*> full_;
+        //! Buffers to be filled
+        std::vector<Buffer*> free_;
+        //! Whether the current file is to be closed after the next buffer
+        bool rotate_ = false;
+        //! Whether the last buffer of the current file waits to be written
+        bool closing_ = false;
+        //! Whether recording stops
+        bool stopping_ = false;
+        //! Telegrams dropped because no buffer was free
+        uint64_t dropped_ = 0;
+
+        //! Writer thread, the members below are only used by it
+        std::thread writer_;
+        //! Descriptor of the current file, -1 if none is open
+        int fd_ = -1;
+        //! Bytes written to the current file
+        uint64_t fileBytes_ = 0;
+        //! Time the current file was opened
+        std::chrono::steady_clock::time_point fileOpened_;
+        //! Number of files opened
+        uint64_t files_ = 0;
+        //! Bytes written in total
+        uint64_t written_ = 0;
+        //! Bytes lost due to write errors
+        uint64_t lost_ = 0;
+    };
+} // namespace io
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <stdint.h>
 #include <string>
 #include <vector>
@@ -123,7 +124,7 @@ namespace device_type {
 struct Settings
 {
     //! Set logger level to DEBUG
-    bool activate_debug_log;
+    bool activate_debug_log = false;
     //! Device
     std::string device;
     //! Device type
@@ -138,6 +139,10 @@ struct Settings
     std::string udp_unicast_ip;
     //! UDP IP server id
     std::string udp_ip_server;
+    //! Origin of the receive time stamps of telegrams, "software" for the time of
+    //! processing the read, "kernel" for the time the kernel received the data, or
+    //! "hardware" for the time the network interface received it
+    std::string receive_timestamps;
     //! TCP port
     uint32_t tcp_port;
     //! TCP IP server id
@@ -151,6 +156,43 @@ struct Settings
     //! Delay in seconds between reconnection attempts to the connection type
     //! specified in the parameter connection_type
     float reconnect_delay_s;
+    //! Delay in seconds before the second attempt to reconnect after the
+    //! connection was lost, further attempts back off exponentially
+    double reconnect_backoff_min_s;
+    //! Upper bound in seconds of the delay between attempts to reconnect
+    double reconnect_backoff_max_s;
+    //! Time in milliseconds a TCP connection may stay silent or leave data
+    //! unacknowledged before it is considered lost, 0 to disable keepalive
+    uint32_t tcp_user_timeout_ms;
+    //! Maximum number of data telegrams waiting for processing
+    uint32_t telegram_queue_capacity;
+    //! What to do if the telegram queue is full: "block", "drop_oldest" or
+    //! "drop_by_priority"
+    std::string telegram_queue_policy;
+    //! Number of threads publishing messages, 0 to publish after parsing
+    uint32_t publish_pipeline_threads;
+    //! Period in seconds of publishing latency statistics, 0 to disable them
+    double latency_statistics_period_s;
+    //! Speed of replaying files relative to real time, 0 for no throttling
+    double replay_rate;
+    //! Seconds to skip at the beginning of an SBF file
+    double replay_skip_s;
+    //! Rosbag to write the output of an SBF file to instead of publishing
+    std::string replay_bag;
+    //! Number of threads processing an SBF file for a rosbag, 0 for one per core
+    uint32_t replay_threads;
+    //! Prefix of the files the raw stream is recorded to, empty to not record
+    std::string raw_recorder_prefix;
+    //! Size in KiB of each recording buffer
+    uint32_t raw_recorder_buffer_kb;
+    //! Number of recording buffers
+    uint32_t raw_recorder_buffers;
+    //! Size in MB after which a new recording is started, 0 to not rotate by size
+    uint32_t raw_recorder_rotate_size_mb;
+    //! Seconds after which a new recording is started, 0 to not rotate by time
+    double raw_recorder_rotate_period_s;
+    //! Whether recordings bypass the page cache
+    bool raw_recorder_direct_io;
     //! Baudrate
     uint32_t baudrate;
     //! HW flow control
@@ -298,8 +340,12 @@ struct Settings
     bool publish_twist;
     //! Whether or not to publish the tf of the localization
     bool publish_tf;
+    //! Maximum rate in Hz of each topic by topic::Topic, 0 for every epoch
+    std::vector<double> publish_rate;
     //! Whether or not to publish the tf of the localization
     bool publish_tf_ecef;
+    //! IDs of the SBF blocks to be published raw, none if empty
+    std::vector<uint16_t> publish_raw_sbf;
     //! Wether local frame should be inserted into tf
     bool insert_local_frame = false;
     //! Frame id of the local frame to be inserted
@@ -341,6 +387,8 @@ struct Settings
     bool ins_vsm_ros_variances_by_parameter = false;
     //! Variances of the 3D velocity (var_x, var_y, var_z)
     std::vector<double> ins_vsm_ros_variances = {-1.0, -1.0, -1.0};
+    //! Rate in Hz of sending the averaged velocities to the Rx
+    double ins_vsm_ros_rate = 2.0;
     //! VSM IP server id
     std::string ins_vsm_ip_server_id;
     //! VSM tcp port
@@ -359,9 +407,9 @@ struct Settings
 struct Capabilities
 {
     //! Wether Rx is INS
-    bool is_ins = false;
+    std::atomic<bool> is_ins{false};
     //! Wether Rx has heading
-    bool has_heading = false;
+    std::atomic<bool> has_heading{false};
     //! Wether Rx has improved VSM handling
-    bool has_improved_vsm_handling = false;
+    std::atomic<bool> has_improved_vsm_handling{false};
 };
\ No newline at end of file
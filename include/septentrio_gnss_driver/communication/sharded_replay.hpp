@@ -0,0 +1,115 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++ includes
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// ROSaic includes
+#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+#include <septentrio_gnss_driver/communication/io.hpp>
+#include <septentrio_gnss_driver/communication/message_recorder.hpp>
+
+/**
+ * @file sharded_replay.hpp
+ * @brief Parallel processing of SBF files into rosbags
+ */
+
+//! Minimum number of SBF blocks per shard
+static const size_t REPLAY_SHARD_MIN_BLOCKS = 20000;
+//! Shards per thread, more shards bound the memory of pending recordings
+static const size_t REPLAY_SHARDS_PER_THREAD = 4;
+//! Seconds of the preceding blocks parsed to restore the state of a shard
+static const double REPLAY_WARM_UP_S = 5.0;
+
+namespace io {
+
+    /**
+     * @class ShardedReplay
+     * @brief Processes an SBF file with several threads and writes the messages to
+     * a rosbag. The file is split into shards at epoch boundaries, each shard is
+     * parsed by its own MessageHandler. To restore state, such as the last
+     * blocks of lower rate and the leap seconds, a shard first parses the
+     * preceding seconds without recording. The shards are written in order, thus
+     * the bag is in the same order as a sequential replay.
+     */
+    class ShardedReplay
+    {
+    public:
+        /**
+         * @brief Constructor of the class ShardedReplay
+         * @param[in] node Pointer to the node
+         */
+        explicit ShardedReplay(ROSaicNodeBase* node);
+
+        /**
+         * @brief Processes the SBF file of the settings into the rosbag of the
+         * settings
+         * @return True if the bag was written
+         */
+        [[nodiscard]] bool run();
+
+    private:
+        //! Blocks of a shard as range of the file index
+        struct Shard
+        {
+            //! First block to be parsed without recording
+            size_t warmUp;
+            //! First block to be recorded
+            size_t begin;
+            //! Block after the shard
+            size_t end;
+            MessageRecorder recorder;
+            bool done = false;
+        };
+
+        void buildShards(size_t numThreads);
+        void processShards();
+        void processShard(Shard& shard);
+
+        //! Pointer to the node
+        ROSaicNodeBase* node_;
+        //! Mapped SBF file
+        SbfFileIo file_;
+        std::vector<std::unique_ptr<Shard>> shards_;
+        //! Next shard to be processed
+        size_t nextShard_ = 0;
+        //! Number of shards written to the bag
+        size_t writtenShards_ = 0;
+        //! Maximum number of shards processed but not yet written
+        size_t maxPendingShards_ = 0;
+        std::mutex mutex_;
+        std::condition_variable cond_;
+    };
+} // namespace io
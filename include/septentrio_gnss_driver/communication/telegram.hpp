@@ -31,14 +31,20 @@
 #pragma once
 
 // C++
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <functional>
 #include <mutex>
+#include <memory>
 #include <queue>
+#include <thread>
 #include <vector>
 
-// ROSaic
-#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+// ROSaic, no ROS dependencies so that framing can be used without ROS
+#include <septentrio_gnss_driver/abstraction/timestamp.hpp>
+#include <septentrio_gnss_driver/parsers/sbf_header.hpp>
 
 //! 0x24 is ASCII for $ - 1st byte in each message
 static const uint8_t SYNC_BYTE_1 = 0x24;
@@ -85,7 +91,15 @@ static const uint8_t CONNECTION_DESCRIPTOR_FOOTER = 0x3E;
 
 static const uint16_t SBF_HEADER_SIZE = 8;
 static const uint16_t MAX_SBF_SIZE = 65535;
+//! Number of possible SBF IDs, the ID field has 13 bits
+static const uint16_t SBF_ID_COUNT = 8192;
 static const uint16_t MAX_UDP_PACKET_SIZE = 65535;
+//! Maximum number of idle telegrams kept for reuse
+static const size_t TELEGRAM_POOL_CAPACITY = 128;
+//! Default maximum number of data telegrams waiting for processing
+static const size_t TELEGRAM_QUEUE_CAPACITY = 1024;
+//! Size of a cache line, used to keep indices of producers and consumer apart
+static const size_t CACHE_LINE_SIZE = 64;
 
 namespace telegram_type {
     enum TelegramType
@@ -104,11 +118,15 @@ namespace telegram_type {
 struct Telegram
 {
     Timestamp stamp;
+    //! Monotonic time the telegram was framed completely, 0 if not instrumented
+    Timestamp framed;
+    //! Monotonic time the telegram passed validation, 0 if not instrumented
+    Timestamp validated;
     telegram_type::TelegramType type;
     std::vector<uint8_t> message;
 
     Telegram(size_t preallocate = 3) noexcept :
-        stamp(0), type(telegram_type::EMPTY),
+        stamp(0), framed(0), validated(0), type(telegram_type::EMPTY),
         message(std::vector<uint8_t>(preallocate))
     {
     }
@@ -116,12 +134,14 @@ struct Telegram
     ~Telegram() {}
 
     Telegram(const Telegram& other) noexcept :
-        stamp(other.stamp), type(other.type), message(other.message)
+        stamp(other.stamp), framed(other.framed), validated(other.validated),
+        type(other.type), message(other.message)
     {
     }
 
     Telegram(Telegram&& other) noexcept :
-        stamp(other.stamp), type(other.type), message(other.message)
+        stamp(other.stamp), framed(other.framed), validated(other.validated),
+        type(other.type), message(std::move(other.message))
     {
     }
 
@@ -130,6 +150,8 @@ struct Telegram
         if (this != &other)
         {
             this->stamp = other.stamp;
+            this->framed = other.framed;
+            this->validated = other.validated;
             this->type = other.type;
             this->message = other.message;
         }
@@ -141,59 +163,545 @@ struct Telegram
         if (this != &other)
         {
             this->stamp = other.stamp;
+            this->framed = other.framed;
+            this->validated = other.validated;
             this->type = other.type;
-            this->message = other.message;
+            this->message = std::move(other.message);
         }
         return *this;
     }
 };
 
-template <typename T>
-class ConcurrentQueue
+namespace queue_policy {
+    enum QueuePolicy
+    {
+        //! Producer waits until the consumer has made room
+        BLOCK,
+        //! Oldest queued telegram is discarded to make room
+        DROP_OLDEST,
+        //! Incoming low-priority SBF blocks and NMEA are discarded, otherwise the
+        //! oldest queued telegram
+        DROP_BY_PRIORITY
+    };
+}
+
+/**
+ * @class TelegramQueue
+ * @brief Bounded ring of telegrams between the I/O threads and the processing
+ * thread
+ *
+ * Data telegrams (SBF, NMEA and unknown strings) go into a lock-free ring with
+ * per-slot sequence numbers, so producers and consumer only share two padded
+ * indices. The ring tolerates more than one producer since TCP/UDP stream clients
+ * may feed it next to the main connection. Control telegrams (responses,
+ * connection descriptors and the shutdown telegram) are never dropped, as
+ * command handling waits for them, and bypass the ring in a small locked queue.
+ * Threads only block on a condition variable once there is nothing to do.
+ */
+class TelegramQueue
 {
 public:
+    TelegramQueue(size_t capacity = TELEGRAM_QUEUE_CAPACITY,
+                  queue_policy::QueuePolicy policy = queue_policy::BLOCK);
+    /**
+     * @brief Sets capacity and overflow policy, must not be called while the
+     * queue is in use
+     * @param[in] capacity Maximum number of data telegrams, rounded up to the next
+     * power of two
+     * @param[in] policy Overflow policy
+     */
+    void configure(size_t capacity, queue_policy::QueuePolicy policy);
+    /**
+     * @brief Sets a function called after each push, for a consumer that is
+     * scheduled instead of waiting in pop_all(). Must not be called while the
+     * queue is in use.
+     * @param[in] notifier Function to be called, must not block
+     */
+    void setNotifier(std::function<void()> notifier);
     [[nodiscard]] bool empty() const noexcept;
     [[nodiscard]] size_t size() const noexcept;
-    void push(const T& input) noexcept;
-    void pop(T& output) noexcept;
+    void push(std::shared_ptr<Telegram>&& telegram) noexcept;
+    //! Pushes all elements of input and clears it
+    void push_all(std::vector<std::shared_ptr<Telegram>>& input) noexcept;
+    template <typename... Args>
+    void emplace(Args&&... args) noexcept;
+    //! Waits for data and moves all queued elements to output
+    void pop_all(std::vector<std::shared_ptr<Telegram>>& output) noexcept;
+    //! Moves all queued elements to output if there are any, does not wait
+    [[nodiscard]] bool
+    try_pop_all(std::vector<std::shared_ptr<Telegram>>& output) noexcept;
+    //! Releases waiting producers, afterwards data telegrams are dropped instead
+    //! of blocking
+    void close() noexcept;
+    //! Capacity of the ring
+    [[nodiscard]] size_t capacity() const noexcept;
+    //! Highest number of data telegrams queued at once
+    [[nodiscard]] size_t highWaterMark() const noexcept;
+    //! Number of data telegrams dropped due to overflow
+    [[nodiscard]] uint64_t dropped() const noexcept;
 
 private:
-    std::queue<T> queue_;
-    std::condition_variable cond_;
-    mutable std::mutex mtx_;
+    struct alignas(CACHE_LINE_SIZE) Slot
+    {
+        std::atomic<size_t> sequence;
+        std::shared_ptr<Telegram> telegram;
+    };
+
+    [[nodiscard]] static bool isControl(const Telegram& telegram) noexcept;
+    [[nodiscard]] static bool isHighPriority(const Telegram& telegram) noexcept;
+    [[nodiscard]] size_t depth() const noexcept;
+    //! Moves telegram into the ring if there is room
+    [[nodiscard]] bool tryEnqueue(std::shared_ptr<Telegram>& telegram) noexcept;
+    //! Moves the oldest telegram out of the ring if there is one
+    [[nodiscard]] bool tryDequeue(std::shared_ptr<Telegram>& telegram) noexcept;
+    [[nodiscard]] bool drain(std::vector<std::shared_ptr<Telegram>>& output) noexcept;
+    void waitNotFull() noexcept;
+    void notifyConsumer() noexcept;
+    void notifyProducers() noexcept;
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_ = 0;
+    queue_policy::QueuePolicy policy_;
+    //! Next position to be written by a producer
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueuePos_;
+    //! Next position to be read by the consumer
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeuePos_;
+
+    alignas(CACHE_LINE_SIZE) std::queue<std::shared_ptr<Telegram>> control_;
+    std::atomic<size_t> controlCount_;
+    std::mutex controlMtx_;
+
+    std::mutex mtx_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    std::atomic<bool> consumerWaiting_;
+    std::atomic<size_t> producersWaiting_;
+    std::atomic<bool> closed_;
+    std::function<void()> notifier_;
+
+    std::atomic<size_t> highWaterMark_;
+    std::atomic<uint64_t> dropped_;
 };
 
-template <typename T>
-[[nodiscard]] bool ConcurrentQueue<T>::empty() const noexcept
+inline TelegramQueue::TelegramQueue(size_t capacity,
+                                    queue_policy::QueuePolicy policy) :
+    policy_(policy), enqueuePos_(0), dequeuePos_(0), controlCount_(0),
+    consumerWaiting_(false), producersWaiting_(0), closed_(false),
+    highWaterMark_(0), dropped_(0)
 {
-    std::lock_guard<std::mutex> lck(mtx_);
-    return queue_.empty();
+    configure(capacity, policy);
 }
 
-template <typename T>
-[[nodiscard]] size_t ConcurrentQueue<T>::size() const noexcept
+inline void TelegramQueue::configure(size_t capacity,
+                                     queue_policy::QueuePolicy policy)
 {
-    std::lock_guard<std::mutex> lck(mtx_);
-    return queue_.size();
+    size_t size = 2;
+    while (size < capacity)
+        size <<= 1;
+
+    slots_.reset(new Slot[size]);
+    for (size_t i = 0; i < size; ++i)
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    mask_ = size - 1;
+    policy_ = policy;
+    enqueuePos_.store(0, std::memory_order_relaxed);
+    dequeuePos_.store(0, std::memory_order_relaxed);
+}
+
+inline void TelegramQueue::setNotifier(std::function<void()> notifier)
+{
+    notifier_ = std::move(notifier);
+}
+
+[[nodiscard]] inline bool TelegramQueue::empty() const noexcept
+{
+    return (controlCount_ == 0) && (depth() == 0);
+}
+
+[[nodiscard]] inline size_t TelegramQueue::size() const noexcept
+{
+    return controlCount_ + depth();
 }
 
-template <typename T>
-void ConcurrentQueue<T>::push(const T& input) noexcept
+inline void TelegramQueue::push(std::shared_ptr<Telegram>&& telegram) noexcept
 {
+    if (isControl(*telegram))
     {
-        std::lock_guard<std::mutex> lck(mtx_);
-        queue_.push(input);
+        {
+            std::lock_guard<std::mutex> lck(controlMtx_);
+            control_.push(std::move(telegram));
+            ++controlCount_;
+        }
+        notifyConsumer();
+        return;
+    }
+
+    while (!tryEnqueue(telegram))
+    {
+        switch (policy_)
+        {
+        case queue_policy::BLOCK:
+        {
+            if (closed_)
+            {
+                ++dropped_;
+                return;
+            }
+            waitNotFull();
+            break;
+        }
+        case queue_policy::DROP_BY_PRIORITY:
+        {
+            if (!isHighPriority(*telegram))
+            {
+                ++dropped_;
+                return;
+            }
+            [[fallthrough]];
+        }
+        case queue_policy::DROP_OLDEST:
+        {
+            std::shared_ptr<Telegram> oldest;
+            if (tryDequeue(oldest))
+                ++dropped_;
+            break;
+        }
+        }
     }
-    cond_.notify_one();
+
+    size_t currentDepth = depth();
+    size_t highWaterMark = highWaterMark_.load(std::memory_order_relaxed);
+    while ((currentDepth > highWaterMark) &&
+           !highWaterMark_.compare_exchange_weak(highWaterMark, currentDepth,
+                                                 std::memory_order_relaxed))
+        ;
+
+    notifyConsumer();
+}
+
+inline void
+TelegramQueue::push_all(std::vector<std::shared_ptr<Telegram>>& input) noexcept
+{
+    for (auto& telegram : input)
+        push(std::move(telegram));
+    input.clear();
+}
+
+template <typename... Args>
+void TelegramQueue::emplace(Args&&... args) noexcept
+{
+    push(std::make_shared<Telegram>(std::forward<Args>(args)...));
+}
+
+inline void
+TelegramQueue::pop_all(std::vector<std::shared_ptr<Telegram>>& output) noexcept
+{
+    static const size_t SPIN_COUNT = 64;
+    while (true)
+    {
+        for (size_t i = 0; i < SPIN_COUNT; ++i)
+        {
+            if (drain(output))
+                return;
+            std::this_thread::yield();
+        }
+
+        std::unique_lock<std::mutex> lck(mtx_);
+        consumerWaiting_ = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        notEmpty_.wait(lck, [this] { return !empty(); });
+        consumerWaiting_ = false;
+    }
+}
+
+[[nodiscard]] inline bool
+TelegramQueue::try_pop_all(std::vector<std::shared_ptr<Telegram>>& output) noexcept
+{
+    return drain(output);
 }
 
-template <typename T>
-void ConcurrentQueue<T>::pop(T& output) noexcept
+inline void TelegramQueue::close() noexcept
+{
+    closed_ = true;
+    notifyProducers();
+}
+
+[[nodiscard]] inline size_t TelegramQueue::capacity() const noexcept
+{
+    return mask_ + 1;
+}
+
+[[nodiscard]] inline size_t TelegramQueue::highWaterMark() const noexcept
+{
+    return highWaterMark_;
+}
+
+[[nodiscard]] inline uint64_t TelegramQueue::dropped() const noexcept
+{
+    return dropped_;
+}
+
+[[nodiscard]] inline bool TelegramQueue::isControl(const Telegram& telegram) noexcept
+{
+    switch (telegram.type)
+    {
+    case telegram_type::SBF:
+    case telegram_type::NMEA:
+    case telegram_type::NMEA_INS:
+    case telegram_type::UNKNOWN:
+        return false;
+    default:
+        return true;
+    }
+}
+
+/**
+ * High priority are the SBF blocks feeding the navigation solution (PVT, INS,
+ * attitude, covariances and time), everything else, e.g. measurement, status
+ * blocks and NMEA, may be dropped first.
+ */
+[[nodiscard]] inline bool
+TelegramQueue::isHighPriority(const Telegram& telegram) noexcept
+{
+    if (telegram.type != telegram_type::SBF)
+        return false;
+
+    switch (parsing_utilities::getId(telegram.message))
+    {
+    case 4006: // PVTCartesian
+    case 4007: // PVTGeodetic
+    case 4225: // INSNavCart
+    case 4226: // INSNavGeod
+    case 4229: // ExtEventINSNavCart
+    case 4230: // ExtEventINSNavGeod
+    case 4050: // ExtSensorMeas
+    case 5905: // PosCovCartesian
+    case 5906: // PosCovGeodetic
+    case 5907: // VelCovCartesian
+    case 5908: // VelCovGeodetic
+    case 5938: // AttEuler
+    case 5939: // AttCovEuler
+    case 5914: // ReceiverTime
+        return true;
+    default:
+        return false;
+    }
+}
+
+[[nodiscard]] inline size_t TelegramQueue::depth() const noexcept
+{
+    // Reading the consumer index first guarantees enqueue >= dequeue
+    size_t dequeuePos = dequeuePos_.load(std::memory_order_acquire);
+    size_t enqueuePos = enqueuePos_.load(std::memory_order_acquire);
+    return std::min(enqueuePos - dequeuePos, mask_ + 1);
+}
+
+[[nodiscard]] inline bool
+TelegramQueue::tryEnqueue(std::shared_ptr<Telegram>& telegram) noexcept
+{
+    Slot* slot;
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    while (true)
+    {
+        slot = &slots_[pos & mask_];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff =
+            static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0)
+        {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1,
+                                                  std::memory_order_relaxed))
+                break;
+        } else if (diff < 0)
+            return false;
+        else
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+    }
+    slot->telegram = std::move(telegram);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+[[nodiscard]] inline bool
+TelegramQueue::tryDequeue(std::shared_ptr<Telegram>& telegram) noexcept
+{
+    Slot* slot;
+    size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+    while (true)
+    {
+        slot = &slots_[pos & mask_];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff =
+            static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0)
+        {
+            if (dequeuePos_.compare_exchange_weak(pos, pos + 1,
+                                                  std::memory_order_relaxed))
+                break;
+        } else if (diff < 0)
+            return false;
+        else
+            pos = dequeuePos_.load(std::memory_order_relaxed);
+    }
+    telegram = std::move(slot->telegram);
+    slot->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+}
+
+[[nodiscard]] inline bool
+TelegramQueue::drain(std::vector<std::shared_ptr<Telegram>>& output) noexcept
+{
+    size_t initialSize = output.size();
+    if (controlCount_ != 0)
+    {
+        std::lock_guard<std::mutex> lck(controlMtx_);
+        while (!control_.empty())
+        {
+            output.push_back(std::move(control_.front()));
+            control_.pop();
+        }
+        controlCount_ = 0;
+    }
+
+    std::shared_ptr<Telegram> telegram;
+    while (tryDequeue(telegram))
+        output.push_back(std::move(telegram));
+
+    if (output.size() == initialSize)
+        return false;
+
+    notifyProducers();
+    return true;
+}
+
+inline void TelegramQueue::waitNotFull() noexcept
 {
     std::unique_lock<std::mutex> lck(mtx_);
-    cond_.wait(lck, [this] { return !queue_.empty(); });
-    output = queue_.front();
-    queue_.pop();
+    ++producersWaiting_;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    notFull_.wait(lck, [this] { return (depth() <= mask_) || closed_; });
+    --producersWaiting_;
+}
+
+inline void TelegramQueue::notifyConsumer() noexcept
+{
+    if (notifier_)
+    {
+        notifier_();
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumerWaiting_)
+    {
+        {
+            std::lock_guard<std::mutex> lck(mtx_);
+        }
+        notEmpty_.notify_one();
+    }
 }
 
-typedef ConcurrentQueue<std::shared_ptr<Telegram>> TelegramQueue;
\ No newline at end of file
+inline void TelegramQueue::notifyProducers() noexcept
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (producersWaiting_ != 0)
+    {
+        {
+            std::lock_guard<std::mutex> lck(mtx_);
+        }
+        notFull_.notify_all();
+    }
+}
+
+/**
+ * @class TelegramPool
+ * @brief Bounded pool of recyclable telegrams
+ *
+ * Telegrams handed back after processing keep their allocated message buffer, so in
+ * steady state framing a message does not allocate. If the pool runs empty a new
+ * telegram is allocated, if it is full recycled telegrams are freed.
+ */
+class TelegramPool
+{
+public:
+    TelegramPool(size_t capacity = TELEGRAM_POOL_CAPACITY);
+    /**
+     * @brief Gets an empty telegram, reused from the pool if available
+     * @param[in] preallocate Size of the message of the telegram
+     * @return Telegram
+     */
+    [[nodiscard]] std::shared_ptr<Telegram> acquire(size_t preallocate = 3);
+    /**
+     * @brief Hands telegram back to the pool. It is only reused if the caller holds
+     * the last reference.
+     * @param[in] telegram Telegram no longer needed
+     */
+    void recycle(std::shared_ptr<Telegram>&& telegram);
+    //! Number of telegrams served from the pool
+    [[nodiscard]] uint64_t hits() const noexcept;
+    //! Number of telegrams that had to be allocated
+    [[nodiscard]] uint64_t misses() const noexcept;
+
+private:
+    std::vector<std::shared_ptr<Telegram>> pool_;
+    size_t capacity_;
+    std::mutex mtx_;
+    std::atomic<uint64_t> hits_;
+    std::atomic<uint64_t> misses_;
+};
+
+inline TelegramPool::TelegramPool(size_t capacity) :
+    capacity_(capacity), hits_(0), misses_(0)
+{
+    pool_.reserve(capacity_);
+}
+
+[[nodiscard]] inline std::shared_ptr<Telegram>
+TelegramPool::acquire(size_t preallocate)
+{
+    std::shared_ptr<Telegram> telegram;
+    {
+        std::lock_guard<std::mutex> lck(mtx_);
+        if (!pool_.empty())
+        {
+            telegram = std::move(pool_.back());
+            pool_.pop_back();
+        }
+    }
+
+    if (telegram)
+    {
+        ++hits_;
+        telegram->stamp = 0;
+        telegram->framed = 0;
+        telegram->validated = 0;
+        telegram->type = telegram_type::EMPTY;
+        telegram->message.resize(preallocate);
+    } else
+    {
+        ++misses_;
+        telegram = std::make_shared<Telegram>(preallocate);
+    }
+    return telegram;
+}
+
+inline void TelegramPool::recycle(std::shared_ptr<Telegram>&& telegram)
+{
+    if (!telegram || (telegram.use_count() != 1))
+    {
+        telegram.reset();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lck(mtx_);
+    if (pool_.size() < capacity_)
+        pool_.push_back(std::move(telegram));
+    else
+        telegram.reset();
+}
+
+[[nodiscard]] inline uint64_t TelegramPool::hits() const noexcept { return hits_; }
+
+[[nodiscard]] inline uint64_t TelegramPool::misses() const noexcept
+{
+    return misses_;
+}
\ No newline at end of file
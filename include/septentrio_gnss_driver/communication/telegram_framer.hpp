@@ -0,0 +1,498 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+
+// ROSaic, no ROS dependencies so that framing can be used without ROS
+#include <septentrio_gnss_driver/abstraction/timestamp.hpp>
+#include <septentrio_gnss_driver/communication/telegram.hpp>
+#include <septentrio_gnss_driver/crc/crc.hpp>
+
+/**
+ * @file telegram_framer.hpp
+ * @brief Extracts SBF blocks, NMEA sentences, command replies and connection
+ * descriptors from a byte stream
+ */
+
+namespace io {
+
+    //! Ways the framer loses sync
+    namespace framing_error {
+        enum FramingError
+        {
+            SYNC_BYTE_2,
+            SYNC_BYTE_3,
+            SBF_LENGTH,
+            SYNC_BYTE_1_IN_STRING,
+            LF_WITHOUT_CR
+        };
+    } // namespace framing_error
+
+    /**
+     * @class TelegramSink
+     * @brief Receives the telegrams and the errors of a TelegramFramer
+     */
+    class TelegramSink
+    {
+    public:
+        virtual ~TelegramSink() {}
+
+        /**
+         * @brief Takes over a complete telegram, SBF blocks have passed the CRC
+         * check
+         * @param[in] telegram Telegram
+         */
+        virtual void onTelegram(std::shared_ptr<Telegram>&& telegram) = 0;
+
+        /**
+         * @brief Called for SBF blocks failing the CRC check, which are dropped
+         * @param[in] telegram The SBF block
+         */
+        virtual void onCrcFailure(const Telegram& /*telegram*/) {}
+
+        /**
+         * @brief Called whenever the framer loses sync, describe with
+         * TelegramFramer::describe() only if needed
+         * @param[in] error What went wrong
+         * @param[in] telegram The telegram being framed
+         */
+        virtual void onFramingError(framing_error::FramingError /*error*/,
+                                    const Telegram& /*telegram*/)
+        {
+        }
+    };
+
+    /**
+     * @class TelegramFramer
+     * @brief State machine framing telegrams from a byte stream. Each state
+     * consumes as many bytes as it can in one go, so SBF blocks and strings are
+     * copied in bulk and only sync bytes are inspected one by one. A telegram may
+     * span several chunks, the state is kept in between.
+     */
+    class TelegramFramer
+    {
+    public:
+        /**
+         * @brief Class constructor
+         * @param[in] sink Receiver of the telegrams, has to outlive the framer
+         * @param[in] telegramPool Pool telegrams are taken from
+         */
+        TelegramFramer(TelegramSink* sink, TelegramPool* telegramPool) :
+            sink_(sink), telegramPool_(telegramPool)
+        {
+        }
+
+        /**
+         * @brief Sets the transmission time per byte, so that telegrams are
+         * stamped with the time their first byte arrived
+         * @param[in] byteDuration Duration in nanoseconds, 0 to stamp all
+         * telegrams of a chunk alike
+         */
+        void setByteDuration(Timestamp byteDuration)
+        {
+            byteDuration_ = byteDuration;
+        }
+
+        /**
+         * @brief Stamps telegrams with the monotonic time of being framed and
+         * validated
+         * @param[in] instrumented Whether to stamp
+         */
+        void setInstrumented(bool instrumented) { instrumented_ = instrumented; }
+
+        //! Discards the current telegram and waits for the next sync byte
+        void resync()
+        {
+            telegramPool_->recycle(std::move(telegram_));
+            telegram_ = telegramPool_->acquire();
+            framerState_ = FramerState::SYNC_1;
+        }
+
+        /**
+         * @brief Runs a chunk of the stream through the framer
+         * @param[in] data Bytes of the chunk
+         * @param[in] numBytes Number of bytes of the chunk
+         * @param[in] stamp Time the last byte of the chunk was received
+         */
+        void frame(const uint8_t* data, std::size_t numBytes, Timestamp stamp);
+
+        /**
+         * @brief Describes a framing error for debugging
+         * @param[in] error What went wrong
+         * @param[in] telegram The telegram passed with the error
+         */
+        [[nodiscard]] static std::string
+        describe(framing_error::FramingError error, const Telegram& telegram);
+
+    private:
+        void frameSync1(uint8_t currByte);
+        void frameSync2(uint8_t currByte);
+        void frameSync3(uint8_t currByte);
+        [[nodiscard]] std::size_t frameSbf(const uint8_t* it, const uint8_t* end);
+        [[nodiscard]] std::size_t frameString(const uint8_t* it,
+                                              const uint8_t* end);
+        [[nodiscard]] static std::string toHex(uint8_t byte);
+
+        //! States of the framer
+        enum class FramerState
+        {
+            SYNC_1,
+            SYNC_2,
+            SYNC_3,
+            SBF_HEADER,
+            SBF_BLOCK,
+            STRING
+        };
+
+        //! Receiver of the telegrams
+        TelegramSink* sink_;
+        //! TelegramPool
+        TelegramPool* telegramPool_;
+        //! Transmission time per byte to back-date bytes of a chunk by, 0 if chunks
+        //! are stamped as a whole
+        Timestamp byteDuration_ = 0;
+        //! Whether telegrams are stamped with monotonic time
+        bool instrumented_ = false;
+        //! Timestamp of receiving the first byte of the current telegram
+        Timestamp recvStamp_ = 0;
+        //! Current state of the framer
+        FramerState framerState_ = FramerState::SYNC_1;
+        //! Number of bytes of the current SBF block already received
+        std::size_t sbfBytesReceived_ = 0;
+        //! Telegram
+        std::shared_ptr<Telegram> telegram_;
+    };
+
+    inline void TelegramFramer::frame(const uint8_t* data, std::size_t numBytes,
+                                      Timestamp stamp)
+    {
+        if (!telegram_)
+            resync();
+
+        const uint8_t* it = data;
+        const uint8_t* end = it + numBytes;
+
+        while (it != end)
+        {
+            switch (framerState_)
+            {
+            case FramerState::SYNC_1:
+            {
+                Timestamp backdate = (end - it - 1) * byteDuration_;
+                recvStamp_ = (stamp > backdate) ? (stamp - backdate) : stamp;
+                frameSync1(*it);
+                ++it;
+                break;
+            }
+            case FramerState::SYNC_2:
+            {
+                frameSync2(*it);
+                ++it;
+                break;
+            }
+            case FramerState::SYNC_3:
+            {
+                frameSync3(*it);
+                ++it;
+                break;
+            }
+            case FramerState::SBF_HEADER:
+            case FramerState::SBF_BLOCK:
+            {
+                it += frameSbf(it, end);
+                break;
+            }
+            case FramerState::STRING:
+            {
+                it += frameString(it, end);
+                break;
+            }
+            }
+        }
+    }
+
+    inline void TelegramFramer::frameSync1(uint8_t currByte)
+    {
+        telegram_->message[0] = currByte;
+        if (currByte == SYNC_BYTE_1)
+        {
+            telegram_->stamp = recvStamp_;
+            framerState_ = FramerState::SYNC_2;
+        } else
+        {
+            telegram_->type = telegram_type::UNKNOWN;
+            telegram_->message.resize(1);
+            telegram_->message.reserve(256);
+            framerState_ = FramerState::STRING;
+        }
+    }
+
+    inline void TelegramFramer::frameSync2(uint8_t currByte)
+    {
+        telegram_->message[1] = currByte;
+        switch (currByte)
+        {
+        case SYNC_BYTE_1:
+        {
+            telegram_->stamp = recvStamp_;
+            break;
+        }
+        case SBF_SYNC_BYTE_2:
+        {
+            telegram_->type = telegram_type::SBF;
+            telegram_->message.resize(SBF_HEADER_SIZE);
+            sbfBytesReceived_ = 2;
+            framerState_ = FramerState::SBF_HEADER;
+            break;
+        }
+        case NMEA_SYNC_BYTE_2:
+        {
+            telegram_->type = telegram_type::NMEA;
+            framerState_ = FramerState::SYNC_3;
+            break;
+        }
+        case NMEA_INS_SYNC_BYTE_2:
+        {
+            telegram_->type = telegram_type::NMEA_INS;
+            framerState_ = FramerState::SYNC_3;
+            break;
+        }
+        case RESPONSE_SYNC_BYTE_2:
+        {
+            telegram_->type = telegram_type::RESPONSE;
+            framerState_ = FramerState::SYNC_3;
+            break;
+        }
+        default:
+        {
+            sink_->onFramingError(framing_error::SYNC_BYTE_2, *telegram_);
+            resync();
+            break;
+        }
+        }
+    }
+
+    inline void TelegramFramer::frameSync3(uint8_t currByte)
+    {
+        telegram_->message[2] = currByte;
+        bool valid = false;
+        switch (currByte)
+        {
+        case SYNC_BYTE_1:
+        {
+            telegram_->message[0] = currByte;
+            telegram_->stamp = recvStamp_;
+            framerState_ = FramerState::SYNC_2;
+            return;
+        }
+        case NMEA_SYNC_BYTE_3:
+        {
+            valid = (telegram_->type == telegram_type::NMEA);
+            break;
+        }
+        case NMEA_INS_SYNC_BYTE_3:
+        {
+            valid = (telegram_->type == telegram_type::NMEA_INS);
+            break;
+        }
+        case RESPONSE_SYNC_BYTE_3:
+        case RESPONSE_SYNC_BYTE_3a:
+        {
+            valid = (telegram_->type == telegram_type::RESPONSE);
+            break;
+        }
+        case ERROR_SYNC_BYTE_3:
+        {
+            valid = (telegram_->type == telegram_type::RESPONSE);
+            if (valid)
+                telegram_->type = telegram_type::ERROR_RESPONSE;
+            break;
+        }
+        default:
+        {
+            sink_->onFramingError(framing_error::SYNC_BYTE_3, *telegram_);
+            break;
+        }
+        }
+
+        if (valid)
+        {
+            telegram_->message.resize(3);
+            telegram_->message.reserve(256);
+            framerState_ = FramerState::STRING;
+        } else
+            resync();
+    }
+
+    /**
+     * Copies as much of the SBF header or block as is available. Once the header is
+     * complete the block is resized to its announced length, once the block is
+     * complete its CRC is checked and the framer is resynced.
+     * @return Number of bytes consumed
+     */
+    [[nodiscard]] inline std::size_t TelegramFramer::frameSbf(const uint8_t* it,
+                                                              const uint8_t* end)
+    {
+        std::size_t numBytes =
+            std::min(static_cast<std::size_t>(end - it),
+                     telegram_->message.size() - sbfBytesReceived_);
+        std::copy(it, it + numBytes,
+                  telegram_->message.begin() + sbfBytesReceived_);
+        sbfBytesReceived_ += numBytes;
+
+        if (sbfBytesReceived_ < telegram_->message.size())
+            return numBytes;
+
+        if (framerState_ == FramerState::SBF_HEADER)
+        {
+            uint16_t length = parsing_utilities::getLength(telegram_->message);
+            if ((length < SBF_HEADER_SIZE) || (length > MAX_SBF_SIZE))
+            {
+                sink_->onFramingError(framing_error::SBF_LENGTH, *telegram_);
+                resync();
+                return numBytes;
+            }
+            telegram_->message.resize(length);
+            framerState_ = FramerState::SBF_BLOCK;
+            if (length > SBF_HEADER_SIZE)
+                return numBytes;
+        }
+
+        if (instrumented_)
+            telegram_->framed = steadyTime();
+        if (crc::isValid(telegram_->message))
+        {
+            if (instrumented_)
+                telegram_->validated = steadyTime();
+            sink_->onTelegram(std::move(telegram_));
+        } else
+            sink_->onCrcFailure(*telegram_);
+        resync();
+        return numBytes;
+    }
+
+    /**
+     * Appends all bytes up to the next character of interest at once. A sync byte 1
+     * within a string starts a new telegram, LF after CR terminates NMEA and
+     * responses, the connection descriptor footer terminates connection
+     * descriptors.
+     * @return Number of bytes consumed
+     */
+    [[nodiscard]] inline std::size_t
+    TelegramFramer::frameString(const uint8_t* it, const uint8_t* end)
+    {
+        const uint8_t* delimiter = std::find_if(it, end, [](uint8_t byte) {
+            return (byte == SYNC_BYTE_1) || (byte == LF) ||
+                   (byte == CONNECTION_DESCRIPTOR_FOOTER);
+        });
+        if (delimiter == end)
+        {
+            telegram_->message.insert(telegram_->message.end(), it, end);
+            return end - it;
+        }
+        telegram_->message.insert(telegram_->message.end(), it, delimiter + 1);
+
+        switch (*delimiter)
+        {
+        case SYNC_BYTE_1:
+        {
+            telegramPool_->recycle(std::move(telegram_));
+            telegram_ = telegramPool_->acquire();
+            telegram_->message[0] = *delimiter;
+            telegram_->stamp = recvStamp_;
+            sink_->onFramingError(framing_error::SYNC_BYTE_1_IN_STRING,
+                                  *telegram_);
+            framerState_ = FramerState::SYNC_2;
+            break;
+        }
+        case LF:
+        {
+            if (telegram_->message[telegram_->message.size() - 2] == CR)
+            {
+                if (instrumented_)
+                {
+                    telegram_->framed = steadyTime();
+                    telegram_->validated = telegram_->framed;
+                }
+                sink_->onTelegram(std::move(telegram_));
+            } else
+                sink_->onFramingError(framing_error::LF_WITHOUT_CR, *telegram_);
+            resync();
+            break;
+        }
+        case CONNECTION_DESCRIPTOR_FOOTER:
+        {
+            telegram_->type = telegram_type::CONNECTION_DESCRIPTOR;
+            sink_->onTelegram(std::move(telegram_));
+            resync();
+            break;
+        }
+        }
+        return (delimiter + 1) - it;
+    }
+
+    [[nodiscard]] inline std::string TelegramFramer::toHex(uint8_t byte)
+    {
+        std::stringstream ss;
+        ss << std::hex << static_cast<uint32_t>(byte);
+        return ss.str();
+    }
+
+    [[nodiscard]] inline std::string
+    TelegramFramer::describe(framing_error::FramingError error,
+                             const Telegram& telegram)
+    {
+        switch (error)
+        {
+        case framing_error::SYNC_BYTE_2:
+            return "sync byte 2 read fault, should never come here.. Received byte was " +
+                   toHex(telegram.message[1]);
+        case framing_error::SYNC_BYTE_3:
+            return "sync byte 3 read fault, should never come here. Received byte was " +
+                   toHex(telegram.message[2]);
+        case framing_error::SBF_LENGTH:
+            return "SBF header read fault, invalid length of block: " +
+                   std::to_string(parsing_utilities::getLength(telegram.message));
+        case framing_error::SYNC_BYTE_1_IN_STRING:
+            return "string read fault, sync 1 found.";
+        case framing_error::LF_WITHOUT_CR:
+            return "LF wo CR: " +
+                   std::string(telegram.message.begin(), telegram.message.end());
+        }
+        return std::string();
+    }
+} // namespace io
@@ -63,6 +63,7 @@
 
 // ROSaic includes
 #include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+#include <septentrio_gnss_driver/communication/command_pipeline.hpp>
 #include <septentrio_gnss_driver/communication/message_handler.hpp>
 #include <septentrio_gnss_driver/communication/telegram.hpp>
 
@@ -95,6 +96,16 @@ namespace io {
             block_ = true;
         }
 
+        //! @return Whether notified before the timeout passed
+        [[nodiscard]] bool waitFor(std::chrono::milliseconds timeout)
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            if (!cv_.wait_for(lock, timeout, [this] { return !block_; }))
+                return false;
+            block_ = true;
+            return true;
+        }
+
     private:
         std::mutex mtx_;
         std::condition_variable cv_;
@@ -115,13 +126,49 @@ namespace io {
         ~TelegramHandler()
         {
             cdSemaphore_.notify();
-            responseSemaphore_.notify();
+            commands_.clear();
         }
 
         void clearSemaphores()
         {
             cdSemaphore_.notify();
-            responseSemaphore_.notify();
+            commands_.clear();
+        }
+
+        //! Determines which SBF blocks have to be parsed, call once settings are
+        //! loaded
+        void setupSbfConsumers() { messageHandler_.setupSbfConsumers(); }
+
+        //! Registers the outputs combining blocks of an epoch, call once settings
+        //! are loaded
+        void setupEpochAggregator() { messageHandler_.setupEpochAggregator(); }
+
+        //! Discards the epochs aggregated so far, call after reconnecting
+        void resetEpochs() { messageHandler_.resetEpochs(); }
+
+        //! Advertises the enabled topics, call once settings are loaded
+        void advertiseTopics() { messageHandler_.advertiseTopics(); }
+
+        //! Starts the publishing threads, call once settings are loaded
+        void startPublishPipeline() { messageHandler_.startPublishPipeline(); }
+
+        //! Number of messages dropped since the publish pipeline lagged behind
+        [[nodiscard]] uint64_t publishDropped() const
+        {
+            return messageHandler_.publishDropped();
+        }
+
+        //! Measures publication latencies, call before processing starts
+        void setStatistics(LatencyStatistics* statistics)
+        {
+            messageHandler_.setStatistics(statistics);
+        }
+
+        //! Publishes and resets the latency statistics
+        void publishStatistics(LatencyStatistics& statistics,
+                               const TelegramQueue& telegramQueue)
+        {
+            messageHandler_.publishStatistics(statistics, telegramQueue);
         }
 
         /**
@@ -139,8 +186,22 @@ namespace io {
             return mainConnectionDescriptor_;
         }
 
-        //! Waits for response
-        void waitForResponse() { responseSemaphore_.wait(); }
+        //! Commands sent to the Rx and waiting for their reply
+        [[nodiscard]] CommandPipeline& commands() { return commands_; }
+
+        /**
+         * @brief Captures the next message of the Rx containing the keyword, call
+         * before sending the query it answers
+         * @param[in] keyword Keyword identifying the message
+         */
+        void expectMessage(const std::string& keyword);
+
+        /**
+         * @brief Waits for the message registered by expectMessage()
+         * @param[in] timeout Time to wait for the message
+         * @return The message, empty if it did not arrive in time
+         */
+        [[nodiscard]] std::string waitForMessage(std::chrono::milliseconds timeout);
 
         //! Waits for capabilities
         void waitForCapabilities() { capabilitiesSemaphore_.wait(); }
@@ -158,9 +219,16 @@ namespace io {
         MessageHandler messageHandler_;
 
         Semaphore cdSemaphore_;
-        Semaphore responseSemaphore_;
         Semaphore capabilitiesSemaphore_;
         std::string mainConnectionDescriptor_ = std::string();
+
+        //! Commands in flight
+        CommandPipeline commands_;
+        //! Message expected by expectMessage() and its guard
+        std::mutex messageMutex_;
+        Semaphore messageSemaphore_;
+        std::string messageKeyword_;
+        std::string message_;
     };
 
 } // namespace io
\ No newline at end of file
@@ -0,0 +1,183 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <algorithm>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Boost
+#include <boost/asio.hpp>
+
+/**
+ * @file thread_pool.hpp
+ * @brief Threads shared by several receivers and the serialization of the
+ * handlers of each of them
+ */
+
+namespace io {
+
+    /**
+     * @class ThreadPool
+     * @brief Runs one io_service on a fixed number of threads until destruction,
+     * so that the I/O or processing of several receivers does not need threads of
+     * their own. Has to outlive all users of the io_service.
+     */
+    class ThreadPool
+    {
+    public:
+        /**
+         * @brief Starts the threads
+         * @param[in] threads Number of threads, at least one is started
+         */
+        explicit ThreadPool(std::size_t threads) :
+            ioService_(new boost::asio::io_service),
+            work_(boost::asio::make_work_guard(*ioService_))
+        {
+            for (std::size_t i = 0; i < std::max<std::size_t>(threads, 1); ++i)
+                threads_.emplace_back([this]() { ioService_->run(); });
+        }
+
+        ~ThreadPool()
+        {
+            work_.reset();
+            ioService_->stop();
+            for (auto& thread : threads_)
+                thread.join();
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        //! @return The io_service run by the threads
+        [[nodiscard]] std::shared_ptr<boost::asio::io_service> ioService() const
+        {
+            return ioService_;
+        }
+
+        //! @return Number of threads
+        [[nodiscard]] std::size_t size() const { return threads_.size(); }
+
+    private:
+        std::shared_ptr<boost::asio::io_service> ioService_;
+        boost::asio::executor_work_guard<boost::asio::io_service::executor_type>
+            work_;
+        std::vector<std::thread> threads_;
+    };
+
+    /**
+     * @class HandlerGroup
+     * @brief Runs the handlers of one user of an io_service one at a time, also if
+     * the io_service is run by several threads, and counts the handlers not yet
+     * run. A user of a shared io_service waits for them with drain() before it is
+     * destroyed, as the io_service keeps running for the others.
+     */
+    class HandlerGroup
+    {
+    public:
+        explicit HandlerGroup(boost::asio::io_service& ioService) :
+            strand_(ioService)
+        {
+        }
+
+        /**
+         * @brief Wraps a completion handler, to be passed to an asynchronous
+         * operation right away
+         * @param[in] handler Handler to be run in the group
+         */
+        template <typename Handler>
+        [[nodiscard]] auto wrap(Handler&& handler)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++outstanding_;
+            }
+            return boost::asio::bind_executor(
+                strand_, [this, handler = std::forward<Handler>(handler)](
+                             auto&&... args) mutable {
+                    handler(std::forward<decltype(args)>(args)...);
+                    finished();
+                });
+        }
+
+        /**
+         * @brief Runs a function in the group without waiting for it
+         * @param[in] function Function to be run
+         */
+        template <typename Function>
+        void post(Function&& function)
+        {
+            boost::asio::post(wrap(std::forward<Function>(function)));
+        }
+
+        /**
+         * @brief Runs a function in the group and waits for it, the io_service has
+         * to be run by another thread
+         * @param[in] function Function to be run
+         */
+        template <typename Function>
+        void run(Function&& function)
+        {
+            std::promise<void> done;
+            post([&function, &done]() {
+                function();
+                done.set_value();
+            });
+            done.get_future().wait();
+        }
+
+        //! Waits until all handlers wrapped so far have been run
+        void drain()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            drained_.wait(lock, [this]() { return outstanding_ == 0; });
+        }
+
+    private:
+        void finished()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--outstanding_ == 0)
+                drained_.notify_all();
+        }
+
+        boost::asio::io_service::strand strand_;
+        std::mutex mutex_;
+        std::condition_variable drained_;
+        //! Handlers wrapped but not yet run
+        std::size_t outstanding_ = 0;
+    };
+} // namespace io
@@ -0,0 +1,172 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <array>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @file topic_decimator.hpp
+ * @brief Limits the rate of topics on the host by dropping SBF blocks before they
+ * are parsed
+ */
+
+namespace io {
+
+    /**
+     * @class TopicDecimator
+     * @brief Decides per epoch, identified by WNc and TOW of the SBF blocks, which
+     * topics are published. A topic is due in the first epoch after its period
+     * has passed since the epoch it was last published in, so it carries the
+     * latest value available. All blocks and composite outputs of an epoch are
+     * decided alike and replays are decimated the same way as live data.
+     */
+    class TopicDecimator
+    {
+    public:
+        //! Topics as bit mask, bit i stands for topic i
+        typedef uint64_t TopicMask;
+
+        //! Maximum number of topics
+        static constexpr std::size_t MAX_TOPICS = 64;
+
+        /**
+         * @brief Sets the period of a topic
+         * @param[in] topic Topic to be decimated, < MAX_TOPICS
+         * @param[in] period Minimum period in ms between two epochs the topic is
+         * published in, 0 to publish every epoch
+         */
+        void configure(uint8_t topic, uint32_t period)
+        {
+            periods_[topic] = period;
+            if (period == 0)
+                decimated_ &= ~bit(topic);
+            else
+                decimated_ |= bit(topic);
+            reset();
+        }
+
+        //! Whether any topic is decimated
+        [[nodiscard]] bool active() const { return decimated_ != 0; }
+
+        /**
+         * @brief To be called for every SBF block before it is parsed. Decides
+         * which topics are due if the block starts a new epoch. Blocks with
+         * do-not-use TOW or WNc are attributed to the current epoch.
+         * @param[in] tow TOW of the block in ms
+         * @param[in] wnc WNc of the block
+         */
+        void begin(uint32_t tow, uint16_t wnc)
+        {
+            if ((decimated_ == 0) || (tow == 4294967295UL) || (wnc == 65535))
+                return;
+            uint64_t epoch = static_cast<uint64_t>(wnc) * MS_PER_WEEK + tow;
+            if (epoch == epoch_)
+                return;
+            if (epoch < epoch_)
+            {
+                // Late block, e.g. an external event
+                if ((epoch_ - epoch) < MAX_LATENESS)
+                    return;
+                // Time jumped back, e.g. a log was restarted
+                last_.fill(NEVER);
+            }
+            epoch_ = epoch;
+
+            due_ = ~decimated_;
+            for (std::size_t topic = 0; topic < MAX_TOPICS; ++topic)
+            {
+                if (((decimated_ & bit(topic)) != 0) &&
+                    ((last_[topic] == NEVER) ||
+                     ((epoch - last_[topic]) >= periods_[topic])))
+                    due_ |= bit(topic);
+            }
+        }
+
+        /**
+         * @brief Whether any of the topics is due in the current epoch
+         * @param[in] topics Topics as mask
+         */
+        [[nodiscard]] bool due(TopicMask topics) const
+        {
+            return (topics & due_) != 0;
+        }
+
+        /**
+         * @brief Checks whether a topic is due in the current epoch and, if so,
+         * marks it as published
+         * @param[in] topic Topic to be published
+         * @return Whether the topic shall be published
+         */
+        [[nodiscard]] bool publish(uint8_t topic)
+        {
+            if ((due_ & bit(topic)) == 0)
+                return false;
+            if ((decimated_ & bit(topic)) != 0)
+                last_[topic] = epoch_;
+            return true;
+        }
+
+        //! Makes all topics due until the next epoch
+        void reset()
+        {
+            last_.fill(NEVER);
+            epoch_ = 0;
+            due_ = ~TopicMask(0);
+        }
+
+        //! Bit of a topic in a mask
+        [[nodiscard]] static constexpr TopicMask bit(uint8_t topic)
+        {
+            return TopicMask(1) << topic;
+        }
+
+    private:
+        static constexpr uint64_t MS_PER_WEEK = 604800000;
+        static constexpr uint64_t NEVER = std::numeric_limits<uint64_t>::max();
+        //! Blocks older than the current epoch by less than this in ms are
+        //! attributed to it
+        static constexpr uint64_t MAX_LATENESS = 10000;
+
+        //! Minimum period in ms of each topic
+        std::array<uint32_t, MAX_TOPICS> periods_{};
+        //! Epoch in ms each topic was last published in
+        std::array<uint64_t, MAX_TOPICS> last_{};
+        //! Topics with a period
+        TopicMask decimated_ = 0;
+        //! Topics due in the current epoch
+        TopicMask due_ = ~TopicMask(0);
+        //! Current epoch in ms since the start of GPS time
+        uint64_t epoch_ = 0;
+    };
+} // namespace io
@@ -0,0 +1,175 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Boost
+#include <boost/asio/buffer.hpp>
+
+/**
+ * @file write_queue.hpp
+ * @brief Outbound data of a connection, written in order of priority
+ */
+
+namespace write_priority {
+    //! Priority of outbound data, lower values are written first
+    enum WritePriority : uint8_t
+    {
+        //! Corrections, their latency directly affects the RTK fix
+        RTCM = 0,
+        //! Velocity aiding
+        VELOCITY = 1,
+        //! Configuration commands
+        COMMAND = 2,
+        COUNT = 3
+    };
+} // namespace write_priority
+
+namespace io {
+
+    /**
+     * @struct OutboundBuffer
+     * @brief Data to be written, kept alive by its owner until written
+     */
+    struct OutboundBuffer
+    {
+        OutboundBuffer(std::shared_ptr<const void> owner, const void* data,
+                       std::size_t size, write_priority::WritePriority priority) :
+            owner(std::move(owner)),
+            buffer(data, size), priority(priority)
+        {
+        }
+
+        /**
+         * @brief Moves a string into a buffer of its own
+         * @param[in] data String to be written
+         * @param[in] priority Priority of the string
+         */
+        [[nodiscard]] static OutboundBuffer
+        fromString(std::string data, write_priority::WritePriority priority)
+        {
+            auto owner = std::make_shared<const std::string>(std::move(data));
+            return OutboundBuffer(owner, owner->data(), owner->size(), priority);
+        }
+
+        //! Keeps the data alive
+        std::shared_ptr<const void> owner;
+        //! Data to be written
+        boost::asio::const_buffer buffer;
+        write_priority::WritePriority priority;
+    };
+
+    /**
+     * @class WriteQueue
+     * @brief Collects the outbound data of a connection, so that it is written by
+     * one write at a time and partial writes never interleave. All data pending
+     * when the previous write completes is gathered into the next one, higher
+     * priorities first and in order of pushing within a priority. Not thread-safe,
+     * to be used from the I/O thread only.
+     */
+    class WriteQueue
+    {
+    public:
+        //! Maximum number of buffers gathered into one write
+        static constexpr std::size_t MAX_GATHER = 64;
+
+        void push(OutboundBuffer&& data)
+        {
+            pending_[data.priority].push_back(std::move(data));
+        }
+
+        //! Whether data is waiting to be gathered
+        [[nodiscard]] bool pending() const
+        {
+            for (const auto& queue : pending_)
+            {
+                if (!queue.empty())
+                    return true;
+            }
+            return false;
+        }
+
+        //! Whether gathered data is being written
+        [[nodiscard]] bool writing() const { return !inFlight_.empty(); }
+
+        /**
+         * @brief Takes the pending data in order of priority, it is in flight then
+         * until written() is called
+         * @return Buffers to be written at once
+         */
+        [[nodiscard]] const std::vector<boost::asio::const_buffer>& gather()
+        {
+            buffers_.clear();
+            for (auto& queue : pending_)
+            {
+                while (!queue.empty() && (inFlight_.size() < MAX_GATHER))
+                {
+                    buffers_.push_back(queue.front().buffer);
+                    inFlight_.push_back(std::move(queue.front()));
+                    queue.pop_front();
+                }
+            }
+            return buffers_;
+        }
+
+        //! Data gathered by the last call of gather()
+        [[nodiscard]] const std::vector<OutboundBuffer>& inFlight() const
+        {
+            return inFlight_;
+        }
+
+        //! Releases the data gathered by the last call of gather()
+        void written() { inFlight_.clear(); }
+
+        //! Discards all data, e.g. after the connection was lost
+        void clear()
+        {
+            for (auto& queue : pending_)
+                queue.clear();
+            inFlight_.clear();
+        }
+
+    private:
+        //! Data waiting to be gathered, one queue per priority
+        std::array<std::deque<OutboundBuffer>, write_priority::COUNT> pending_;
+        //! Data being written
+        std::vector<OutboundBuffer> inFlight_;
+        //! Buffers of the data being written
+        std::vector<boost::asio::const_buffer> buffers_;
+    };
+} // namespace io
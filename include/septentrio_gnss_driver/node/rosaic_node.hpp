@@ -90,7 +90,21 @@ namespace rosaic_node {
         //! The constructor initializes and runs the ROSaic node, if everything works
         //! fine. It loads the user-defined ROS parameters, subscribes to Rx
         //! messages, and publishes requested ROS messages...
-        ROSaicNode(const ros::NodeHandle& nh);
+        //! @param[in] nh Node handle for subscriptions
+        //! @param[in] pNh Private node handle for parameters and publications
+        //! @param[in] sharedPublishing Whether to publish shared pointers for
+        //! zero-copy delivery within the process
+        //! @param[in] ioPool Threads running the I/O of several receivers, nullptr
+        //! for threads of its own
+        //! @param[in] processingPool Threads processing the telegrams of several
+        //! receivers, nullptr for a thread of its own
+        //! @param[in] stop Set by the owner to stop connecting to an unreachable
+        //! Rx, e.g. on shutdown, nullptr to stop on ROS shutdown only
+        ROSaicNode(const ros::NodeHandle& nh,
+                   const ros::NodeHandle& pNh = ros::NodeHandle("~"),
+                   bool sharedPublishing = false, io::ThreadPool* ioPool = nullptr,
+                   io::ThreadPool* processingPool = nullptr,
+                   const std::atomic<bool>* stop = nullptr);
 
     private:
         /**
@@ -126,13 +140,14 @@ namespace rosaic_node {
         void getRPY(const QuaternionMsg& qm, double& roll, double& pitch,
                     double& yaw) const;
 
-        void sendVelocity(const std::string& velNmea);
+        void sendVelocity(std::string_view velNmea);
         /**
-         * @brief The callback for the rtcm msg
-         * 
-         * @param msg 
+         * @brief The callback for the rtcm msg, hands over its buffer without
+         * copying it
+         *
+         * @param msg
          */
-        void rtcmCallback(const rtcm_msgs::Message & msg);
+        void rtcmCallback(const rtcm_msgs::MessageConstPtr& msg);
         /**
          * @brief Subscriber to rctm msg
          * 
@@ -0,0 +1,245 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++ library includes
+#include <cmath>
+#include <cstdint>
+// Eigen Includes
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+// Boost includes
+#include <boost/math/constants/constants.hpp>
+
+/**
+ * @file local_frame_cache.hpp
+ * @brief Caches the rotations between the local ENU or NED frame and ECEF
+ */
+
+namespace parsing_utilities {
+
+    /**
+     * @class LocalFrameCache
+     * @brief Rotations between the local frame at a geodetic position and ECEF,
+     * same as q_enu_ecef(), q_ned_ecef(), R_enu_ecef() and R_ned_ecef(). They are
+     * reused while the position moves less than the tolerance. Larger steps,
+     * e.g. of a vehicle crossing the cell at high rates, advance the sines and
+     * cosines by angle addition instead of evaluating them anew, they are
+     * recomputed exactly after large jumps and every MAX_INCREMENTS steps.
+     */
+    class LocalFrameCache
+    {
+    public:
+        /**
+         * @brief Class constructor
+         * @param[in] tolerance Change of latitude and longitude in rad up to which
+         * the rotations are reused, default corresponds to about 6 cm
+         */
+        explicit LocalFrameCache(double tolerance = 1e-8) : tolerance_(tolerance)
+        {
+        }
+
+        /**
+         * @brief Sets the position of the local frame
+         * @param[in] lat Latitude in rad
+         * @param[in] lon Longitude in rad
+         * @return Whether the rotations changed
+         */
+        bool update(double lat, double lon)
+        {
+            const double dLat = lat - lat_.angle;
+            const double dLon = lon - lon_.angle;
+            if (valid_ && (std::abs(dLat) <= tolerance_) &&
+                (std::abs(dLon) <= tolerance_))
+                return false;
+
+            if (valid_ && (std::abs(dLat) <= MAX_STEP) &&
+                (std::abs(dLon) <= MAX_STEP) && (increments_ < MAX_INCREMENTS))
+            {
+                lat_.advance(dLat);
+                lon_.advance(dLon);
+                enuHalfLat_.advance(-dLat / 2.0);
+                enuHalfLon_.advance(dLon / 2.0);
+                nedHalfLat_.advance(-dLat / 2.0);
+                nedHalfLon_.advance(dLon / 2.0);
+                ++increments_;
+            } else
+            {
+                constexpr double pihalf = boost::math::constants::pi<double>() / 2.0;
+                lat_.set(lat);
+                lon_.set(lon);
+                enuHalfLat_.set((pihalf - lat) / 2.0);
+                enuHalfLon_.set((lon + pihalf) / 2.0);
+                nedHalfLat_.set((-lat - pihalf) / 2.0);
+                nedHalfLon_.set(lon / 2.0);
+                increments_ = 0;
+            }
+            valid_ = true;
+            computed_ = 0;
+            ++generation_;
+            return true;
+        }
+
+        //! Counts the changes of the rotations, to detect them by other caches
+        [[nodiscard]] uint64_t generation() const { return generation_; }
+
+        //! Rotation from ENU to ECEF as quaternion
+        [[nodiscard]] const Eigen::Quaterniond& q_enu_ecef()
+        {
+            if (!(computed_ & Q_ENU))
+            {
+                double sr = enuHalfLat_.sin;
+                double cr = enuHalfLat_.cos;
+                double sy = enuHalfLon_.sin;
+                double cy = enuHalfLon_.cos;
+                qEnu_ = Eigen::Quaterniond(cr * cy, sr * cy, sr * sy, cr * sy);
+                computed_ |= Q_ENU;
+            }
+            return qEnu_;
+        }
+
+        //! Rotation from NED to ECEF as quaternion
+        [[nodiscard]] const Eigen::Quaterniond& q_ned_ecef()
+        {
+            if (!(computed_ & Q_NED))
+            {
+                double sp = nedHalfLat_.sin;
+                double cp = nedHalfLat_.cos;
+                double sy = nedHalfLon_.sin;
+                double cy = nedHalfLon_.cos;
+                qNed_ = Eigen::Quaterniond(cp * cy, -sp * sy, sp * cy, cp * sy);
+                computed_ |= Q_NED;
+            }
+            return qNed_;
+        }
+
+        //! Rotation matrix from ENU to ECEF
+        [[nodiscard]] const Eigen::Matrix3d& R_enu_ecef()
+        {
+            if (!(computed_ & R_ENU))
+            {
+                REnu_(0, 0) = -lon_.sin;
+                REnu_(0, 1) = -lon_.cos * lat_.sin;
+                REnu_(0, 2) = lon_.cos * lat_.cos;
+                REnu_(1, 0) = lon_.cos;
+                REnu_(1, 1) = -lon_.sin * lat_.sin;
+                REnu_(1, 2) = lon_.sin * lat_.cos;
+                REnu_(2, 0) = 0.0;
+                REnu_(2, 1) = lat_.cos;
+                REnu_(2, 2) = lat_.sin;
+                computed_ |= R_ENU;
+            }
+            return REnu_;
+        }
+
+        //! Rotation matrix from NED to ECEF
+        [[nodiscard]] const Eigen::Matrix3d& R_ned_ecef()
+        {
+            if (!(computed_ & R_NED))
+            {
+                RNed_(0, 0) = -lon_.cos * lat_.sin;
+                RNed_(0, 1) = -lon_.sin;
+                RNed_(0, 2) = -lon_.cos * lat_.cos;
+                RNed_(1, 0) = -lon_.sin * lat_.sin;
+                RNed_(1, 1) = lon_.cos;
+                RNed_(1, 2) = -lon_.sin * lat_.cos;
+                RNed_(2, 0) = lat_.cos;
+                RNed_(2, 1) = 0.0;
+                RNed_(2, 2) = -lat_.sin;
+                computed_ |= R_NED;
+            }
+            return RNed_;
+        }
+
+        //! Largest step in rad advanced incrementally, about 6 km
+        static constexpr double MAX_STEP = 1e-3;
+        //! Incremental steps after which the rotations are recomputed exactly
+        static constexpr uint32_t MAX_INCREMENTS = 1000;
+
+    private:
+        //! Angle with its sine and cosine
+        struct SinCos
+        {
+            double angle = 0.0;
+            double sin = 0.0;
+            double cos = 1.0;
+
+            void set(double a)
+            {
+                angle = a;
+                sin = std::sin(a);
+                cos = std::cos(a);
+            }
+
+            //! Adds a small angle, its sine and cosine are taken from their
+            //! series, which are exact to double precision up to MAX_STEP
+            void advance(double delta)
+            {
+                const double d2 = delta * delta;
+                const double sd = delta * (1.0 - d2 / 6.0 * (1.0 - d2 / 20.0));
+                const double cd = 1.0 - d2 / 2.0 * (1.0 - d2 / 12.0);
+                const double s = sin * cd + cos * sd;
+                cos = cos * cd - sin * sd;
+                sin = s;
+                angle += delta;
+            }
+        };
+
+        enum Computed : uint8_t
+        {
+            Q_ENU = 1 << 0,
+            Q_NED = 1 << 1,
+            R_ENU = 1 << 2,
+            R_NED = 1 << 3
+        };
+
+        //! Tolerance in rad
+        double tolerance_;
+        //! Whether a position has been set
+        bool valid_ = false;
+        //! Steps advanced since the last exact computation
+        uint32_t increments_ = 0;
+        //! Number of changes of the rotations
+        uint64_t generation_ = 0;
+        //! Rotations computed for the current position as mask of Computed
+        uint8_t computed_ = 0;
+        SinCos lat_;
+        SinCos lon_;
+        SinCos enuHalfLat_;
+        SinCos enuHalfLon_;
+        SinCos nedHalfLat_;
+        SinCos nedHalfLon_;
+        Eigen::Quaterniond qEnu_;
+        Eigen::Quaterniond qNed_;
+        Eigen::Matrix3d REnu_;
+        Eigen::Matrix3d RNed_;
+    };
+} // namespace parsing_utilities
@@ -31,37 +31,92 @@
 #pragma once
 
 // C++ library includes
-#include <string>
-#include <vector>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <string_view>
 
 /**
  * @file nmea_sentence.hpp
- * @brief Defines a struct NMEASentence, into which NMEA sentences - both
+ * @brief Defines a class NMEASentence, into which NMEA sentences - both
  * standardized and proprietary ones - should be mapped
  * @date 13/08/20
  */
 
+//! Maximum number of fields of an NMEA sentence, including ID and checksum
+static const std::size_t NMEA_MAX_FIELDS = 64;
+
 /**
- * @brief Struct to split an NMEA sentence into its ID and its body, the latter
- * tokenized into a vector of strings.
+ * @brief Class to split an NMEA sentence into its fields without copying it.
  *
- * By ID, we mean either a standardized ID, e.g. "$GPGGA", or proprietary ID such as
- * "$PSSN,HRP". The STL Container Vector can be used to dynamically allocate arrays
- * (C++ feature). Also note that the ID of !all! (not just those defined by
- * Septentrio) proprietary NMEA messages starts with "$P". The body_ member variable
- * shall exclude the NMEA checksum (also hinted at in files that implement the
- * parsing).
+ * The first field is the ID, either a standardized ID, e.g. "$GPGGA", or a
+ * proprietary ID such as "$PSSN". Also note that the ID of !all! (not just those
+ * defined by Septentrio) proprietary NMEA messages starts with "$P". The last field
+ * is the checksum, which is validated while tokenizing. The fields are views into
+ * the telegram, which thus has to outlive the sentence.
  */
 class NMEASentence
 {
 public:
-    NMEASentence(std::string id, std::vector<std::string> body) :
-        id_(id), body_(body)
+    /**
+     * @brief Splits the sentence at commas and validates its checksum in the same
+     * pass
+     * @param[in] data Pointer to the sentence, starting with "$"
+     * @param[in] size Size of the sentence, trailing CR LF is ignored
+     * @return True if the sentence is well-formed and its checksum matches
+     */
+    [[nodiscard]] bool tokenize(const uint8_t* data, std::size_t size)
+    {
+        size_ = 0;
+        const char* it = reinterpret_cast<const char*>(data);
+        const char* end = it + size;
+        while ((end != it) && ((end[-1] == '\r') || (end[-1] == '\n')))
+            --end;
+        if ((it == end) || (*it != '$'))
+            return false;
+
+        uint8_t checksum = 0;
+        const char* field = it;
+        const char* c = it + 1;
+        for (; (c != end) && (*c != '*'); ++c)
+        {
+            checksum ^= static_cast<uint8_t>(*c);
+            if (*c == ',')
+            {
+                if (!addField(field, c))
+                    return false;
+                field = c + 1;
+            }
+        }
+        if ((c == end) || ((end - c) != 3) || !addField(field, c) ||
+            !addField(c + 1, end))
+            return false;
+
+        uint8_t expected;
+        auto [ptr, ec] = std::from_chars(c + 1, end, expected, 16);
+        return (ec == std::errc()) && (ptr == end) && (expected == checksum);
+    }
+
+    //! Number of fields, including ID and checksum
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+    //! Field i of the sentence, the ID being field 0
+    [[nodiscard]] std::string_view operator[](std::size_t i) const
+    {
+        return fields_[i];
+    }
+
+private:
+    [[nodiscard]] bool addField(const char* begin, const char* end)
     {
+        if (size_ == fields_.size())
+            return false;
+        fields_[size_++] = std::string_view(begin, end - begin);
+        return true;
     }
-    std::vector<std::string> get_body() const { return body_; }
 
-protected:
-    std::string id_;
-    std::vector<std::string> body_;
-};
\ No newline at end of file
+    //! Views into the telegram, valid up to size_
+    std::array<std::string_view, NMEA_MAX_FIELDS> fields_;
+    //! Number of fields
+    std::size_t size_ = 0;
+};
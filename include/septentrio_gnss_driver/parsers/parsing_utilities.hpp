@@ -35,6 +35,7 @@
 #include <cstdint> // C++ header, corresponds to <stdint.h> in C
 #include <ctime>   // C++ header, corresponds to <time.h> in C
 #include <string>  // C++ header, corresponds to <string.h> in C
+#include <string_view>
 // Eigen Includes
 #include <Eigen/Core>
 #include <Eigen/LU>
@@ -42,6 +43,7 @@
 #include <boost/math/constants/constants.hpp>
 // ROS includes
 #include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+#include <septentrio_gnss_driver/parsers/sbf_header.hpp>
 
 /**
  * @file parsing_utilities.hpp
@@ -134,7 +136,7 @@ namespace parsing_utilities {
      * floating point number found in "string"
      * @return True if all went fine, false if not
      */
-    [[nodiscard]] bool parseDouble(const std::string& string, double& value);
+    [[nodiscard]] bool parseDouble(std::string_view string, double& value);
 
     /**
      * @brief Converts a 4-byte-buffer into a float
@@ -155,7 +157,7 @@ namespace parsing_utilities {
      * floating point number found in "string"
      * @return True if all went fine, false if not
      */
-    [[nodiscard]] bool parseFloat(const std::string& string, float& value);
+    [[nodiscard]] bool parseFloat(std::string_view string, float& value);
 
     /**
      * @brief Converts a 2-byte-buffer into a signed 16-bit integer
@@ -178,7 +180,7 @@ namespace parsing_utilities {
      * 10
      * @return True if all went fine, false if not
      */
-    [[nodiscard]] bool parseInt16(const std::string& string, int16_t& value, int32_t base = 10);
+    [[nodiscard]] bool parseInt16(std::string_view string, int16_t& value, int32_t base = 10);
 
     /**
      * @brief Converts a 4-byte-buffer into a signed 32-bit integer
@@ -201,7 +203,7 @@ namespace parsing_utilities {
      * 10
      * @return True if all went fine, false if not
      */
-    [[nodiscard]] bool parseInt32(const std::string& string, int32_t& value, int32_t base = 10);
+    [[nodiscard]] bool parseInt32(std::string_view string, int32_t& value, int32_t base = 10);
 
     /**
      * @brief Interprets the contents of "string" as a unsigned integer number of
@@ -217,7 +219,7 @@ namespace parsing_utilities {
      * 10
      * @return True if all went fine, false if not
      */
-    [[nodiscard]] bool parseUInt8(const std::string& string, uint8_t& value, int32_t base = 10);
+    [[nodiscard]] bool parseUInt8(std::string_view string, uint8_t& value, int32_t base = 10);
 
     /**
      * @brief Converts a 2-byte-buffer into an unsigned 16-bit integer
@@ -240,7 +242,7 @@ namespace parsing_utilities {
      * 10
      * @return True if all went fine, false if not
      */
-    [[nodiscard]] bool parseUInt16(const std::string& string, uint16_t& value, int32_t base = 10);
+    [[nodiscard]] bool parseUInt16(std::string_view string, uint16_t& value, int32_t base = 10);
 
     /**
      * @brief Converts a 4-byte-buffer into an unsigned 32-bit integer
@@ -263,7 +265,7 @@ namespace parsing_utilities {
      * 10
      * @return True if all went fine, false if not
      */
-    [[nodiscard]] bool parseUInt32(const std::string& string, uint32_t& value, int32_t base = 10);
+    [[nodiscard]] bool parseUInt32(std::string_view string, uint32_t& value, int32_t base = 10);
 
     /**
      * @brief Converts UTC time from the without-colon-delimiter format to the
@@ -364,44 +366,4 @@ namespace parsing_utilities {
      * to the Rx
      */
     [[nodiscard]] std::string convertUserPeriodToRxCommand(uint32_t period_user);
-
-    /**
-     * @brief Get the CRC of the SBF message
-     *
-     * @param buffer A pointer to a buffer containing an SBF message
-     * @return SBF message CRC
-     */
-    [[nodiscard]] uint16_t getCrc(const std::vector<uint8_t>& message);
-
-    /**
-     * @brief Get the ID of the SBF message
-     *
-     * @param buffer A pointer to a buffer containing an SBF message
-     * @return SBF message ID
-     */
-    [[nodiscard]] uint16_t getId(const std::vector<uint8_t>& message);
-
-    /**
-     * @brief Get the length of the SBF message
-     *
-     * @param buffer A pointer to a buffer containing an SBF message
-     * @return SBF message length
-     */
-    [[nodiscard]] uint16_t getLength(const std::vector<uint8_t>& message);
-
-    /**
-     * @brief Get the time of week in ms of the SBF message
-     *
-     * @param[in] buffer A pointer to a buffer containing an SBF message
-     * @return SBF time of week in ms
-     */
-    [[nodiscard]] uint32_t getTow(const std::vector<uint8_t>& message);
-
-    /**
-     * @brief Get the GPS week counter of the SBF message
-     *
-     * @param buffer A pointer to a buffer containing an SBF message
-     * @return SBF GPS week counter
-     */
-    [[nodiscard]] uint16_t getWnc(const std::vector<uint8_t>& message);
 } // namespace parsing_utilities
\ No newline at end of file
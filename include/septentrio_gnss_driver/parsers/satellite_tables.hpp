@@ -0,0 +1,149 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++ library includes
+#include <array>
+#include <cstdint>
+#include <vector>
+// ROSaic includes
+#include <septentrio_gnss_driver/parsers/sbf_blocks.hpp>
+
+/**
+ * @file satellite_tables.hpp
+ * @brief Per satellite data of MeasEpoch and ChannelStatus as structure of
+ * arrays indexed by SVID, so that they can be joined in linear time
+ */
+
+//! SVIDs are transmitted as one byte
+static const uint16_t SVID_COUNT = 256;
+
+/**
+ * @struct TrackedSatellites
+ * @brief Satellites of MeasEpoch, one entry per Type1 sub-block
+ */
+struct TrackedSatellites
+{
+    //! Index meaning a satellite is not tracked
+    static constexpr int16_t NOT_TRACKED = -1;
+
+    //! SVID
+    std::vector<int32_t> svid;
+    //! C/N0 in dB-Hz as published in GPSFix
+    std::vector<int32_t> cn0;
+    //! Index of the first entry per SVID, NOT_TRACKED if there is none
+    std::array<int16_t, SVID_COUNT> index;
+
+    TrackedSatellites() { index.fill(NOT_TRACKED); }
+
+    /**
+     * @brief Tabulates the satellites of a MeasEpoch block
+     * @param[in] msg Parsed MeasEpoch block
+     */
+    void fill(const MeasEpochMsg& msg)
+    {
+        for (int32_t id : svid)
+            index[id] = NOT_TRACKED;
+        svid.clear();
+        cn0.clear();
+        svid.reserve(msg.type1.size());
+        cn0.reserve(msg.type1.size());
+
+        for (const auto& type1 : msg.type1)
+        {
+            if (index[type1.sv_id] == NOT_TRACKED)
+                index[type1.sv_id] = static_cast<int16_t>(svid.size());
+            svid.push_back(static_cast<int32_t>(type1.sv_id));
+            // C/N0 is offset by 10 dB-Hz except for signal types 1 and 2
+            const uint8_t signalType = type1.type & 15;
+            int32_t offset = ((signalType == 1) || (signalType == 2)) ? 0 : 10;
+            cn0.push_back(static_cast<int32_t>(type1.cn0) / 4 + offset);
+        }
+    }
+
+    //! Index of the first entry of a SVID, NOT_TRACKED if there is none
+    [[nodiscard]] int16_t find(uint8_t id) const { return index[id]; }
+};
+
+/**
+ * @struct ChannelSatellites
+ * @brief Satellites of ChannelStatus, one entry per ChannelSatInfo sub-block
+ */
+struct ChannelSatellites
+{
+    //! SVID
+    std::vector<int32_t> svid;
+    //! Elevation in degrees
+    std::vector<int32_t> elevation;
+    //! Azimuth in degrees
+    std::vector<int32_t> azimuth;
+    //! SVID once per ChannelStateInfo sub-block with a signal used in PVT
+    std::vector<int32_t> usedInPvt;
+
+    /**
+     * @brief Tabulates the satellites of a ChannelStatus block
+     * @param[in] msg Parsed ChannelStatus block
+     */
+    void fill(const ChannelStatus& msg)
+    {
+        svid.clear();
+        elevation.clear();
+        azimuth.clear();
+        usedInPvt.clear();
+        svid.reserve(msg.satInfo.size());
+        elevation.reserve(msg.satInfo.size());
+        azimuth.reserve(msg.satInfo.size());
+
+        for (const auto& satInfo : msg.satInfo)
+        {
+            svid.push_back(static_cast<int32_t>(satInfo.sv_id));
+            elevation.push_back(static_cast<int32_t>(satInfo.elev));
+            azimuth.push_back(static_cast<int32_t>(satInfo.az_rise_set & 511));
+            for (const auto& stateInfo : satInfo.stateInfo)
+            {
+                if (isUsedInPvt(stateInfo.pvt_status))
+                    usedInPvt.push_back(static_cast<int32_t>(satInfo.sv_id));
+            }
+        }
+    }
+
+    /**
+     * @brief Checks the 2 bit PVT status of all signals at once
+     * @param[in] pvtStatus PVTStatus field of ChannelStateInfo
+     * @return Whether any signal is used in the PVT, i.e. has status 2
+     */
+    [[nodiscard]] static bool isUsedInPvt(uint16_t pvtStatus)
+    {
+        const uint16_t high = pvtStatus & 0xAAAA;
+        const uint16_t low = (pvtStatus & 0x5555) << 1;
+        return (high & ~low) != 0;
+    }
+};
@@ -65,8 +65,9 @@ static const uint8_t SBF_SYNC_2 = 0x40;
 
 // C++
 #include <algorithm>
-// Boost
-#include <boost/spirit/include/qi.hpp>
+#include <bitset>
+#include <cstring>
+#include <iterator>
 // ROSaic
 #include <septentrio_gnss_driver/abstraction/typedefs.hpp>
 #include <septentrio_gnss_driver/parsers/parsing_utilities.hpp>
@@ -232,41 +233,6 @@ struct ReceiverStatus
     std::vector<AgcState> agc_state;
 };
 
-/**
- * @brief CRC look-up table for fast computation of the 16-bit CRC for SBF blocks.
- *
- * Provided by Septenrio (c) 2020 Septentrio N.V./S.A., Belgium.
- */
-static const std::array<uint16_t, 256> CRC_LOOK_UP = {
-    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7, 0x8108, 0x9129,
-    0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef, 0x1231, 0x0210, 0x3273, 0x2252,
-    0x52b5, 0x4294, 0x72f7, 0x62d6, 0x9339, 0x8318, 0xb37b, 0xa35a, 0xd3bd, 0xc39c,
-    0xf3ff, 0xe3de, 0x2462, 0x3443, 0x0420, 0x1401, 0x64e6, 0x74c7, 0x44a4, 0x5485,
-    0xa56a, 0xb54b, 0x8528, 0x9509, 0xe5ee, 0xf5cf, 0xc5ac, 0xd58d, 0x3653, 0x2672,
-    0x1611, 0x0630, 0x76d7, 0x66f6, 0x5695, 0x46b4, 0xb75b, 0xa77a, 0x9719, 0x8738,
-    0xf7df, 0xe7fe, 0xd79d, 0xc7bc, 0x48c4, 0x58e5, 0x6886, 0x78a7, 0x0840, 0x1861,
-    0x2802, 0x3823, 0xc9cc, 0xd9ed, 0xe98e, 0xf9af, 0x8948, 0x9969, 0xa90a, 0xb92b,
-    0x5af5, 0x4ad4, 0x7ab7, 0x6a96, 0x1a71, 0x0a50, 0x3a33, 0x2a12, 0xdbfd, 0xcbdc,
-    0xfbbf, 0xeb9e, 0x9b79, 0x8b58, 0xbb3b, 0xab1a, 0x6ca6, 0x7c87, 0x4ce4, 0x5cc5,
-    0x2c22, 0x3c03, 0x0c60, 0x1c41, 0xedae, 0xfd8f, 0xcdec, 0xddcd, 0xad2a, 0xbd0b,
-    0x8d68, 0x9d49, 0x7e97, 0x6eb6, 0x5ed5, 0x4ef4, 0x3e13, 0x2e32, 0x1e51, 0x0e70,
-    0xff9f, 0xefbe, 0xdfdd, 0xcffc, 0xbf1b, 0xaf3a, 0x9f59, 0x8f78, 0x9188, 0x81a9,
-    0xb1ca, 0xa1eb, 0xd10c, 0xc12d, 0xf14e, 0xe16f, 0x1080, 0x00a1, 0x30c2, 0x20e3,
-    0x5004, 0x4025, 0x7046, 0x6067, 0x83b9, 0x9398, 0xa3fb, 0xb3da, 0xc33d, 0xd31c,
-    0xe37f, 0xf35e, 0x02b1, 0x1290, 0x22f3, 0x32d2, 0x4235, 0x5214, 0x6277, 0x7256,
-    0xb5ea, 0xa5cb, 0x95a8, 0x8589, 0xf56e, 0xe54f, 0xd52c, 0xc50d, 0x34e2, 0x24c3,
-    0x14a0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405, 0xa7db, 0xb7fa, 0x8799, 0x97b8,
-    0xe75f, 0xf77e, 0xc71d, 0xd73c, 0x26d3, 0x36f2, 0x0691, 0x16b0, 0x6657, 0x7676,
-    0x4615, 0x5634, 0xd94c, 0xc96d, 0xf90e, 0xe92f, 0x99c8, 0x89e9, 0xb98a, 0xa9ab,
-    0x5844, 0x4865, 0x7806, 0x6827, 0x18c0, 0x08e1, 0x3882, 0x28a3, 0xcb7d, 0xdb5c,
-    0xeb3f, 0xfb1e, 0x8bf9, 0x9bd8, 0xabbb, 0xbb9a, 0x4a75, 0x5a54, 0x6a37, 0x7a16,
-    0x0af1, 0x1ad0, 0x2ab3, 0x3a92, 0xfd2e, 0xed0f, 0xdd6c, 0xcd4d, 0xbdaa, 0xad8b,
-    0x9de8, 0x8dc9, 0x7c26, 0x6c07, 0x5c64, 0x4c45, 0x3ca2, 0x2c83, 0x1ce0, 0x0cc1,
-    0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8, 0x6e17, 0x7e36,
-    0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0};
-
-namespace qi = boost::spirit::qi;
-
 /**
  * validValue
  * @brief Check if value is not set to Do-Not-Use
@@ -321,11 +287,14 @@ void setDoNotUse(Val& s)
 }
 
 /**
- * qiLittleEndianParser
- * @brief Qi little endian parsers for numeric values
+ * littleEndianParser
+ * @brief Loads a little endian numeric value and advances the iterator
+ *
+ * Fields within SBF blocks are not aligned, memcpy keeps the load well defined and
+ * compiles to a single move.
  */
 template <typename It, typename Val>
-void qiLittleEndianParser(It& it, Val& val)
+void littleEndianParser(It& it, Val& val)
 {
     static_assert(
         std::is_same<int8_t, Val>::value || std::is_same<uint8_t, Val>::value ||
@@ -334,116 +303,132 @@ void qiLittleEndianParser(It& it, Val& val)
         std::is_same<int64_t, Val>::value || std::is_same<uint64_t, Val>::value ||
         std::is_same<float, Val>::value || std::is_same<double, Val>::value);
 
-    if (std::is_same<int8_t, Val>::value)
-    {
-        qi::parse(it, it + 1, qi::char_, val);
-    } else if (std::is_same<uint8_t, Val>::value)
-    {
-        qi::parse(it, it + 1, qi::byte_, val);
-    } else if ((std::is_same<int16_t, Val>::value) ||
-               (std::is_same<uint16_t, Val>::value))
-    {
-        qi::parse(it, it + 2, qi::little_word, val);
-    } else if ((std::is_same<int32_t, Val>::value) ||
-               (std::is_same<uint32_t, Val>::value))
-    {
-        qi::parse(it, it + 4, qi::little_dword, val);
-    } else if ((std::is_same<int64_t, Val>::value) ||
-               (std::is_same<uint64_t, Val>::value))
-    {
-        qi::parse(it, it + 8, qi::little_qword, val);
-    } else if (std::is_same<float, Val>::value)
-    {
-        qi::parse(it, it + 4, qi::little_bin_float, val);
-    } else if (std::is_same<double, Val>::value)
-    {
-        qi::parse(it, it + 8, qi::little_bin_double, val);
-    }
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    uint8_t bytes[sizeof(Val)];
+    std::reverse_copy(it, it + sizeof(Val), bytes);
+    std::memcpy(&val, bytes, sizeof(Val));
+#else
+    std::memcpy(&val, &*it, sizeof(Val));
+#endif
+    it += sizeof(Val);
 }
 
 /**
- * qiCharsToStringParser
- * @brief Qi parser for char array to string
+ * charsToStringParser
+ * @brief Parser for char array to string
  */
 template <typename It>
-void qiCharsToStringParser(It& it, std::string& val, std::size_t num)
+void charsToStringParser(It& it, std::string& val, std::size_t num)
 {
-    val.clear();
-    qi::parse(it, it + num, qi::repeat(num)[qi::char_], val);
+    val.assign(it, it + num);
+    it += num;
     // remove string termination characters '\0'
     val.erase(std::remove(val.begin(), val.end(), '\0'), val.end());
 }
 
+/**
+ * enoughBytes
+ * @brief Checks that at least num bytes are left before itEnd, so the following
+ * fields can be loaded without further checks
+ */
+template <typename It>
+[[nodiscard]] bool enoughBytes(ROSaicNodeBase* node, It it, It itEnd, std::size_t num)
+{
+    if ((itEnd < it) || (static_cast<std::size_t>(itEnd - it) < num))
+    {
+        node->log(log_level::ERROR, "Parse error: block too short.");
+        return false;
+    }
+    return true;
+}
+
 /**
  * BlockHeaderParser
- * @brief Qi based parser for the SBF block "BlockHeader" plus receiver time stamp
+ * @brief Parser for the SBF block "BlockHeader" plus receiver time stamp. Checks
+ * once that the whole block as announced in the header is inside the buffer and
+ * narrows itEnd to the end of the block, against which the parsers of the blocks
+ * check their fields.
  */
 template <typename It, typename Hdr>
-[[nodiscard]] bool BlockHeaderParser(ROSaicNodeBase* node, It& it, Hdr& block_header)
+[[nodiscard]] bool BlockHeaderParser(ROSaicNodeBase* node, It& it, It& itEnd,
+                                     Hdr& block_header)
 {
-    qiLittleEndianParser(it, block_header.sync_1);
+    // Sync, CRC, ID, length, TOW, and WNC
+    static const std::size_t HEADER_AND_TIME_LENGTH = 14;
+    if (!enoughBytes(node, it, itEnd, HEADER_AND_TIME_LENGTH))
+        return false;
+    It itBlock = it;
+    littleEndianParser(it, block_header.sync_1);
     if (block_header.sync_1 != SBF_SYNC_1)
     {
         node->log(log_level::ERROR, "Parse error: Wrong sync byte 1.");
         return false;
     }
-    qiLittleEndianParser(it, block_header.sync_2);
+    littleEndianParser(it, block_header.sync_2);
     if (block_header.sync_2 != SBF_SYNC_2)
     {
         node->log(log_level::ERROR, "Parse error: Wrong sync byte 2.");
         return false;
     }
-    qiLittleEndianParser(it, block_header.crc);
+    littleEndianParser(it, block_header.crc);
     uint16_t ID;
-    qiLittleEndianParser(it, ID);
+    littleEndianParser(it, ID);
     block_header.id = ID & 8191;      // lower 13 bits are id
     block_header.revision = ID >> 13; // upper 3 bits are revision
-    qiLittleEndianParser(it, block_header.length);
-    qiLittleEndianParser(it, block_header.tow);
-    qiLittleEndianParser(it, block_header.wnc);
+    littleEndianParser(it, block_header.length);
+    littleEndianParser(it, block_header.tow);
+    littleEndianParser(it, block_header.wnc);
+    if (!enoughBytes(node, itBlock, itEnd, block_header.length))
+        return false;
+    itEnd = itBlock + block_header.length;
     return true;
 }
 
 /**
  * ChannelStateInfoParser
- * @brief Qi based parser for the SBF sub-block "ChannelStateInfo"
+ * @brief Parser for the SBF sub-block "ChannelStateInfo"
  */
 template <typename It>
 void ChannelStateInfoParser(It& it, ChannelStateInfo& msg, uint8_t sb2_length)
 {
-    qiLittleEndianParser(it, msg.antenna);
+    littleEndianParser(it, msg.antenna);
     ++it; // reserved
-    qiLittleEndianParser(it, msg.tracking_status);
-    qiLittleEndianParser(it, msg.pvt_status);
-    qiLittleEndianParser(it, msg.pvt_info);
+    littleEndianParser(it, msg.tracking_status);
+    littleEndianParser(it, msg.pvt_status);
+    littleEndianParser(it, msg.pvt_info);
     std::advance(it, sb2_length - 8); // skip padding
 };
 
 /**
  * ChannelSatInfoParser
- * @brief Qi based parser or the SBF sub-block "ChannelSatInfo"
+ * @brief Parser for the SBF sub-block "ChannelSatInfo"
  */
 template <typename It>
-[[nodiscard]] bool ChannelSatInfoParser(ROSaicNodeBase* node, It& it,
+[[nodiscard]] bool ChannelSatInfoParser(ROSaicNodeBase* node, It& it, It itEnd,
                                         ChannelSatInfo& msg, uint8_t sb1_length,
                                         uint8_t sb2_length)
 {
-    qiLittleEndianParser(it, msg.sv_id);
-    qiLittleEndianParser(it, msg.freq_nr);
+    // Preceding sub-blocks may have used up the block with their sub-blocks
+    if (!enoughBytes(node, it, itEnd, sb1_length))
+        return false;
+    littleEndianParser(it, msg.sv_id);
+    littleEndianParser(it, msg.freq_nr);
     std::advance(it, 2); // reserved
-    qiLittleEndianParser(it, msg.az_rise_set);
-    qiLittleEndianParser(it, msg.health_status);
-    qiLittleEndianParser(it, msg.elev);
-    qiLittleEndianParser(it, msg.n2);
+    littleEndianParser(it, msg.az_rise_set);
+    littleEndianParser(it, msg.health_status);
+    littleEndianParser(it, msg.elev);
+    littleEndianParser(it, msg.n2);
     if (msg.n2 > MAXSB_CHANNELSTATEINFO)
     {
         node->log(log_level::ERROR, "Parse error: Too many ChannelStateInfo " +
                                         std::to_string(msg.n2));
         return false;
     }
-    qiLittleEndianParser(it, msg.rx_channel);
+    littleEndianParser(it, msg.rx_channel);
     ++it;                              // reserved
     std::advance(it, sb1_length - 12); // skip padding
+    if (!enoughBytes(node, it, itEnd, static_cast<std::size_t>(msg.n2) * sb2_length))
+        return false;
     msg.stateInfo.resize(msg.n2);
     for (auto& stateInfo : msg.stateInfo)
     {
@@ -454,13 +439,13 @@ template <typename It>
 
 /**
  * ChannelStatusParser
- * @brief Qi based parser for the SBF block "ChannelStatus"
+ * @brief Parser for the SBF block "ChannelStatus"
  */
 template <typename It>
 [[nodiscard]] bool ChannelStatusParser(ROSaicNodeBase* node, It it, It itEnd,
                                        ChannelStatus& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4013)
     {
@@ -468,20 +453,32 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.n);
+    if (!enoughBytes(node, it, itEnd, 6))
+        return false;
+    littleEndianParser(it, msg.n);
     if (msg.n > MAXSB_CHANNELSATINFO)
     {
         node->log(log_level::ERROR,
                   "Parse error: Too many ChannelSatInfo " + std::to_string(msg.n));
         return false;
     }
-    qiLittleEndianParser(it, msg.sb1_length);
-    qiLittleEndianParser(it, msg.sb2_length);
+    littleEndianParser(it, msg.sb1_length);
+    littleEndianParser(it, msg.sb2_length);
     std::advance(it, 3); // reserved
+    if ((msg.sb1_length < 12) || (msg.sb2_length < 8))
+    {
+        node->log(log_level::ERROR, "Parse error: Wrong sub-block lengths " +
+                                        std::to_string(msg.sb1_length) + ", " +
+                                        std::to_string(msg.sb2_length));
+        return false;
+    }
+    if (!enoughBytes(node, it, itEnd, static_cast<std::size_t>(msg.n) * msg.sb1_length))
+        return false;
     msg.satInfo.resize(msg.n);
     for (auto& satInfo : msg.satInfo)
     {
-        if (!ChannelSatInfoParser(node, it, satInfo, msg.sb1_length, msg.sb2_length))
+        if (!ChannelSatInfoParser(node, it, itEnd, satInfo, msg.sb1_length,
+                                  msg.sb2_length))
             return false;
     }
     if (it > itEnd)
@@ -494,13 +491,13 @@ template <typename It>
 
 /**
  * DOPParser
- * @brief Qi based parser for the SBF block "DOP"
+ * @brief Parser for the SBF block "DOP"
  */
 template <typename It>
 [[nodiscard]] bool DOPParser(ROSaicNodeBase* node, It it, It itEnd, Dop& msg)
 {
 
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4001)
     {
@@ -508,19 +505,21 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.nr_sv);
+    if (!enoughBytes(node, it, itEnd, 18))
+        return false;
+    littleEndianParser(it, msg.nr_sv);
     ++it; // reserved
     uint16_t temp;
-    qiLittleEndianParser(it, temp);
+    littleEndianParser(it, temp);
     msg.pdop = temp / 100.0;
-    qiLittleEndianParser(it, temp);
+    littleEndianParser(it, temp);
     msg.tdop = temp / 100.0;
-    qiLittleEndianParser(it, temp);
+    littleEndianParser(it, temp);
     msg.hdop = temp / 100.0;
-    qiLittleEndianParser(it, temp);
+    littleEndianParser(it, temp);
     msg.vdop = temp / 100.0;
-    qiLittleEndianParser(it, msg.hpl);
-    qiLittleEndianParser(it, msg.vpl);
+    littleEndianParser(it, msg.hpl);
+    littleEndianParser(it, msg.vpl);
     if (it > itEnd)
     {
         node->log(log_level::ERROR, "Parse error: iterator past end.");
@@ -531,46 +530,50 @@ template <typename It>
 
 /**
  * MeasEpochChannelType2Parser
- * @brief Qi based parser for the SBF sub-block "MeasEpochChannelType2"
+ * @brief Parser for the SBF sub-block "MeasEpochChannelType2"
  */
 template <typename It>
 void MeasEpochChannelType2Parser(It& it, MeasEpochChannelType2Msg& msg,
                                  uint8_t sb2_length)
 {
-    qiLittleEndianParser(it, msg.type);
-    qiLittleEndianParser(it, msg.lock_time);
-    qiLittleEndianParser(it, msg.cn0);
-    qiLittleEndianParser(it, msg.offsets_msb);
-    qiLittleEndianParser(it, msg.carrier_msb);
-    qiLittleEndianParser(it, msg.obs_info);
-    qiLittleEndianParser(it, msg.code_offset_lsb);
-    qiLittleEndianParser(it, msg.carrier_lsb);
-    qiLittleEndianParser(it, msg.doppler_offset_lsb);
+    littleEndianParser(it, msg.type);
+    littleEndianParser(it, msg.lock_time);
+    littleEndianParser(it, msg.cn0);
+    littleEndianParser(it, msg.offsets_msb);
+    littleEndianParser(it, msg.carrier_msb);
+    littleEndianParser(it, msg.obs_info);
+    littleEndianParser(it, msg.code_offset_lsb);
+    littleEndianParser(it, msg.carrier_lsb);
+    littleEndianParser(it, msg.doppler_offset_lsb);
     std::advance(it, sb2_length - 12); // skip padding
 };
 
 /**
  * MeasEpochChannelType1Parser
- * @brief Qi based parser for the SBF sub-block "MeasEpochChannelType1"
+ * @brief Parser for the SBF sub-block "MeasEpochChannelType1"
  */
 template <typename It>
 [[nodiscard]] bool MeasEpochChannelType1Parser(ROSaicNodeBase* node, It& it,
+                                               It itEnd,
                                                MeasEpochChannelType1Msg& msg,
                                                uint8_t sb1_length,
                                                uint8_t sb2_length)
 {
-    qiLittleEndianParser(it, msg.rx_channel);
-    qiLittleEndianParser(it, msg.type);
-    qiLittleEndianParser(it, msg.sv_id);
-    qiLittleEndianParser(it, msg.misc);
-    qiLittleEndianParser(it, msg.code_lsb);
-    qiLittleEndianParser(it, msg.doppler);
-    qiLittleEndianParser(it, msg.carrier_lsb);
-    qiLittleEndianParser(it, msg.carrier_msb);
-    qiLittleEndianParser(it, msg.cn0);
-    qiLittleEndianParser(it, msg.lock_time);
-    qiLittleEndianParser(it, msg.obs_info);
-    qiLittleEndianParser(it, msg.n2);
+    // Preceding sub-blocks may have used up the block with their sub-blocks
+    if (!enoughBytes(node, it, itEnd, sb1_length))
+        return false;
+    littleEndianParser(it, msg.rx_channel);
+    littleEndianParser(it, msg.type);
+    littleEndianParser(it, msg.sv_id);
+    littleEndianParser(it, msg.misc);
+    littleEndianParser(it, msg.code_lsb);
+    littleEndianParser(it, msg.doppler);
+    littleEndianParser(it, msg.carrier_lsb);
+    littleEndianParser(it, msg.carrier_msb);
+    littleEndianParser(it, msg.cn0);
+    littleEndianParser(it, msg.lock_time);
+    littleEndianParser(it, msg.obs_info);
+    littleEndianParser(it, msg.n2);
     std::advance(it, sb1_length - 20); // skip padding
     if (msg.n2 > MAXSB_MEASEPOCH_T2)
     {
@@ -578,6 +581,8 @@ template <typename It>
                                         std::to_string(msg.n2));
         return false;
     }
+    if (!enoughBytes(node, it, itEnd, static_cast<std::size_t>(msg.n2) * sb2_length))
+        return false;
     msg.type2.resize(msg.n2);
     for (auto& type2 : msg.type2)
     {
@@ -588,13 +593,13 @@ template <typename It>
 
 /**
  * MeasEpochParser
- * @brief Qi based parser for the SBF block "MeasEpoch"
+ * @brief Parser for the SBF block "MeasEpoch"
  */
 template <typename It>
 [[nodiscard]] bool MeasEpochParser(ROSaicNodeBase* node, It it, It itEnd,
                                    MeasEpochMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4027)
     {
@@ -602,23 +607,35 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.n);
+    // CumClkJumps since revision 1
+    if (!enoughBytes(node, it, itEnd, (msg.block_header.revision > 0) ? 6 : 5))
+        return false;
+    littleEndianParser(it, msg.n);
     if (msg.n > MAXSB_MEASEPOCH_T1)
     {
         node->log(log_level::ERROR, "Parse error: Too many MeasEpochChannelType1 " +
                                         std::to_string(msg.n));
         return false;
     }
-    qiLittleEndianParser(it, msg.sb1_length);
-    qiLittleEndianParser(it, msg.sb2_length);
-    qiLittleEndianParser(it, msg.common_flags);
+    littleEndianParser(it, msg.sb1_length);
+    littleEndianParser(it, msg.sb2_length);
+    littleEndianParser(it, msg.common_flags);
     if (msg.block_header.revision > 0)
-        qiLittleEndianParser(it, msg.cum_clk_jumps);
+        littleEndianParser(it, msg.cum_clk_jumps);
     ++it; // reserved
+    if ((msg.sb1_length < 20) || (msg.sb2_length < 12))
+    {
+        node->log(log_level::ERROR, "Parse error: Wrong sub-block lengths " +
+                                        std::to_string(msg.sb1_length) + ", " +
+                                        std::to_string(msg.sb2_length));
+        return false;
+    }
+    if (!enoughBytes(node, it, itEnd, static_cast<std::size_t>(msg.n) * msg.sb1_length))
+        return false;
     msg.type1.resize(msg.n);
     for (auto& type1 : msg.type1)
     {
-        if (!MeasEpochChannelType1Parser(node, it, type1, msg.sb1_length,
+        if (!MeasEpochChannelType1Parser(node, it, itEnd, type1, msg.sb1_length,
                                          msg.sb2_length))
             return false;
     }
@@ -632,13 +649,13 @@ template <typename It>
 
 /**
  * GALAuthStatus
- * @brief Qi based parser for the SBF block "GALAuthStatus"
+ * @brief Parser for the SBF block "GALAuthStatus"
  */
 template <typename It>
 [[nodiscard]] bool GalAuthStatusParser(ROSaicNodeBase* node, It it, It itEnd,
                                        GalAuthStatusMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4245)
     {
@@ -646,12 +663,14 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.osnma_status);
-    qiLittleEndianParser(it, msg.trusted_time_delta);
-    qiLittleEndianParser(it, msg.gal_active_mask);
-    qiLittleEndianParser(it, msg.gal_authentic_mask);
-    qiLittleEndianParser(it, msg.gps_active_mask);
-    qiLittleEndianParser(it, msg.gps_authentic_mask);
+    if (!enoughBytes(node, it, itEnd, 38))
+        return false;
+    littleEndianParser(it, msg.osnma_status);
+    littleEndianParser(it, msg.trusted_time_delta);
+    littleEndianParser(it, msg.gal_active_mask);
+    littleEndianParser(it, msg.gal_authentic_mask);
+    littleEndianParser(it, msg.gps_active_mask);
+    littleEndianParser(it, msg.gps_authentic_mask);
     if (it > itEnd)
     {
         node->log(log_level::ERROR, "Parse error: iterator past end.");
@@ -662,26 +681,26 @@ template <typename It>
 
 /**
  * RFBandParser
- * @brief Qi based parser for the SBF sub-block "RFBand"
+ * @brief Parser for the SBF sub-block "RFBand"
  */
 template <typename It>
 void RfBandParser(It& it, RfBandMsg& msg, uint8_t sb_length)
 {
-    qiLittleEndianParser(it, msg.frequency);
-    qiLittleEndianParser(it, msg.bandwidth);
-    qiLittleEndianParser(it, msg.info);
+    littleEndianParser(it, msg.frequency);
+    littleEndianParser(it, msg.bandwidth);
+    littleEndianParser(it, msg.info);
     std::advance(it, sb_length - 7); // skip padding
 };
 
 /**
  * RFStatusParser
- * @brief Qi based parser for the SBF block "RFStatus"
+ * @brief Parser for the SBF block "RFStatus"
  */
 template <typename It>
 [[nodiscard]] bool RfStatusParser(ROSaicNodeBase* node, It it, It itEnd,
                                   RfStatusMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4092)
     {
@@ -689,10 +708,20 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.n);
-    qiLittleEndianParser(it, msg.sb_length);
-    qiLittleEndianParser(it, msg.flags);
+    if (!enoughBytes(node, it, itEnd, 6))
+        return false;
+    littleEndianParser(it, msg.n);
+    littleEndianParser(it, msg.sb_length);
+    littleEndianParser(it, msg.flags);
     std::advance(it, 3); // reserved
+    if (msg.sb_length < 7)
+    {
+        node->log(log_level::ERROR, "Parse error: Wrong sub-block length " +
+                                        std::to_string(msg.sb_length));
+        return false;
+    }
+    if (!enoughBytes(node, it, itEnd, static_cast<std::size_t>(msg.n) * msg.sb_length))
+        return false;
     msg.rfband.resize(msg.n);
     for (auto& rfband : msg.rfband)
     {
@@ -708,13 +737,13 @@ template <typename It>
 
 /**
  * ReceiverSetupParser
- * @brief Qi based parser for the SBF block "ReceiverSetup"
+ * @brief Parser for the SBF block "ReceiverSetup"
  */
 template <typename It>
 [[nodiscard]] bool ReceiverSetupParser(ROSaicNodeBase* node, It it, It itEnd,
                                        ReceiverSetup& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5902)
     {
@@ -722,34 +751,40 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
+    // Fields added by each revision up to 4
+    static const std::size_t REVISION_LENGTHS[] = {274, 294, 334, 374, 409};
+    if (!enoughBytes(node, it, itEnd,
+                     REVISION_LENGTHS[std::min<uint8_t>(msg.block_header.revision,
+                                                        4)]))
+        return false;
     std::advance(it, 2); // reserved
-    qiCharsToStringParser(it, msg.marker_name, 60);
-    qiCharsToStringParser(it, msg.marker_number, 20);
-    qiCharsToStringParser(it, msg.observer, 20);
-    qiCharsToStringParser(it, msg.agency, 40);
-    qiCharsToStringParser(it, msg.rx_serial_number, 20);
-    qiCharsToStringParser(it, msg.rx_name, 20);
-    qiCharsToStringParser(it, msg.rx_version, 20);
-    qiCharsToStringParser(it, msg.ant_serial_nbr, 20);
-    qiCharsToStringParser(it, msg.ant_type, 20);
-    qiLittleEndianParser(it, msg.delta_h);
-    qiLittleEndianParser(it, msg.delta_e);
-    qiLittleEndianParser(it, msg.delta_n);
+    charsToStringParser(it, msg.marker_name, 60);
+    charsToStringParser(it, msg.marker_number, 20);
+    charsToStringParser(it, msg.observer, 20);
+    charsToStringParser(it, msg.agency, 40);
+    charsToStringParser(it, msg.rx_serial_number, 20);
+    charsToStringParser(it, msg.rx_name, 20);
+    charsToStringParser(it, msg.rx_version, 20);
+    charsToStringParser(it, msg.ant_serial_nbr, 20);
+    charsToStringParser(it, msg.ant_type, 20);
+    littleEndianParser(it, msg.delta_h);
+    littleEndianParser(it, msg.delta_e);
+    littleEndianParser(it, msg.delta_n);
     if (msg.block_header.revision > 0)
-        qiCharsToStringParser(it, msg.marker_type, 20);
+        charsToStringParser(it, msg.marker_type, 20);
     if (msg.block_header.revision > 1)
-        qiCharsToStringParser(it, msg.gnss_fw_version, 40);
+        charsToStringParser(it, msg.gnss_fw_version, 40);
     if (msg.block_header.revision > 2)
-        qiCharsToStringParser(it, msg.product_name, 40);
+        charsToStringParser(it, msg.product_name, 40);
     if (msg.block_header.revision > 3)
     {
-        qiLittleEndianParser(it, msg.latitude);
-        qiLittleEndianParser(it, msg.longitude);
-        qiLittleEndianParser(it, msg.height);
-        qiCharsToStringParser(it, msg.station_code, 10);
-        qiLittleEndianParser(it, msg.monument_idx);
-        qiLittleEndianParser(it, msg.receiver_idx);
-        qiCharsToStringParser(it, msg.country_code, 3);
+        littleEndianParser(it, msg.latitude);
+        littleEndianParser(it, msg.longitude);
+        littleEndianParser(it, msg.height);
+        charsToStringParser(it, msg.station_code, 10);
+        littleEndianParser(it, msg.monument_idx);
+        littleEndianParser(it, msg.receiver_idx);
+        charsToStringParser(it, msg.country_code, 3);
     } else
     {
         setDoNotUse(msg.latitude);
@@ -772,7 +807,7 @@ template <typename It>
 [[nodiscard]] bool ReceiverTimesParser(ROSaicNodeBase* node, It it, It itEnd,
                                        ReceiverTimeMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5914)
     {
@@ -780,14 +815,16 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.utc_year);
-    qiLittleEndianParser(it, msg.utc_month);
-    qiLittleEndianParser(it, msg.utc_day);
-    qiLittleEndianParser(it, msg.utc_hour);
-    qiLittleEndianParser(it, msg.utc_min);
-    qiLittleEndianParser(it, msg.utc_second);
-    qiLittleEndianParser(it, msg.delta_ls);
-    qiLittleEndianParser(it, msg.sync_level);
+    if (!enoughBytes(node, it, itEnd, 8))
+        return false;
+    littleEndianParser(it, msg.utc_year);
+    littleEndianParser(it, msg.utc_month);
+    littleEndianParser(it, msg.utc_day);
+    littleEndianParser(it, msg.utc_hour);
+    littleEndianParser(it, msg.utc_min);
+    littleEndianParser(it, msg.utc_second);
+    littleEndianParser(it, msg.delta_ls);
+    littleEndianParser(it, msg.sync_level);
     if (it > itEnd)
     {
         node->log(log_level::ERROR, "Parse error: iterator past end.");
@@ -798,13 +835,13 @@ template <typename It>
 
 /**
  * PVTCartesianParser
- * @brief Qi based parser for the SBF block "PVTCartesian"
+ * @brief Parser for the SBF block "PVTCartesian"
  */
 template <typename It>
 [[nodiscard]] bool PVTCartesianParser(ROSaicNodeBase* node, It it, It itEnd,
                                       PVTCartesianMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4006)
     {
@@ -812,37 +849,42 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.mode);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.x);
-    qiLittleEndianParser(it, msg.y);
-    qiLittleEndianParser(it, msg.z);
-    qiLittleEndianParser(it, msg.undulation);
-    qiLittleEndianParser(it, msg.vx);
-    qiLittleEndianParser(it, msg.vy);
-    qiLittleEndianParser(it, msg.vz);
-    qiLittleEndianParser(it, msg.cog);
-    qiLittleEndianParser(it, msg.rx_clk_bias);
-    qiLittleEndianParser(it, msg.rx_clk_drift);
-    qiLittleEndianParser(it, msg.time_system);
-    qiLittleEndianParser(it, msg.datum);
-    qiLittleEndianParser(it, msg.nr_sv);
-    qiLittleEndianParser(it, msg.wa_corr_info);
-    qiLittleEndianParser(it, msg.reference_id);
-    qiLittleEndianParser(it, msg.mean_corr_age);
-    qiLittleEndianParser(it, msg.signal_info);
-    qiLittleEndianParser(it, msg.alert_flag);
+    // NrBases and PPPInfo since revision 1, Latency to Misc since revision 2
+    if (!enoughBytes(node, it, itEnd,
+                     71 + ((msg.block_header.revision > 0) ? 3 : 0) +
+                         ((msg.block_header.revision > 1) ? 7 : 0)))
+        return false;
+    littleEndianParser(it, msg.mode);
+    littleEndianParser(it, msg.error);
+    littleEndianParser(it, msg.x);
+    littleEndianParser(it, msg.y);
+    littleEndianParser(it, msg.z);
+    littleEndianParser(it, msg.undulation);
+    littleEndianParser(it, msg.vx);
+    littleEndianParser(it, msg.vy);
+    littleEndianParser(it, msg.vz);
+    littleEndianParser(it, msg.cog);
+    littleEndianParser(it, msg.rx_clk_bias);
+    littleEndianParser(it, msg.rx_clk_drift);
+    littleEndianParser(it, msg.time_system);
+    littleEndianParser(it, msg.datum);
+    littleEndianParser(it, msg.nr_sv);
+    littleEndianParser(it, msg.wa_corr_info);
+    littleEndianParser(it, msg.reference_id);
+    littleEndianParser(it, msg.mean_corr_age);
+    littleEndianParser(it, msg.signal_info);
+    littleEndianParser(it, msg.alert_flag);
     if (msg.block_header.revision > 0)
     {
-        qiLittleEndianParser(it, msg.nr_bases);
-        qiLittleEndianParser(it, msg.ppp_info);
+        littleEndianParser(it, msg.nr_bases);
+        littleEndianParser(it, msg.ppp_info);
     }
     if (msg.block_header.revision > 1)
     {
-        qiLittleEndianParser(it, msg.latency);
-        qiLittleEndianParser(it, msg.h_accuracy);
-        qiLittleEndianParser(it, msg.v_accuracy);
-        qiLittleEndianParser(it, msg.misc);
+        littleEndianParser(it, msg.latency);
+        littleEndianParser(it, msg.h_accuracy);
+        littleEndianParser(it, msg.v_accuracy);
+        littleEndianParser(it, msg.misc);
     }
     if (it > itEnd)
     {
@@ -854,13 +896,13 @@ template <typename It>
 
 /**
  * PVTGeodeticParser
- * @brief Qi based parser for the SBF block "PVTGeodetic"
+ * @brief Parser for the SBF block "PVTGeodetic"
  */
 template <typename It>
 [[nodiscard]] bool PVTGeodeticParser(ROSaicNodeBase* node, It it, It itEnd,
                                      PVTGeodeticMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4007)
     {
@@ -868,37 +910,42 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.mode);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.latitude);
-    qiLittleEndianParser(it, msg.longitude);
-    qiLittleEndianParser(it, msg.height);
-    qiLittleEndianParser(it, msg.undulation);
-    qiLittleEndianParser(it, msg.vn);
-    qiLittleEndianParser(it, msg.ve);
-    qiLittleEndianParser(it, msg.vu);
-    qiLittleEndianParser(it, msg.cog);
-    qiLittleEndianParser(it, msg.rx_clk_bias);
-    qiLittleEndianParser(it, msg.rx_clk_drift);
-    qiLittleEndianParser(it, msg.time_system);
-    qiLittleEndianParser(it, msg.datum);
-    qiLittleEndianParser(it, msg.nr_sv);
-    qiLittleEndianParser(it, msg.wa_corr_info);
-    qiLittleEndianParser(it, msg.reference_id);
-    qiLittleEndianParser(it, msg.mean_corr_age);
-    qiLittleEndianParser(it, msg.signal_info);
-    qiLittleEndianParser(it, msg.alert_flag);
+    // NrBases and PPPInfo since revision 1, Latency to Misc since revision 2
+    if (!enoughBytes(node, it, itEnd,
+                     71 + ((msg.block_header.revision > 0) ? 3 : 0) +
+                         ((msg.block_header.revision > 1) ? 7 : 0)))
+        return false;
+    littleEndianParser(it, msg.mode);
+    littleEndianParser(it, msg.error);
+    littleEndianParser(it, msg.latitude);
+    littleEndianParser(it, msg.longitude);
+    littleEndianParser(it, msg.height);
+    littleEndianParser(it, msg.undulation);
+    littleEndianParser(it, msg.vn);
+    littleEndianParser(it, msg.ve);
+    littleEndianParser(it, msg.vu);
+    littleEndianParser(it, msg.cog);
+    littleEndianParser(it, msg.rx_clk_bias);
+    littleEndianParser(it, msg.rx_clk_drift);
+    littleEndianParser(it, msg.time_system);
+    littleEndianParser(it, msg.datum);
+    littleEndianParser(it, msg.nr_sv);
+    littleEndianParser(it, msg.wa_corr_info);
+    littleEndianParser(it, msg.reference_id);
+    littleEndianParser(it, msg.mean_corr_age);
+    littleEndianParser(it, msg.signal_info);
+    littleEndianParser(it, msg.alert_flag);
     if (msg.block_header.revision > 0)
     {
-        qiLittleEndianParser(it, msg.nr_bases);
-        qiLittleEndianParser(it, msg.ppp_info);
+        littleEndianParser(it, msg.nr_bases);
+        littleEndianParser(it, msg.ppp_info);
     }
     if (msg.block_header.revision > 1)
     {
-        qiLittleEndianParser(it, msg.latency);
-        qiLittleEndianParser(it, msg.h_accuracy);
-        qiLittleEndianParser(it, msg.v_accuracy);
-        qiLittleEndianParser(it, msg.misc);
+        littleEndianParser(it, msg.latency);
+        littleEndianParser(it, msg.h_accuracy);
+        littleEndianParser(it, msg.v_accuracy);
+        littleEndianParser(it, msg.misc);
     }
     if (it > itEnd)
     {
@@ -910,13 +957,13 @@ template <typename It>
 
 /**
  * AttEulerParser
- * @brief Qi based parser for the SBF block "AttEuler"
+ * @brief Parser for the SBF block "AttEuler"
  */
 template <typename It>
 [[nodiscard]] bool AttEulerParser(ROSaicNodeBase* node, It it, It itEnd,
                                   AttEulerMsg& msg, bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5938)
     {
@@ -924,16 +971,18 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.nr_sv);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.mode);
+    if (!enoughBytes(node, it, itEnd, 30))
+        return false;
+    littleEndianParser(it, msg.nr_sv);
+    littleEndianParser(it, msg.error);
+    littleEndianParser(it, msg.mode);
     std::advance(it, 2); // reserved
-    qiLittleEndianParser(it, msg.heading);
-    qiLittleEndianParser(it, msg.pitch);
-    qiLittleEndianParser(it, msg.roll);
-    qiLittleEndianParser(it, msg.pitch_dot);
-    qiLittleEndianParser(it, msg.roll_dot);
-    qiLittleEndianParser(it, msg.heading_dot);
+    littleEndianParser(it, msg.heading);
+    littleEndianParser(it, msg.pitch);
+    littleEndianParser(it, msg.roll);
+    littleEndianParser(it, msg.pitch_dot);
+    littleEndianParser(it, msg.roll_dot);
+    littleEndianParser(it, msg.heading_dot);
     if (use_ros_axis_orientation)
     {
         if (validValue(msg.heading))
@@ -955,14 +1004,14 @@ template <typename It>
 
 /**
  * AttCovEulerParser
- * @brief Qi based parser for the SBF block "AttCovEuler"
+ * @brief Parser for the SBF block "AttCovEuler"
  */
 template <typename It>
 [[nodiscard]] bool AttCovEulerParser(ROSaicNodeBase* node, It it, It itEnd,
                                      AttCovEulerMsg& msg,
                                      bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5939)
     {
@@ -970,14 +1019,16 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
+    if (!enoughBytes(node, it, itEnd, 26))
+        return false;
     ++it; // reserved
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.cov_headhead);
-    qiLittleEndianParser(it, msg.cov_pitchpitch);
-    qiLittleEndianParser(it, msg.cov_rollroll);
-    qiLittleEndianParser(it, msg.cov_headpitch);
-    qiLittleEndianParser(it, msg.cov_headroll);
-    qiLittleEndianParser(it, msg.cov_pitchroll);
+    littleEndianParser(it, msg.error);
+    littleEndianParser(it, msg.cov_headhead);
+    littleEndianParser(it, msg.cov_pitchpitch);
+    littleEndianParser(it, msg.cov_rollroll);
+    littleEndianParser(it, msg.cov_headpitch);
+    littleEndianParser(it, msg.cov_headroll);
+    littleEndianParser(it, msg.cov_pitchroll);
     if (use_ros_axis_orientation)
     {
         if (validValue(msg.cov_headroll))
@@ -995,38 +1046,38 @@ template <typename It>
 
 /**
  * VectorInfoCartParser
- * @brief Qi based parser for the SBF sub-block "VectorInfoCart"
+ * @brief Parser for the SBF sub-block "VectorInfoCart"
  */
 template <typename It>
 void VectorInfoCartParser(It& it, VectorInfoCartMsg& msg, uint8_t sb_length)
 {
-    qiLittleEndianParser(it, msg.nr_sv);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.mode);
-    qiLittleEndianParser(it, msg.misc);
-    qiLittleEndianParser(it, msg.delta_x);
-    qiLittleEndianParser(it, msg.delta_y);
-    qiLittleEndianParser(it, msg.delta_z);
-    qiLittleEndianParser(it, msg.delta_vx);
-    qiLittleEndianParser(it, msg.delta_vy);
-    qiLittleEndianParser(it, msg.delta_vz);
-    qiLittleEndianParser(it, msg.azimuth);
-    qiLittleEndianParser(it, msg.elevation);
-    qiLittleEndianParser(it, msg.reference_id);
-    qiLittleEndianParser(it, msg.corr_age);
-    qiLittleEndianParser(it, msg.signal_info);
+    littleEndianParser(it, msg.nr_sv);
+    littleEndianParser(it, msg.error);
+    littleEndianParser(it, msg.mode);
+    littleEndianParser(it, msg.misc);
+    littleEndianParser(it, msg.delta_x);
+    littleEndianParser(it, msg.delta_y);
+    littleEndianParser(it, msg.delta_z);
+    littleEndianParser(it, msg.delta_vx);
+    littleEndianParser(it, msg.delta_vy);
+    littleEndianParser(it, msg.delta_vz);
+    littleEndianParser(it, msg.azimuth);
+    littleEndianParser(it, msg.elevation);
+    littleEndianParser(it, msg.reference_id);
+    littleEndianParser(it, msg.corr_age);
+    littleEndianParser(it, msg.signal_info);
     std::advance(it, sb_length - 52); // skip padding
 };
 
 /**
  * BaseVectorCartParser
- * @brief Qi based parser for the SBF block "BaseVectorCart"
+ * @brief Parser for the SBF block "BaseVectorCart"
  */
 template <typename It>
 [[nodiscard]] bool BaseVectorCartParser(ROSaicNodeBase* node, It it, It itEnd,
                                         BaseVectorCartMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4043)
     {
@@ -1034,14 +1085,24 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.n);
+    if (!enoughBytes(node, it, itEnd, 2))
+        return false;
+    littleEndianParser(it, msg.n);
     if (msg.n > MAXSB_NBVECTORINFO)
     {
         node->log(log_level::ERROR,
                   "Parse error: Too many VectorInfoCart " + std::to_string(msg.n));
         return false;
     }
-    qiLittleEndianParser(it, msg.sb_length);
+    littleEndianParser(it, msg.sb_length);
+    if (msg.sb_length < 52)
+    {
+        node->log(log_level::ERROR, "Parse error: Wrong sub-block length " +
+                                        std::to_string(msg.sb_length));
+        return false;
+    }
+    if (!enoughBytes(node, it, itEnd, static_cast<std::size_t>(msg.n) * msg.sb_length))
+        return false;
     msg.vector_info_cart.resize(msg.n);
     for (auto& vector_info_cart : msg.vector_info_cart)
     {
@@ -1057,38 +1118,38 @@ template <typename It>
 
 /**
  * VectorInfoGeodParser
- * @brief Qi based parser for the SBF sub-block "VectorInfoGeod"
+ * @brief Parser for the SBF sub-block "VectorInfoGeod"
  */
 template <typename It>
 void VectorInfoGeodParser(It& it, VectorInfoGeodMsg& msg, uint8_t sb_length)
 {
-    qiLittleEndianParser(it, msg.nr_sv);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.mode);
-    qiLittleEndianParser(it, msg.misc);
-    qiLittleEndianParser(it, msg.delta_east);
-    qiLittleEndianParser(it, msg.delta_north);
-    qiLittleEndianParser(it, msg.delta_up);
-    qiLittleEndianParser(it, msg.delta_ve);
-    qiLittleEndianParser(it, msg.delta_vn);
-    qiLittleEndianParser(it, msg.delta_vu);
-    qiLittleEndianParser(it, msg.azimuth);
-    qiLittleEndianParser(it, msg.elevation);
-    qiLittleEndianParser(it, msg.reference_id);
-    qiLittleEndianParser(it, msg.corr_age);
-    qiLittleEndianParser(it, msg.signal_info);
+    littleEndianParser(it, msg.nr_sv);
+    littleEndianParser(it, msg.error);
+    littleEndianParser(it, msg.mode);
+    littleEndianParser(it, msg.misc);
+    littleEndianParser(it, msg.delta_east);
+    littleEndianParser(it, msg.delta_north);
+    littleEndianParser(it, msg.delta_up);
+    littleEndianParser(it, msg.delta_ve);
+    littleEndianParser(it, msg.delta_vn);
+    littleEndianParser(it, msg.delta_vu);
+    littleEndianParser(it, msg.azimuth);
+    littleEndianParser(it, msg.elevation);
+    littleEndianParser(it, msg.reference_id);
+    littleEndianParser(it, msg.corr_age);
+    littleEndianParser(it, msg.signal_info);
     std::advance(it, sb_length - 52); // skip padding
 };
 
 /**
  * BaseVectorGeodParser
- * @brief Qi based parser for the SBF block "BaseVectorGeod"
+ * @brief Parser for the SBF block "BaseVectorGeod"
  */
 template <typename It>
 [[nodiscard]] bool BaseVectorGeodParser(ROSaicNodeBase* node, It it, It itEnd,
                                         BaseVectorGeodMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4028)
     {
@@ -1096,14 +1157,24 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.n);
+    if (!enoughBytes(node, it, itEnd, 2))
+        return false;
+    littleEndianParser(it, msg.n);
     if (msg.n > MAXSB_NBVECTORINFO)
     {
         node->log(log_level::ERROR,
                   "Parse error: Too many VectorInfoGeod " + std::to_string(msg.n));
         return false;
     }
-    qiLittleEndianParser(it, msg.sb_length);
+    littleEndianParser(it, msg.sb_length);
+    if (msg.sb_length < 52)
+    {
+        node->log(log_level::ERROR, "Parse error: Wrong sub-block length " +
+                                        std::to_string(msg.sb_length));
+        return false;
+    }
+    if (!enoughBytes(node, it, itEnd, static_cast<std::size_t>(msg.n) * msg.sb_length))
+        return false;
     msg.vector_info_geod.resize(msg.n);
     for (auto& vector_info_geod : msg.vector_info_geod)
     {
@@ -1119,14 +1190,14 @@ template <typename It>
 
 /**
  * INSNavCartParser
- * @brief Qi based parser for the SBF block "INSNavCart"
+ * @brief Parser for the SBF block "INSNavCart"
  */
 template <typename It>
 [[nodiscard]] bool INSNavCartParser(ROSaicNodeBase* node, It it, It itEnd,
                                     INSNavCartMsg& msg,
                                     bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if ((msg.block_header.id != 4225) && (msg.block_header.id != 4229))
     {
@@ -1134,23 +1205,29 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.gnss_mode);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.info);
-    qiLittleEndianParser(it, msg.gnss_age);
-    qiLittleEndianParser(it, msg.x);
-    qiLittleEndianParser(it, msg.y);
-    qiLittleEndianParser(it, msg.z);
-    qiLittleEndianParser(it, msg.accuracy);
-    qiLittleEndianParser(it, msg.latency);
-    qiLittleEndianParser(it, msg.datum);
+    if (!enoughBytes(node, it, itEnd, 38))
+        return false;
+    littleEndianParser(it, msg.gnss_mode);
+    littleEndianParser(it, msg.error);
+    littleEndianParser(it, msg.info);
+    littleEndianParser(it, msg.gnss_age);
+    littleEndianParser(it, msg.x);
+    littleEndianParser(it, msg.y);
+    littleEndianParser(it, msg.z);
+    littleEndianParser(it, msg.accuracy);
+    littleEndianParser(it, msg.latency);
+    littleEndianParser(it, msg.datum);
     ++it; // reserved
-    qiLittleEndianParser(it, msg.sb_list);
+    littleEndianParser(it, msg.sb_list);
+    // Three values of 4 bytes for each sub-block selected by SBList
+    if (!enoughBytes(node, it, itEnd,
+                     12 * std::bitset<8>(msg.sb_list & 0xFF).count()))
+        return false;
     if ((msg.sb_list & 1) != 0)
     {
-        qiLittleEndianParser(it, msg.x_std_dev);
-        qiLittleEndianParser(it, msg.y_std_dev);
-        qiLittleEndianParser(it, msg.z_std_dev);
+        littleEndianParser(it, msg.x_std_dev);
+        littleEndianParser(it, msg.y_std_dev);
+        littleEndianParser(it, msg.z_std_dev);
     } else
     {
         setDoNotUse(msg.x_std_dev);
@@ -1159,9 +1236,9 @@ template <typename It>
     }
     if ((msg.sb_list & 2) != 0)
     {
-        qiLittleEndianParser(it, msg.heading);
-        qiLittleEndianParser(it, msg.pitch);
-        qiLittleEndianParser(it, msg.roll);
+        littleEndianParser(it, msg.heading);
+        littleEndianParser(it, msg.pitch);
+        littleEndianParser(it, msg.roll);
         if (use_ros_axis_orientation)
         {
             if (validValue(msg.heading))
@@ -1177,9 +1254,9 @@ template <typename It>
     }
     if ((msg.sb_list & 4) != 0)
     {
-        qiLittleEndianParser(it, msg.heading_std_dev);
-        qiLittleEndianParser(it, msg.pitch_std_dev);
-        qiLittleEndianParser(it, msg.roll_std_dev);
+        littleEndianParser(it, msg.heading_std_dev);
+        littleEndianParser(it, msg.pitch_std_dev);
+        littleEndianParser(it, msg.roll_std_dev);
     } else
     {
         setDoNotUse(msg.heading_std_dev);
@@ -1188,9 +1265,9 @@ template <typename It>
     }
     if ((msg.sb_list & 8) != 0)
     {
-        qiLittleEndianParser(it, msg.vx);
-        qiLittleEndianParser(it, msg.vy);
-        qiLittleEndianParser(it, msg.vz);
+        littleEndianParser(it, msg.vx);
+        littleEndianParser(it, msg.vy);
+        littleEndianParser(it, msg.vz);
     } else
     {
         setDoNotUse(msg.vx);
@@ -1199,9 +1276,9 @@ template <typename It>
     }
     if ((msg.sb_list & 16) != 0)
     {
-        qiLittleEndianParser(it, msg.vx_std_dev);
-        qiLittleEndianParser(it, msg.vy_std_dev);
-        qiLittleEndianParser(it, msg.vz_std_dev);
+        littleEndianParser(it, msg.vx_std_dev);
+        littleEndianParser(it, msg.vy_std_dev);
+        littleEndianParser(it, msg.vz_std_dev);
     } else
     {
         setDoNotUse(msg.vx_std_dev);
@@ -1210,9 +1287,9 @@ template <typename It>
     }
     if ((msg.sb_list & 32) != 0)
     {
-        qiLittleEndianParser(it, msg.xy_cov);
-        qiLittleEndianParser(it, msg.xz_cov);
-        qiLittleEndianParser(it, msg.yz_cov);
+        littleEndianParser(it, msg.xy_cov);
+        littleEndianParser(it, msg.xz_cov);
+        littleEndianParser(it, msg.yz_cov);
     } else
     {
         setDoNotUse(msg.xy_cov);
@@ -1221,9 +1298,9 @@ template <typename It>
     }
     if ((msg.sb_list & 64) != 0)
     {
-        qiLittleEndianParser(it, msg.heading_pitch_cov);
-        qiLittleEndianParser(it, msg.heading_roll_cov);
-        qiLittleEndianParser(it, msg.pitch_roll_cov);
+        littleEndianParser(it, msg.heading_pitch_cov);
+        littleEndianParser(it, msg.heading_roll_cov);
+        littleEndianParser(it, msg.pitch_roll_cov);
         if (use_ros_axis_orientation)
         {
             if (validValue(msg.heading_roll_cov))
@@ -1239,9 +1316,9 @@ template <typename It>
     }
     if ((msg.sb_list & 128) != 0)
     {
-        qiLittleEndianParser(it, msg.vx_vy_cov);
-        qiLittleEndianParser(it, msg.vx_vz_cov);
-        qiLittleEndianParser(it, msg.vy_vz_cov);
+        littleEndianParser(it, msg.vx_vy_cov);
+        littleEndianParser(it, msg.vx_vz_cov);
+        littleEndianParser(it, msg.vy_vz_cov);
     } else
     {
         setDoNotUse(msg.vx_vy_cov);
@@ -1258,13 +1335,13 @@ template <typename It>
 
 /**
  * PosCovCartesianParser
- * @brief Qi based parser for the SBF block "PosCovCartesian"
+ * @brief Parser for the SBF block "PosCovCartesian"
  */
 template <typename It>
 [[nodiscard]] bool PosCovCartesianParser(ROSaicNodeBase* node, It it, It itEnd,
                                          PosCovCartesianMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5905)
     {
@@ -1272,18 +1349,20 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.mode);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.cov_xx);
-    qiLittleEndianParser(it, msg.cov_yy);
-    qiLittleEndianParser(it, msg.cov_zz);
-    qiLittleEndianParser(it, msg.cov_bb);
-    qiLittleEndianParser(it, msg.cov_xy);
-    qiLittleEndianParser(it, msg.cov_xz);
-    qiLittleEndianParser(it, msg.cov_xb);
-    qiLittleEndianParser(it, msg.cov_yz);
-    qiLittleEndianParser(it, msg.cov_yb);
-    qiLittleEndianParser(it, msg.cov_zb);
+    if (!enoughBytes(node, it, itEnd, 42))
+        return false;
+    littleEndianParser(it, msg.mode);
+    littleEndianParser(it, msg.error);
+    littleEndianParser(it, msg.cov_xx);
+    littleEndianParser(it, msg.cov_yy);
+    littleEndianParser(it, msg.cov_zz);
+    littleEndianParser(it, msg.cov_bb);
+    littleEndianParser(it, msg.cov_xy);
+    littleEndianParser(it, msg.cov_xz);
+    littleEndianParser(it, msg.cov_xb);
+    littleEndianParser(it, msg.cov_yz);
+    littleEndianParser(it, msg.cov_yb);
+    littleEndianParser(it, msg.cov_zb);
     if (it > itEnd)
     {
         node->log(log_level::ERROR, "Parse error: iterator past end.");
@@ -1294,13 +1373,13 @@ template <typename It>
 
 /**
  * PosCovGeodeticParser
- * @brief Qi based parser for the SBF block "PosCovGeodetic"
+ * @brief Parser for the SBF block "PosCovGeodetic"
  */
 template <typename It>
 [[nodiscard]] bool PosCovGeodeticParser(ROSaicNodeBase* node, It it, It itEnd,
                                         PosCovGeodeticMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5906)
     {
@@ -1308,18 +1387,20 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.mode);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.cov_latlat);
-    qiLittleEndianParser(it, msg.cov_lonlon);
-    qiLittleEndianParser(it, msg.cov_hgthgt);
-    qiLittleEndianParser(it, msg.cov_bb);
-    qiLittleEndianParser(it, msg.cov_latlon);
-    qiLittleEndianParser(it, msg.cov_lathgt);
-    qiLittleEndianParser(it, msg.cov_latb);
-    qiLittleEndianParser(it, msg.cov_lonhgt);
-    qiLittleEndianParser(it, msg.cov_lonb);
-    qiLittleEndianParser(it, msg.cov_hb);
+    if (!enoughBytes(node, it, itEnd, 42))
+        return false;
+    littleEndianParser(it, msg.mode);
+    littleEndianParser(it, msg.error);
+    littleEndianParser(it, msg.cov_latlat);
+    littleEndianParser(it, msg.cov_lonlon);
+    littleEndianParser(it, msg.cov_hgthgt);
+    littleEndianParser(it, msg.cov_bb);
+    littleEndianParser(it, msg.cov_latlon);
+    littleEndianParser(it, msg.cov_lathgt);
+    littleEndianParser(it, msg.cov_latb);
+    littleEndianParser(it, msg.cov_lonhgt);
+    littleEndianParser(it, msg.cov_lonb);
+    littleEndianParser(it, msg.cov_hb);
     if (it > itEnd)
     {
         node->log(log_level::ERROR, "Parse error: iterator past end.");
@@ -1330,13 +1411,13 @@ template <typename It>
 
 /**
  * VelCovCartesianParser
- * @brief Qi based parser for the SBF block "VelCovCartesian"
+ * @brief Parser for the SBF block "VelCovCartesian"
  */
 template <typename It>
 [[nodiscard]] bool VelCovCartesianParser(ROSaicNodeBase* node, It it, It itEnd,
                                          VelCovCartesianMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5907)
     {
@@ -1344,18 +1425,20 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.mode);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.cov_vxvx);
-    qiLittleEndianParser(it, msg.cov_vyvy);
-    qiLittleEndianParser(it, msg.cov_vzvz);
-    qiLittleEndianParser(it, msg.cov_dtdt);
-    qiLittleEndianParser(it, msg.cov_vxvy);
-    qiLittleEndianParser(it, msg.cov_vxvz);
-    qiLittleEndianParser(it, msg.cov_vxdt);
-    qiLittleEndianParser(it, msg.cov_vyvz);
-    qiLittleEndianParser(it, msg.cov_vydt);
-    qiLittleEndianParser(it, msg.cov_vzdt);
+    if (!enoughBytes(node, it, itEnd, 42))
+        return false;
+    littleEndianParser(it, msg.mode);
+    littleEndianParser(it, msg.error);
+    littleEndianParser(it, msg.cov_vxvx);
+    littleEndianParser(it, msg.cov_vyvy);
+    littleEndianParser(it, msg.cov_vzvz);
+    littleEndianParser(it, msg.cov_dtdt);
+    littleEndianParser(it, msg.cov_vxvy);
+    littleEndianParser(it, msg.cov_vxvz);
+    littleEndianParser(it, msg.cov_vxdt);
+    littleEndianParser(it, msg.cov_vyvz);
+    littleEndianParser(it, msg.cov_vydt);
+    littleEndianParser(it, msg.cov_vzdt);
     if (it > itEnd)
     {
         node->log(log_level::ERROR, "Parse error: iterator past end.");
@@ -1366,13 +1449,13 @@ template <typename It>
 
 /**
  * VelCovGeodeticParser
- * @brief Qi based parser for the SBF block "VelCovGeodetic"
+ * @brief Parser for the SBF block "VelCovGeodetic"
  */
 template <typename It>
 [[nodiscard]] bool VelCovGeodeticParser(ROSaicNodeBase* node, It it, It itEnd,
                                         VelCovGeodeticMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5908)
     {
@@ -1380,18 +1463,20 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.mode);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.cov_vnvn);
-    qiLittleEndianParser(it, msg.cov_veve);
-    qiLittleEndianParser(it, msg.cov_vuvu);
-    qiLittleEndianParser(it, msg.cov_dtdt);
-    qiLittleEndianParser(it, msg.cov_vnve);
-    qiLittleEndianParser(it, msg.cov_vnvu);
-    qiLittleEndianParser(it, msg.cov_vndt);
-    qiLittleEndianParser(it, msg.cov_vevu);
-    qiLittleEndianParser(it, msg.cov_vedt);
-    qiLittleEndianParser(it, msg.cov_vudt);
+    if (!enoughBytes(node, it, itEnd, 42))
+        return false;
+    littleEndianParser(it, msg.mode);
+    littleEndianParser(it, msg.error);
+    littleEndianParser(it, msg.cov_vnvn);
+    littleEndianParser(it, msg.cov_veve);
+    littleEndianParser(it, msg.cov_vuvu);
+    littleEndianParser(it, msg.cov_dtdt);
+    littleEndianParser(it, msg.cov_vnve);
+    littleEndianParser(it, msg.cov_vnvu);
+    littleEndianParser(it, msg.cov_vndt);
+    littleEndianParser(it, msg.cov_vevu);
+    littleEndianParser(it, msg.cov_vedt);
+    littleEndianParser(it, msg.cov_vudt);
     if (it > itEnd)
     {
         node->log(log_level::ERROR, "Parse error: iterator past end.");
@@ -1402,13 +1487,13 @@ template <typename It>
 
 /**
  * QualityIndParser
- * @brief @brief Qi based parser for the SBF block "QualityInd"
+ * @brief Parser for the SBF block "QualityInd"
  */
 template <typename It>
 [[nodiscard]] bool QualityIndParser(ROSaicNodeBase* node, It it, It itEnd,
                                     QualityInd& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4082)
     {
@@ -1416,7 +1501,9 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.n);
+    if (!enoughBytes(node, it, itEnd, 2))
+        return false;
+    littleEndianParser(it, msg.n);
     if (msg.n > 40)
     {
         node->log(log_level::ERROR,
@@ -1424,11 +1511,13 @@ template <typename It>
         return false;
     }
     ++it; // reserved
+    if (!enoughBytes(node, it, itEnd, static_cast<std::size_t>(msg.n) * sizeof(uint16_t)))
+        return false;
     msg.indicators.resize(msg.n);
     std::vector<uint16_t> indicators;
     for (auto& indicators : msg.indicators)
     {
-        qiLittleEndianParser(it, indicators);
+        littleEndianParser(it, indicators);
     }
     if (it > itEnd)
     {
@@ -1443,12 +1532,12 @@ template <typename It>
  * @brief Struct for the SBF sub-block "AGCState"
  */
 template <typename It>
-void AgcStateParser(It it, AgcState& msg, uint8_t sb_length)
+void AgcStateParser(It& it, AgcState& msg, uint8_t sb_length)
 {
-    qiLittleEndianParser(it, msg.frontend_id);
-    qiLittleEndianParser(it, msg.gain);
-    qiLittleEndianParser(it, msg.sample_var);
-    qiLittleEndianParser(it, msg.blanking_stat);
+    littleEndianParser(it, msg.frontend_id);
+    littleEndianParser(it, msg.gain);
+    littleEndianParser(it, msg.sample_var);
+    littleEndianParser(it, msg.blanking_stat);
     std::advance(it, sb_length - 4); // skip padding
 };
 
@@ -1460,7 +1549,7 @@ template <typename It>
 [[nodiscard]] bool ReceiverStatusParser(ROSaicNodeBase* node, It it, It itEnd,
                                         ReceiverStatus& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4014)
     {
@@ -1468,21 +1557,31 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.cpu_load);
-    qiLittleEndianParser(it, msg.ext_error);
-    qiLittleEndianParser(it, msg.up_time);
-    qiLittleEndianParser(it, msg.rx_status);
-    qiLittleEndianParser(it, msg.rx_error);
-    qiLittleEndianParser(it, msg.n);
+    if (!enoughBytes(node, it, itEnd, 18))
+        return false;
+    littleEndianParser(it, msg.cpu_load);
+    littleEndianParser(it, msg.ext_error);
+    littleEndianParser(it, msg.up_time);
+    littleEndianParser(it, msg.rx_status);
+    littleEndianParser(it, msg.rx_error);
+    littleEndianParser(it, msg.n);
     if (msg.n > 18)
     {
         node->log(log_level::ERROR,
                   "Parse error: Too many AGCState " + std::to_string(msg.n));
         return false;
     }
-    qiLittleEndianParser(it, msg.sb_length);
-    qiLittleEndianParser(it, msg.cmd_count);
-    qiLittleEndianParser(it, msg.temperature);
+    littleEndianParser(it, msg.sb_length);
+    littleEndianParser(it, msg.cmd_count);
+    littleEndianParser(it, msg.temperature);
+    if (msg.sb_length < 4)
+    {
+        node->log(log_level::ERROR, "Parse error: Wrong sub-block length " +
+                                        std::to_string(msg.sb_length));
+        return false;
+    }
+    if (!enoughBytes(node, it, itEnd, static_cast<std::size_t>(msg.n) * msg.sb_length))
+        return false;
     msg.agc_state.resize(msg.n);
     for (auto& agc_state : msg.agc_state)
     {
@@ -1504,7 +1603,7 @@ template <typename It>
 [[nodiscard]] bool ReceiverTimeParser(ROSaicNodeBase* node, It it, It itEnd,
                                       ReceiverTimeMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5914)
     {
@@ -1512,14 +1611,16 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.utc_year);
-    qiLittleEndianParser(it, msg.utc_month);
-    qiLittleEndianParser(it, msg.utc_day);
-    qiLittleEndianParser(it, msg.utc_hour);
-    qiLittleEndianParser(it, msg.utc_min);
-    qiLittleEndianParser(it, msg.utc_second);
-    qiLittleEndianParser(it, msg.delta_ls);
-    qiLittleEndianParser(it, msg.sync_level);
+    if (!enoughBytes(node, it, itEnd, 8))
+        return false;
+    littleEndianParser(it, msg.utc_year);
+    littleEndianParser(it, msg.utc_month);
+    littleEndianParser(it, msg.utc_day);
+    littleEndianParser(it, msg.utc_hour);
+    littleEndianParser(it, msg.utc_min);
+    littleEndianParser(it, msg.utc_second);
+    littleEndianParser(it, msg.delta_ls);
+    littleEndianParser(it, msg.sync_level);
     if (it > itEnd)
     {
         node->log(log_level::ERROR, "Parse error: iterator past end.");
@@ -1530,14 +1631,14 @@ template <typename It>
 
 /**
  * INSNavGeodParser
- * @brief Qi based parser for the SBF block "INSNavGeod"
+ * @brief Parser for the SBF block "INSNavGeod"
  */
 template <typename It>
 [[nodiscard]] bool INSNavGeodParser(ROSaicNodeBase* node, It it, It itEnd,
                                     INSNavGeodMsg& msg,
                                     bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if ((msg.block_header.id != 4226) && (msg.block_header.id != 4230))
     {
@@ -1545,24 +1646,30 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.gnss_mode);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.info);
-    qiLittleEndianParser(it, msg.gnss_age);
-    qiLittleEndianParser(it, msg.latitude);
-    qiLittleEndianParser(it, msg.longitude);
-    qiLittleEndianParser(it, msg.height);
-    qiLittleEndianParser(it, msg.undulation);
-    qiLittleEndianParser(it, msg.accuracy);
-    qiLittleEndianParser(it, msg.latency);
-    qiLittleEndianParser(it, msg.datum);
+    if (!enoughBytes(node, it, itEnd, 42))
+        return false;
+    littleEndianParser(it, msg.gnss_mode);
+    littleEndianParser(it, msg.error);
+    littleEndianParser(it, msg.info);
+    littleEndianParser(it, msg.gnss_age);
+    littleEndianParser(it, msg.latitude);
+    littleEndianParser(it, msg.longitude);
+    littleEndianParser(it, msg.height);
+    littleEndianParser(it, msg.undulation);
+    littleEndianParser(it, msg.accuracy);
+    littleEndianParser(it, msg.latency);
+    littleEndianParser(it, msg.datum);
     ++it; // reserved
-    qiLittleEndianParser(it, msg.sb_list);
+    littleEndianParser(it, msg.sb_list);
+    // Three values of 4 bytes for each sub-block selected by SBList
+    if (!enoughBytes(node, it, itEnd,
+                     12 * std::bitset<8>(msg.sb_list & 0xFF).count()))
+        return false;
     if ((msg.sb_list & 1) != 0)
     {
-        qiLittleEndianParser(it, msg.latitude_std_dev);
-        qiLittleEndianParser(it, msg.longitude_std_dev);
-        qiLittleEndianParser(it, msg.height_std_dev);
+        littleEndianParser(it, msg.latitude_std_dev);
+        littleEndianParser(it, msg.longitude_std_dev);
+        littleEndianParser(it, msg.height_std_dev);
     } else
     {
         setDoNotUse(msg.latitude_std_dev);
@@ -1571,9 +1678,9 @@ template <typename It>
     }
     if ((msg.sb_list & 2) != 0)
     {
-        qiLittleEndianParser(it, msg.heading);
-        qiLittleEndianParser(it, msg.pitch);
-        qiLittleEndianParser(it, msg.roll);
+        littleEndianParser(it, msg.heading);
+        littleEndianParser(it, msg.pitch);
+        littleEndianParser(it, msg.roll);
         if (use_ros_axis_orientation)
         {
             if (validValue(msg.heading))
@@ -1589,9 +1696,9 @@ template <typename It>
     }
     if ((msg.sb_list & 4) != 0)
     {
-        qiLittleEndianParser(it, msg.heading_std_dev);
-        qiLittleEndianParser(it, msg.pitch_std_dev);
-        qiLittleEndianParser(it, msg.roll_std_dev);
+        littleEndianParser(it, msg.heading_std_dev);
+        littleEndianParser(it, msg.pitch_std_dev);
+        littleEndianParser(it, msg.roll_std_dev);
     } else
     {
         setDoNotUse(msg.heading_std_dev);
@@ -1600,9 +1707,9 @@ template <typename It>
     }
     if ((msg.sb_list & 8) != 0)
     {
-        qiLittleEndianParser(it, msg.ve);
-        qiLittleEndianParser(it, msg.vn);
-        qiLittleEndianParser(it, msg.vu);
+        littleEndianParser(it, msg.ve);
+        littleEndianParser(it, msg.vn);
+        littleEndianParser(it, msg.vu);
     } else
     {
         setDoNotUse(msg.ve);
@@ -1611,9 +1718,9 @@ template <typename It>
     }
     if ((msg.sb_list & 16) != 0)
     {
-        qiLittleEndianParser(it, msg.ve_std_dev);
-        qiLittleEndianParser(it, msg.vn_std_dev);
-        qiLittleEndianParser(it, msg.vu_std_dev);
+        littleEndianParser(it, msg.ve_std_dev);
+        littleEndianParser(it, msg.vn_std_dev);
+        littleEndianParser(it, msg.vu_std_dev);
     } else
     {
         setDoNotUse(msg.ve_std_dev);
@@ -1622,9 +1729,9 @@ template <typename It>
     }
     if ((msg.sb_list & 32) != 0)
     {
-        qiLittleEndianParser(it, msg.latitude_longitude_cov);
-        qiLittleEndianParser(it, msg.latitude_height_cov);
-        qiLittleEndianParser(it, msg.longitude_height_cov);
+        littleEndianParser(it, msg.latitude_longitude_cov);
+        littleEndianParser(it, msg.latitude_height_cov);
+        littleEndianParser(it, msg.longitude_height_cov);
     } else
     {
         setDoNotUse(msg.latitude_longitude_cov);
@@ -1633,9 +1740,9 @@ template <typename It>
     }
     if ((msg.sb_list & 64) != 0)
     {
-        qiLittleEndianParser(it, msg.heading_pitch_cov);
-        qiLittleEndianParser(it, msg.heading_roll_cov);
-        qiLittleEndianParser(it, msg.pitch_roll_cov);
+        littleEndianParser(it, msg.heading_pitch_cov);
+        littleEndianParser(it, msg.heading_roll_cov);
+        littleEndianParser(it, msg.pitch_roll_cov);
         if (use_ros_axis_orientation)
         {
             if (validValue(msg.heading_roll_cov))
@@ -1651,9 +1758,9 @@ template <typename It>
     }
     if ((msg.sb_list & 128) != 0)
     {
-        qiLittleEndianParser(it, msg.ve_vn_cov);
-        qiLittleEndianParser(it, msg.ve_vu_cov);
-        qiLittleEndianParser(it, msg.vn_vu_cov);
+        littleEndianParser(it, msg.ve_vn_cov);
+        littleEndianParser(it, msg.ve_vu_cov);
+        littleEndianParser(it, msg.vn_vu_cov);
     } else
     {
         setDoNotUse(msg.ve_vn_cov);
@@ -1670,13 +1777,13 @@ template <typename It>
 
 /**
  * IMUSetupParser
- * @brief Qi based parser for the SBF block "IMUSetup"
+ * @brief Parser for the SBF block "IMUSetup"
  */
 template <typename It>
 [[nodiscard]] bool IMUSetupParser(ROSaicNodeBase* node, It it, It itEnd,
                                   IMUSetupMsg& msg, bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4224)
     {
@@ -1684,14 +1791,16 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
+    if (!enoughBytes(node, it, itEnd, 26))
+        return false;
     ++it; // reserved
-    qiLittleEndianParser(it, msg.serial_port);
-    qiLittleEndianParser(it, msg.ant_lever_arm_x);
-    qiLittleEndianParser(it, msg.ant_lever_arm_y);
-    qiLittleEndianParser(it, msg.ant_lever_arm_z);
-    qiLittleEndianParser(it, msg.theta_x);
-    qiLittleEndianParser(it, msg.theta_y);
-    qiLittleEndianParser(it, msg.theta_z);
+    littleEndianParser(it, msg.serial_port);
+    littleEndianParser(it, msg.ant_lever_arm_x);
+    littleEndianParser(it, msg.ant_lever_arm_y);
+    littleEndianParser(it, msg.ant_lever_arm_z);
+    littleEndianParser(it, msg.theta_x);
+    littleEndianParser(it, msg.theta_y);
+    littleEndianParser(it, msg.theta_z);
     if (use_ros_axis_orientation)
     {
         msg.ant_lever_arm_y = -msg.ant_lever_arm_y;
@@ -1708,14 +1817,14 @@ template <typename It>
 
 /**
  * VelSensorSetupParser
- * @brief Qi based parser for the SBF block "VelSensorSetup"
+ * @brief Parser for the SBF block "VelSensorSetup"
  */
 template <typename It>
 [[nodiscard]] bool VelSensorSetupParser(ROSaicNodeBase* node, It it, It itEnd,
                                         VelSensorSetupMsg& msg,
                                         bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4244)
     {
@@ -1723,11 +1832,13 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
+    if (!enoughBytes(node, it, itEnd, 14))
+        return false;
     ++it; // reserved
-    qiLittleEndianParser(it, msg.port);
-    qiLittleEndianParser(it, msg.lever_arm_x);
-    qiLittleEndianParser(it, msg.lever_arm_y);
-    qiLittleEndianParser(it, msg.lever_arm_z);
+    littleEndianParser(it, msg.port);
+    littleEndianParser(it, msg.lever_arm_x);
+    littleEndianParser(it, msg.lever_arm_y);
+    littleEndianParser(it, msg.lever_arm_z);
     if (use_ros_axis_orientation)
     {
         msg.lever_arm_y = -msg.lever_arm_y;
@@ -1743,14 +1854,14 @@ template <typename It>
 
 /**
  * ExtSensorMeasParser
- * @brief Qi based parser for the SBF block "ExtSensorMeas"
+ * @brief Parser for the SBF block "ExtSensorMeas"
  */
 template <typename It>
 [[nodiscard]] bool
 ExtSensorMeasParser(ROSaicNodeBase* node, It it, It itEnd, ExtSensorMeasMsg& msg,
                     bool use_ros_axis_orientation, bool& hasImuMeas)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4050)
     {
@@ -1758,8 +1869,10 @@ ExtSensorMeasParser(ROSaicNodeBase* node, It it, It itEnd, ExtSensorMeasMsg& msg
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.n);
-    qiLittleEndianParser(it, msg.sb_length);
+    if (!enoughBytes(node, it, itEnd, 2))
+        return false;
+    littleEndianParser(it, msg.n);
+    littleEndianParser(it, msg.sb_length);
     if (msg.sb_length != 28)
     {
         node->log(log_level::ERROR,
@@ -1786,6 +1899,8 @@ ExtSensorMeasParser(ROSaicNodeBase* node, It it, It itEnd, ExtSensorMeasMsg& msg
     msg.sensor_temperature = std::numeric_limits<float>::quiet_NaN();
     msg.zero_velocity_flag = std::numeric_limits<double>::quiet_NaN();
 
+    if (!enoughBytes(node, it, itEnd, static_cast<std::size_t>(msg.n) * msg.sb_length))
+        return false;
     msg.source.resize(msg.n);
     msg.sensor_model.resize(msg.n);
     msg.type.resize(msg.n);
@@ -1795,33 +1910,33 @@ ExtSensorMeasParser(ROSaicNodeBase* node, It it, It itEnd, ExtSensorMeasMsg& msg
     hasImuMeas = false;
     for (size_t i = 0; i < msg.n; i++)
     {
-        qiLittleEndianParser(it, msg.source[i]);
-        qiLittleEndianParser(it, msg.sensor_model[i]);
-        qiLittleEndianParser(it, msg.type[i]);
-        qiLittleEndianParser(it, msg.obs_info[i]);
+        littleEndianParser(it, msg.source[i]);
+        littleEndianParser(it, msg.sensor_model[i]);
+        littleEndianParser(it, msg.type[i]);
+        littleEndianParser(it, msg.obs_info[i]);
 
         switch (msg.type[i])
         {
         case 0:
         {
-            qiLittleEndianParser(it, msg.acceleration_x);
-            qiLittleEndianParser(it, msg.acceleration_y);
-            qiLittleEndianParser(it, msg.acceleration_z);
+            littleEndianParser(it, msg.acceleration_x);
+            littleEndianParser(it, msg.acceleration_y);
+            littleEndianParser(it, msg.acceleration_z);
             hasAcc = true;
             break;
         }
         case 1:
         {
-            qiLittleEndianParser(it, msg.angular_rate_x);
-            qiLittleEndianParser(it, msg.angular_rate_y);
-            qiLittleEndianParser(it, msg.angular_rate_z);
+            littleEndianParser(it, msg.angular_rate_x);
+            littleEndianParser(it, msg.angular_rate_y);
+            littleEndianParser(it, msg.angular_rate_z);
             hasOmega = true;
             break;
         }
         case 3:
         {
             int16_t temp;
-            qiLittleEndianParser(it, temp);
+            littleEndianParser(it, temp);
             if (temp != -32768)
                 msg.sensor_temperature = temp / 100.0f;
             else
@@ -1831,12 +1946,12 @@ ExtSensorMeasParser(ROSaicNodeBase* node, It it, It itEnd, ExtSensorMeasMsg& msg
         }
         case 4:
         {
-            qiLittleEndianParser(it, msg.velocity_x);
-            qiLittleEndianParser(it, msg.velocity_y);
-            qiLittleEndianParser(it, msg.velocity_z);
-            qiLittleEndianParser(it, msg.std_dev_x);
-            qiLittleEndianParser(it, msg.std_dev_y);
-            qiLittleEndianParser(it, msg.std_dev_z);
+            littleEndianParser(it, msg.velocity_x);
+            littleEndianParser(it, msg.velocity_y);
+            littleEndianParser(it, msg.velocity_z);
+            littleEndianParser(it, msg.std_dev_x);
+            littleEndianParser(it, msg.std_dev_y);
+            littleEndianParser(it, msg.std_dev_z);
             if (use_ros_axis_orientation)
             {
                 if (validValue(msg.velocity_y))
@@ -1848,7 +1963,7 @@ ExtSensorMeasParser(ROSaicNodeBase* node, It it, It itEnd, ExtSensorMeasMsg& msg
         }
         case 20:
         {
-            qiLittleEndianParser(it, msg.zero_velocity_flag);
+            littleEndianParser(it, msg.zero_velocity_flag);
             std::advance(it, 16); // reserved
             break;
         }
@@ -0,0 +1,119 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file sbf_header.hpp
+ * @brief Accessors of the SBF block header fields that do not depend on ROS
+ */
+
+namespace parsing_utilities {
+
+    //! Little-endian 16 bit value at offset of message
+    [[nodiscard]] inline uint16_t headerUInt16(const std::vector<uint8_t>& message,
+                                               size_t offset)
+    {
+        return static_cast<uint16_t>(message[offset] |
+                                     (message[offset + 1] << 8));
+    }
+
+    /**
+     * @brief Get the CRC of the SBF message
+     *
+     * @param message A buffer containing an SBF message
+     * @return SBF message CRC
+     */
+    [[nodiscard]] inline uint16_t getCrc(const std::vector<uint8_t>& message)
+    {
+        return headerUInt16(message, 2);
+    }
+
+    /**
+     * @brief Get the ID of the SBF message
+     *
+     * @param message A buffer containing an SBF message
+     * @return SBF message ID
+     */
+    [[nodiscard]] inline uint16_t getId(const std::vector<uint8_t>& message)
+    {
+        // Highest three bits are for revision and rest for block number
+        return headerUInt16(message, 4) & 8191;
+    }
+
+    /**
+     * @brief Get the revision of the SBF message
+     *
+     * @param message A buffer containing an SBF message
+     * @return SBF message revision
+     */
+    [[nodiscard]] inline uint8_t getRevision(const std::vector<uint8_t>& message)
+    {
+        return static_cast<uint8_t>(headerUInt16(message, 4) >> 13);
+    }
+
+    /**
+     * @brief Get the length of the SBF message
+     *
+     * @param message A buffer containing an SBF message
+     * @return SBF message length
+     */
+    [[nodiscard]] inline uint16_t getLength(const std::vector<uint8_t>& message)
+    {
+        return headerUInt16(message, 6);
+    }
+
+    /**
+     * @brief Get the time of week in ms of the SBF message
+     *
+     * @param[in] message A buffer containing an SBF message
+     * @return SBF time of week in ms
+     */
+    [[nodiscard]] inline uint32_t getTow(const std::vector<uint8_t>& message)
+    {
+        return headerUInt16(message, 8) |
+               (static_cast<uint32_t>(headerUInt16(message, 10)) << 16);
+    }
+
+    /**
+     * @brief Get the GPS week counter of the SBF message
+     *
+     * @param message A buffer containing an SBF message
+     * @return SBF GPS week counter
+     */
+    [[nodiscard]] inline uint16_t getWnc(const std::vector<uint8_t>& message)
+    {
+        return headerUInt16(message, 12);
+    }
+} // namespace parsing_utilities
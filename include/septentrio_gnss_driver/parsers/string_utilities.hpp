@@ -34,6 +34,7 @@
 #include <cstdint>
 #include <locale> // Merely for "isdigit()" function, also available in <cctype.h> C header..
 #include <string>
+#include <string_view>
 
 /**
  * @file string_utilities.hpp
@@ -57,7 +58,7 @@ namespace string_utilities {
      * floating point number found in "string"
      * @return True if all went fine, false if not
      */
-    [[nodiscard]] bool toDouble(const std::string& string, double& value);
+    [[nodiscard]] bool toDouble(std::string_view string, double& value);
 
     /**
      * @brief Interprets the contents of "string" as a floating point number of type
@@ -71,7 +72,7 @@ namespace string_utilities {
      * floating point number found in "string"
      * @return True if all went fine, false if not
      */
-    [[nodiscard]] bool toFloat(const std::string& string, float& value);
+    [[nodiscard]] bool toFloat(std::string_view string, float& value);
 
     /**
      * @brief Interprets the contents of "string" as a floating point number of
@@ -86,7 +87,7 @@ namespace string_utilities {
      * @param[in] base The conversion assumes this base, here: decimal
      * @return True if all went fine, false if not
      */
-    [[nodiscard]] bool toInt32(const std::string& string, int32_t& value, int32_t base = 10);
+    [[nodiscard]] bool toInt32(std::string_view string, int32_t& value, int32_t base = 10);
 
     /**
      * @brief Interprets the contents of "string" as a floating point number of
@@ -101,7 +102,7 @@ namespace string_utilities {
      * @param[in] base The conversion assumes this base, here: decimal
      * @return True if all went fine, false if not
      */
-    [[nodiscard]] bool toUInt32(const std::string& string, uint32_t& value, int32_t base = 10);
+    [[nodiscard]] bool toUInt32(std::string_view string, uint32_t& value, int32_t base = 10);
 
     /**
      * @brief Interprets the contents of "string" as a floating point number of
@@ -0,0 +1,69 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// ROSaic
+#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+
+/**
+ * @file stub_node.hpp
+ * @brief Node without connection to an Rx, to run parsers and the message handler
+ * in isolation
+ */
+
+/**
+ * @class StubNode
+ * @brief Node whose settings are zero initialized and may be set freely, velocities
+ * are discarded. Nothing is advertised unless the message handler publishes, thus
+ * it shall record instead.
+ */
+class StubNode : public ROSaicNodeBase
+{
+public:
+    StubNode()
+    {
+        settings_ = Settings();
+        settings_.septentrio_receiver_type = "gnss";
+        settings_.frame_id = "gnss";
+        settings_.imu_frame_id = "imu";
+        settings_.poi_frame_id = "base_link";
+        settings_.vsm_frame_id = "vsm";
+        settings_.aux1_frame_id = "aux1";
+        settings_.vehicle_frame_id = "base_link";
+        settings_.local_frame_id = "odom";
+    }
+
+    //! Settings to be altered before the message handler is set up
+    [[nodiscard]] Settings& mutableSettings() { return settings_; }
+
+protected:
+    void sendVelocity(std::string_view) override {}
+};
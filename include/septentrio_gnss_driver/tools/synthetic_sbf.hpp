@@ -0,0 +1,479 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ROSaic, no ROS dependencies so that blocks can be synthesized anywhere
+#include <septentrio_gnss_driver/crc/crc.hpp>
+
+/**
+ * @file synthetic_sbf.hpp
+ * @brief Synthesizes valid SBF blocks and NMEA sentences with plausible content
+ * for the load generator and the benchmarks
+ */
+
+namespace synthetic_sbf {
+
+    //! GPS week number of the synthesized blocks
+    static const uint16_t WNC = 2300;
+
+    /**
+     * @class BlockBuilder
+     * @brief Assembles an SBF block field by field in little-endian order and
+     * completes its header
+     */
+    class BlockBuilder
+    {
+    public:
+        BlockBuilder(uint16_t id, uint8_t revision, uint32_t tow,
+                     uint16_t wnc = WNC) :
+            block_(8, 0)
+        {
+            block_[0] = '$';
+            block_[1] = '@';
+            uint16_t idRevision = static_cast<uint16_t>(id | (revision << 13));
+            block_[4] = idRevision & 0xff;
+            block_[5] = idRevision >> 8;
+            add(tow);
+            add(wnc);
+        }
+
+        template <typename T>
+        void add(T value)
+        {
+            uint8_t bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            block_.insert(block_.end(), bytes, bytes + sizeof(T));
+        }
+
+        //! Appends zero bytes, e.g. reserved fields
+        void zeros(size_t count) { block_.resize(block_.size() + count, 0); }
+
+        //! Pads the block to a multiple of 4 bytes, sets length and CRC
+        [[nodiscard]] std::vector<uint8_t> finish()
+        {
+            block_.resize((block_.size() + 3) & ~size_t(3), 0);
+            block_[6] = block_.size() & 0xff;
+            block_[7] = block_.size() >> 8;
+            uint16_t crc = crc::compute16CCITT(block_.data() + 4, block_.size() - 4);
+            block_[2] = crc & 0xff;
+            block_[3] = crc >> 8;
+            return std::move(block_);
+        }
+
+    private:
+        std::vector<uint8_t> block_;
+    };
+
+    /**
+     * @brief Block whose body after the time header is zero, for blocks whose
+     * content does not matter
+     */
+    [[nodiscard]] inline std::vector<uint8_t> zeroed(uint16_t id, uint8_t revision,
+                                                     uint32_t tow, size_t body)
+    {
+        BlockBuilder block(id, revision, tow);
+        block.zeros(body);
+        return block.finish();
+    }
+
+    /**
+     * @brief PVTGeodetic and PVTCartesian revision 2 share their layout, only the
+     * meaning of position and velocity differs
+     */
+    [[nodiscard]] inline std::vector<uint8_t> pvt(uint16_t id, uint32_t tow,
+                                                  double a, double b, double c)
+    {
+        BlockBuilder block(id, 2, tow);
+        block.add<uint8_t>(4);     // Mode, RTK fixed
+        block.add<uint8_t>(0);     // Error
+        block.add<double>(a);      // Latitude or X
+        block.add<double>(b);      // Longitude or Y
+        block.add<double>(c);      // Height or Z
+        block.add<float>(47.5f);   // Undulation
+        block.add<float>(0.01f);   // Vn or Vx
+        block.add<float>(-0.02f);  // Ve or Vy
+        block.add<float>(0.0f);    // Vu or Vz
+        block.add<float>(120.0f);  // COG
+        block.add<double>(0.25);   // RxClkBias
+        block.add<float>(0.01f);   // RxClkDrift
+        block.add<uint8_t>(0);     // TimeSystem
+        block.add<uint8_t>(0);     // Datum
+        block.add<uint8_t>(24);    // NrSV
+        block.add<uint8_t>(0);     // WACorrInfo
+        block.add<uint16_t>(1);    // ReferenceID
+        block.add<uint16_t>(100);  // MeanCorrAge
+        block.add<uint32_t>(7);    // SignalInfo
+        block.add<uint8_t>(0);     // AlertFlag
+        block.add<uint8_t>(1);     // NrBases
+        block.add<uint16_t>(0);    // PPPInfo
+        block.add<uint16_t>(20);   // Latency
+        block.add<uint16_t>(2);    // HAccuracy
+        block.add<uint16_t>(3);    // VAccuracy
+        block.add<uint8_t>(0);     // Misc
+        return block.finish();
+    }
+
+    //! PosCovGeodetic/-Cartesian, VelCovGeodetic/-Cartesian share their layout
+    [[nodiscard]] inline std::vector<uint8_t> covariance(uint16_t id, uint32_t tow)
+    {
+        BlockBuilder block(id, 0, tow);
+        block.add<uint8_t>(4); // Mode
+        block.add<uint8_t>(0); // Error
+        for (size_t i = 0; i < 4; ++i)
+            block.add<float>(0.0004f * (i + 1)); // Variances
+        for (size_t i = 0; i < 6; ++i)
+            block.add<float>(0.00001f * (i + 1)); // Covariances
+        return block.finish();
+    }
+
+    [[nodiscard]] inline std::vector<uint8_t> attEuler(uint32_t tow)
+    {
+        BlockBuilder block(5938, 0, tow);
+        block.add<uint8_t>(12);     // NrSV
+        block.add<uint8_t>(0);      // Error
+        block.add<uint16_t>(2);     // Mode, heading and pitch
+        block.zeros(2);             // Reserved
+        block.add<float>(93.5f);    // Heading
+        block.add<float>(1.5f);     // Pitch
+        block.add<float>(-0.5f);    // Roll
+        block.add<float>(0.01f);    // PitchDot
+        block.add<float>(0.02f);    // RollDot
+        block.add<float>(0.03f);    // HeadingDot
+        return block.finish();
+    }
+
+    [[nodiscard]] inline std::vector<uint8_t> attCovEuler(uint32_t tow)
+    {
+        BlockBuilder block(5939, 0, tow);
+        block.zeros(1);        // Reserved
+        block.add<uint8_t>(0); // Error
+        for (size_t i = 0; i < 6; ++i)
+            block.add<float>(0.001f * (i + 1));
+        return block.finish();
+    }
+
+    [[nodiscard]] inline std::vector<uint8_t> dop(uint32_t tow)
+    {
+        BlockBuilder block(4001, 0, tow);
+        block.add<uint8_t>(24);    // NrSV
+        block.zeros(1);            // Reserved
+        block.add<uint16_t>(120);  // PDOP
+        block.add<uint16_t>(80);   // TDOP
+        block.add<uint16_t>(70);   // HDOP
+        block.add<uint16_t>(100);  // VDOP
+        block.add<float>(1.5f);    // HPL
+        block.add<float>(2.5f);    // VPL
+        return block.finish();
+    }
+
+    /**
+     * @brief INSNavGeod and INSNavCart share their layout, only the meaning of
+     * the position differs
+     */
+    [[nodiscard]] inline std::vector<uint8_t> insNav(uint16_t id, uint32_t tow,
+                                                     double a, double b, double c)
+    {
+        BlockBuilder block(id, 0, tow);
+        block.add<uint8_t>(4);      // GNSSMode
+        block.add<uint8_t>(0);      // Error
+        block.add<uint16_t>(0);     // Info
+        block.add<uint16_t>(5);     // GNSSAge
+        block.add<double>(a);       // Latitude or X
+        block.add<double>(b);       // Longitude or Y
+        block.add<double>(c);       // Height or Z
+        if (id == 4226)
+            block.add<float>(47.5f); // Undulation, INSNavGeod only
+        block.add<uint16_t>(2);     // Accuracy
+        block.add<uint16_t>(30);    // Latency
+        block.add<uint8_t>(0);      // Datum
+        block.add<uint8_t>(0);      // Reserved
+        block.add<uint16_t>(0xff);  // SBList, all sub-blocks
+        for (size_t i = 0; i < 8 * 3; ++i)
+            block.add<float>(0.01f * (i + 1));
+        return block.finish();
+    }
+
+    [[nodiscard]] inline std::vector<uint8_t> insNavGeod(uint32_t tow)
+    {
+        return insNav(4226, tow, 0.8743, 0.0762, 120.0);
+    }
+
+    /**
+     * @brief MeasEpoch with channels Type1 sub-blocks with signals Type2 sub-blocks
+     * each
+     */
+    [[nodiscard]] inline std::vector<uint8_t> measEpoch(uint32_t tow, uint8_t channels,
+                                                        uint8_t signals)
+    {
+        BlockBuilder block(4027, 1, tow);
+        block.add<uint8_t>(channels); // N1
+        block.add<uint8_t>(20);       // SB1Length
+        block.add<uint8_t>(12);       // SB2Length
+        block.add<uint8_t>(0);        // CommonFlags
+        block.add<uint8_t>(0);        // CumClkJumps
+        block.add<uint8_t>(0);        // Reserved
+        for (uint8_t i = 0; i < channels; ++i)
+        {
+            block.add<uint8_t>(i);                    // RxChannel
+            block.add<uint8_t>(0);                    // Type, GPS L1C/A
+            block.add<uint8_t>(1 + (i % 32));         // SVID
+            block.add<uint8_t>(0);                    // Misc
+            block.add<uint32_t>(1000000u + tow + i);  // CodeLSB
+            block.add<int32_t>(-1200 + i);            // Doppler
+            block.add<uint16_t>(100);                 // CarrierLSB
+            block.add<int8_t>(1);                     // CarrierMSB
+            block.add<uint8_t>(180);                  // CN0
+            block.add<uint16_t>(600);                 // LockTime
+            block.add<uint8_t>(0);                    // ObsInfo
+            block.add<uint8_t>(signals);              // N2
+            for (uint8_t j = 0; j < signals; ++j)
+            {
+                block.add<uint8_t>(1 + j);  // Type
+                block.add<uint8_t>(60);     // LockTime
+                block.add<uint8_t>(170);    // CN0
+                block.add<uint8_t>(0);      // OffsetsMSB
+                block.add<int8_t>(0);       // CarrierMSB
+                block.add<uint8_t>(0);      // ObsInfo
+                block.add<uint16_t>(10);    // CodeOffsetLSB
+                block.add<uint16_t>(20);    // CarrierLSB
+                block.add<uint16_t>(30);    // DopplerOffsetLSB
+            }
+        }
+        return block.finish();
+    }
+
+    /**
+     * @brief ChannelStatus with channels SatInfo sub-blocks with states StateInfo
+     * sub-blocks each, the satellites match those of measEpoch()
+     */
+    [[nodiscard]] inline std::vector<uint8_t>
+    channelStatus(uint32_t tow, uint8_t channels, uint8_t states)
+    {
+        BlockBuilder block(4013, 0, tow);
+        block.add<uint8_t>(channels); // N
+        block.add<uint8_t>(12);       // SB1Length
+        block.add<uint8_t>(8);        // SB2Length
+        block.zeros(3);               // Reserved
+        for (uint8_t i = 0; i < channels; ++i)
+        {
+            block.add<uint8_t>(1 + (i % 32));  // SVID
+            block.add<uint8_t>(0);             // FreqNr
+            block.zeros(2);                    // Reserved
+            block.add<uint16_t>(180);          // Azimuth/RiseSet
+            block.add<uint16_t>(0);            // HealthStatus
+            block.add<int8_t>(45);             // Elevation
+            block.add<uint8_t>(states);        // N2
+            block.add<uint8_t>(i);             // RxChannel
+            block.zeros(1);                    // Reserved
+            for (uint8_t j = 0; j < states; ++j)
+            {
+                block.add<uint8_t>(j);         // Antenna
+                block.zeros(1);                // Reserved
+                block.add<uint16_t>(0x0300);   // TrackingStatus
+                block.add<uint16_t>(0x0200);   // PVTStatus
+                block.add<uint16_t>(0);        // PVTInfo
+            }
+        }
+        return block.finish();
+    }
+
+    [[nodiscard]] inline std::vector<uint8_t> receiverStatus(uint32_t tow,
+                                                             uint8_t frontends)
+    {
+        BlockBuilder block(4014, 2, tow);
+        block.add<uint8_t>(30);        // CPULoad
+        block.add<uint8_t>(0);         // ExtError
+        block.add<uint32_t>(3600);     // UpTime
+        block.add<uint32_t>(0x0100);   // RxState
+        block.add<uint32_t>(0);        // RxError
+        block.add<uint8_t>(frontends); // N
+        block.add<uint8_t>(4);         // SBLength
+        block.add<uint8_t>(1);         // CmdCount
+        block.add<uint8_t>(140);       // Temperature
+        for (uint8_t i = 0; i < frontends; ++i)
+        {
+            block.add<uint8_t>(i);   // FrontendID
+            block.add<int8_t>(20);   // Gain
+            block.add<uint8_t>(50);  // SampleVar
+            block.add<uint8_t>(0);   // BlankingStat
+        }
+        return block.finish();
+    }
+
+    [[nodiscard]] inline std::vector<uint8_t> qualityInd(uint32_t tow,
+                                                         uint8_t indicators)
+    {
+        BlockBuilder block(4082, 0, tow);
+        block.add<uint8_t>(indicators); // N
+        block.zeros(1);                 // Reserved
+        // Types defined by the firmware, the overall quality (type 0) is last
+        // as the diagnostics of the driver expect
+        const uint8_t types[] = {1, 2, 11, 12, 21, 25, 30, 31};
+        for (uint8_t i = 0; i < indicators; ++i)
+        {
+            uint8_t type = (i + 1 == indicators) ? 0 : types[i % sizeof(types)];
+            block.add<uint16_t>(static_cast<uint16_t>(type | (8 << 8)));
+        }
+        return block.finish();
+    }
+
+    [[nodiscard]] inline std::vector<uint8_t> galAuthStatus(uint32_t tow)
+    {
+        BlockBuilder block(4245, 0, tow);
+        block.add<uint16_t>(0x0002);            // OSNMAStatus, started
+        block.add<float>(0.5f);                 // TrustedTimeDelta
+        block.add<uint64_t>(0x3ffffff);         // GalActiveMask
+        block.add<uint64_t>(0x3ffffff);         // GalAuthenticMask
+        block.add<uint64_t>(0xffffffff);        // GpsActiveMask
+        block.add<uint64_t>(0);                 // GpsAuthenticMask
+        return block.finish();
+    }
+
+    [[nodiscard]] inline std::vector<uint8_t> rfStatus(uint32_t tow, uint8_t bands)
+    {
+        BlockBuilder block(4092, 0, tow);
+        block.add<uint8_t>(bands);  // N
+        block.add<uint8_t>(8);      // SBLength
+        block.add<uint8_t>(0);      // Flags
+        block.zeros(3);             // Reserved
+        for (uint8_t i = 0; i < bands; ++i)
+        {
+            block.add<uint32_t>(1575420000 - i * 350000000); // Frequency
+            block.add<uint16_t>(2000);                       // Bandwidth
+            block.add<uint8_t>(0);                           // Info
+            block.zeros(1);                                  // Padding
+        }
+        return block.finish();
+    }
+
+    //! BaseVectorCart/-Geod share their layout, with one VectorInfo sub-block
+    [[nodiscard]] inline std::vector<uint8_t> baseVector(uint16_t id, uint32_t tow)
+    {
+        BlockBuilder block(id, 0, tow);
+        block.add<uint8_t>(1);       // N
+        block.add<uint8_t>(52);      // SBLength
+        block.add<uint8_t>(20);      // NrSV
+        block.add<uint8_t>(0);       // Error
+        block.add<uint8_t>(4);       // Mode, RTK fixed
+        block.add<uint8_t>(0);       // Misc
+        block.add<double>(1.5);      // DeltaX/-East
+        block.add<double>(-2.5);     // DeltaY/-North
+        block.add<double>(0.5);      // DeltaZ/-Up
+        block.add<float>(0.0f);      // DeltaVx/-Ve
+        block.add<float>(0.0f);      // DeltaVy/-Vn
+        block.add<float>(0.0f);      // DeltaVz/-Vu
+        block.add<uint16_t>(12000);  // Azimuth
+        block.add<int16_t>(1000);    // Elevation
+        block.add<uint16_t>(1);      // ReferenceID
+        block.add<uint16_t>(100);    // CorrAge
+        block.add<uint32_t>(0);      // SignalInfo
+        return block.finish();
+    }
+
+    //! ExtSensorMeas with an accelerometer and a gyroscope measurement
+    [[nodiscard]] inline std::vector<uint8_t> extSensorMeas(uint32_t tow)
+    {
+        BlockBuilder block(4050, 0, tow);
+        block.add<uint8_t>(2);  // N
+        block.add<uint8_t>(28); // SBLength
+        for (uint8_t type = 0; type < 2; ++type)
+        {
+            block.add<uint8_t>(0);    // Source
+            block.add<uint8_t>(0);    // SensorModel
+            block.add<uint8_t>(type); // Type, acceleration or angular rate
+            block.add<uint8_t>(0);    // ObsInfo
+            block.add<double>(0.01);
+            block.add<double>(-0.02);
+            block.add<double>(type == 0 ? 9.81 : 0.5);
+        }
+        return block.finish();
+    }
+
+    //! NMEA sentence of a body between $ and *, with checksum and CR LF
+    [[nodiscard]] inline std::vector<uint8_t> nmea(const std::string& body)
+    {
+        uint8_t checksum = 0;
+        for (char c : body)
+            checksum ^= static_cast<uint8_t>(c);
+        std::stringstream sentence;
+        sentence << '$' << body << '*' << std::uppercase << std::hex
+                 << std::setfill('0') << std::setw(2)
+                 << static_cast<uint32_t>(checksum) << "\r\n";
+        std::string s = sentence.str();
+        return std::vector<uint8_t>(s.begin(), s.end());
+    }
+
+    //! UTC time of day hhmmss.ss of a time of week, ignoring leap seconds
+    [[nodiscard]] inline std::string utcTime(uint32_t tow)
+    {
+        uint32_t daySeconds = (tow / 1000) % 86400;
+        std::stringstream time;
+        time << std::setfill('0') << std::setw(2) << daySeconds / 3600
+             << std::setw(2) << (daySeconds / 60) % 60 << std::setw(2)
+             << daySeconds % 60 << '.' << std::setw(2) << (tow % 1000) / 10;
+        return time.str();
+    }
+
+    //! GGA sentence for the time of week
+    [[nodiscard]] inline std::vector<uint8_t> gpgga(uint32_t tow)
+    {
+        return nmea("GPGGA," + utcTime(tow) +
+                    ",5005.1234,N,00421.5678,E,4,24,0.6,120.0,M,47.5,M,1.0,0001");
+    }
+
+    //! RMC sentence for the time of week
+    [[nodiscard]] inline std::vector<uint8_t> gprmc(uint32_t tow)
+    {
+        return nmea("GPRMC," + utcTime(tow) +
+                    ",A,5005.1234,N,00421.5678,E,0.5,54.7,010424,0.0,E,R");
+    }
+
+    //! GSA sentence with twelve satellites
+    [[nodiscard]] inline std::vector<uint8_t> gpgsa()
+    {
+        return nmea("GPGSA,A,3,01,02,03,04,05,06,07,08,09,10,11,12,1.2,0.7,1.0");
+    }
+
+    //! First GSV sentence of three with four satellites
+    [[nodiscard]] inline std::vector<uint8_t> gagsv()
+    {
+        return nmea(
+            "GAGSV,3,1,12,01,45,180,48,02,30,090,45,03,60,270,50,04,15,010,38");
+    }
+} // namespace synthetic_sbf
@@ -28,12 +28,15 @@
 //
 // *****************************************************************************
 
+#include <algorithm>
 #include <chrono>
+#include <thread>
 #include <linux/serial.h>
 
 // Boost includes
 #include <boost/regex.hpp>
 #include <septentrio_gnss_driver/communication/communication_core.hpp>
+#include <septentrio_gnss_driver/communication/sharded_replay.hpp>
 
 static const int16_t ANGLE_MAX = 180;
 static const int16_t ANGLE_MIN = -180;
@@ -58,26 +61,66 @@ static const int8_t POSSTD_DEV_MAX = 100;
 
 namespace io {
 
-    CommunicationCore::CommunicationCore(ROSaicNodeBase* node) :
-        node_(node), settings_(node->settings()), telegramHandler_(node),
-        running_(true)
+    CommunicationCore::CommunicationCore(ROSaicNodeBase* node,
+                                         ThreadPool* ioPool,
+                                         ThreadPool* processingPool,
+                                         const std::atomic<bool>* stop) :
+        node_(node), settings_(node->settings()), ioPool_(ioPool),
+        processingPool_(processingPool), telegramHandler_(node),
+        processingScheduled_(false), reconfiguring_(true), running_(true),
+        stop_(stop)
     {
         running_ = true;
-
-        processingThread_ =
-            std::thread(std::bind(&CommunicationCore::processTelegrams, this));
     }
 
     CommunicationCore::~CommunicationCore()
     {
         telegramHandler_.clearSemaphores();
 
-        resetSettings();
+        if (reconfigureThread_.joinable())
+        {
+            reconfiguring_ = false;
+            reconfigureSemaphore_.notify();
+            reconfigureThread_.join();
+        }
+
+        if (processingThread_.joinable())
+        {
+            resetSettings();
+
+            running_ = false;
+            telegramQueue_.emplace();
+            processingThread_.join();
+        } else if (processing_)
+        {
+            resetSettings();
+
+            running_ = false;
+        }
+        telegramQueue_.close();
+        if (processing_)
+        {
+            // The pool keeps running, so no connection may schedule processing
+            // once it is drained
+            manager_.reset();
+            tcpClient_.reset();
+            udpClient_.reset();
+            processing_->drain();
+        }
+        if (rawRecorder_)
+            rawRecorder_->stop();
 
-        running_ = false;
-        std::shared_ptr<Telegram> telegram(new Telegram);
-        telegramQueue_.push(telegram);
-        processingThread_.join();
+        node_->log(log_level::DEBUG,
+                   "Telegram pool hits: " + std::to_string(telegramPool_.hits()) +
+                       ", misses: " + std::to_string(telegramPool_.misses()));
+        node_->log(log_level::DEBUG,
+                   "Telegram queue high-water mark: " +
+                       std::to_string(telegramQueue_.highWaterMark()) + " of " +
+                       std::to_string(telegramQueue_.capacity()) +
+                       ", dropped: " + std::to_string(telegramQueue_.dropped()));
+        node_->log(log_level::DEBUG,
+                   "Publish pipeline dropped: " +
+                       std::to_string(telegramHandler_.publishDropped()));
     }
 
     void CommunicationCore::resetSettings()
@@ -156,34 +199,94 @@ namespace io {
 
             if (!settings_->login_user.empty() && !settings_->login_password.empty())
                 send("logout \x0D");
+            flush();
         }
     }
 
     void CommunicationCore::connect()
     {
         node_->log(log_level::DEBUG, "Called connect() method");
+
+        if (settings_->read_from_sbf_log && !settings_->replay_bag.empty())
+        {
+            ShardedReplay replay(node_);
+            if (replay.run())
+                node_->log(log_level::INFO, "Processing of SBF file complete.");
+            return;
+        }
+
+        // The queue and the SBF consumers depend on the settings, which are not
+        // loaded yet on construction, hence processing starts here
+        queue_policy::QueuePolicy policy = queue_policy::BLOCK;
+        if (settings_->telegram_queue_policy == "drop_oldest")
+            policy = queue_policy::DROP_OLDEST;
+        else if (settings_->telegram_queue_policy == "drop_by_priority")
+            policy = queue_policy::DROP_BY_PRIORITY;
+        telegramQueue_.configure(settings_->telegram_queue_capacity, policy);
+        if (settings_->latency_statistics_period_s > 0.0)
+        {
+            statistics_.reset(new LatencyStatistics);
+            telegramHandler_.setStatistics(statistics_.get());
+            statisticsPeriod_ = static_cast<Timestamp>(
+                settings_->latency_statistics_period_s * 1e9);
+            nextStatistics_ = LatencyStatistics::now() + statisticsPeriod_;
+        }
+        telegramHandler_.setupSbfConsumers();
+        telegramHandler_.setupEpochAggregator();
+        telegramHandler_.advertiseTopics();
+        telegramHandler_.startPublishPipeline();
+        if (!settings_->raw_recorder_prefix.empty() &&
+            !settings_->read_from_sbf_log && !settings_->read_from_pcap)
+        {
+            rawRecorder_.reset(new RawRecorder(node_));
+            if (!rawRecorder_->start())
+                rawRecorder_.reset();
+        }
+        if (processingPool_)
+        {
+            processing_.reset(new HandlerGroup(*processingPool_->ioService()));
+            telegramQueue_.setNotifier([this]() { scheduleProcessing(); });
+        } else
+            processingThread_ =
+                std::thread(std::bind(&CommunicationCore::processTelegrams, this));
+
         node_->log(
             log_level::DEBUG,
             "Started timer for calling connect() method until connection succeeds");
 
-        boost::asio::io_service io;
-        boost::posix_time::millisec wait_ms(
+        const auto delay = std::chrono::milliseconds(
             static_cast<uint32_t>(settings_->reconnect_delay_s * 1000));
+        // Waiting is sliced, so that stopping is not held up by the delay
+        const auto slice = std::min<std::chrono::milliseconds>(
+            delay, std::chrono::milliseconds(100));
         if (initializeIo())
         {
-            while (running_)
+            // The Rx may have lost its configuration with the connection
+            if (settings_->configure_rx && manager_)
+                manager_->setReconnectHandler([this]() {
+                    // Epochs interrupted by the outage are not completed
+                    telegramHandler_.resetEpochs();
+                    reconfigureSemaphore_.notify();
+                });
+
+            while (!stopped())
             {
-                boost::asio::deadline_timer t(io, wait_ms);
-
                 if (manager_->connect())
                 {
                     initializedIo_ = true;
                     break;
                 }
 
-                t.wait();
+                auto until = std::chrono::steady_clock::now() + delay;
+                while (!stopped() && (std::chrono::steady_clock::now() < until))
+                    std::this_thread::sleep_for(slice);
             }
         }
+        if (!initializedIo_ && stopped())
+        {
+            node_->log(log_level::INFO, "Stopped connecting to the Rx.");
+            return;
+        }
 
         // Sends commands to the Rx regarding which SBF/NMEA messages it should
         // output
@@ -192,7 +295,11 @@ namespace io {
         {
             node_->log(log_level::DEBUG, "Configure Rx.");
             if (settings_->configure_rx)
+            {
                 configureRx();
+                reconfigureThread_ =
+                    std::thread(std::bind(&CommunicationCore::reconfigureRx, this));
+            }
         }
 
         node_->log(log_level::INFO, "Setup complete.");
@@ -205,9 +312,13 @@ namespace io {
     {
         bool client = false;
         node_->log(log_level::DEBUG, "Called initializeIo() method");
+        std::shared_ptr<boost::asio::io_service> ioService =
+            ioPool_ ? ioPool_->ioService() : nullptr;
         if ((settings_->tcp_port != 0) && (!settings_->tcp_ip_server.empty()))
         {
-            tcpClient_.reset(new AsyncManager<TcpIo>(node_, &telegramQueue_));
+            tcpClient_.reset(new AsyncManager<TcpIo>(node_, &telegramQueue_,
+                                                     &telegramPool_,
+                                                     statistics_.get(), ioService));
             tcpClient_->setPort(std::to_string(settings_->tcp_port));
             if (!settings_->configure_rx)
                 tcpClient_->connect();
@@ -216,7 +327,8 @@ namespace io {
         if ((settings_->udp_port != 0) && (!settings_->udp_ip_server.empty()))
         {
             udpClient_.reset(
-                new UdpClient(node_, settings_->udp_port, &telegramQueue_));
+                new UdpClient(node_, settings_->udp_port, &telegramQueue_,
+                              &telegramPool_, statistics_.get(), ioService));
             client = true;
         }
 
@@ -224,22 +336,30 @@ namespace io {
         {
         case device_type::TCP:
         {
-            manager_.reset(new AsyncManager<TcpIo>(node_, &telegramQueue_));
+            manager_.reset(new AsyncManager<TcpIo>(node_, &telegramQueue_,
+                                                  &telegramPool_,
+                                                  statistics_.get(), ioService));
             break;
         }
         case device_type::SERIAL:
         {
-            manager_.reset(new AsyncManager<SerialIo>(node_, &telegramQueue_));
+            manager_.reset(new AsyncManager<SerialIo>(node_, &telegramQueue_,
+                                                  &telegramPool_,
+                                                  statistics_.get(), ioService));
             break;
         }
         case device_type::SBF_FILE:
         {
-            manager_.reset(new AsyncManager<SbfFileIo>(node_, &telegramQueue_));
+            manager_.reset(new AsyncManager<SbfFileIo>(node_, &telegramQueue_,
+                                                  &telegramPool_,
+                                                  statistics_.get(), ioService));
             break;
         }
         case device_type::PCAP_FILE:
         {
-            manager_.reset(new AsyncManager<PcapFileIo>(node_, &telegramQueue_));
+            manager_.reset(new AsyncManager<PcapFileIo>(node_, &telegramQueue_,
+                                                  &telegramPool_,
+                                                  statistics_.get(), ioService));
             break;
         }
         default:
@@ -268,6 +388,7 @@ namespace io {
     {
         node_->log(log_level::DEBUG, "Called configureRx() method");
 
+        std::lock_guard<std::mutex> lock(configMutex_);
         if (!initializedIo_)
         {
             node_->log(log_level::DEBUG,
@@ -276,6 +397,7 @@ namespace io {
         }
 
         uint8_t stream = 1;
+        desiredConfig_.clear();
         // Determining communication mode: TCP vs USB/Serial
         boost::smatch match;
         boost::regex_match(settings_->device, match,
@@ -290,6 +412,7 @@ namespace io {
             streamPort_ = settings_->tcp_ip_server;
             send("siss, " + streamPort_ + ", " +
                  std::to_string(settings_->tcp_port) + ", TCP, " + "\x0D");
+            flush();
             tcpClient_->connect();
         } else if ((settings_->udp_port != 0) && (!settings_->udp_ip_server.empty()))
         {
@@ -323,17 +446,20 @@ namespace io {
                      settings_->login_password + " \x0D");
         }
 
-        // Turning off all current SBF/NMEA output
-        send("sso, all, none, none, off \x0D");
-        send("sno, all, none, none, off \x0D");
-
         // Get Rx capabilities
         send("grc \x0D");
         telegramHandler_.waitForCapabilities();
 
+        // From here on the commands are collected and applied at once, so that
+        // after a reconnect only the changes have to be sent
+
+        // Turning off all current SBF/NMEA output
+        configure("sso, all, none, none, off \x0D");
+        configure("sno, all, none, none, off \x0D");
+
         // Activate NTP server
         if (settings_->use_gnss_time)
-            send("sntp, on \x0D");
+            configure("sntp, on \x0D");
 
         // Setting the datum to be used by the Rx (not the NMEA output though, which
         // only provides MSL and undulation (by default with respect to WGS84), but
@@ -341,7 +467,7 @@ namespace io {
         {
             std::stringstream ss;
             ss << "sgd, " << settings_->datum << "\x0D";
-            send(ss.str());
+            configure(ss.str());
         }
 
         if ((settings_->septentrio_receiver_type == "ins") || node_->isIns())
@@ -350,7 +476,7 @@ namespace io {
                 std::stringstream ss;
                 ss << "sat, Main, \"" << settings_->ant_type << "\""
                    << "\x0D";
-                send(ss.str());
+                configure(ss.str());
             }
 
             // Configure Aux1 antenna
@@ -359,7 +485,7 @@ namespace io {
                 std::stringstream ss;
                 ss << "sat, Aux1, \"" << settings_->ant_type << "\""
                    << "\x0D";
-                send(ss.str());
+                configure(ss.str());
             }
         } else if (settings_->septentrio_receiver_type == "gnss")
         {
@@ -374,7 +500,7 @@ namespace io {
                    << string_utilities::trimDecimalPlaces(settings_->delta_u)
                    << ", \"" << settings_->ant_type << "\", "
                    << settings_->ant_serial_nr << "\x0D";
-                send(ss.str());
+                configure(ss.str());
             }
 
             // Configure Aux1 antenna
@@ -386,7 +512,7 @@ namespace io {
                    << string_utilities::trimDecimalPlaces(0.0) << ", \""
                    << settings_->ant_aux1_type << "\", "
                    << settings_->ant_aux1_serial_nr << "\x0D";
-                send(ss.str());
+                configure(ss.str());
             }
         }
 
@@ -396,7 +522,7 @@ namespace io {
             if (!ntrip.id.empty())
             {
                 // First disable any existing NTRIP connection on NTR1
-                send("snts, " + ntrip.id + ", off \x0D");
+                configure("snts, " + ntrip.id + ", off \x0D");
                 {
                     std::stringstream ss;
                     ss << "snts, " << ntrip.id << ", Client, " << ntrip.caster
@@ -404,19 +530,19 @@ namespace io {
                        << ntrip.username << ", " << ntrip.password << ", "
                        << ntrip.mountpoint << ", " << ntrip.version << ", "
                        << ntrip.send_gga << " \x0D";
-                    send(ss.str());
+                    configure(ss.str());
                 }
                 if (ntrip.tls)
                 {
                     std::stringstream ss;
                     ss << "sntt, " << ntrip.id << ", on, \"" << ntrip.fingerprint
                        << "\" \x0D";
-                    send(ss.str());
+                    configure(ss.str());
                 } else
                 {
                     std::stringstream ss;
                     ss << "sntt, " << ntrip.id << ", off \x0D";
-                    send(ss.str());
+                    configure(ss.str());
                 }
             }
         }
@@ -434,13 +560,13 @@ namespace io {
                     // configuration is lost of course.
                     ss << "siss, " << ip_server.id << ", "
                        << std::to_string(ip_server.port) << ", TCP2Way \x0D";
-                    send(ss.str());
+                    configure(ss.str());
                 }
                 {
                     std::stringstream ss;
                     ss << "sdio, " << ip_server.id << ", " << ip_server.rtk_standard
                        << ", +SBF+NMEA \x0D";
-                    send(ss.str());
+                    configure(ss.str());
                 }
                 if (ip_server.send_gga != "off")
                 {
@@ -451,7 +577,7 @@ namespace io {
                     ss << "sno, Stream" << std::to_string(stream) << ", "
                        << ip_server.id << ", GGA, " << rate << " \x0D";
                     ++stream;
-                    send(ss.str());
+                    configure(ss.str());
                 }
             }
         }
@@ -461,14 +587,14 @@ namespace io {
             if (!serial.port.empty())
             {
                 if (serial.port.rfind("COM", 0) == 0)
-                    send("scs, " + serial.port + ", baud" +
-                         std::to_string(serial.baud_rate) +
-                         ", bits8, No, bit1, none\x0D");
+                    configure("scs, " + serial.port + ", baud" +
+                              std::to_string(serial.baud_rate) +
+                              ", bits8, No, bit1, none\x0D");
 
                 std::stringstream ss;
                 ss << "sdio, " << serial.port << ", " << serial.rtk_standard
                    << ", +SBF+NMEA \x0D";
-                send(ss.str());
+                configure(ss.str());
                 if (serial.send_gga != "off")
                 {
                     std::string rate = serial.send_gga;
@@ -478,7 +604,7 @@ namespace io {
                     ss << "sno, Stream" << std::to_string(stream) << ", "
                        << serial.port << ", GGA, " << rate << " \x0D";
                     ++stream;
-                    send(ss.str());
+                    configure(ss.str());
                 }
             }
         }
@@ -487,13 +613,13 @@ namespace io {
         if (settings_->multi_antenna)
         {
             if (node_->hasHeading())
-                send("sga, MultiAntenna \x0D");
+                configure("sga, MultiAntenna \x0D");
             else
                 node_->log(log_level::WARN,
                            "Multi antenna requested but Rx does not support it.");
         } else
         {
-            send("sga, none \x0D");
+            configure("sga, none \x0D");
         }
 
         // Setting the Attitude Determination
@@ -509,7 +635,7 @@ namespace io {
                    << ", "
                    << string_utilities::trimDecimalPlaces(settings_->pitch_offset)
                    << " \x0D";
-                send(ss.str());
+                configure(ss.str());
             } else
             {
                 node_->log(log_level::ERROR,
@@ -539,7 +665,7 @@ namespace io {
                        << ", "
                        << string_utilities::trimDecimalPlaces(settings_->theta_z)
                        << " \x0D";
-                    send(ss.str());
+                    configure(ss.str());
                 } else
                 {
                     node_->log(
@@ -565,7 +691,7 @@ namespace io {
                        << ", "
                        << string_utilities::trimDecimalPlaces(settings_->ant_lever_z)
                        << " \x0D";
-                    send(ss.str());
+                    configure(ss.str());
                 } else
                 {
                     node_->log(
@@ -591,7 +717,7 @@ namespace io {
                        << ", "
                        << string_utilities::trimDecimalPlaces(settings_->poi_z)
                        << " \x0D";
-                    send(ss.str());
+                    configure(ss.str());
                 } else
                 {
                     node_->log(
@@ -617,7 +743,7 @@ namespace io {
                        << ", "
                        << string_utilities::trimDecimalPlaces(settings_->vsm_z)
                        << " \x0D";
-                    send(ss.str());
+                    configure(ss.str());
                 } else
                 {
                     node_->log(
@@ -631,7 +757,7 @@ namespace io {
             {
                 std::stringstream ss;
                 ss << "sinc, off, all, MainAnt \x0D";
-                send(ss.str());
+                configure(ss.str());
             }
 
             // INS solution reference point
@@ -642,13 +768,13 @@ namespace io {
                     ss << "sinc, on, all, "
                        << "POI1"
                        << " \x0D";
-                    send(ss.str());
+                    configure(ss.str());
                 } else
                 {
                     ss << "sinc, on, all, "
                        << "MainAnt"
                        << " \x0D";
-                    send(ss.str());
+                    configure(ss.str());
                 }
             }
 
@@ -658,11 +784,11 @@ namespace io {
                 if (settings_->ins_initial_heading == "auto")
                 {
                     ss << "siih, " << settings_->ins_initial_heading << " \x0D";
-                    send(ss.str());
+                    configure(ss.str());
                 } else if (settings_->ins_initial_heading == "stored")
                 {
                     ss << "siih, " << settings_->ins_initial_heading << " \x0D";
-                    send(ss.str());
+                    configure(ss.str());
                 } else
                 {
                     node_->log(log_level::ERROR,
@@ -683,7 +809,7 @@ namespace io {
                        << ", "
                        << string_utilities::trimDecimalPlaces(settings_->pos_std_dev)
                        << " \x0D";
-                    send(ss.str());
+                    configure(ss.str());
                 } else
                 {
                     node_->log(log_level::ERROR,
@@ -697,13 +823,13 @@ namespace io {
         {
             std::stringstream ss;
             ss << "sou, " << settings_->osnma.mode << " \x0D";
-            send(ss.str());
+            configure(ss.str());
 
             if (!settings_->osnma.ntp_server.empty())
             {
                 std::stringstream ss;
                 ss << "snc, on, " << settings_->osnma.ntp_server << " \x0D";
-                send(ss.str());
+                configure(ss.str());
             } else
             {
                 if (settings_->osnma.mode == "strict")
@@ -747,19 +873,17 @@ namespace io {
             std::stringstream ss;
             ss << "sso, Stream" << std::to_string(stream) << ", " << streamPort_
                << "," << blocks.str() << ", " << rest_interval << "\x0D";
-            send(ss.str());
+            configure(ss.str());
+            restStream_ = stream;
             ++stream;
         }
 
-        // send command to trigger emission of receiver setup
-        send("sop, \"\", \"\" \x0D");
-
         // Setting up NMEA streams
         {
             if (settings_->septentrio_receiver_type == "ins")
-                send("snti, auto\x0D");
+                configure("snti, auto\x0D");
             else
-                send("snti, GP\x0D");
+                configure("snti, GP\x0D");
 
             std::stringstream blocks;
             if (settings_->publish_gpgga)
@@ -782,7 +906,7 @@ namespace io {
             std::stringstream ss;
             ss << "sno, Stream" << std::to_string(stream) << ", " << streamPort_
                << "," << blocks.str() << ", " << pvt_interval << "\x0D";
-            send(ss.str());
+            configure(ss.str());
             ++stream;
         }
 
@@ -901,7 +1025,7 @@ namespace io {
             std::stringstream ss;
             ss << "sso, Stream" << std::to_string(stream) << ", " << streamPort_
                << "," << blocks.str() << ", " << pvt_interval << "\x0D";
-            send(ss.str());
+            configure(ss.str());
             ++stream;
         }
 
@@ -909,36 +1033,45 @@ namespace io {
         {
             if (!settings_->ins_vsm_ip_server_id.empty())
             {
-                send("siss, " + settings_->ins_vsm_ip_server_id + ", " +
-                     std::to_string(settings_->ins_vsm_ip_server_port) +
-                     ", TCP2Way \x0D");
-                send("sdio, IPS2, NMEA, none\x0D");
+                configure("siss, " + settings_->ins_vsm_ip_server_id + ", " +
+                          std::to_string(settings_->ins_vsm_ip_server_port) +
+                          ", TCP2Way \x0D");
+                configure("sdio, IPS2, NMEA, none\x0D");
             }
             if (!settings_->ins_vsm_serial_port.empty())
             {
                 if (settings_->ins_vsm_serial_port.rfind("COM", 0) == 0)
-                    send("scs, " + settings_->ins_vsm_serial_port + ", baud" +
-                         std::to_string(settings_->ins_vsm_serial_baud_rate) +
-                         ", bits8, No, bit1, none\x0D");
-                send("sdio, " + settings_->ins_vsm_serial_port + ", NMEA\x0D");
+                    configure("scs, " + settings_->ins_vsm_serial_port +
+                              ", baud" +
+                              std::to_string(settings_->ins_vsm_serial_baud_rate) +
+                              ", bits8, No, bit1, none\x0D");
+                configure("sdio, " + settings_->ins_vsm_serial_port +
+                          ", NMEA\x0D");
             }
             if ((settings_->ins_vsm_ros_source == "odometry") ||
                 (settings_->ins_vsm_ros_source == "twist"))
             {
                 std::string s;
                 s = "sdio, " + mainConnectionPort_ + ", NMEA, +NMEA +SBF\x0D";
-                send(s);
+                configure(s);
                 nmeaActivated_ = true;
             }
         }
 
+        applyConfiguration();
+
+        // send command to trigger emission of receiver setup
+        send("sop, \"\", \"\" \x0D");
+        flush();
+
         node_->log(log_level::DEBUG, "Leaving configureRx() method");
     }
 
-    void CommunicationCore::sendVelocity(const std::string& velNmea)
+    void CommunicationCore::sendVelocity(std::string_view velNmea)
     {
         if (nmeaActivated_)
-            manager_.get()->send(velNmea);
+            manager_.get()->send(OutboundBuffer::fromString(
+                std::string(velNmea), write_priority::VELOCITY));
     }
 
     std::string CommunicationCore::resetMainConnection()
@@ -957,27 +1090,180 @@ namespace io {
         return telegramHandler_.getMainCd();
     }
 
+    void CommunicationCore::reconfigureRx()
+    {
+        while (true)
+        {
+            reconfigureSemaphore_.wait();
+            if (!reconfiguring_)
+                break;
+            node_->log(log_level::INFO, "Reconfiguring Rx after reconnecting.");
+            // Replies to commands sent before the loss will not arrive anymore
+            telegramHandler_.commands().clear();
+            configureRx();
+        }
+    }
+
     void CommunicationCore::processTelegrams()
     {
+        std::vector<std::shared_ptr<Telegram>> telegrams;
         while (running_)
         {
-            std::shared_ptr<Telegram> telegram;
-            telegramQueue_.pop(telegram);
+            telegramQueue_.pop_all(telegrams);
+            processBatch(telegrams);
+        }
+    }
+
+    void CommunicationCore::scheduleProcessing()
+    {
+        if (!processingScheduled_.exchange(true))
+            processing_->post([this]() { processAvailable(); });
+    }
+
+    void CommunicationCore::processAvailable()
+    {
+        // Telegrams pushed from now on schedule another run
+        processingScheduled_ = false;
+        while (telegramQueue_.try_pop_all(scheduledTelegrams_))
+            processBatch(scheduledTelegrams_);
+    }
 
+    void CommunicationCore::processBatch(
+        std::vector<std::shared_ptr<Telegram>>& telegrams)
+    {
+        for (auto& telegram : telegrams)
+        {
             if (telegram->type != telegram_type::EMPTY)
-                telegramHandler_.handleTelegram(telegram);
+            {
+                if (rawRecorder_)
+                    rawRecorder_->record(*telegram);
+                if (statistics_)
+                    handleInstrumented(telegram);
+                else
+                    telegramHandler_.handleTelegram(telegram);
+            }
+
+            telegramPool_.recycle(std::move(telegram));
+        }
+        telegrams.clear();
+
+        if (statistics_)
+        {
+            Timestamp now = LatencyStatistics::now();
+            if (now >= nextStatistics_)
+            {
+                nextStatistics_ = now + statisticsPeriod_;
+                telegramHandler_.publishStatistics(*statistics_,
+                                                   telegramQueue_);
+            }
         }
     }
 
+    /**
+     * Stage latencies are only taken for telegrams stamped by the framers.
+     */
+    void CommunicationCore::handleInstrumented(
+        const std::shared_ptr<Telegram>& telegram)
+    {
+        Timestamp dequeued = LatencyStatistics::now();
+        telegramHandler_.handleTelegram(telegram);
+        Timestamp processed = LatencyStatistics::now();
+
+        if (telegram->validated != 0)
+        {
+            statistics_->stage(latency_stage::CRC)
+                .add(LatencyStatistics::elapsed(telegram->framed,
+                                                telegram->validated));
+            statistics_->stage(latency_stage::QUEUE)
+                .add(LatencyStatistics::elapsed(telegram->validated, dequeued));
+        }
+        Timestamp processing = LatencyStatistics::elapsed(dequeued, processed);
+        statistics_->stage(latency_stage::PROCESSING).add(processing);
+        if (telegram->type == telegram_type::SBF)
+        {
+            SbfLatencies& sbf =
+                statistics_->sbf(parsing_utilities::getId(telegram->message));
+            sbf.received.add(
+                LatencyStatistics::elapsed(telegram->stamp, node_->getTime()));
+            sbf.processing.add(processing);
+        } else if ((telegram->type == telegram_type::NMEA) ||
+                   (telegram->type == telegram_type::NMEA_INS))
+            statistics_->nmea().add(processing);
+    }
+
+    /**
+     * Commands are resent from the first one that differs from the applied
+     * configuration on, as later commands may depend on earlier ones. Stream
+     * numbers only depend on the settings, so resent streams replace the old ones.
+     */
+    void CommunicationCore::applyConfiguration()
+    {
+        std::size_t first = 0;
+        if (!appliedConfig_.empty() && rxKeptConfiguration())
+            first = std::mismatch(desiredConfig_.begin(), desiredConfig_.end(),
+                                  appliedConfig_.begin(), appliedConfig_.end())
+                        .first -
+                    desiredConfig_.begin();
+
+        if (first == desiredConfig_.size())
+            node_->log(log_level::INFO,
+                       "Rx kept its configuration, nothing to be resent.");
+        else if (first > 0)
+            node_->log(log_level::INFO,
+                       "Rx kept its configuration, resending " +
+                           std::to_string(desiredConfig_.size() - first) + " of " +
+                           std::to_string(desiredConfig_.size()) + " commands.");
+
+        for (std::size_t i = first; i < desiredConfig_.size(); ++i)
+            send(desiredConfig_[i]);
+        flush();
+        appliedConfig_ = desiredConfig_;
+    }
+
+    /**
+     * The stream of the ReceiverSetup block is set up last among the SBF streams
+     * and is not part of the boot configuration, so it is only still set up if the
+     * Rx kept its configuration.
+     */
+    [[nodiscard]] bool CommunicationCore::rxKeptConfiguration()
+    {
+        std::string stream = "Stream" + std::to_string(restStream_);
+        telegramHandler_.expectMessage("SBFOutput, " + stream);
+        send("gso, " + stream + " \x0D");
+        std::string output =
+            telegramHandler_.waitForMessage(CommandPipeline::DEFAULT_TIMEOUT);
+        flush();
+        return output.find("ReceiverSetup") != std::string::npos;
+    }
+
+    void CommunicationCore::configure(const std::string& cmd)
+    {
+        desiredConfig_.push_back(cmd);
+    }
+
     void CommunicationCore::send(const std::string& cmd)
     {
+        if (!telegramHandler_.commands().push(cmd))
+            node_->log(log_level::WARN,
+                       "No reply of the Rx to a command in time, continuing.");
         manager_.get()->send(cmd);
-        telegramHandler_.waitForResponse();
     }
 
-    void CommunicationCore::sendRtcm(const std::string& cmd)
+    void CommunicationCore::flush()
     {
-        manager_.get()->send(cmd);
+        CommandPipeline& commands = telegramHandler_.commands();
+        if (!commands.flush())
+            node_->log(log_level::WARN,
+                       "No reply of the Rx to all commands, " +
+                           std::to_string(commands.unanswered()) +
+                           " commands unanswered so far.");
+    }
+
+    void CommunicationCore::sendRtcm(std::shared_ptr<const void> owner,
+                                     const uint8_t* data, std::size_t size)
+    {
+        manager_.get()->send(
+            OutboundBuffer(std::move(owner), data, size, write_priority::RTCM));
     }
 
 } // namespace io
\ No newline at end of file
@@ -56,18 +56,14 @@ using parsing_utilities::square;
 namespace io {
     void MessageHandler::assemblePoseWithCovarianceStamped()
     {
-        if (!settings_->publish_pose)
+        if (!settings_->publish_pose || !hasSubscribers(topic::POSE))
             return;
 
-        static auto last_ins_tow = last_insnavgeod_.block_header.tow;
-
         PoseWithCovarianceStampedMsg msg;
         if (settings_->septentrio_receiver_type == "ins")
         {
-            if (!validValue(last_insnavgeod_.block_header.tow) ||
-                (last_insnavgeod_.block_header.tow == last_ins_tow))
+            if (!validValue(last_insnavgeod_.block_header.tow))
                 return;
-            last_ins_tow = last_insnavgeod_.block_header.tow;
 
             msg.header = last_insnavgeod_.header;
 
@@ -210,13 +206,12 @@ namespace io {
             msg.pose.covariance[34] = deg2radSq(last_attcoveuler_.cov_headpitch);
             msg.pose.covariance[35] = deg2radSq(last_attcoveuler_.cov_headhead);
         }
-        publish<PoseWithCovarianceStampedMsg>("pose", msg);
+        publish<PoseWithCovarianceStampedMsg>(topic::POSE, msg);
     };
 
-    void MessageHandler::assembleDiagnosticArray(
-        const std::shared_ptr<Telegram>& telegram)
+    void MessageHandler::assembleDiagnosticArray()
     {
-        if (!settings_->publish_diagnostics)
+        if (!settings_->publish_diagnostics || !diagnosticsTelegram_)
             return;
 
         DiagnosticArrayMsg msg;
@@ -346,8 +341,9 @@ namespace io {
                 frame_id = settings_->frame_id;
             }
         }
-        assembleHeader(frame_id, telegram, msg);
-        publish<DiagnosticArrayMsg>("/diagnostics", msg);
+        assembleHeader(frame_id, diagnosticsTelegram_, msg);
+        diagnosticsTelegram_.reset();
+        publish<DiagnosticArrayMsg>(topic::DIAGNOSTICS, msg);
     };
 
     void MessageHandler::assembleOsnmaDiagnosticArray()
@@ -440,7 +436,7 @@ namespace io {
         msg.status.push_back(diagOsnma);
         msg.header = last_gal_auth_status_.header;
 
-        publish<DiagnosticArrayMsg>("/diagnostics", msg);
+        publish<DiagnosticArrayMsg>(topic::DIAGNOSTICS, msg);
     }
 
     void MessageHandler::assembleAimAndDiagnosticArray()
@@ -530,7 +526,7 @@ namespace io {
         aimMsg.header = last_rf_status_.header;
         aimMsg.tow = last_rf_status_.block_header.tow;
         aimMsg.wnc = last_rf_status_.block_header.wnc;
-        publish<AimPlusStatusMsg>("aimplusstatus", aimMsg);
+        publish<AimPlusStatusMsg>(topic::AIM_PLUS_STATUS, aimMsg);
 
         if (spoofed || detected)
             diagRf.level = DiagnosticStatusMsg::ERROR;
@@ -542,7 +538,7 @@ namespace io {
         msg.status.push_back(diagRf);
         msg.header = last_rf_status_.header;
 
-        publish<DiagnosticArrayMsg>("/diagnostics", msg);
+        publish<DiagnosticArrayMsg>(topic::DIAGNOSTICS, msg);
     }
 
     void MessageHandler::assembleImu()
@@ -653,12 +649,13 @@ namespace io {
             msg.orientation_covariance[8] = -1.0;
         }
 
-        publish<ImuMsg>("imu", msg);
+        publish<ImuMsg>(topic::IMU, msg);
     };
 
     void MessageHandler::assembleTwist(bool fromIns /* = false*/)
     {
-        if (!settings_->publish_twist)
+        if (!settings_->publish_twist ||
+            !hasSubscribers(fromIns ? topic::TWIST_INS : topic::TWIST_GNSS))
             return;
         TwistWithCovarianceStampedMsg msg;
 
@@ -773,7 +770,7 @@ namespace io {
             msg.twist.covariance[28] = -1.0;
             msg.twist.covariance[35] = -1.0;
 
-            publish<TwistWithCovarianceStampedMsg>("twist_ins", msg);
+            publish<TwistWithCovarianceStampedMsg>(topic::TWIST_INS, msg);
         } else
         {
             if ((!validValue(last_pvtgeodetic_.block_header.tow)) ||
@@ -874,7 +871,7 @@ namespace io {
             msg.twist.covariance[28] = -1.0;
             msg.twist.covariance[35] = -1.0;
 
-            publish<TwistWithCovarianceStampedMsg>("twist_gnss", msg);
+            publish<TwistWithCovarianceStampedMsg>(topic::TWIST_GNSS, msg);
         }
     };
 
@@ -886,53 +883,61 @@ namespace io {
      */
     void MessageHandler::assembleLocalizationUtm()
     {
-        if (!settings_->publish_localization && !settings_->publish_tf)
+        const bool publishLocalization =
+            settings_->publish_localization && hasSubscribers(topic::LOCALIZATION);
+        if (!publishLocalization && !settings_->publish_tf)
             return;
 
         LocalizationMsg msg;
 
+        const double lat = rad2deg(last_insnavgeod_.latitude);
+        const double lon = rad2deg(last_insnavgeod_.longitude);
+        localFrame_.update(last_insnavgeod_.latitude, last_insnavgeod_.longitude);
         int zone;
-        std::string zonestring;
         bool northernHemisphere;
         double easting;
         double northing;
         double meridian_convergence = 0.0;
-        if (fixedUtmZone_)
-        {
-            try
-            {
-                GeographicLib::UTMUPS::DecodeZone(*fixedUtmZone_, zone,
-                                                  northernHemisphere);
-                double k;
-                GeographicLib::UTMUPS::Forward(
-                    rad2deg(last_insnavgeod_.latitude),
-                    rad2deg(last_insnavgeod_.longitude), zone, northernHemisphere,
-                    easting, northing, meridian_convergence, k, zone);
-            } catch (const std::exception& e)
-            {
-                node_->log(log_level::DEBUG,
-                           "UTMUPS conversion exception: " + std::string(e.what()));
-                return;
-            }
-            zonestring = *fixedUtmZone_;
-        } else
+        try
         {
-            try
+            // The zone is determined anew only once the position left the cell of
+            // the local frame cache, a fixed zone is decoded only once
+            if (fixedUtmZone_)
             {
-                double k;
-                GeographicLib::UTMUPS::Forward(rad2deg(last_insnavgeod_.latitude),
-                                               rad2deg(last_insnavgeod_.longitude),
-                                               zone, northernHemisphere, easting,
-                                               northing, meridian_convergence, k);
-                zonestring =
+                if (utmZoneString_ != *fixedUtmZone_)
+                {
+                    GeographicLib::UTMUPS::DecodeZone(*fixedUtmZone_, utmZone_,
+                                                      northernHemisphere);
+                    utmZoneString_ = *fixedUtmZone_;
+                }
+            } else if ((utmZone_ < 0) ||
+                       (utmGeneration_ != localFrame_.generation()))
+            {
+                utmZone_ = GeographicLib::UTMUPS::StandardZone(lat, lon);
+                utmZoneString_.clear();
+            }
+            double k;
+            GeographicLib::UTMUPS::Forward(lat, lon, zone, northernHemisphere,
+                                           easting, northing, meridian_convergence,
+                                           k, utmZone_);
+            if (utmZoneString_.empty())
+                utmZoneString_ =
                     GeographicLib::UTMUPS::EncodeZone(zone, northernHemisphere);
-            } catch (const std::exception& e)
-            {
-                node_->log(log_level::DEBUG,
-                           "UTMUPS conversion exception: " + std::string(e.what()));
-                return;
-            }
+        } catch (const std::exception& e)
+        {
+            ROSAIC_LOG(node_, log_level::DEBUG,
+                       "UTMUPS conversion exception: " + std::string(e.what()));
+            utmZone_ = -1;
+            utmZoneString_.clear();
+            return;
+        }
+        if (utmGeneration_ != localFrame_.generation())
+        {
+            utmConvergenceCos_ = std::cos(meridian_convergence);
+            utmConvergenceSin_ = std::sin(meridian_convergence);
+            utmGeneration_ = localFrame_.generation();
         }
+        const std::string& zonestring = utmZoneString_;
         if (settings_->lock_utm_zone && !fixedUtmZone_)
             fixedUtmZone_ = std::make_shared<std::string>(zonestring);
 
@@ -1043,8 +1048,8 @@ namespace io {
 
         if ((meridian_convergence != 0.0) && (last_insnavgeod_.sb_list & 1))
         {
-            double cg = std::cos(meridian_convergence);
-            double sg = std::sin(meridian_convergence);
+            double cg = utmConvergenceCos_;
+            double sg = utmConvergenceSin_;
             Eigen::Matrix3d R = Eigen::Matrix3d::Identity();
             R(0, 0) = cg;
             R(0, 1) = -sg;
@@ -1077,8 +1082,8 @@ namespace io {
 
         assembleLocalizationMsgTwist(roll, pitch, yaw, msg);
 
-        if (settings_->publish_localization)
-            publish<LocalizationMsg>("localization", msg);
+        if (publishLocalization)
+            publish<LocalizationMsg>(topic::LOCALIZATION, msg);
         if (settings_->publish_tf)
             publishTf(msg);
     };
@@ -1090,7 +1095,10 @@ namespace io {
      */
     void MessageHandler::assembleLocalizationEcef()
     {
-        if (!settings_->publish_localization_ecef && !settings_->publish_tf_ecef)
+        const bool publishLocalizationEcef =
+            settings_->publish_localization_ecef &&
+            hasSubscribers(topic::LOCALIZATION_ECEF);
+        if (!publishLocalizationEcef && !settings_->publish_tf_ecef)
             return;
 
         if ((!validValue(last_insnavcart_.block_header.tow)) ||
@@ -1145,16 +1153,13 @@ namespace io {
         if (validValue(last_insnavcart_.heading))
             yaw = deg2rad(last_insnavcart_.heading);
 
+        localFrame_.update(last_insnavgeod_.latitude, last_insnavgeod_.longitude);
         if ((last_insnavcart_.sb_list & 2) != 0)
         {
             // Attitude
-            Eigen::Quaterniond q_local_ecef;
-            if (settings_->use_ros_axis_orientation)
-                q_local_ecef = parsing_utilities::q_enu_ecef(
-                    last_insnavgeod_.latitude, last_insnavgeod_.longitude);
-            else
-                q_local_ecef = parsing_utilities::q_ned_ecef(
-                    last_insnavgeod_.latitude, last_insnavgeod_.longitude);
+            const Eigen::Quaterniond& q_local_ecef =
+                settings_->use_ros_axis_orientation ? localFrame_.q_enu_ecef()
+                                                    : localFrame_.q_ned_ecef();
             Eigen::Quaterniond q_b_local =
                 parsing_utilities::convertEulerToQuaternion(roll, pitch, yaw);
 
@@ -1217,13 +1222,9 @@ namespace io {
                 covAtt_local(1, 2) = deg2radSq(last_insnavcart_.heading_pitch_cov);
             }
 
-            Eigen::Matrix3d R_local_ecef;
-            if (settings_->use_ros_axis_orientation)
-                R_local_ecef = parsing_utilities::R_enu_ecef(
-                    last_insnavgeod_.latitude, last_insnavgeod_.longitude);
-            else
-                R_local_ecef = parsing_utilities::R_ned_ecef(
-                    last_insnavgeod_.latitude, last_insnavgeod_.longitude);
+            const Eigen::Matrix3d& R_local_ecef =
+                settings_->use_ros_axis_orientation ? localFrame_.R_enu_ecef()
+                                                    : localFrame_.R_ned_ecef();
             // Rotate attitude covariance matrix to ecef coordinates
             Eigen::Matrix3d covAtt_ecef =
                 R_local_ecef * covAtt_local * R_local_ecef.transpose();
@@ -1246,8 +1247,8 @@ namespace io {
 
         assembleLocalizationMsgTwist(roll, pitch, yaw, msg);
 
-        if (settings_->publish_localization_ecef)
-            publish<LocalizationMsg>("localization_ecef", msg);
+        if (publishLocalizationEcef)
+            publish<LocalizationMsg>(topic::LOCALIZATION_ECEF, msg);
         if (settings_->publish_tf_ecef)
             publishTf(msg);
     };
@@ -1256,8 +1257,9 @@ namespace io {
                                                       double yaw,
                                                       LocalizationMsg& msg) const
     {
+        // Inverse of a rotation is its transpose
         Eigen::Matrix3d R_local_body =
-            parsing_utilities::rpyToRot(roll, pitch, yaw).inverse();
+            parsing_utilities::rpyToRot(roll, pitch, yaw).transpose();
         if ((last_insnavgeod_.sb_list & 8) != 0)
         {
             // Linear velocity (ENU)
@@ -1377,11 +1379,9 @@ namespace io {
      */
     void MessageHandler::assembleNavSatFix()
     {
-        if (!settings_->publish_navsatfix)
+        if (!settings_->publish_navsatfix || !hasSubscribers(topic::NAVSATFIX))
             return;
 
-        static auto last_ins_tow = last_insnavgeod_.block_header.tow;
-
         NavSatFixMsg msg;
         uint16_t mask = 15; // We extract the first four bits using this mask.
         if (settings_->septentrio_receiver_type == "gnss")
@@ -1469,12 +1469,8 @@ namespace io {
             msg.position_covariance_type = NavSatFixMsg::COVARIANCE_TYPE_KNOWN;
         } else if (settings_->septentrio_receiver_type == "ins")
         {
-            if ((!validValue(last_insnavgeod_.block_header.tow)) ||
-                (last_insnavgeod_.block_header.tow == last_ins_tow))
-            {
+            if (!validValue(last_insnavgeod_.block_header.tow))
                 return;
-            }
-            last_ins_tow = last_insnavgeod_.block_header.tow;
 
             msg.header = last_insnavgeod_.header;
 
@@ -1563,7 +1559,7 @@ namespace io {
             msg.position_covariance_type =
                 NavSatFixMsg::COVARIANCE_TYPE_DIAGONAL_KNOWN;
         }
-        publish<NavSatFixMsg>("navsatfix", msg);
+        publish<NavSatFixMsg>(topic::NAVSATFIX, msg);
     };
 
     /**
@@ -1589,7 +1585,7 @@ namespace io {
      */
     void MessageHandler::assembleGpsFix()
     {
-        if (!settings_->publish_gpsfix)
+        if (!settings_->publish_gpsfix || !hasSubscribers(topic::GPSFIX))
             return;
 
         if (settings_->septentrio_receiver_type == "gnss")
@@ -1617,120 +1613,29 @@ namespace io {
         GpsFixMsg msg;
         msg.status.satellites_used = static_cast<uint16_t>(last_pvtgeodetic_.nr_sv);
 
-        // MeasEpoch Processing
-        std::vector<int32_t> cno_tracked;
-        std::vector<int32_t> svid_in_sync;
-        {
-            cno_tracked.reserve(last_measepoch_.type1.size());
-            svid_in_sync.reserve(last_measepoch_.type1.size());
-            for (const auto& measepoch_channel_type1 : last_measepoch_.type1)
-            {
-                // Define MeasEpochChannelType1 struct for the corresponding
-                // sub-block
-                svid_in_sync.push_back(
-                    static_cast<int32_t>(measepoch_channel_type1.sv_id));
-                uint8_t type_mask =
-                    15; // We extract the first four bits using this mask.
-                if (((measepoch_channel_type1.type & type_mask) ==
-                     static_cast<uint8_t>(1)) ||
-                    ((measepoch_channel_type1.type & type_mask) ==
-                     static_cast<uint8_t>(2)))
-                {
-                    cno_tracked.push_back(
-                        static_cast<int32_t>(measepoch_channel_type1.cn0) / 4);
-                } else
-                {
-                    cno_tracked.push_back(
-                        static_cast<int32_t>(measepoch_channel_type1.cn0) / 4 +
-                        static_cast<int32_t>(10));
-                }
-            }
-        }
-
-        // ChannelStatus Processing
-        std::vector<int32_t> svid_in_sync_2;
-        std::vector<int32_t> elevation_tracked;
-        std::vector<int32_t> azimuth_tracked;
-        std::vector<int32_t> svid_pvt;
-        svid_pvt.clear();
-        std::vector<int32_t> ordering;
-        {
-            svid_in_sync_2.reserve(last_channelstatus_.satInfo.size());
-            elevation_tracked.reserve(last_channelstatus_.satInfo.size());
-            azimuth_tracked.reserve(last_channelstatus_.satInfo.size());
-            for (const auto& channel_sat_info : last_channelstatus_.satInfo)
-            {
-                bool to_be_added = false;
-                for (int32_t j = 0; j < static_cast<int32_t>(svid_in_sync.size());
-                     ++j)
-                {
-                    if (svid_in_sync[j] ==
-                        static_cast<int32_t>(channel_sat_info.sv_id))
-                    {
-                        ordering.push_back(j);
-                        to_be_added = true;
-                        break;
-                    }
-                }
-                if (to_be_added)
-                {
-                    svid_in_sync_2.push_back(
-                        static_cast<int32_t>(channel_sat_info.sv_id));
-                    elevation_tracked.push_back(
-                        static_cast<int32_t>(channel_sat_info.elev));
-                    static uint16_t azimuth_mask = 511;
-                    azimuth_tracked.push_back(static_cast<int32_t>(
-                        (channel_sat_info.az_rise_set & azimuth_mask)));
-                }
-                svid_pvt.reserve(channel_sat_info.stateInfo.size());
-                for (const auto& channel_state_info : channel_sat_info.stateInfo)
-                {
-                    // Define ChannelStateInfo struct for the corresponding sub-block
-                    bool pvt_status = false;
-                    uint16_t pvt_status_mask = std::pow(2, 15) + std::pow(2, 14);
-                    for (int k = 15; k != -1; k -= 2)
-                    {
-                        uint16_t pvt_status_value =
-                            (channel_state_info.pvt_status & pvt_status_mask) >>
-                            k - 1;
-                        if (pvt_status_value == 2)
-                        {
-                            pvt_status = true;
-                        }
-                        if (k > 1)
-                        {
-                            pvt_status_mask = pvt_status_mask - std::pow(2, k) -
-                                              std::pow(2, k - 1) +
-                                              std::pow(2, k - 2) +
-                                              std::pow(2, k - 3);
-                        }
-                    }
-                    if (pvt_status)
-                    {
-                        svid_pvt.push_back(
-                            static_cast<int32_t>(channel_sat_info.sv_id));
-                    }
-                }
-            }
-        }
-        msg.status.satellite_used_prn =
-            svid_pvt; // Entries such as int32[] in ROS messages are to be treated as
-                      // std::vectors.
-        msg.status.satellites_visible = static_cast<uint16_t>(svid_in_sync.size());
-        msg.status.satellite_visible_prn = svid_in_sync_2;
-        msg.status.satellite_visible_z = elevation_tracked;
-        msg.status.satellite_visible_azimuth = azimuth_tracked;
-
-        // Reordering CNO vector to that of all previous arrays
-        std::vector<int32_t> cno_tracked_reordered;
-        if (static_cast<int32_t>(last_channelstatus_.n) != 0)
-        {
-            for (int32_t k = 0; k < static_cast<int32_t>(ordering.size()); ++k)
-            {
-                cno_tracked_reordered.push_back(cno_tracked[ordering[k]]);
-            }
+        // Join the satellites of ChannelStatus with the tracked ones of MeasEpoch
+        msg.status.satellites_visible =
+            static_cast<uint16_t>(trackedSatellites_.svid.size());
+        msg.status.satellite_used_prn = channelSatellites_.usedInPvt;
+        const size_t channels = channelSatellites_.svid.size();
+        msg.status.satellite_visible_prn.reserve(channels);
+        msg.status.satellite_visible_z.reserve(channels);
+        msg.status.satellite_visible_azimuth.reserve(channels);
+        msg.status.satellite_visible_snr.reserve(channels);
+        for (size_t i = 0; i < channels; ++i)
+        {
+            int16_t tracked = trackedSatellites_.find(
+                static_cast<uint8_t>(channelSatellites_.svid[i]));
+            if (tracked == TrackedSatellites::NOT_TRACKED)
+                continue;
+            msg.status.satellite_visible_prn.push_back(channelSatellites_.svid[i]);
+            msg.status.satellite_visible_z.push_back(
+                channelSatellites_.elevation[i]);
+            msg.status.satellite_visible_azimuth.push_back(
+                channelSatellites_.azimuth[i]);
+            msg.status.satellite_visible_snr.push_back(
+                trackedSatellites_.cn0[tracked]);
         }
-        msg.status.satellite_visible_snr = cno_tracked_reordered;
         msg.err_time = 2 * std::sqrt(last_poscovgeodetic_.cov_bb);
 
         if (settings_->septentrio_receiver_type == "gnss")
@@ -2051,7 +1956,7 @@ namespace io {
             msg.position_covariance_type =
                 NavSatFixMsg::COVARIANCE_TYPE_DIAGONAL_KNOWN;
         }
-        publish<GpsFixMsg>("gpsfix", msg);
+        publish<GpsFixMsg>(topic::GPSFIX, msg);
     }
 
     void
@@ -2062,7 +1967,7 @@ namespace io {
         msg.time_ref = timestampToRos(time_obj);
         msg.source = "GPST";
         assembleHeader(settings_->frame_id, telegram, msg);
-        publish<TimeReferenceMsg>("gpst", msg);
+        publish<TimeReferenceMsg>(topic::GPST, msg);
     }
 
     template <typename T>
@@ -2120,42 +2025,33 @@ namespace io {
     /// next leap second is inserted into the UTC time.
     Timestamp MessageHandler::timestampSBF(uint32_t tow, uint16_t wnc) const
     {
-        Timestamp time_obj;
-
         // conversion from GPS time of week and week number to UTC taking leap
         // seconds into account
-        static uint64_t secToNSec = 1000000000;
-        static uint64_t mSec2NSec = 1000000;
-        static uint64_t nsOfGpsStart =
-            315964800 *
-            secToNSec; // GPS week counter starts at 1980-01-06 which is
-                       // 315964800 seconds since Unix epoch (1970-01-01 UTC)
-        static uint64_t nsecPerWeek = 7 * 24 * 60 * 60 * secToNSec;
-
-        time_obj = nsOfGpsStart + tow * mSec2NSec + wnc * nsecPerWeek;
-
-        if (current_leap_seconds_ != -128)
-            time_obj -= current_leap_seconds_ * secToNSec;
-        // else: warn?
-
-        return time_obj;
+        return gnssToUnixTime(tow, wnc, current_leap_seconds_);
     }
 
     /**
      * If GNSS time is used, Publishing is only done with valid leap seconds
      */
     template <typename M>
-    void MessageHandler::publish(const std::string& topic, const M& msg)
+    void MessageHandler::publish(topic::Topic topic, const M& msg)
     {
+        if (!decimator_.publish(topic))
+            return;
         // TODO: maybe publish only if wnc and tow is valid?
         if (!settings_->use_gnss_time ||
             (settings_->use_gnss_time && (current_leap_seconds_ != -128)))
         {
+            if (recorder_ != nullptr)
+            {
+                recorder_->record(topic, msg);
+                return;
+            }
             if (settings_->read_from_sbf_log || settings_->read_from_pcap)
             {
                 wait(timestampFromRos(msg.header.stamp));
             }
-            node_->publishMessage<M>(topic, msg);
+            dispatch(topic, msg, (statistics_ != nullptr) ? telegramStamp_ : 0);
         } else
         {
             node_->log(
@@ -2171,6 +2067,120 @@ namespace io {
         }
     }
 
+    /**
+     * The latency is taken once the message is handed to ROS, i.e. in the
+     * publishing thread if there is a publish pipeline. Messages are handed to the
+     * pipeline as shared pointers, so they are copied once only, also when
+     * publishing shared pointers.
+     */
+    template <typename M>
+    void MessageHandler::dispatch(topic::Topic topic, const M& msg,
+                                  Timestamp received)
+    {
+        if (publishPipeline_.workers() == 0)
+        {
+            node_->publishMessage<M>(topic, msg);
+            if (received != 0)
+                statistics_->topic(topic).add(
+                    LatencyStatistics::elapsed(received, node_->getTime()));
+        } else
+        {
+            // Advertise here, the workers shall not alter the publishers
+            node_->advertise<M>(topic);
+            boost::shared_ptr<const M> shared = boost::make_shared<const M>(msg);
+            post(publish_lane::laneOf(topic), [this, topic, shared, received]() {
+                if (node_->sharedPublishing())
+                    node_->publishMessage<M>(topic, shared);
+                else
+                    node_->publishMessage<M>(topic, *shared);
+                if (received != 0)
+                    statistics_->topic(topic).add(
+                        LatencyStatistics::elapsed(received, node_->getTime()));
+            });
+        }
+    }
+
+    void MessageHandler::post(publish_lane::PublishLane lane,
+                              std::function<void()>&& job)
+    {
+        if (!publishPipeline_.post(lane, std::move(job)))
+            ROSAIC_LOG_THROTTLE(node_, log_level::WARN, STREAM_ERROR_LOG_PERIOD_S,
+                                std::string("Publishing lags behind, dropped the "
+                                            "oldest message in lane ") +
+                                    publish_lane::NAMES[lane] + ".");
+    }
+
+    void MessageHandler::publishStatistics(LatencyStatistics& statistics,
+                                           const TelegramQueue& telegramQueue)
+    {
+        DiagnosticStatusMsg diagLatency;
+        diagLatency.hardware_id = last_receiversetup_.rx_serial_number;
+        diagLatency.name = "septentrio_driver: Latency";
+        diagLatency.message =
+            "Latencies since the last report as n, p50, p99, and max";
+        diagLatency.level = DiagnosticStatusMsg::OK;
+
+        auto addValue = [&diagLatency](const std::string& key,
+                                       const std::string& value) {
+            diagLatency.values.emplace_back();
+            diagLatency.values.back().key = key;
+            diagLatency.values.back().value = value;
+        };
+        auto addSummary = [&addValue](const std::string& key,
+                                      LatencyHistogram& histogram) {
+            LatencyHistogram::Summary summary = histogram.collect();
+            if (summary.count == 0)
+                return;
+            addValue(key, "n=" + std::to_string(summary.count) +
+                              " p50=" + std::to_string(summary.p50) +
+                              "us p99=" + std::to_string(summary.p99) +
+                              "us max=" + std::to_string(summary.max) + "us");
+        };
+
+        for (uint8_t stage = 0; stage < latency_stage::COUNT; ++stage)
+            addSummary(std::string("stage ") + latency_stage::NAMES[stage],
+                       statistics.stage(
+                           static_cast<latency_stage::LatencyStage>(stage)));
+        for (uint16_t id = 0; id < SBF_ID_COUNT; ++id)
+        {
+            if (SbfLatencies* histograms = statistics.sbfIfReceived(id))
+            {
+                addSummary("sbf " + std::to_string(id), histograms->received);
+                addSummary("sbf " + std::to_string(id) + " processing",
+                           histograms->processing);
+            }
+        }
+        addSummary("nmea processing", statistics.nmea());
+        for (uint8_t topic = 0; topic < topic::COUNT; ++topic)
+            addSummary(std::string("topic ") + topic::NAMES[topic],
+                       statistics.topic(static_cast<topic::Topic>(topic)));
+
+        addValue("queue depth", std::to_string(telegramQueue.size()));
+        addValue("queue high-water mark",
+                 std::to_string(telegramQueue.highWaterMark()) + " of " +
+                     std::to_string(telegramQueue.capacity()));
+        addValue("queue dropped", std::to_string(telegramQueue.dropped()));
+        addValue("publish dropped", std::to_string(publishPipeline_.dropped()));
+        addValue("crc failures", std::to_string(statistics.crcFailures()));
+        addValue("framing errors", std::to_string(statistics.framingErrors()));
+        if ((telegramQueue.dropped() > 0) || (publishPipeline_.dropped() > 0))
+            diagLatency.level = DiagnosticStatusMsg::WARN;
+
+        DiagnosticArrayMsg msg;
+        msg.header.stamp = timestampToRos(node_->getTime());
+        msg.header.frame_id = settings_->frame_id;
+        msg.status.push_back(diagLatency);
+        dispatch(topic::DIAGNOSTICS, msg, 0);
+    }
+
+    [[nodiscard]] bool MessageHandler::hasSubscribers(topic::Topic topic) const
+    {
+        // Recordings shall be complete
+        if (recorder_ != nullptr)
+            return true;
+        return node_->hasSubscribers(topic);
+    }
+
     /**
      * If GNSS time is used, Publishing is only done with valid leap seconds
      */
@@ -2180,11 +2190,16 @@ namespace io {
         if (!settings_->use_gnss_time ||
             (settings_->use_gnss_time && (current_leap_seconds_ != -128)))
         {
+            if (recorder_ != nullptr)
+            {
+                recorder_->recordTf(msg);
+                return;
+            }
             if (settings_->read_from_sbf_log || settings_->read_from_pcap)
             {
                 wait(timestampFromRos(msg.header.stamp));
             }
-            node_->publishTf(msg);
+            post(publish_lane::LOW_LATENCY, [this, msg]() { node_->publishTf(msg); });
         } else
         {
             node_->log(
@@ -2200,11 +2215,435 @@ namespace io {
         }
     }
 
+    /**
+     * The message is stamped with the time of reception and refers to the telegram,
+     * so the block is neither copied nor decoded before serialization
+     */
+    void MessageHandler::publishRawSbf(const std::shared_ptr<Telegram>& telegram)
+    {
+        if (!decimator_.publish(topic::RAW_SBF) || !hasSubscribers(topic::RAW_SBF))
+            return;
+
+        RawSbfBlockView msg(telegram);
+        msg.header.frame_id = settings_->frame_id;
+        msg.header.stamp = timestampToRos(telegram->stamp);
+        if (recorder_ != nullptr)
+        {
+            recorder_->record(topic::RAW_SBF, msg);
+            return;
+        }
+        if (settings_->read_from_sbf_log || settings_->read_from_pcap)
+        {
+            // Same time base as the decoded messages to keep the replay rate
+            wait(settings_->use_gnss_time ? timestampSBF(telegram->message)
+                                          : telegram->stamp);
+        }
+        dispatch(topic::RAW_SBF, msg, (statistics_ != nullptr) ? telegramStamp_ : 0);
+    }
+
+    void MessageHandler::setupSbfConsumers()
+    {
+        using namespace sbf_consumer;
+
+        sbfConsumers_.fill(NONE);
+        auto consume = [this](SbfId id, SbfConsumer consumer, bool active) {
+            if (active)
+                sbfConsumers_[id] |= consumer;
+        };
+
+        const bool nmeaGnssTime = settings_->use_gnss_time &&
+                                  (settings_->publish_gpgsa || settings_->publish_gpgsv);
+        // PVTGeodetic provides the latency to be compensated in related blocks
+        const bool pvtLatency =
+            !settings_->use_gnss_time && settings_->latency_compensation;
+        const bool localization =
+            settings_->publish_localization || settings_->publish_tf;
+        const bool localizationEcef =
+            settings_->publish_localization_ecef || settings_->publish_tf_ecef;
+
+        consume(PVT_CARTESIAN, TOPIC, settings_->publish_pvtcartesian);
+        consume(PVT_GEODETIC, TOPIC, settings_->publish_pvtgeodetic);
+        consume(PVT_GEODETIC, NAVSATFIX, settings_->publish_navsatfix);
+        consume(PVT_GEODETIC, GPSFIX, settings_->publish_gpsfix);
+        consume(PVT_GEODETIC, POSE, settings_->publish_pose);
+        consume(PVT_GEODETIC, TWIST, settings_->publish_twist);
+        consume(PVT_GEODETIC, TIME_REFERENCE, settings_->publish_gpst);
+        consume(PVT_GEODETIC, NMEA, nmeaGnssTime);
+        consume(PVT_GEODETIC, DRIVER, pvtLatency);
+        consume(BASE_VECTOR_CART, TOPIC, settings_->publish_basevectorcart);
+        consume(BASE_VECTOR_GEOD, TOPIC, settings_->publish_basevectorgeod);
+        consume(POS_COV_CARTESIAN, TOPIC, settings_->publish_poscovcartesian);
+        consume(POS_COV_GEODETIC, TOPIC, settings_->publish_poscovgeodetic);
+        consume(POS_COV_GEODETIC, NAVSATFIX, settings_->publish_navsatfix);
+        consume(POS_COV_GEODETIC, GPSFIX, settings_->publish_gpsfix);
+        consume(POS_COV_GEODETIC, POSE, settings_->publish_pose);
+        consume(ATT_EULER, TOPIC, settings_->publish_atteuler);
+        consume(ATT_EULER, GPSFIX, settings_->publish_gpsfix);
+        consume(ATT_EULER, POSE, settings_->publish_pose);
+        consume(ATT_COV_EULER, TOPIC, settings_->publish_attcoveuler);
+        consume(ATT_COV_EULER, GPSFIX, settings_->publish_gpsfix);
+        consume(ATT_COV_EULER, POSE, settings_->publish_pose);
+        consume(GAL_AUTH_STATUS, TOPIC, settings_->publish_galauthstatus);
+        consume(GAL_AUTH_STATUS, DIAGNOSTICS,
+                settings_->publish_galauthstatus || settings_->publish_aimplusstatus);
+        consume(RF_STATUS, TOPIC, settings_->publish_aimplusstatus);
+        consume(RF_STATUS, DIAGNOSTICS, settings_->publish_aimplusstatus);
+        consume(INS_NAV_CART, TOPIC, settings_->publish_insnavcart);
+        consume(INS_NAV_CART, LOCALIZATION_ECEF, localizationEcef);
+        consume(INS_NAV_GEOD, TOPIC, settings_->publish_insnavgeod);
+        consume(INS_NAV_GEOD, NAVSATFIX, settings_->publish_navsatfix);
+        consume(INS_NAV_GEOD, GPSFIX, settings_->publish_gpsfix);
+        consume(INS_NAV_GEOD, POSE, settings_->publish_pose);
+        consume(INS_NAV_GEOD, TWIST, settings_->publish_twist);
+        consume(INS_NAV_GEOD, IMU, settings_->publish_imu);
+        consume(INS_NAV_GEOD, LOCALIZATION, localization);
+        consume(INS_NAV_GEOD, LOCALIZATION_ECEF, localizationEcef);
+        consume(INS_NAV_GEOD, TIME_REFERENCE, settings_->publish_gpst);
+        consume(INS_NAV_GEOD, NMEA, nmeaGnssTime);
+        consume(IMU_SETUP, TOPIC, settings_->publish_imusetup);
+        consume(VEL_SENSOR_SETUP, TOPIC, settings_->publish_velsensorsetup);
+        consume(EXT_EVENT_INS_NAV_CART, TOPIC, settings_->publish_exteventinsnavcart);
+        consume(EXT_EVENT_INS_NAV_GEOD, TOPIC, settings_->publish_exteventinsnavgeod);
+        consume(EXT_SENSOR_MEAS, TOPIC, settings_->publish_extsensormeas);
+        consume(EXT_SENSOR_MEAS, IMU, settings_->publish_imu);
+        consume(CHANNEL_STATUS, GPSFIX, settings_->publish_gpsfix);
+        consume(MEAS_EPOCH, TOPIC, settings_->publish_measepoch);
+        consume(MEAS_EPOCH, GPSFIX, settings_->publish_gpsfix);
+        consume(DOP, GPSFIX, settings_->publish_gpsfix);
+        consume(VEL_COV_CARTESIAN, TOPIC, settings_->publish_velcovcartesian);
+        consume(VEL_COV_GEODETIC, TOPIC, settings_->publish_velcovgeodetic);
+        consume(VEL_COV_GEODETIC, GPSFIX, settings_->publish_gpsfix);
+        consume(VEL_COV_GEODETIC, TWIST, settings_->publish_twist);
+        consume(RECEIVER_STATUS, DIAGNOSTICS, settings_->publish_diagnostics);
+        consume(QUALITY_IND, DIAGNOSTICS, settings_->publish_diagnostics);
+        consume(RECEIVER_SETUP, DRIVER, true);
+        consume(RECEIVER_TIME, DRIVER, true);
+        for (uint16_t id : settings_->publish_raw_sbf)
+            sbfConsumers_[id] |= RAW;
+
+        std::string parsed;
+        for (uint16_t id = 0; id < SBF_ID_COUNT; ++id)
+        {
+            if (sbfConsumers_[id] != NONE)
+                parsed += " " + std::to_string(id);
+        }
+        node_->log(log_level::DEBUG, "SBF blocks to be parsed:" + parsed);
+
+        decimator_ = TopicDecimator();
+        sbfTopics_.clear();
+        for (size_t t = 0; t < settings_->publish_rate.size(); ++t)
+        {
+            if (settings_->publish_rate[t] > 0.0)
+                decimator_.configure(
+                    t, static_cast<uint32_t>(
+                           std::lround(1000.0 / settings_->publish_rate[t])));
+        }
+        if (!decimator_.active())
+            return;
+
+        auto bit = [](topic::Topic t) { return TopicDecimator::bit(t); };
+        // Consumers without topic, if not decimated, keep their blocks parsed
+        const std::array<std::pair<SbfConsumer, TopicDecimator::TopicMask>, 10>
+            consumerTopics = {
+                {{NAVSATFIX, bit(topic::NAVSATFIX)},
+                 {GPSFIX, bit(topic::GPSFIX)},
+                 {POSE, bit(topic::POSE)},
+                 {TWIST, bit(topic::TWIST_GNSS) | bit(topic::TWIST_INS)},
+                 {IMU, bit(topic::IMU)},
+                 {LOCALIZATION,
+                  settings_->publish_tf ? 0 : bit(topic::LOCALIZATION)},
+                 {LOCALIZATION_ECEF,
+                  settings_->publish_tf_ecef ? 0 : bit(topic::LOCALIZATION_ECEF)},
+                 {DIAGNOSTICS,
+                  bit(topic::DIAGNOSTICS) | bit(topic::AIM_PLUS_STATUS)},
+                 {TIME_REFERENCE, bit(topic::GPST)},
+                 {RAW, bit(topic::RAW_SBF)}}};
+        for (uint16_t id = 0; id < SBF_ID_COUNT; ++id)
+        {
+            uint16_t consumers = sbfConsumers_[id];
+            if (consumers == NONE)
+                continue;
+            TopicDecimator::TopicMask topics = 0;
+            if (consumers & TOPIC)
+            {
+                topic::Topic t = blockTopic(id);
+                if (t == topic::COUNT)
+                    continue;
+                topics |= bit(t);
+                consumers &= ~TOPIC;
+            }
+            for (const auto& [consumer, mask] : consumerTopics)
+            {
+                if ((consumers & consumer) && (mask != 0))
+                {
+                    topics |= mask;
+                    consumers &= ~consumer;
+                }
+            }
+            if (consumers == NONE)
+                sbfTopics_[id] = topics;
+        }
+    }
+
+    uint16_t MessageHandler::epochBlock(uint16_t sbfId)
+    {
+        switch (sbfId)
+        {
+        case PVT_GEODETIC:
+            return epoch_block::PVT_GEODETIC;
+        case POS_COV_GEODETIC:
+            return epoch_block::POS_COV_GEODETIC;
+        case ATT_EULER:
+            return epoch_block::ATT_EULER;
+        case ATT_COV_EULER:
+            return epoch_block::ATT_COV_EULER;
+        case VEL_COV_GEODETIC:
+            return epoch_block::VEL_COV_GEODETIC;
+        case INS_NAV_CART:
+            return epoch_block::INS_NAV_CART;
+        case INS_NAV_GEOD:
+            return epoch_block::INS_NAV_GEOD;
+        case MEAS_EPOCH:
+            return epoch_block::MEAS_EPOCH;
+        case CHANNEL_STATUS:
+            return epoch_block::CHANNEL_STATUS;
+        case DOP:
+            return epoch_block::DOP;
+        case RECEIVER_STATUS:
+            return epoch_block::RECEIVER_STATUS;
+        case QUALITY_IND:
+            return epoch_block::QUALITY_IND;
+        default:
+            return epoch_block::NONE;
+        }
+    }
+
+    topic::Topic MessageHandler::blockTopic(uint16_t sbfId)
+    {
+        switch (sbfId)
+        {
+        case PVT_CARTESIAN:
+            return topic::PVT_CARTESIAN;
+        case PVT_GEODETIC:
+            return topic::PVT_GEODETIC;
+        case BASE_VECTOR_CART:
+            return topic::BASE_VECTOR_CART;
+        case BASE_VECTOR_GEOD:
+            return topic::BASE_VECTOR_GEOD;
+        case POS_COV_CARTESIAN:
+            return topic::POS_COV_CARTESIAN;
+        case POS_COV_GEODETIC:
+            return topic::POS_COV_GEODETIC;
+        case VEL_COV_CARTESIAN:
+            return topic::VEL_COV_CARTESIAN;
+        case VEL_COV_GEODETIC:
+            return topic::VEL_COV_GEODETIC;
+        case ATT_EULER:
+            return topic::ATT_EULER;
+        case ATT_COV_EULER:
+            return topic::ATT_COV_EULER;
+        case MEAS_EPOCH:
+            return topic::MEAS_EPOCH;
+        case GAL_AUTH_STATUS:
+            return topic::GAL_AUTH_STATUS;
+        case RF_STATUS:
+            return topic::RF_STATUS;
+        case INS_NAV_CART:
+            return topic::INS_NAV_CART;
+        case INS_NAV_GEOD:
+            return topic::INS_NAV_GEOD;
+        case IMU_SETUP:
+            return topic::IMU_SETUP;
+        case VEL_SENSOR_SETUP:
+            return topic::VEL_SENSOR_SETUP;
+        case EXT_EVENT_INS_NAV_CART:
+            return topic::EXT_EVENT_INS_NAV_CART;
+        case EXT_EVENT_INS_NAV_GEOD:
+            return topic::EXT_EVENT_INS_NAV_GEOD;
+        case EXT_SENSOR_MEAS:
+            return topic::EXT_SENSOR_MEAS;
+        default:
+            return topic::COUNT;
+        }
+    }
+
+    void MessageHandler::setupEpochAggregator()
+    {
+        // Block names clash with the SBF IDs
+        const uint16_t pvt = epoch_block::PVT_GEODETIC;
+        const uint16_t posCov = epoch_block::POS_COV_GEODETIC;
+        const uint16_t att = epoch_block::ATT_EULER;
+        const uint16_t attCov = epoch_block::ATT_COV_EULER;
+        const uint16_t velCov = epoch_block::VEL_COV_GEODETIC;
+        const uint16_t insCart = epoch_block::INS_NAV_CART;
+        const uint16_t insGeod = epoch_block::INS_NAV_GEOD;
+        const uint16_t meas = epoch_block::MEAS_EPOCH;
+        const uint16_t channels = epoch_block::CHANNEL_STATUS | epoch_block::DOP;
+        const uint16_t diagnostics =
+            epoch_block::RECEIVER_STATUS | epoch_block::QUALITY_IND;
+
+        epochAggregator_.clear();
+        auto add = [this](uint16_t inputs, uint16_t required,
+                          EpochAggregator::Assembler assembler) {
+            epochAggregator_.add(inputs, required, std::move(assembler));
+        };
+
+        if (settings_->septentrio_receiver_type == "gnss")
+        {
+            const uint16_t pose = pvt | posCov | att | attCov;
+            if (settings_->publish_navsatfix)
+                add(pvt | posCov, pvt | posCov, [this]() { assembleNavSatFix(); });
+            if (settings_->publish_gpsfix)
+                add(pose | velCov | meas | channels, pose | meas,
+                    [this]() { assembleGpsFix(); });
+            if (settings_->publish_pose)
+                add(pose, pose, [this]() { assemblePoseWithCovarianceStamped(); });
+        } else if (settings_->septentrio_receiver_type == "ins")
+        {
+            if (settings_->publish_navsatfix)
+                add(insGeod, insGeod, [this]() { assembleNavSatFix(); });
+            if (settings_->publish_gpsfix)
+                add(insGeod | pvt | meas | channels, insGeod | meas,
+                    [this]() { assembleGpsFix(); });
+            if (settings_->publish_pose)
+                add(insGeod, insGeod,
+                    [this]() { assemblePoseWithCovarianceStamped(); });
+            if (settings_->publish_twist)
+                add(insGeod, insGeod, [this]() { assembleTwist(true); });
+            if (settings_->publish_localization || settings_->publish_tf)
+                add(insGeod, insGeod, [this]() { assembleLocalizationUtm(); });
+            if (settings_->publish_localization_ecef || settings_->publish_tf_ecef)
+                add(insCart | insGeod, insCart | insGeod,
+                    [this]() { assembleLocalizationEcef(); });
+        }
+        // Twist from PVTGeodetic is published for both receiver types
+        if (settings_->publish_twist)
+            add(pvt | velCov, pvt | velCov, [this]() { assembleTwist(false); });
+        if (settings_->publish_diagnostics)
+            add(diagnostics, diagnostics, [this]() { assembleDiagnosticArray(); });
+    }
+
+    void MessageHandler::advertiseTopics()
+    {
+        auto advertise = [this](auto msgType, topic::Topic topic, bool active) {
+            if (active)
+                node_->advertise<decltype(msgType)>(topic);
+        };
+
+        advertise(GpggaMsg(), topic::GPGGA, settings_->publish_gpgga);
+        advertise(GprmcMsg(), topic::GPRMC, settings_->publish_gprmc);
+        advertise(GpgsaMsg(), topic::GPGSA, settings_->publish_gpgsa);
+        advertise(GpgsvMsg(), topic::GPGSV, settings_->publish_gpgsv);
+        advertise(PVTCartesianMsg(), topic::PVT_CARTESIAN,
+                  settings_->publish_pvtcartesian);
+        advertise(PVTGeodeticMsg(), topic::PVT_GEODETIC,
+                  settings_->publish_pvtgeodetic);
+        advertise(BaseVectorCartMsg(), topic::BASE_VECTOR_CART,
+                  settings_->publish_basevectorcart);
+        advertise(BaseVectorGeodMsg(), topic::BASE_VECTOR_GEOD,
+                  settings_->publish_basevectorgeod);
+        advertise(PosCovCartesianMsg(), topic::POS_COV_CARTESIAN,
+                  settings_->publish_poscovcartesian);
+        advertise(PosCovGeodeticMsg(), topic::POS_COV_GEODETIC,
+                  settings_->publish_poscovgeodetic);
+        advertise(VelCovCartesianMsg(), topic::VEL_COV_CARTESIAN,
+                  settings_->publish_velcovcartesian);
+        advertise(VelCovGeodeticMsg(), topic::VEL_COV_GEODETIC,
+                  settings_->publish_velcovgeodetic);
+        advertise(AttEulerMsg(), topic::ATT_EULER, settings_->publish_atteuler);
+        advertise(AttCovEulerMsg(), topic::ATT_COV_EULER,
+                  settings_->publish_attcoveuler);
+        advertise(MeasEpochMsg(), topic::MEAS_EPOCH, settings_->publish_measepoch);
+        advertise(GalAuthStatusMsg(), topic::GAL_AUTH_STATUS,
+                  settings_->publish_galauthstatus);
+        advertise(RfStatusMsg(), topic::RF_STATUS, settings_->publish_aimplusstatus);
+        advertise(AimPlusStatusMsg(), topic::AIM_PLUS_STATUS,
+                  settings_->publish_aimplusstatus);
+        advertise(INSNavCartMsg(), topic::INS_NAV_CART,
+                  settings_->publish_insnavcart);
+        advertise(INSNavGeodMsg(), topic::INS_NAV_GEOD,
+                  settings_->publish_insnavgeod);
+        advertise(IMUSetupMsg(), topic::IMU_SETUP, settings_->publish_imusetup);
+        advertise(VelSensorSetupMsg(), topic::VEL_SENSOR_SETUP,
+                  settings_->publish_velsensorsetup);
+        advertise(INSNavCartMsg(), topic::EXT_EVENT_INS_NAV_CART,
+                  settings_->publish_exteventinsnavcart);
+        advertise(INSNavGeodMsg(), topic::EXT_EVENT_INS_NAV_GEOD,
+                  settings_->publish_exteventinsnavgeod);
+        advertise(ExtSensorMeasMsg(), topic::EXT_SENSOR_MEAS,
+                  settings_->publish_extsensormeas);
+        advertise(TimeReferenceMsg(), topic::GPST, settings_->publish_gpst);
+        advertise(NavSatFixMsg(), topic::NAVSATFIX, settings_->publish_navsatfix);
+        advertise(GpsFixMsg(), topic::GPSFIX, settings_->publish_gpsfix);
+        advertise(PoseWithCovarianceStampedMsg(), topic::POSE,
+                  settings_->publish_pose);
+        advertise(DiagnosticArrayMsg(), topic::DIAGNOSTICS,
+                  settings_->publish_diagnostics ||
+                      settings_->publish_galauthstatus ||
+                      settings_->publish_aimplusstatus);
+        advertise(ImuMsg(), topic::IMU, settings_->publish_imu);
+        advertise(LocalizationMsg(), topic::LOCALIZATION,
+                  settings_->publish_localization);
+        advertise(LocalizationMsg(), topic::LOCALIZATION_ECEF,
+                  settings_->publish_localization_ecef);
+        advertise(TwistWithCovarianceStampedMsg(), topic::TWIST_GNSS,
+                  settings_->publish_twist);
+        advertise(TwistWithCovarianceStampedMsg(), topic::TWIST_INS,
+                  settings_->publish_twist);
+        advertise(RawSbfBlockView(), topic::RAW_SBF,
+                  !settings_->publish_raw_sbf.empty());
+    }
+
+    void MessageHandler::startPublishPipeline()
+    {
+        // Replaying files shall not lose messages, when reading from the Rx
+        // stale messages are dropped instead of delaying fresh ones
+        publishPipeline_.start(settings_->publish_pipeline_threads,
+                               settings_->read_from_sbf_log ||
+                                   settings_->read_from_pcap);
+        node_->log(log_level::DEBUG,
+                   "Publishing with " + std::to_string(publishPipeline_.workers()) +
+                       " threads.");
+    }
+
     void MessageHandler::parseSbf(const std::shared_ptr<Telegram>& telegram)
     {
 
         uint16_t sbfId = parsing_utilities::getId(telegram->message);
 
+        // Nobody needs this block, no need to parse it
+        if (sbfConsumers_[sbfId] == sbf_consumer::NONE)
+            return;
+        telegramStamp_ = telegram->stamp;
+
+        uint32_t tow = parsing_utilities::getTow(telegram->message);
+        uint16_t wnc = parsing_utilities::getWnc(telegram->message);
+        if (epochsReset_.load(std::memory_order_relaxed) &&
+            epochsReset_.exchange(false))
+            epochAggregator_.reset();
+        epochAggregator_.begin(epochBlock(sbfId), tow, wnc, steadyTime());
+
+        // Composites closed above are still decided in the previous epoch
+        if (decimator_.active())
+        {
+            decimator_.begin(tow, wnc);
+            auto topics = sbfTopics_.find(sbfId);
+            // None of the topics needing this block is due in this epoch
+            if ((topics != sbfTopics_.end()) && !decimator_.due(topics->second))
+            {
+                epochAggregator_.skipped();
+                return;
+            }
+        }
+
+        if (sbfConsumers_[sbfId] & sbf_consumer::RAW)
+        {
+            publishRawSbf(telegram);
+            // Published raw only
+            if (sbfConsumers_[sbfId] == sbf_consumer::RAW)
+                return;
+        }
+
         /*node_->log(log_level::DEBUG, "ROSaic reading SBF block " +
                                         std::to_string(sbfId) + " made up of " +
                                         std::to_string(telegram->message.size()) +
@@ -2221,11 +2660,13 @@ namespace io {
                 if (!PVTCartesianParser(node_, telegram->message.begin(),
                                         telegram->message.end(), msg))
                 {
-                    node_->log(log_level::ERROR, "parse error in PVTCartesian");
+                    ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                        STREAM_ERROR_LOG_PERIOD_S,
+                                        "parse error in PVTCartesian");
                     break;
                 }
                 assembleHeader(settings_->frame_id, telegram, msg);
-                publish<PVTCartesianMsg>("pvtcartesian", msg);
+                publish<PVTCartesianMsg>(topic::PVT_CARTESIAN, msg);
             }
             break;
         }
@@ -2235,16 +2676,15 @@ namespace io {
             if (!PVTGeodeticParser(node_, telegram->message.begin(),
                                    telegram->message.end(), last_pvtgeodetic_))
             {
-                node_->log(log_level::ERROR, "parse error in PVTGeodetic");
+                ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                    STREAM_ERROR_LOG_PERIOD_S,
+                                    "parse error in PVTGeodetic");
                 break;
             }
             assembleHeader(settings_->frame_id, telegram, last_pvtgeodetic_);
             if (settings_->publish_pvtgeodetic)
-                publish<PVTGeodeticMsg>("pvtgeodetic", last_pvtgeodetic_);
-            assembleTwist();
-            assembleNavSatFix();
-            assemblePoseWithCovarianceStamped();
-            assembleGpsFix();
+                publish<PVTGeodeticMsg>(topic::PVT_GEODETIC, last_pvtgeodetic_);
+            epochAggregator_.received();
             if (settings_->publish_gpst &&
                 (settings_->septentrio_receiver_type == "gnss"))
                 assembleTimeReference(telegram);
@@ -2259,11 +2699,13 @@ namespace io {
                 if (!BaseVectorCartParser(node_, telegram->message.begin(),
                                           telegram->message.end(), msg))
                 {
-                    node_->log(log_level::ERROR, "parse error in BaseVectorCart");
+                    ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                        STREAM_ERROR_LOG_PERIOD_S,
+                                        "parse error in BaseVectorCart");
                     break;
                 }
                 assembleHeader(settings_->frame_id, telegram, msg);
-                publish<BaseVectorCartMsg>("basevectorcart", msg);
+                publish<BaseVectorCartMsg>(topic::BASE_VECTOR_CART, msg);
             }
             break;
         }
@@ -2276,11 +2718,13 @@ namespace io {
                 if (!BaseVectorGeodParser(node_, telegram->message.begin(),
                                           telegram->message.end(), msg))
                 {
-                    node_->log(log_level::ERROR, "parse error in BaseVectorGeod");
+                    ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                        STREAM_ERROR_LOG_PERIOD_S,
+                                        "parse error in BaseVectorGeod");
                     break;
                 }
                 assembleHeader(settings_->frame_id, telegram, msg);
-                publish<BaseVectorGeodMsg>("basevectorgeod", msg);
+                publish<BaseVectorGeodMsg>(topic::BASE_VECTOR_GEOD, msg);
             }
             break;
         }
@@ -2293,11 +2737,13 @@ namespace io {
                 if (!PosCovCartesianParser(node_, telegram->message.begin(),
                                            telegram->message.end(), msg))
                 {
-                    node_->log(log_level::ERROR, "parse error in PosCovCartesian");
+                    ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                        STREAM_ERROR_LOG_PERIOD_S,
+                                        "parse error in PosCovCartesian");
                     break;
                 }
                 assembleHeader(settings_->frame_id, telegram, msg);
-                publish<PosCovCartesianMsg>("poscovcartesian", msg);
+                publish<PosCovCartesianMsg>(topic::POS_COV_CARTESIAN, msg);
             }
             break;
         }
@@ -2306,15 +2752,16 @@ namespace io {
             if (!PosCovGeodeticParser(node_, telegram->message.begin(),
                                       telegram->message.end(), last_poscovgeodetic_))
             {
-                node_->log(log_level::ERROR, "parse error in PosCovGeodetic");
+                ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                    STREAM_ERROR_LOG_PERIOD_S,
+                                    "parse error in PosCovGeodetic");
                 break;
             }
             assembleHeader(settings_->frame_id, telegram, last_poscovgeodetic_);
             if (settings_->publish_poscovgeodetic)
-                publish<PosCovGeodeticMsg>("poscovgeodetic", last_poscovgeodetic_);
-            assembleNavSatFix();
-            assemblePoseWithCovarianceStamped();
-            assembleGpsFix();
+                publish<PosCovGeodeticMsg>(topic::POS_COV_GEODETIC,
+                                           last_poscovgeodetic_);
+            epochAggregator_.received();
             break;
         }
         case ATT_EULER:
@@ -2323,14 +2770,15 @@ namespace io {
                                 telegram->message.end(), last_atteuler_,
                                 settings_->use_ros_axis_orientation))
             {
-                node_->log(log_level::ERROR, "parse error in AttEuler");
+                ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                    STREAM_ERROR_LOG_PERIOD_S,
+                                    "parse error in AttEuler");
                 break;
             }
             assembleHeader(settings_->frame_id, telegram, last_atteuler_);
             if (settings_->publish_atteuler)
-                publish<AttEulerMsg>("atteuler", last_atteuler_);
-            assemblePoseWithCovarianceStamped();
-            assembleGpsFix();
+                publish<AttEulerMsg>(topic::ATT_EULER, last_atteuler_);
+            epochAggregator_.received();
             break;
         }
         case ATT_COV_EULER:
@@ -2339,14 +2787,15 @@ namespace io {
                                    telegram->message.end(), last_attcoveuler_,
                                    settings_->use_ros_axis_orientation))
             {
-                node_->log(log_level::ERROR, "parse error in AttCovEuler");
+                ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                    STREAM_ERROR_LOG_PERIOD_S,
+                                    "parse error in AttCovEuler");
                 break;
             }
             assembleHeader(settings_->frame_id, telegram, last_attcoveuler_);
             if (settings_->publish_attcoveuler)
-                publish<AttCovEulerMsg>("attcoveuler", last_attcoveuler_);
-            assemblePoseWithCovarianceStamped();
-            assembleGpsFix();
+                publish<AttCovEulerMsg>(topic::ATT_COV_EULER, last_attcoveuler_);
+            epochAggregator_.received();
             break;
         }
         case GAL_AUTH_STATUS:
@@ -2354,14 +2803,17 @@ namespace io {
             if (!GalAuthStatusParser(node_, telegram->message.begin(),
                                      telegram->message.end(), last_gal_auth_status_))
             {
-                node_->log(log_level::ERROR, "parse error in GalAuthStatus");
+                ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                    STREAM_ERROR_LOG_PERIOD_S,
+                                    "parse error in GalAuthStatus");
                 break;
             }
             osnma_info_available_ = true;
             assembleHeader(settings_->frame_id, telegram, last_gal_auth_status_);
             if (settings_->publish_galauthstatus)
             {
-                publish<GalAuthStatusMsg>("galauthstatus", last_gal_auth_status_);
+                publish<GalAuthStatusMsg>(topic::GAL_AUTH_STATUS,
+                                          last_gal_auth_status_);
                 assembleOsnmaDiagnosticArray();
             }
             break;
@@ -2377,7 +2829,7 @@ namespace io {
             assembleHeader(settings_->frame_id, telegram, last_rf_status_);
             if (settings_->publish_aimplusstatus)
             {
-                publish<RfStatusMsg>("rfstatus", last_rf_status_);
+                publish<RfStatusMsg>(topic::RF_STATUS, last_rf_status_);
                 assembleAimAndDiagnosticArray();
             }
             break;
@@ -2389,7 +2841,9 @@ namespace io {
                                   telegram->message.end(), last_insnavcart_,
                                   settings_->use_ros_axis_orientation))
             {
-                node_->log(log_level::ERROR, "parse error in INSNavCart");
+                ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                    STREAM_ERROR_LOG_PERIOD_S,
+                                    "parse error in INSNavCart");
                 break;
             }
             std::string frame_id;
@@ -2402,8 +2856,8 @@ namespace io {
             }
             assembleHeader(frame_id, telegram, last_insnavcart_);
             if (settings_->publish_insnavcart)
-                publish<INSNavCartMsg>("insnavcart", last_insnavcart_);
-            assembleLocalizationEcef();
+                publish<INSNavCartMsg>(topic::INS_NAV_CART, last_insnavcart_);
+            epochAggregator_.received();
             break;
         }
         case INS_NAV_GEOD: // Position, velocity and orientation in geodetic
@@ -2413,7 +2867,9 @@ namespace io {
                                   telegram->message.end(), last_insnavgeod_,
                                   settings_->use_ros_axis_orientation))
             {
-                node_->log(log_level::ERROR, "parse error in INSNavGeod");
+                ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                    STREAM_ERROR_LOG_PERIOD_S,
+                                    "parse error in INSNavGeod");
                 break;
             }
             std::string frame_id;
@@ -2426,13 +2882,8 @@ namespace io {
             }
             assembleHeader(frame_id, telegram, last_insnavgeod_);
             if (settings_->publish_insnavgeod)
-                publish<INSNavGeodMsg>("insnavgeod", last_insnavgeod_);
-            assembleLocalizationUtm();
-            assembleLocalizationEcef();
-            assembleTwist(true);
-            assemblePoseWithCovarianceStamped();
-            assembleNavSatFix();
-            assembleGpsFix();
+                publish<INSNavGeodMsg>(topic::INS_NAV_GEOD, last_insnavgeod_);
+            epochAggregator_.received();
             if (settings_->publish_gpst)
                 assembleTimeReference(telegram);
             break;
@@ -2447,17 +2898,19 @@ namespace io {
                                     telegram->message.end(), msg,
                                     settings_->use_ros_axis_orientation))
                 {
-                    node_->log(log_level::ERROR, "parse error in IMUSetup");
+                    ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                        STREAM_ERROR_LOG_PERIOD_S,
+                                        "parse error in IMUSetup");
                     break;
                 }
                 assembleHeader(settings_->vehicle_frame_id, telegram, msg);
-                publish<IMUSetupMsg>("imusetup", msg);
+                publish<IMUSetupMsg>(topic::IMU_SETUP, msg);
             }
             break;
         }
         case VEL_SENSOR_SETUP: // Velocity sensor lever arm
         {
-            if (settings_->publish_velcovgeodetic)
+            if (settings_->publish_velsensorsetup)
             {
                 VelSensorSetupMsg msg;
 
@@ -2465,11 +2918,13 @@ namespace io {
                                           telegram->message.end(), msg,
                                           settings_->use_ros_axis_orientation))
                 {
-                    node_->log(log_level::ERROR, "parse error in VelSensorSetup");
+                    ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                        STREAM_ERROR_LOG_PERIOD_S,
+                                        "parse error in VelSensorSetup");
                     break;
                 }
                 assembleHeader(settings_->vehicle_frame_id, telegram, msg);
-                publish<VelSensorSetupMsg>("velsensorsetup", msg);
+                publish<VelSensorSetupMsg>(topic::VEL_SENSOR_SETUP, msg);
             }
             break;
         }
@@ -2497,7 +2952,7 @@ namespace io {
                     frame_id = settings_->frame_id;
                 }
                 assembleHeader(frame_id, telegram, msg);
-                publish<INSNavCartMsg>("exteventinsnavcart", msg);
+                publish<INSNavCartMsg>(topic::EXT_EVENT_INS_NAV_CART, msg);
             }
             break;
         }
@@ -2524,7 +2979,7 @@ namespace io {
                     frame_id = settings_->frame_id;
                 }
                 assembleHeader(frame_id, telegram, msg);
-                publish<INSNavGeodMsg>("exteventinsnavgeod", msg);
+                publish<INSNavGeodMsg>(topic::EXT_EVENT_INS_NAV_GEOD, msg);
             }
             break;
         }
@@ -2536,12 +2991,14 @@ namespace io {
                                      settings_->use_ros_axis_orientation,
                                      hasImuMeas))
             {
-                node_->log(log_level::ERROR, "parse error in ExtSensorMeas");
+                ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                    STREAM_ERROR_LOG_PERIOD_S,
+                                    "parse error in ExtSensorMeas");
                 break;
             }
             assembleHeader(settings_->imu_frame_id, telegram, last_extsensmeas_);
             if (settings_->publish_extsensormeas)
-                publish<ExtSensorMeasMsg>("extsensormeas", last_extsensmeas_);
+                publish<ExtSensorMeasMsg>(topic::EXT_SENSOR_MEAS, last_extsensmeas_);
             if (settings_->publish_imu && hasImuMeas)
             {
                 assembleImu();
@@ -2553,10 +3010,13 @@ namespace io {
             if (!ChannelStatusParser(node_, telegram->message.begin(),
                                      telegram->message.end(), last_channelstatus_))
             {
-                node_->log(log_level::ERROR, "parse error in ChannelStatus");
+                ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                    STREAM_ERROR_LOG_PERIOD_S,
+                                    "parse error in ChannelStatus");
                 break;
             }
-            assembleGpsFix();
+            channelSatellites_.fill(last_channelstatus_);
+            epochAggregator_.received();
             break;
         }
         case MEAS_EPOCH:
@@ -2564,13 +3024,17 @@ namespace io {
             if (!MeasEpochParser(node_, telegram->message.begin(),
                                  telegram->message.end(), last_measepoch_))
             {
-                node_->log(log_level::ERROR, "parse error in MeasEpoch");
+                ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                    STREAM_ERROR_LOG_PERIOD_S,
+                                    "parse error in MeasEpoch");
                 break;
             }
+            if (sbfConsumers_[MEAS_EPOCH] & sbf_consumer::GPSFIX)
+                trackedSatellites_.fill(last_measepoch_);
             assembleHeader(settings_->frame_id, telegram, last_measepoch_);
             if (settings_->publish_measepoch)
-                publish<MeasEpochMsg>("measepoch", last_measepoch_);
-            assembleGpsFix();
+                publish<MeasEpochMsg>(topic::MEAS_EPOCH, last_measepoch_);
+            epochAggregator_.received();
             break;
         }
         case DOP:
@@ -2578,10 +3042,12 @@ namespace io {
             if (!DOPParser(node_, telegram->message.begin(), telegram->message.end(),
                            last_dop_))
             {
-                node_->log(log_level::ERROR, "parse error in DOP");
+                ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                    STREAM_ERROR_LOG_PERIOD_S,
+                                    "parse error in DOP");
                 break;
             }
-            assembleGpsFix();
+            epochAggregator_.received();
             break;
         }
         case VEL_COV_CARTESIAN:
@@ -2592,11 +3058,13 @@ namespace io {
                 if (!VelCovCartesianParser(node_, telegram->message.begin(),
                                            telegram->message.end(), msg))
                 {
-                    node_->log(log_level::ERROR, "parse error in VelCovCartesian");
+                    ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                        STREAM_ERROR_LOG_PERIOD_S,
+                                        "parse error in VelCovCartesian");
                     break;
                 }
                 assembleHeader(settings_->frame_id, telegram, msg);
-                publish<VelCovCartesianMsg>("velcovcartesian", msg);
+                publish<VelCovCartesianMsg>(topic::VEL_COV_CARTESIAN, msg);
             }
             break;
         }
@@ -2606,14 +3074,16 @@ namespace io {
             if (!VelCovGeodeticParser(node_, telegram->message.begin(),
                                       telegram->message.end(), last_velcovgeodetic_))
             {
-                node_->log(log_level::ERROR, "parse error in VelCovGeodetic");
+                ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                    STREAM_ERROR_LOG_PERIOD_S,
+                                    "parse error in VelCovGeodetic");
                 break;
             }
             assembleHeader(settings_->frame_id, telegram, last_velcovgeodetic_);
             if (settings_->publish_velcovgeodetic)
-                publish<VelCovGeodeticMsg>("velcovgeodetic", last_velcovgeodetic_);
-            assembleTwist();
-            assembleGpsFix();
+                publish<VelCovGeodeticMsg>(topic::VEL_COV_GEODETIC,
+                                           last_velcovgeodetic_);
+            epochAggregator_.received();
             break;
         }
         case RECEIVER_STATUS:
@@ -2621,10 +3091,13 @@ namespace io {
             if (!ReceiverStatusParser(node_, telegram->message.begin(),
                                       telegram->message.end(), last_receiverstatus_))
             {
-                node_->log(log_level::ERROR, "parse error in ReceiverStatus");
+                ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                    STREAM_ERROR_LOG_PERIOD_S,
+                                    "parse error in ReceiverStatus");
                 break;
             }
-            assembleDiagnosticArray(telegram);
+            diagnosticsTelegram_ = telegram;
+            epochAggregator_.received();
             break;
         }
         case QUALITY_IND:
@@ -2632,10 +3105,13 @@ namespace io {
             if (!QualityIndParser(node_, telegram->message.begin(),
                                   telegram->message.end(), last_qualityind_))
             {
-                node_->log(log_level::ERROR, "parse error in QualityInd");
+                ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                    STREAM_ERROR_LOG_PERIOD_S,
+                                    "parse error in QualityInd");
                 break;
             }
-            assembleDiagnosticArray(telegram);
+            diagnosticsTelegram_ = telegram;
+            epochAggregator_.received();
             break;
         }
         case RECEIVER_SETUP:
@@ -2643,7 +3119,9 @@ namespace io {
             if (!ReceiverSetupParser(node_, telegram->message.begin(),
                                      telegram->message.end(), last_receiversetup_))
             {
-                node_->log(log_level::ERROR, "parse error in ReceiverSetup");
+                ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                    STREAM_ERROR_LOG_PERIOD_S,
+                                    "parse error in ReceiverSetup");
                 break;
             }
             node_->log(log_level::DEBUG,
@@ -2719,7 +3197,9 @@ namespace io {
             if (!ReceiverTimeParser(node_, telegram->message.begin(),
                                     telegram->message.end(), msg))
             {
-                node_->log(log_level::ERROR, "parse error in ReceiverTime");
+                ROSAIC_LOG_THROTTLE(node_, log_level::ERROR,
+                                    STREAM_ERROR_LOG_PERIOD_S,
+                                    "parse error in ReceiverTime");
                 break;
             }
             current_leap_seconds_ = msg.delta_ls;
@@ -2727,8 +3207,9 @@ namespace io {
         }
         default:
         {
-            node_->log(log_level::DEBUG, "unhandled SBF block " +
-                                             std::to_string(sbfId) + " received.");
+            ROSAIC_LOG_THROTTLE(node_, log_level::DEBUG, STREAM_ERROR_LOG_PERIOD_S,
+                                "unhandled SBF block " + std::to_string(sbfId) +
+                                    " received.");
             break;
         }
             // Many more to be implemented...
@@ -2739,13 +3220,15 @@ namespace io {
     {
         Timestamp unix_old = unix_time_;
         unix_time_ = time_obj;
-        if ((unix_old != 0) && (unix_time_ > unix_old))
+        if ((settings_->replay_rate > 0.0) && (unix_old != 0) &&
+            (unix_time_ > unix_old))
         {
-            auto sleep_nsec = unix_time_ - unix_old;
+            auto sleep_nsec = static_cast<Timestamp>((unix_time_ - unix_old) /
+                                                     settings_->replay_rate);
 
-            std::stringstream ss;
-            ss << "Waiting for " << sleep_nsec / 1000000 << " milliseconds...";
-            node_->log(log_level::DEBUG, ss.str());
+            ROSAIC_LOG(node_, log_level::DEBUG,
+                       "Waiting for " + std::to_string(sleep_nsec / 1000000) +
+                           " milliseconds...");
 
             std::this_thread::sleep_for(std::chrono::nanoseconds(sleep_nsec));
         }
@@ -2753,83 +3236,70 @@ namespace io {
 
     void MessageHandler::parseNmea(const std::shared_ptr<Telegram>& telegram)
     {
-        std::string message(telegram->message.begin(), telegram->message.end());
-        /*node_->log(
-          LogLevel::DEBUG,
-          "The NMEA message contains " + std::to_string(message.size()) +
-              " bytes and is ready to be parsed. It reads: " + message);*/
-        boost::char_separator<char> sep_2(",*", "", boost::keep_empty_tokens);
-        boost::tokenizer<boost::char_separator<char>> tokens(message, sep_2);
-        std::vector<std::string> body;
-        body.reserve(20);
-        for (boost::tokenizer<boost::char_separator<char>>::iterator tok_iter =
-                 tokens.begin();
-             tok_iter != tokens.end(); ++tok_iter)
+        NMEASentence sentence;
+        if (!sentence.tokenize(telegram->message.data(), telegram->message.size()))
         {
-            body.push_back(*tok_iter);
+            ROSAIC_LOG_THROTTLE(node_, log_level::DEBUG, STREAM_ERROR_LOG_PERIOD_S,
+                                "Invalid NMEA message: " +
+                                    std::string(telegram->message.begin(),
+                                                telegram->message.end()));
+            return;
         }
+        telegramStamp_ = telegram->stamp;
 
-        std::string id(body[0].begin() + 1, body[0].end());
-
-        auto it = nmeaMap_.find(body[0]);
+        auto it = nmeaMap_.find(sentence[0]);
         if (it != nmeaMap_.end())
         {
             switch (it->second)
             {
             case 0:
             {
-                // Create NmeaSentence struct to pass to GpggaParser::parseASCII
-                NMEASentence gga_message(id, body);
                 GpggaMsg msg;
                 GpggaParser parser_obj;
                 try
                 {
-                    msg = parser_obj.parseASCII(gga_message, settings_->frame_id,
+                    msg = parser_obj.parseASCII(sentence, settings_->frame_id,
                                                 settings_->use_gnss_time,
                                                 telegram->stamp);
                 } catch (ParseException& e)
                 {
-                    node_->log(log_level::DEBUG,
+                    ROSAIC_LOG(node_, log_level::DEBUG,
                                "GpggaMsg: " + std::string(e.what()));
                     break;
                 }
-                publish<GpggaMsg>("gpgga", msg);
+                publish<GpggaMsg>(topic::GPGGA, msg);
                 break;
             }
             case 1:
             {
-                // Create NmeaSentence struct to pass to GprmcParser::parseASCII
-                NMEASentence rmc_message(id, body);
                 GprmcMsg msg;
                 GprmcParser parser_obj;
                 try
                 {
-                    msg = parser_obj.parseASCII(rmc_message, settings_->frame_id,
+                    msg = parser_obj.parseASCII(sentence, settings_->frame_id,
                                                 settings_->use_gnss_time,
                                                 telegram->stamp);
                 } catch (ParseException& e)
                 {
-                    node_->log(log_level::DEBUG,
+                    ROSAIC_LOG(node_, log_level::DEBUG,
                                "GprmcMsg: " + std::string(e.what()));
                     break;
                 }
-                publish<GprmcMsg>("gprmc", msg);
+                publish<GprmcMsg>(topic::GPRMC, msg);
                 break;
             }
             case 2:
             {
-                // Create NmeaSentence struct to pass to GpgsaParser::parseASCII
-                NMEASentence gsa_message(id, body);
                 GpgsaMsg msg;
                 GpgsaParser parser_obj;
                 try
                 {
-                    msg = parser_obj.parseASCII(gsa_message, settings_->frame_id,
+                    msg = parser_obj.parseASCII(sentence, settings_->frame_id,
                                                 settings_->use_gnss_time,
                                                 node_->getTime());
                 } catch (ParseException& e)
                 {
-                    node_->log(log_level::DEBUG,
+                    ROSAIC_LOG(node_, log_level::DEBUG,
                                "GpgsaMsg: " + std::string(e.what()));
                     break;
                 }
@@ -2851,23 +3321,21 @@ namespace io {
                     }
                 } else
                     msg.header.stamp = timestampToRos(telegram->stamp);
-                publish<GpgsaMsg>("gpgsa", msg);
+                publish<GpgsaMsg>(topic::GPGSA, msg);
                 break;
             }
-            case 4:
+            case 3:
             {
-                // Create NmeaSentence struct to pass to GpgsvParser::parseASCII
-                NMEASentence gsv_message(id, body);
                 GpgsvMsg msg;
                 GpgsvParser parser_obj;
                 try
                 {
-                    msg = parser_obj.parseASCII(gsv_message, settings_->frame_id,
+                    msg = parser_obj.parseASCII(sentence, settings_->frame_id,
                                                 settings_->use_gnss_time,
                                                 node_->getTime());
                 } catch (ParseException& e)
                 {
-                    node_->log(log_level::DEBUG,
+                    ROSAIC_LOG(node_, log_level::DEBUG,
                                "GpgsvMsg: " + std::string(e.what()));
                     break;
                 }
@@ -2890,13 +3358,15 @@ namespace io {
                     }
                 } else
                     msg.header.stamp = timestampToRos(telegram->stamp);
-                publish<GpgsvMsg>("gpgsv", msg);
+                publish<GpgsvMsg>(topic::GPGSV, msg);
                 break;
             }
             }
         } else
         {
-            node_->log(log_level::DEBUG, "Unknown NMEA message: " + body[0]);
+            ROSAIC_LOG_THROTTLE(node_, log_level::DEBUG, STREAM_ERROR_LOG_PERIOD_S,
+                                "Unknown NMEA message: " +
+                                    std::string(sentence[0]));
         }
     }
 
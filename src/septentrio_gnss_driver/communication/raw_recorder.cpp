@@ -0,0 +1,310 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <tuple>
+
+// POSIX
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <septentrio_gnss_driver/communication/raw_recorder.hpp>
+
+/**
+ * @file raw_recorder.cpp
+ * @brief Records the raw SBF and NMEA stream of the Rx to disk
+ */
+
+namespace io {
+
+    RawRecorder::RawRecorder(ROSaicNodeBase* node) :
+        node_(node), prefix_(node->settings()->raw_recorder_prefix),
+        directIo_(node->settings()->raw_recorder_direct_io),
+        rotateSize_(static_cast<uint64_t>(
+                        node->settings()->raw_recorder_rotate_size_mb) *
+                    1000000),
+        rotatePeriod_(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(
+                node->settings()->raw_recorder_rotate_period_s)))
+    {
+        capacity_ = std::max(
+            static_cast<std::size_t>(node->settings()->raw_recorder_buffer_kb) * 1024,
+            MIN_BUFFER_SIZE);
+        capacity_ = ((capacity_ + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+        buffers_.resize(std::max<uint32_t>(node->settings()->raw_recorder_buffers, 2));
+    }
+
+    RawRecorder::~RawRecorder() { stop(); }
+
+    bool RawRecorder::start()
+    {
+        for (auto& buffer : buffers_)
+        {
+            buffer.data.reset(
+                static_cast<uint8_t*>(std::aligned_alloc(ALIGNMENT, capacity_)));
+            if (!buffer.data)
+            {
+                node_->log(log_level::ERROR,
+                           "RawRecorder could not allocate its buffers.");
+                return false;
+            }
+            free_.push_back(&buffer);
+        }
+        fill_ = free_.back();
+        free_.pop_back();
+
+        if (!open())
+            return false;
+        alignment_ = directIo_ ? ALIGNMENT : 1;
+
+        writer_ = std::thread(&RawRecorder::run, this);
+        return true;
+    }
+
+    void RawRecorder::stop()
+    {
+        if (!writer_.joinable())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        writer_.join();
+        close();
+
+        node_->log(log_level::INFO,
+                   "RawRecorder wrote " + std::to_string(written_) + " bytes to " +
+                       std::to_string(files_) + " files, dropped " +
+                       std::to_string(dropped_) + " telegrams, lost " +
+                       std::to_string(lost_) + " bytes to write errors.");
+    }
+
+    void RawRecorder::record(const Telegram& telegram)
+    {
+        if ((telegram.type != telegram_type::SBF) &&
+            (telegram.type != telegram_type::NMEA) &&
+            (telegram.type != telegram_type::NMEA_INS))
+            return;
+
+        const std::size_t size = telegram.message.size();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_ || (fill_ == nullptr))
+            return;
+        // Does not fit next to the bytes carried over
+        if (size > (capacity_ - ALIGNMENT))
+        {
+            ++dropped_;
+            return;
+        }
+        if ((fill_->size + size) > capacity_)
+        {
+            if (!submit())
+            {
+                ++dropped_;
+                return;
+            }
+        }
+        std::memcpy(fill_->data.get() + fill_->size, telegram.message.data(), size);
+        fill_->size += size;
+    }
+
+    bool RawRecorder::submit()
+    {
+        if (free_.empty())
+            return false;
+        Buffer* next = free_.back();
+        free_.pop_back();
+
+        fill_->last = rotate_ || stopping_;
+        rotate_ = false;
+        closing_ = closing_ || fill_->last;
+        std::size_t carry = fill_->last ? 0 : (fill_->size % alignment_);
+        std::memcpy(next->data.get(), fill_->data.get() + fill_->size - carry,
+                    carry);
+        next->size = carry;
+        fill_->size -= carry;
+
+        full_.push_back(fill_);
+        fill_ = next;
+        cv_.notify_one();
+        return true;
+    }
+
+    void RawRecorder::run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            cv_.wait_for(lock, FLUSH_PERIOD,
+                         [this]() { return !full_.empty() || stopping_; });
+            if (!rotate_ && !closing_ && rotationDue())
+                rotate_ = true;
+
+            if (full_.empty())
+            {
+                // Idle or stopping, write what there is
+                if (fill_->size == 0)
+                {
+                    if (stopping_)
+                        break;
+                    continue;
+                }
+                if (!stopping_ && !rotate_ && (fill_->size < alignment_))
+                    continue;
+                if (!submit())
+                    continue;
+            }
+
+            Buffer* buffer = full_.front();
+            full_.pop_front();
+            bool reopen = !stopping_;
+            lock.unlock();
+            write(*buffer, reopen);
+            lock.lock();
+            if (buffer->last)
+                closing_ = false;
+            buffer->size = 0;
+            buffer->last = false;
+            free_.push_back(buffer);
+        }
+    }
+
+    void RawRecorder::write(const Buffer& buffer, bool reopen)
+    {
+        if ((fd_ < 0) && !open())
+        {
+            lost_ += buffer.size;
+            return;
+        }
+
+        const uint8_t* data = buffer.data.get();
+        std::size_t whole = buffer.size - (buffer.size % alignment_);
+        bool ok = writeAll(data, whole);
+        if (ok && (whole < buffer.size))
+        {
+            // The partial block ends the file and cannot be written with O_DIRECT
+            if (directIo_)
+                ::fcntl(fd_, F_SETFL, ::fcntl(fd_, F_GETFL) & ~O_DIRECT);
+            ok = writeAll(data + whole, buffer.size - whole);
+        }
+        if (!ok)
+        {
+            node_->log(log_level::ERROR,
+                       "RawRecorder write error: " + std::string(std::strerror(errno)) +
+                           ", starting a new file.");
+            close();
+            return;
+        }
+
+        if (buffer.last)
+        {
+            close();
+            if (reopen)
+                std::ignore = open();
+        }
+    }
+
+    bool RawRecorder::writeAll(const uint8_t* data, std::size_t size)
+    {
+        std::size_t done = 0;
+        while (done < size)
+        {
+            ssize_t n = ::write(fd_, data + done, size - done);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                lost_ += size - done;
+                return false;
+            }
+            done += static_cast<std::size_t>(n);
+            fileBytes_ += static_cast<uint64_t>(n);
+            written_ += static_cast<uint64_t>(n);
+        }
+        return true;
+    }
+
+    bool RawRecorder::open()
+    {
+        std::time_t now = std::time(nullptr);
+        std::tm utc;
+        gmtime_r(&now, &utc);
+        char stamp[20];
+        std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", &utc);
+        std::string file =
+            prefix_ + "_" + stamp + "_" + std::to_string(files_) + ".sbf";
+
+        int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+        if (directIo_)
+            flags |= O_DIRECT;
+        fd_ = ::open(file.c_str(), flags, 0644);
+        // Some file systems, e.g. tmpfs, do not support O_DIRECT, which can only
+        // be given up before the writer thread relies on the alignment
+        if ((fd_ < 0) && directIo_ && (errno == EINVAL) && (files_ == 0))
+        {
+            node_->log(log_level::WARN,
+                       "RawRecorder cannot use O_DIRECT, using the page cache.");
+            directIo_ = false;
+            fd_ = ::open(file.c_str(), flags & ~O_DIRECT, 0644);
+        }
+        if (fd_ < 0)
+        {
+            node_->log(log_level::ERROR, "RawRecorder could not open " + file +
+                                             ": " + std::strerror(errno));
+            return false;
+        }
+        ++files_;
+        fileBytes_ = 0;
+        fileOpened_ = std::chrono::steady_clock::now();
+        node_->log(log_level::INFO, "Recording raw stream to " + file);
+        return true;
+    }
+
+    void RawRecorder::close()
+    {
+        if (fd_ < 0)
+            return;
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+    bool RawRecorder::rotationDue() const
+    {
+        if ((fd_ < 0) || (fileBytes_ == 0))
+            return false;
+        return ((rotateSize_ != 0) && (fileBytes_ >= rotateSize_)) ||
+               ((rotatePeriod_.count() != 0) &&
+                ((std::chrono::steady_clock::now() - fileOpened_) >= rotatePeriod_));
+    }
+} // namespace io
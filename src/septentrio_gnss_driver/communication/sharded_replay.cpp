@@ -0,0 +1,209 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/message_handler.hpp>
+#include <septentrio_gnss_driver/communication/sharded_replay.hpp>
+
+/**
+ * @file sharded_replay.cpp
+ * @brief Parallel processing of SBF files into rosbags
+ */
+
+namespace io {
+
+    ShardedReplay::ShardedReplay(ROSaicNodeBase* node) :
+        node_(node), file_(node, nullptr)
+    {
+    }
+
+    [[nodiscard]] bool ShardedReplay::run()
+    {
+        const Settings* settings = node_->settings();
+        if (!file_.connect())
+            return false;
+
+        if (settings->insert_local_frame)
+            node_->log(
+                log_level::WARN,
+                "Local frame is not inserted into tf when processing into a rosbag.");
+
+        rosbag::Bag bag;
+        try
+        {
+            bag.open(settings->replay_bag, rosbag::bagmode::Write);
+        } catch (const std::exception& e)
+        {
+            node_->log(log_level::ERROR, "Opening rosbag " + settings->replay_bag +
+                                             " failed due to " + e.what());
+            return false;
+        }
+
+        size_t numThreads = settings->replay_threads;
+        if (numThreads == 0)
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        buildShards(numThreads);
+        maxPendingShards_ = 2 * numThreads;
+
+        node_->log(log_level::INFO, "Processing " + settings->device + " with " +
+                                        std::to_string(numThreads) + " threads in " +
+                                        std::to_string(shards_.size()) +
+                                        " shards into " + settings->replay_bag +
+                                        "...");
+        Timestamp start = node_->getTime();
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < numThreads; ++i)
+            threads.emplace_back([this]() { processShards(); });
+
+        size_t numMessages = 0;
+        for (auto& shard : shards_)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_.wait(lock, [&shard]() { return shard->done; });
+            }
+            numMessages += shard->recorder.size();
+            shard->recorder.writeTo(bag);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++writtenShards_;
+            }
+            cond_.notify_all();
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+        bag.close();
+
+        node_->log(log_level::INFO,
+                   "Wrote " + std::to_string(numMessages) + " messages to " +
+                       settings->replay_bag + " in " +
+                       std::to_string((node_->getTime() - start) / 1000000) +
+                       " ms.");
+        return true;
+    }
+
+    /**
+     * Shards end at the first TOW change after the shard size, so all blocks of an
+     * epoch are in the same shard.
+     */
+    void ShardedReplay::buildShards(size_t numThreads)
+    {
+        const std::vector<SbfIndexEntry>& index = file_.index();
+
+        size_t begin = 0;
+        size_t startOffset = file_.startOffset();
+        while ((begin < index.size()) && (index[begin].offset < startOffset))
+            ++begin;
+
+        size_t shardSize = std::max(REPLAY_SHARD_MIN_BLOCKS,
+                                    (index.size() - begin) /
+                                        (numThreads * REPLAY_SHARDS_PER_THREAD));
+
+        while (begin < index.size())
+        {
+            size_t end = std::min(begin + shardSize, index.size());
+            while ((end < index.size()) && (index[end].tow == index[end - 1].tow))
+                ++end;
+
+            size_t warmUp = begin;
+            if (SbfFileIo::validTime(index[begin]))
+            {
+                double warmUpTime =
+                    SbfFileIo::gpsTime(index[begin]) - REPLAY_WARM_UP_S;
+                while ((warmUp > 0) &&
+                       (!SbfFileIo::validTime(index[warmUp - 1]) ||
+                        (SbfFileIo::gpsTime(index[warmUp - 1]) >= warmUpTime)))
+                    --warmUp;
+            }
+
+            std::unique_ptr<Shard> shard(new Shard);
+            shard->warmUp = warmUp;
+            shard->begin = begin;
+            shard->end = end;
+            shards_.push_back(std::move(shard));
+            begin = end;
+        }
+    }
+
+    void ShardedReplay::processShards()
+    {
+        while (true)
+        {
+            Shard* shard;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (nextShard_ == shards_.size())
+                    return;
+                size_t current = nextShard_++;
+                // Do not run ahead of writing too far
+                cond_.wait(lock, [this, current]() {
+                    return current < writtenShards_ + maxPendingShards_;
+                });
+                shard = shards_[current].get();
+            }
+
+            processShard(*shard);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                shard->done = true;
+            }
+            cond_.notify_all();
+        }
+    }
+
+    void ShardedReplay::processShard(Shard& shard)
+    {
+        const std::vector<SbfIndexEntry>& index = file_.index();
+
+        MessageHandler handler(node_);
+        handler.setupSbfConsumers();
+        handler.setupEpochAggregator();
+        handler.setLeapSeconds();
+        handler.setRecorder(&shard.recorder);
+
+        for (size_t i = shard.warmUp; i < shard.end; ++i)
+        {
+            if (i == shard.begin)
+                shard.recorder.clear();
+
+            const uint8_t* block = file_.data() + index[i].offset;
+            uint16_t length = parsing_utilities::parseUInt16(block + 6);
+            // A fresh telegram per block, as recorded views of raw blocks keep
+            // theirs until the shard is written
+            std::shared_ptr<Telegram> telegram(new Telegram);
+            telegram->type = telegram_type::SBF;
+            telegram->message.assign(block, block + length);
+            telegram->stamp = node_->getTime();
+            handler.parseSbf(telegram);
+        }
+    }
+} // namespace io
@@ -74,10 +74,22 @@ namespace io {
         }
         case telegram_type::UNKNOWN:
         {
-            std::string block_in_string(telegram->message.begin(),
-                                        telegram->message.end());
+            std::string_view block_in_string(
+                reinterpret_cast<const char*>(telegram->message.data()),
+                telegram->message.size());
 
-            node_->log(log_level::DEBUG, "A message received: " + block_in_string);
+            ROSAIC_LOG(node_, log_level::DEBUG,
+                       "A message received: " + std::string(block_in_string));
+            {
+                std::lock_guard<std::mutex> lock(messageMutex_);
+                if (!messageKeyword_.empty() &&
+                    (block_in_string.find(messageKeyword_) != std::string::npos))
+                {
+                    messageKeyword_.clear();
+                    message_ = std::string(block_in_string);
+                    messageSemaphore_.notify();
+                }
+            }
             if (block_in_string.find("ReceiverCapabilities") != std::string::npos)
             {
                 if (block_in_string.find("INS") != std::string::npos)
@@ -116,12 +128,14 @@ namespace io {
     {
         std::string block_in_string(telegram->message.begin(),
                                     telegram->message.end());
+        std::string cmd = commands_.reply(block_in_string);
 
         if (telegram->type == telegram_type::ERROR_RESPONSE)
         {
             node_->log(
                 log_level::ERROR,
-                "Invalid command just sent to the Rx! The Rx's response contains " +
+                "Invalid command just sent to the Rx! The command was: " + cmd +
+                    "\n The Rx's response contains " +
                     std::to_string(block_in_string.size()) + " bytes and reads:\n " +
                     block_in_string);
 
@@ -135,17 +149,34 @@ namespace io {
             }
         } else
         {
-            node_->log(log_level::DEBUG, "The Rx's response contains " +
-                                             std::to_string(block_in_string.size()) +
-                                             " bytes and reads:\n " +
-                                             block_in_string);
+            ROSAIC_LOG(node_, log_level::DEBUG,
+                       "The Rx's response contains " +
+                           std::to_string(block_in_string.size()) +
+                           " bytes and reads:\n " + block_in_string);
         }
-        responseSemaphore_.notify();
+    }
+
+    void TelegramHandler::expectMessage(const std::string& keyword)
+    {
+        std::lock_guard<std::mutex> lock(messageMutex_);
+        messageKeyword_ = keyword;
+        message_.clear();
+    }
+
+    [[nodiscard]] std::string
+    TelegramHandler::waitForMessage(std::chrono::milliseconds timeout)
+    {
+        bool received = messageSemaphore_.waitFor(timeout);
+        std::lock_guard<std::mutex> lock(messageMutex_);
+        messageKeyword_.clear();
+        if (!received)
+            return std::string();
+        return message_;
     }
 
     void TelegramHandler::handleCd(const std::shared_ptr<Telegram>& telegram)
     {
-        node_->log(log_level::DEBUG,
+        ROSAIC_LOG(node_, log_level::DEBUG,
                    "handleCd: " + std::string(telegram->message.begin(),
                                               telegram->message.end()));
         if (telegram->message.back() == CONNECTION_DESCRIPTOR_FOOTER)
@@ -29,7 +29,17 @@
 // *****************************************************************************
 
 #include <septentrio_gnss_driver/crc/crc.hpp>
-#include <septentrio_gnss_driver/parsers/parsing_utilities.hpp>
+#include <septentrio_gnss_driver/parsers/sbf_header.hpp>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CRC_CLMUL_X86
+#elif defined(__aarch64__) && defined(__linux__)
+#include <arm_neon.h>
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#define CRC_PMULL_ARM
+#endif
 
 namespace crc {
     /**
@@ -39,33 +49,251 @@ namespace crc {
      * @date 17/08/20
      */
 
+    namespace {
+        //! Generator polynomial of CRC-16-CCITT without the x^16 term
+        const uint16_t CRC_POLYNOMIAL = 0x1021;
+        //! Below this length the setup of carry-less multiplication does not pay
+        //! off
+        const size_t CLMUL_MIN_LENGTH = 64;
+
+        typedef std::array<std::array<uint16_t, 256>, 8> SliceTables;
+
+        /**
+         * @brief Derives the slicing-by-8 tables from CRC_LOOK_UP, table k holds the
+         * CRC of a byte followed by k zero bytes
+         */
+        SliceTables makeSliceTables()
+        {
+            SliceTables tables;
+            tables[0] = CRC_LOOK_UP;
+            for (size_t k = 1; k < tables.size(); ++k)
+            {
+                for (size_t i = 0; i < 256; ++i)
+                {
+                    uint16_t prev = tables[k - 1][i];
+                    tables[k][i] = static_cast<uint16_t>(prev << 8) ^
+                                   CRC_LOOK_UP[static_cast<uint8_t>(prev >> 8)];
+                }
+            }
+            return tables;
+        }
+
+        const SliceTables SLICE_TABLES = makeSliceTables();
+
+        uint16_t updateBytewise(uint16_t crc, const uint8_t* buf, size_t buf_length)
+        {
+            for (size_t i = 0; i < buf_length; i++)
+            {
+                crc = static_cast<uint16_t>(crc << 8) ^
+                      CRC_LOOK_UP[static_cast<uint8_t>((crc >> 8) ^ buf[i])];
+            }
+            return crc;
+        }
+
+        /**
+         * @brief Processes 8 bytes per step: the current CRC is folded into the
+         * first two bytes, each byte is then looked up in the table matching the
+         * number of bytes following it within the step.
+         */
+        uint16_t updateSliced(uint16_t crc, const uint8_t* buf, size_t buf_length)
+        {
+            const SliceTables& t = SLICE_TABLES;
+            for (; buf_length >= 8; buf += 8, buf_length -= 8)
+            {
+                crc = t[7][buf[0] ^ (crc >> 8)] ^ t[6][buf[1] ^ (crc & 0xFF)] ^
+                      t[5][buf[2]] ^ t[4][buf[3]] ^ t[3][buf[4]] ^ t[2][buf[5]] ^
+                      t[1][buf[6]] ^ t[0][buf[7]];
+            }
+            return updateBytewise(crc, buf, buf_length);
+        }
+
+#if defined(CRC_CLMUL_X86) || defined(CRC_PMULL_ARM)
+        //! x^n mod P, used as folding constant
+        constexpr uint64_t xPowModP(size_t n)
+        {
+            uint32_t r = 1;
+            for (size_t i = 0; i < n; ++i)
+            {
+                r <<= 1;
+                if (r & 0x10000)
+                    r ^= 0x10000 | CRC_POLYNOMIAL;
+            }
+            return r;
+        }
+
+        // Folding a 128 bit chunk A = A_hi * x^64 + A_lo a distance of D bits
+        // ahead replaces A * x^D by A_hi * (x^(D+64) mod P) + A_lo * (x^D mod P),
+        // which is congruent modulo P and fits into 128 bits again.
+        constexpr uint64_t FOLD_128_HI = xPowModP(128 + 64);
+        constexpr uint64_t FOLD_128_LO = xPowModP(128);
+        constexpr uint64_t FOLD_512_HI = xPowModP(512 + 64);
+        constexpr uint64_t FOLD_512_LO = xPowModP(512);
+#endif
+
+#if defined(CRC_CLMUL_X86)
+        __attribute__((target("pclmul,ssse3"))) inline __m128i
+        loadBigEndian(const uint8_t* buf)
+        {
+            const __m128i reverse =
+                _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+            return _mm_shuffle_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf)), reverse);
+        }
+
+        __attribute__((target("pclmul,ssse3"))) inline __m128i
+        fold(__m128i acc, __m128i constants)
+        {
+            return _mm_xor_si128(_mm_clmulepi64_si128(acc, constants, 0x11),
+                                 _mm_clmulepi64_si128(acc, constants, 0x00));
+        }
+
+        /**
+         * @brief Folds the message in 16 byte chunks with carry-less
+         * multiplication, the remaining 16 byte residue and the tail are finished
+         * with the sliced tables. Requires at least 64 bytes.
+         */
+        __attribute__((target("pclmul,ssse3"))) uint16_t
+        updateClmul(uint16_t crc, const uint8_t* buf, size_t buf_length)
+        {
+            const __m128i fold128 = _mm_set_epi64x(FOLD_128_HI, FOLD_128_LO);
+            const __m128i fold512 = _mm_set_epi64x(FOLD_512_HI, FOLD_512_LO);
+            size_t chunks = buf_length / 16;
+
+            __m128i acc0 = _mm_xor_si128(
+                loadBigEndian(buf), _mm_set_epi64x(static_cast<uint64_t>(crc) << 48, 0));
+            __m128i acc1 = loadBigEndian(buf + 16);
+            __m128i acc2 = loadBigEndian(buf + 32);
+            __m128i acc3 = loadBigEndian(buf + 48);
+            size_t i = 4;
+            for (; i + 4 <= chunks; i += 4)
+            {
+                acc0 = _mm_xor_si128(fold(acc0, fold512), loadBigEndian(buf + 16 * i));
+                acc1 = _mm_xor_si128(fold(acc1, fold512),
+                                     loadBigEndian(buf + 16 * (i + 1)));
+                acc2 = _mm_xor_si128(fold(acc2, fold512),
+                                     loadBigEndian(buf + 16 * (i + 2)));
+                acc3 = _mm_xor_si128(fold(acc3, fold512),
+                                     loadBigEndian(buf + 16 * (i + 3)));
+            }
+            __m128i acc = _mm_xor_si128(fold(acc0, fold128), acc1);
+            acc = _mm_xor_si128(fold(acc, fold128), acc2);
+            acc = _mm_xor_si128(fold(acc, fold128), acc3);
+            for (; i < chunks; ++i)
+                acc = _mm_xor_si128(fold(acc, fold128), loadBigEndian(buf + 16 * i));
+
+            const __m128i reverse =
+                _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+            uint8_t residue[16];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(residue),
+                             _mm_shuffle_epi8(acc, reverse));
+            crc = updateSliced(0, residue, sizeof(residue));
+            return updateSliced(crc, buf + 16 * chunks, buf_length - 16 * chunks);
+        }
+
+        bool hasClmul()
+        {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("pclmul") &&
+                   __builtin_cpu_supports("ssse3");
+        }
+#elif defined(CRC_PMULL_ARM)
+        __attribute__((target("+crypto"))) inline uint64x2_t
+        loadBigEndian(const uint8_t* buf)
+        {
+            uint8x16_t bytes = vrev64q_u8(vld1q_u8(buf));
+            return vreinterpretq_u64_u8(vextq_u8(bytes, bytes, 8));
+        }
+
+        __attribute__((target("+crypto"))) inline uint64x2_t
+        fold(uint64x2_t acc, uint64_t hi, uint64_t lo)
+        {
+            return veorq_u64(
+                vreinterpretq_u64_p128(vmull_p64(vgetq_lane_u64(acc, 1), hi)),
+                vreinterpretq_u64_p128(vmull_p64(vgetq_lane_u64(acc, 0), lo)));
+        }
+
+        //! Same as the x86 path with PMULL instead of PCLMULQDQ
+        __attribute__((target("+crypto"))) uint16_t
+        updateClmul(uint16_t crc, const uint8_t* buf, size_t buf_length)
+        {
+            size_t chunks = buf_length / 16;
+
+            uint64x2_t acc0 = veorq_u64(
+                loadBigEndian(buf),
+                vcombine_u64(vcreate_u64(0),
+                             vcreate_u64(static_cast<uint64_t>(crc) << 48)));
+            uint64x2_t acc1 = loadBigEndian(buf + 16);
+            uint64x2_t acc2 = loadBigEndian(buf + 32);
+            uint64x2_t acc3 = loadBigEndian(buf + 48);
+            size_t i = 4;
+            for (; i + 4 <= chunks; i += 4)
+            {
+                acc0 = veorq_u64(fold(acc0, FOLD_512_HI, FOLD_512_LO),
+                                 loadBigEndian(buf + 16 * i));
+                acc1 = veorq_u64(fold(acc1, FOLD_512_HI, FOLD_512_LO),
+                                 loadBigEndian(buf + 16 * (i + 1)));
+                acc2 = veorq_u64(fold(acc2, FOLD_512_HI, FOLD_512_LO),
+                                 loadBigEndian(buf + 16 * (i + 2)));
+                acc3 = veorq_u64(fold(acc3, FOLD_512_HI, FOLD_512_LO),
+                                 loadBigEndian(buf + 16 * (i + 3)));
+            }
+            uint64x2_t acc =
+                veorq_u64(fold(acc0, FOLD_128_HI, FOLD_128_LO), acc1);
+            acc = veorq_u64(fold(acc, FOLD_128_HI, FOLD_128_LO), acc2);
+            acc = veorq_u64(fold(acc, FOLD_128_HI, FOLD_128_LO), acc3);
+            for (; i < chunks; ++i)
+                acc = veorq_u64(fold(acc, FOLD_128_HI, FOLD_128_LO),
+                                loadBigEndian(buf + 16 * i));
+
+            uint8_t residue[16];
+            uint8x16_t bytes = vrev64q_u8(vreinterpretq_u8_u64(acc));
+            vst1q_u8(residue, vextq_u8(bytes, bytes, 8));
+            crc = updateSliced(0, residue, sizeof(residue));
+            return updateSliced(crc, buf + 16 * chunks, buf_length - 16 * chunks);
+        }
+
+        bool hasClmul() { return (getauxval(AT_HWCAP) & HWCAP_PMULL) != 0; }
+#endif
+    } // namespace
+
+    namespace variant {
+        uint16_t bytewise(const uint8_t* buf, size_t buf_length)
+        {
+            return updateBytewise(0, buf, buf_length);
+        }
+
+        uint16_t sliced(const uint8_t* buf, size_t buf_length)
+        {
+            return updateSliced(0, buf, buf_length);
+        }
+
+        bool clmulSupported()
+        {
+#if defined(CRC_CLMUL_X86) || defined(CRC_PMULL_ARM)
+            static const bool supported = hasClmul();
+            return supported;
+#else
+            return false;
+#endif
+        }
+
+        uint16_t clmul(const uint8_t* buf, size_t buf_length)
+        {
+#if defined(CRC_CLMUL_X86) || defined(CRC_PMULL_ARM)
+            if (clmulSupported() && (buf_length >= CLMUL_MIN_LENGTH))
+                return updateClmul(0, buf, buf_length);
+#endif
+            return updateSliced(0, buf, buf_length);
+        }
+    } // namespace variant
+
     uint16_t compute16CCITT(const uint8_t* buf,
                             size_t buf_length) // The CRC we choose is 2 bytes,
                                                // remember, hence uint16_t..
     {
-        uint16_t crc = 0; // Seed is 0, as suggested by the firmware, will compute
-                          // CRC in the forward direction..
-
-        for (size_t i = 0; i < buf_length; i++)
-        {
-            crc = (crc << 8) ^ CRC_LOOK_UP[uint8_t((crc >> 8) ^ buf[i])];
-            // The ^ (bitwise XOR) in C or C++ takes two numbers as operands and does
-            // XOR on every bit of two numbers. The result of XOR is 1 if the two
-            // bits are different. The << (left shift) in C or C++ takes two numbers,
-            // left shifts the bits of the first operand, the second operand decides
-            // the number of places to shift. The >> (right shift) in C or C++ takes
-            // two numbers, right shifts the bits of the first operand, the second
-            // operand decides the number of places to shift; you can just loose the
-            // smallest values if big-endian. The left shift and right shift
-            // operators should not be used for negative numbers. The left-shift and
-            // right-shift operators are equivalent to multiplication and division by
-            // 2 respectively, hence only rightshift is non-exact (remainder is not
-            // retained). CRC_LOOK_UP is constructed from truncated polynomial
-            // (divisor). The above implements a kind of CRC 32 algorithm: efficient,
-            // fast.
-        }
-
-        return crc;
+        // Seed is 0, as suggested by the firmware, will compute CRC in the forward
+        // direction..
+        return variant::clmul(buf, buf_length);
     }
 
     bool isValid(const std::vector<uint8_t>& message)
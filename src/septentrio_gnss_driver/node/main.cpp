@@ -36,12 +36,58 @@
  * @brief Main function of the ROSaic driver:
  */
 
+/**
+ * Runs one node per entry of the list "receivers", each with its parameters, topics
+ * and frame IDs in the namespace of its name. The receivers share the I/O and
+ * processing threads, each is set up in a thread of its own so that a receiver not
+ * replying does not hold up the others. On shutdown, receivers still trying to
+ * connect give up.
+ */
+void runReceivers(const ros::NodeHandle& nh, const ros::NodeHandle& pNh,
+                  const std::vector<std::string>& receivers)
+{
+    int ioThreads;
+    int processingThreads;
+    pNh.param("io_threads", ioThreads, 1);
+    pNh.param("processing_threads", processingThreads, 1);
+    io::ThreadPool ioPool(std::max(ioThreads, 1));
+    io::ThreadPool processingPool(std::max(processingThreads, 1));
+
+    std::vector<std::unique_ptr<rosaic_node::ROSaicNode>> nodes(receivers.size());
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> initThreads;
+    for (size_t i = 0; i < receivers.size(); ++i)
+    {
+        initThreads.emplace_back([&, i]() {
+            nodes[i].reset(new rosaic_node::ROSaicNode(
+                ros::NodeHandle(nh, receivers[i]),
+                ros::NodeHandle(pNh, receivers[i]), false, &ioPool,
+                &processingPool, &stop));
+        });
+    }
+    ros::spin();
+
+    stop = true;
+    for (auto& thread : initThreads)
+        thread.join();
+    // The nodes use the pools until destroyed
+    nodes.clear();
+}
+
 int main(int argc, char** argv)
 {
     ros::init(argc, argv, "septentrio_gnss");
   	ros::NodeHandle nh;
+    ros::NodeHandle pNh("~");
+    std::vector<std::string> receivers;
+    if (pNh.getParam("receivers", receivers) && !receivers.empty())
+    {
+        runReceivers(nh, pNh, receivers);
+        return 0;
+    }
+
     rosaic_node::ROSaicNode
-        rx_node(nh); // This launches everything we need, in theory :)
+        rx_node(nh, pNh); // This launches everything we need, in theory :)
     ros::spin();
     
     return 0;
@@ -38,7 +38,14 @@
  * @brief The heart of the ROSaic driver: The ROS node that represents it
  */
 
-rosaic_node::ROSaicNode::ROSaicNode(const ros::NodeHandle& nh) : IO_(this), nh_(nh)
+rosaic_node::ROSaicNode::ROSaicNode(const ros::NodeHandle& nh,
+                                    const ros::NodeHandle& pNh,
+                                    bool sharedPublishing,
+                                    io::ThreadPool* ioPool,
+                                    io::ThreadPool* processingPool,
+                                    const std::atomic<bool>* stop) :
+    ROSaicNodeBase(pNh, sharedPublishing),
+    IO_(this, ioPool, processingPool, stop), nh_(nh)
 {
     param("activate_debug_log", settings_.activate_debug_log, false);
     if (settings_.activate_debug_log)
@@ -59,7 +66,8 @@ rosaic_node::ROSaicNode::ROSaicNode(const ros::NodeHandle& nh) : IO_(this), nh_(
         return;
 
     // Set up ntrip subscriber
-    rtcmSub_ = nh_.subscribe(ntripInput_, 0, &ROSaicNode::rtcmCallback, this);
+    rtcmSub_ = nh_.subscribe(ntripInput_, 0, &ROSaicNode::rtcmCallback, this,
+                             ros::TransportHints().tcpNoDelay());
     // Initializes Connection
     IO_.connect();
 
@@ -104,9 +112,90 @@ rosaic_node::ROSaicNode::ROSaicNode(const ros::NodeHandle& nh) : IO_(this), nh_(
           static_cast<std::string>(""));
     param("stream_device/udp/ip_server", settings_.udp_ip_server,
           static_cast<std::string>(""));
+    param("receive_timestamps", settings_.receive_timestamps,
+          static_cast<std::string>("software"));
+    if (!((settings_.receive_timestamps == "software") ||
+          (settings_.receive_timestamps == "kernel") ||
+          (settings_.receive_timestamps == "hardware")))
+    {
+        this->log(log_level::FATAL,
+                  "Unkown receive_timestamps " + settings_.receive_timestamps +
+                      " use either software, kernel, or hardware.");
+        return false;
+    }
     param("login/user", settings_.login_user, static_cast<std::string>(""));
     param("login/password", settings_.login_password, static_cast<std::string>(""));
     settings_.reconnect_delay_s = 2.0f; // Removed from ROS parameter list.
+    param("reconnect/backoff_min_s", settings_.reconnect_backoff_min_s, 0.1);
+    param("reconnect/backoff_max_s", settings_.reconnect_backoff_max_s, 5.0);
+    if ((settings_.reconnect_backoff_min_s < 0.0) ||
+        (settings_.reconnect_backoff_max_s < settings_.reconnect_backoff_min_s))
+    {
+        this->log(
+            log_level::FATAL,
+            "reconnect/backoff_min_s must not be negative and not exceed reconnect/backoff_max_s.");
+        return false;
+    }
+    getUint32Param("reconnect/tcp_user_timeout_ms", settings_.tcp_user_timeout_ms,
+                   static_cast<uint32_t>(2000));
+    getUint32Param("telegram_queue/capacity", settings_.telegram_queue_capacity,
+                   static_cast<uint32_t>(TELEGRAM_QUEUE_CAPACITY));
+    param("telegram_queue/policy", settings_.telegram_queue_policy,
+          static_cast<std::string>("block"));
+    if (!((settings_.telegram_queue_policy == "block") ||
+          (settings_.telegram_queue_policy == "drop_oldest") ||
+          (settings_.telegram_queue_policy == "drop_by_priority")))
+    {
+        this->log(log_level::FATAL,
+                  "Unkown telegram_queue/policy " + settings_.telegram_queue_policy +
+                      " use either block, drop_oldest, or drop_by_priority.");
+        return false;
+    }
+    getUint32Param("publish_pipeline/threads", settings_.publish_pipeline_threads,
+                   static_cast<uint32_t>(0));
+    if (settings_.publish_pipeline_threads > publish_lane::COUNT)
+    {
+        this->log(log_level::WARN,
+                  "publish_pipeline/threads is limited to " +
+                      std::to_string(publish_lane::COUNT) + ".");
+        settings_.publish_pipeline_threads = publish_lane::COUNT;
+    }
+    param("latency_statistics/period_s", settings_.latency_statistics_period_s,
+          0.0);
+    if (settings_.latency_statistics_period_s < 0.0)
+    {
+        this->log(log_level::FATAL,
+                  "latency_statistics/period_s must not be negative.");
+        return false;
+    }
+    param("replay/rate", settings_.replay_rate, 1.0);
+    if (settings_.replay_rate < 0.0)
+    {
+        this->log(log_level::FATAL, "replay/rate must not be negative.");
+        return false;
+    }
+    param("replay/skip_s", settings_.replay_skip_s, 0.0);
+    param("replay/bag", settings_.replay_bag, static_cast<std::string>(""));
+    getUint32Param("replay/threads", settings_.replay_threads,
+                   static_cast<uint32_t>(0));
+    param("raw_recorder/prefix", settings_.raw_recorder_prefix,
+          static_cast<std::string>(""));
+    getUint32Param("raw_recorder/buffer_kb", settings_.raw_recorder_buffer_kb,
+                   static_cast<uint32_t>(1024));
+    getUint32Param("raw_recorder/buffers", settings_.raw_recorder_buffers,
+                   static_cast<uint32_t>(8));
+    getUint32Param("raw_recorder/rotate_size_mb",
+                   settings_.raw_recorder_rotate_size_mb,
+                   static_cast<uint32_t>(0));
+    param("raw_recorder/rotate_period_s", settings_.raw_recorder_rotate_period_s,
+          0.0);
+    if (settings_.raw_recorder_rotate_period_s < 0.0)
+    {
+        this->log(log_level::FATAL,
+                  "raw_recorder/rotate_period_s must not be negative.");
+        return false;
+    }
+    param("raw_recorder/direct_io", settings_.raw_recorder_direct_io, false);
     param("receiver_type", settings_.septentrio_receiver_type,
           static_cast<std::string>("gnss"));
     if (!((settings_.septentrio_receiver_type == "gnss") ||
@@ -192,6 +281,19 @@ rosaic_node::ROSaicNode::ROSaicNode(const ros::NodeHandle& nh) : IO_(this), nh_(
     param("publish/twist", settings_.publish_twist, false);
     param("publish/tf", settings_.publish_tf, false);
     param("publish/tf_ecef", settings_.publish_tf_ecef, false);
+    std::vector<int> rawSbfIds;
+    param("publish/raw_sbf", rawSbfIds, std::vector<int>());
+    settings_.publish_raw_sbf.clear();
+    for (int id : rawSbfIds)
+    {
+        if ((id <= 0) || (id >= SBF_ID_COUNT))
+        {
+            this->log(log_level::ERROR, "publish/raw_sbf contains invalid SBF ID " +
+                                            std::to_string(id) + " -> ignored.");
+            continue;
+        }
+        settings_.publish_raw_sbf.push_back(static_cast<uint16_t>(id));
+    }
 
     if (settings_.publish_tf && settings_.publish_tf_ecef)
     {
@@ -201,6 +303,22 @@ rosaic_node::ROSaicNode::ROSaicNode(const ros::NodeHandle& nh) : IO_(this), nh_(
         settings_.publish_tf = false;
     }
 
+    // Host-side decimation, NMEA is not decimated as it has no epoch
+    settings_.publish_rate.assign(topic::COUNT, 0.0);
+    for (uint8_t t = topic::PVT_CARTESIAN; t < topic::COUNT; ++t)
+    {
+        std::string name = topic::NAMES[t];
+        if (name.front() == '/')
+            name.erase(0, 1);
+        param("publish_rate/" + name, settings_.publish_rate[t], 0.0);
+        if (settings_.publish_rate[t] < 0.0)
+        {
+            this->log(log_level::ERROR, "publish_rate/" + name +
+                                            " must not be negative -> topic is not decimated.");
+            settings_.publish_rate[t] = 0.0;
+        }
+    }
+
     // Datum and marker-to-ARP offset
     param("datum", settings_.datum, std::string("Default"));
     // WGS84 is equivalent to Default and kept for backwards compatibility
@@ -632,6 +750,13 @@ rosaic_node::ROSaicNode::ROSaicNode(const ros::NodeHandle& nh) : IO_(this), nh_(
                 log_level::ERROR,
                 "ins_vsm/ros/config has to be of size 3 to signal wether to use v_x, v_y, and v_z -> VSM input will not be used!");
         }
+        param("ins_vsm/ros/rate", settings_.ins_vsm_ros_rate, 2.0);
+        if (!(settings_.ins_vsm_ros_rate > 0.0))
+        {
+            this->log(log_level::ERROR,
+                      "ins_vsm/ros/rate has to be > 0.0 -> 2 Hz will be used.");
+            settings_.ins_vsm_ros_rate = 2.0;
+        }
         if (ins_use_vsm)
         {
             this->log(log_level::INFO, "ins_vsm/ros/source " +
@@ -787,19 +912,14 @@ void rosaic_node::ROSaicNode::getRPY(const QuaternionMsg& qm, double& roll,
     yaw = std::atan2(C(1, 0), C(0, 0));
 }
 
-void rosaic_node::ROSaicNode::sendVelocity(const std::string& velNmea)
+void rosaic_node::ROSaicNode::sendVelocity(std::string_view velNmea)
 {
     IO_.sendVelocity(velNmea);
 }
 
-void rosaic_node::ROSaicNode::rtcmCallback(const rtcm_msgs::Message& msg)
+void rosaic_node::ROSaicNode::rtcmCallback(const rtcm_msgs::MessageConstPtr& msg)
 {
-    std::stringstream aa;
-    std::vector<u_char> data_out;
-    data_out.resize(msg.message.size());
-    for (auto b : msg.message)
-    {
-        aa << b;
-    }
-    IO_.sendRtcm(aa.str());
+    // The message is kept alive until its buffer is written
+    std::shared_ptr<const void> owner(msg.get(), [msg](const void*) {});
+    IO_.sendRtcm(std::move(owner), msg->message.data(), msg->message.size());
 }
@@ -0,0 +1,86 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// ****************************************************************************
+
+// C++ includes
+#include <atomic>
+#include <memory>
+#include <thread>
+// ROS includes
+#include <nodelet/nodelet.h>
+#include <pluginlib/class_list_macros.h>
+// ROSaic includes
+#include <septentrio_gnss_driver/node/rosaic_node.hpp>
+
+/**
+ * @file rosaic_nodelet.cpp
+ * @brief Runs the ROSaic driver as nodelet, so that consumers in the same nodelet
+ * manager receive its messages without serialization
+ */
+
+namespace rosaic_node {
+    /**
+     * @class ROSaicNodelet
+     * @brief Nodelet wrapping ROSaicNode, messages are published as shared
+     * pointers to const
+     */
+    class ROSaicNodelet : public nodelet::Nodelet
+    {
+    public:
+        ~ROSaicNodelet()
+        {
+            // Unloading does not shut down ROS, an Rx not reachable would block
+            stop_ = true;
+            if (initThread_.joinable())
+                initThread_.join();
+        }
+
+    private:
+        /**
+         * Connecting and configuring the Rx blocks until the Rx replies, hence
+         * the node is set up in a thread of its own so as not to stall the
+         * nodelet manager.
+         */
+        void onInit() override
+        {
+            initThread_ = std::thread([this]() {
+                node_.reset(new ROSaicNode(getMTNodeHandle(),
+                                           getMTPrivateNodeHandle(), true, nullptr,
+                                           nullptr, &stop_));
+            });
+        }
+
+        //! Stops connecting on unloading
+        std::atomic<bool> stop_{false};
+        std::thread initThread_;
+        std::unique_ptr<ROSaicNode> node_;
+    };
+} // namespace rosaic_node
+
+PLUGINLIB_EXPORT_CLASS(rosaic_node::ROSaicNodelet, nodelet::Nodelet)
@@ -47,8 +47,8 @@ const std::string GpgsaParser::getMessageID() const
  * Caution: Due to the occurrence of the throw keyword, this method ParseASCII should
  * be called within a try / catch framework... Note: This method is called from
  * within the read() method of the RxMessage class by including the checksum part in
- * the argument "sentence" here, though the checksum is never parsed: It would be
- * sentence.get_body()[18] if anybody ever needs it.
+ * the argument "sentence" here, the checksum being validated on tokenizing:
+ * It would be sentence[18] if anybody ever needs it.
  */
 GpgsaMsg GpgsaParser::parseASCII(const NMEASentence& sentence,
                                  const std::string& frame_id, bool /*use_gnss_time*/,
@@ -57,19 +57,19 @@ GpgsaMsg GpgsaParser::parseASCII(const NMEASentence& sentence,
 
     // Checking the length first, it should be 19 elements
     const size_t LENGTH = 19;
-    if (sentence.get_body().size() != LENGTH)
+    if (sentence.size() != LENGTH)
     {
         std::stringstream error;
         error << "Expected GPGSA length is " << LENGTH << ". The actual length is "
-              << sentence.get_body().size();
+              << sentence.size();
         throw ParseException(error.str());
     }
 
     GpgsaMsg msg;
     msg.header.frame_id = frame_id;
-    msg.message_id = sentence.get_body()[0];
-    msg.auto_manual_mode = sentence.get_body()[1];
-    if (!parsing_utilities::parseUInt8(sentence.get_body()[2], msg.fix_mode))
+    msg.message_id = sentence[0];
+    msg.auto_manual_mode = sentence[1];
+    if (!parsing_utilities::parseUInt8(sentence[2], msg.fix_mode))
     {
         std::stringstream error;
         error << "GPGSA fix_mode parsing error.";
@@ -80,13 +80,11 @@ GpgsaMsg GpgsaParser::parseASCII(const NMEASentence& sentence,
     // argument) is larger than sv_ids.
     msg.sv_ids.resize(12, 0);
     size_t n_svs = 0;
-    for (std::vector<std::string>::const_iterator id =
-             sentence.get_body().begin() + 3;
-         id < sentence.get_body().begin() + 15; ++id)
+    for (size_t i = 3; i < 15; ++i)
     {
-        if (!id->empty())
+        if (!sentence[i].empty())
         {
-            if (!parsing_utilities::parseUInt8(*id, msg.sv_ids[n_svs]))
+            if (!parsing_utilities::parseUInt8(sentence[i], msg.sv_ids[n_svs]))
             {
                 std::stringstream error;
                 error << "GPGSA sv_ids parsing error.";
@@ -97,19 +95,19 @@ GpgsaMsg GpgsaParser::parseASCII(const NMEASentence& sentence,
     }
     msg.sv_ids.resize(n_svs);
 
-    if (!parsing_utilities::parseFloat(sentence.get_body()[15], msg.pdop))
+    if (!parsing_utilities::parseFloat(sentence[15], msg.pdop))
     {
         std::stringstream error;
         error << "GPGSA pdop parsing error.";
         throw ParseException(error.str());
     }
-    if (!parsing_utilities::parseFloat(sentence.get_body()[16], msg.hdop))
+    if (!parsing_utilities::parseFloat(sentence[16], msg.hdop))
     {
         std::stringstream error;
         error << "GPGSA hdop parsing error.";
         throw ParseException(error.str());
     }
-    if (!parsing_utilities::parseFloat(sentence.get_body()[17], msg.vdop))
+    if (!parsing_utilities::parseFloat(sentence[17], msg.vdop))
     {
         std::stringstream error;
         error << "GPGSA vdop parsing error.";
@@ -47,8 +47,8 @@ const std::string GpgsvParser::getMessageID() const
  * Caution: Due to the occurrence of the throw keyword, this method parseASCII should
  * be called within a try / catch framework... Note: This method is called from
  * within the read() method of the RxMessage class by including the checksum part in
- * the argument "sentence" here, though the checksum is never parsed: E.g. for
- * message with 4 Svs it would be sentence.get_body()[20] if anybody ever needs it.
+ * the argument "sentence" here, the checksum being validated on tokenizing:
+ * E.g. for message with 4 Svs it would be sentence[20] if anybody ever needs it.
  */
 GpgsvMsg GpgsvParser::parseASCII(const NMEASentence& sentence,
                                  const std::string& frame_id, bool /*use_gnss_time*/,
@@ -57,17 +57,17 @@ GpgsvMsg GpgsvParser::parseASCII(const NMEASentence& sentence,
 
     const size_t MIN_LENGTH = 4;
     // Checking that the message is at least as long as a GPGSV with no satellites
-    if (sentence.get_body().size() < MIN_LENGTH)
+    if (sentence.size() < MIN_LENGTH)
     {
         std::stringstream error;
         error << "Expected GSV length is at least " << MIN_LENGTH
-              << ". The actual length is " << sentence.get_body().size();
+              << ". The actual length is " << sentence.size();
         throw ParseException(error.str());
     }
     GpgsvMsg msg;
     msg.header.frame_id = frame_id;
-    msg.message_id = sentence.get_body()[0];
-    if (!parsing_utilities::parseUInt8(sentence.get_body()[1], msg.n_msgs))
+    msg.message_id = sentence[0];
+    if (!parsing_utilities::parseUInt8(sentence[1], msg.n_msgs))
     {
         throw ParseException("Error parsing n_msgs in GSV.");
     }
@@ -79,7 +79,7 @@ GpgsvMsg GpgsvParser::parseASCII(const NMEASentence& sentence,
         throw ParseException(error.str());
     }
 
-    if (!parsing_utilities::parseUInt8(sentence.get_body()[2], msg.msg_number))
+    if (!parsing_utilities::parseUInt8(sentence[2], msg.msg_number))
     {
         throw ParseException("Error parsing msg_number in GSV.");
     }
@@ -91,7 +91,7 @@ GpgsvMsg GpgsvParser::parseASCII(const NMEASentence& sentence,
               << " > " << msg.n_msgs << ".";
         throw ParseException(error.str());
     }
-    if (!parsing_utilities::parseUInt8(sentence.get_body()[3], msg.n_satellites))
+    if (!parsing_utilities::parseUInt8(sentence[3], msg.n_satellites))
     {
         throw ParseException("Error parsing n_satellites in GSV.");
     }
@@ -128,14 +128,14 @@ GpgsvMsg GpgsvParser::parseASCII(const NMEASentence& sentence,
     // msg.n_satellites, msg.n_satellites % static_cast<uint8_t>(4),
     // msg.msg_number
     // == msg.n_msgs ? "true" : "false", n_sats_in_sentence);
-    if (sentence.get_body().size() != expected_length &&
-        sentence.get_body().size() != expected_length - 1)
+    if (sentence.size() != expected_length &&
+        sentence.size() != expected_length - 1)
     {
         std::stringstream ss;
-        for (size_t i = 0; i < sentence.get_body().size(); ++i)
+        for (size_t i = 0; i < sentence.size(); ++i)
         {
-            ss << sentence.get_body()[i];
-            if ((i + 1) < sentence.get_body().size())
+            ss << sentence[i];
+            if ((i + 1) < sentence.size())
             {
                 ss << ",";
             }
@@ -143,7 +143,7 @@ GpgsvMsg GpgsvParser::parseASCII(const NMEASentence& sentence,
         std::stringstream error;
         error << "Expected GSV length is " << expected_length << " for message with "
               << n_sats_in_sentence << " satellites. The actual length is "
-              << sentence.get_body().size() << ".\n"
+              << sentence.size() << ".\n"
               << ss.str().c_str();
         throw ParseException(error.str());
     }
@@ -153,7 +153,7 @@ GpgsvMsg GpgsvParser::parseASCII(const NMEASentence& sentence,
     for (size_t sat = 0, index = MIN_LENGTH; sat < n_sats_in_sentence;
          ++sat, index += 4)
     {
-        if (!parsing_utilities::parseUInt8(sentence.get_body()[index],
+        if (!parsing_utilities::parseUInt8(sentence[index],
                                            msg.satellites[sat].prn))
         {
             std::stringstream error;
@@ -161,7 +161,7 @@ GpgsvMsg GpgsvParser::parseASCII(const NMEASentence& sentence,
             throw ParseException(error.str());
         }
         float elevation;
-        if (!parsing_utilities::parseFloat(sentence.get_body()[index + 1],
+        if (!parsing_utilities::parseFloat(sentence[index + 1],
                                            elevation))
         {
             std::stringstream error;
@@ -171,7 +171,7 @@ GpgsvMsg GpgsvParser::parseASCII(const NMEASentence& sentence,
         msg.satellites[sat].elevation = static_cast<uint8_t>(elevation);
 
         float azimuth;
-        if (!parsing_utilities::parseFloat(sentence.get_body()[index + 2], azimuth))
+        if (!parsing_utilities::parseFloat(sentence[index + 2], azimuth))
         {
             std::stringstream error;
             error << "Error parsing azimuth for satellite " << sat << " in GSV.";
@@ -179,14 +179,14 @@ GpgsvMsg GpgsvParser::parseASCII(const NMEASentence& sentence,
         }
         msg.satellites[sat].azimuth = static_cast<uint16_t>(azimuth);
 
-        if ((index + 3) >= sentence.get_body().size() ||
-            sentence.get_body()[index + 3].empty())
+        if ((index + 3) >= sentence.size() ||
+            sentence[index + 3].empty())
         {
             msg.satellites[sat].snr = -1;
         } else
         {
             uint8_t snr;
-            if (!parsing_utilities::parseUInt8(sentence.get_body()[index + 3], snr))
+            if (!parsing_utilities::parseUInt8(sentence[index + 3], snr))
             {
                 std::stringstream error;
                 error << "Error parsing snr for satellite " << sat << " in GSV.";
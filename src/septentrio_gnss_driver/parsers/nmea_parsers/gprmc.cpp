@@ -47,8 +47,8 @@ const std::string GprmcParser::getMessageID() const
  * Caution: Due to the occurrence of the throw keyword, this method ParseASCII should
  * be called within a try / catch framework... Note: This method is called from
  * within the read() method of the RxMessage class by including the checksum part in
- * the argument "sentence" here, though the checksum is never parsed: It would be
- * sentence.get_body()[13] if anybody ever needs it. The status character can be 'A'
+ * the argument "sentence" here, the checksum being validated on tokenizing:
+ * It would be sentence[13] if anybody ever needs it. The status character can be 'A'
  * (for Active) or 'V' (for Void), signaling whether the GPS was active when the
  * positioning was made. If it is void, the GPS could not make a good positioning and
  * you should thus ignore it. This usually occurs when the GPS is still searching for
@@ -63,11 +63,11 @@ GprmcMsg GprmcParser::parseASCII(const NMEASentence& sentence,
     const size_t LEN_MIN = 13;
     const size_t LEN_MAX = 14;
 
-    if (sentence.get_body().size() > LEN_MAX || sentence.get_body().size() < LEN_MIN)
+    if (sentence.size() > LEN_MAX || sentence.size() < LEN_MIN)
     {
         std::stringstream error;
         error << "Expected GPRMC length is between " << LEN_MIN << " and " << LEN_MAX
-              << ". The actual length is " << sentence.get_body().size();
+              << ". The actual length is " << sentence.size();
         throw ParseException(error.str());
     }
 
@@ -75,15 +75,15 @@ GprmcMsg GprmcParser::parseASCII(const NMEASentence& sentence,
 
     msg.header.frame_id = frame_id;
 
-    msg.message_id = sentence.get_body()[0];
+    msg.message_id = sentence[0];
 
-    if (sentence.get_body()[1].empty() || sentence.get_body()[1] == "0")
+    if (sentence[1].empty() || sentence[1] == "0")
     {
         msg.utc_seconds = 0;
     } else
     {
         double utc_double;
-        if (string_utilities::toDouble(sentence.get_body()[1], utc_double))
+        if (string_utilities::toDouble(sentence[1], utc_double))
         {
             msg.utc_seconds =
                 parsing_utilities::convertUTCDoubleToSeconds(utc_double);
@@ -113,45 +113,47 @@ GprmcMsg GprmcParser::parseASCII(const NMEASentence& sentence,
     bool valid = true;
     bool to_be_ignored = false;
 
-    msg.position_status = sentence.get_body()[2];
+    msg.position_status = sentence[2];
     // Check to see whether this message should be ignored
-    to_be_ignored &= !(sentence.get_body()[2].compare("A") ==
+    to_be_ignored &= !(sentence[2].compare("A") ==
                        0); // 0 : if both strings are equal.
     to_be_ignored &=
-        (sentence.get_body()[3].empty() || sentence.get_body()[5].empty());
+        (sentence[3].empty() || sentence[5].empty());
 
     double latitude = 0.0;
     valid =
-        valid && parsing_utilities::parseDouble(sentence.get_body()[3], latitude);
+        valid && parsing_utilities::parseDouble(sentence[3], latitude);
     msg.lat = parsing_utilities::convertDMSToDegrees(latitude);
 
     double longitude = 0.0;
     valid =
-        valid && parsing_utilities::parseDouble(sentence.get_body()[5], longitude);
+        valid && parsing_utilities::parseDouble(sentence[5], longitude);
     msg.lon = parsing_utilities::convertDMSToDegrees(longitude);
 
-    msg.lat_dir = sentence.get_body()[4];
-    msg.lon_dir = sentence.get_body()[6];
+    msg.lat_dir = sentence[4];
+    msg.lon_dir = sentence[6];
 
     valid =
-        valid && parsing_utilities::parseFloat(sentence.get_body()[7], msg.speed);
+        valid && parsing_utilities::parseFloat(sentence[7], msg.speed);
     msg.speed *= KNOTS_TO_MPS;
 
     valid =
-        valid && parsing_utilities::parseFloat(sentence.get_body()[8], msg.track);
+        valid && parsing_utilities::parseFloat(sentence[8], msg.track);
 
-    std::string date_str = sentence.get_body()[9];
-    if (!date_str.empty())
+    std::string_view date_str = sentence[9];
+    if (date_str.size() >= 6)
     {
-        msg.date = std::string("20") + date_str.substr(4, 2) + std::string("-") +
-                   date_str.substr(2, 2) + std::string("-") + date_str.substr(0, 2);
+        msg.date.reserve(10);
+        msg.date.assign("20").append(date_str.substr(4, 2)).append("-");
+        msg.date.append(date_str.substr(2, 2)).append("-");
+        msg.date.append(date_str.substr(0, 2));
     }
     valid =
-        valid && parsing_utilities::parseFloat(sentence.get_body()[10], msg.mag_var);
-    msg.mag_var_direction = sentence.get_body()[11];
-    if (sentence.get_body().size() == LEN_MAX)
+        valid && parsing_utilities::parseFloat(sentence[10], msg.mag_var);
+    msg.mag_var_direction = sentence[11];
+    if (sentence.size() == LEN_MAX)
     {
-        msg.mode_indicator = sentence.get_body()[12];
+        msg.mode_indicator = sentence[12];
     }
 
     if (!valid)
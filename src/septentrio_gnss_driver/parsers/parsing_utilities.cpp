@@ -65,7 +65,7 @@ namespace parsing_utilities {
      * exist within "string", and returns true if the latter two tests are negative
      * or when the string is empty, false otherwise.
      */
-    [[nodiscard]] bool parseDouble(const std::string& string, double& value)
+    [[nodiscard]] bool parseDouble(std::string_view string, double& value)
     {
         return string_utilities::toDouble(string, value) || string.empty();
     }
@@ -82,7 +82,7 @@ namespace parsing_utilities {
      * exist within "string", and returns true if the latter two tests are negative
      * or when the string is empty, false otherwise.
      */
-    [[nodiscard]] bool parseFloat(const std::string& string, float& value)
+    [[nodiscard]] bool parseFloat(std::string_view string, float& value)
     {
         return string_utilities::toFloat(string, value) || string.empty();
     }
@@ -106,7 +106,7 @@ namespace parsing_utilities {
      * exist within "string", and returns true if the latter two tests are negative
      * or when the string is empty, false otherwise.
      */
-    [[nodiscard]] bool parseInt16(const std::string& string, int16_t& value,
+    [[nodiscard]] bool parseInt16(std::string_view string, int16_t& value,
                                   int32_t base)
     {
         value = 0;
@@ -139,7 +139,7 @@ namespace parsing_utilities {
      * exist within "string", and returns true if the latter two tests are negative
      * or when the string is empty, false otherwise.
      */
-    [[nodiscard]] bool parseInt32(const std::string& string, int32_t& value,
+    [[nodiscard]] bool parseInt32(std::string_view string, int32_t& value,
                                   int32_t base)
     {
         return string_utilities::toInt32(string, value, base) || string.empty();
@@ -150,7 +150,7 @@ namespace parsing_utilities {
      * exist within "string", and returns true if the latter two tests are negative
      * or when the string is empty, false otherwise.
      */
-    [[nodiscard]] bool parseUInt8(const std::string& string, uint8_t& value,
+    [[nodiscard]] bool parseUInt8(std::string_view string, uint8_t& value,
                                   int32_t base)
     {
         value = 0;
@@ -182,7 +182,7 @@ namespace parsing_utilities {
      * exist within "string", and returns true if the latter two tests are negative
      * or when the string is empty, false otherwise.
      */
-    [[nodiscard]] bool parseUInt16(const std::string& string, uint16_t& value,
+    [[nodiscard]] bool parseUInt16(std::string_view string, uint16_t& value,
                                    int32_t base)
     {
         value = 0;
@@ -214,7 +214,7 @@ namespace parsing_utilities {
      * exist within "string", and returns true if the latter two tests are negative
      * or when the string is empty, false otherwise.
      */
-    [[nodiscard]] bool parseUInt32(const std::string& string, uint32_t& value,
+    [[nodiscard]] bool parseUInt32(std::string_view string, uint32_t& value,
                                    int32_t base)
     {
         return string_utilities::toUInt32(string, value, base) || string.empty();
@@ -411,34 +411,4 @@ namespace parsing_utilities {
             return "min" + std::to_string(period_user / 60000);
     }
 
-    [[nodiscard]] uint16_t getCrc(const std::vector<uint8_t>& message)
-    {
-        return parseUInt16(message.data() + 2);
-    }
-
-    [[nodiscard]] uint16_t getId(const std::vector<uint8_t>& message)
-    {
-        // Defines bit mask..
-        // Highest three bits are for revision and rest for block number
-        static uint16_t mask = 8191;
-        // Bitwise AND gives us all but highest 3 bits set to zero, rest unchanged
-
-        return parseUInt16(message.data() + 4) & mask;
-    }
-
-    [[nodiscard]] uint16_t getLength(const std::vector<uint8_t>& message)
-    {
-        return parseUInt16(message.data() + 6);
-    }
-
-    [[nodiscard]] uint32_t getTow(const std::vector<uint8_t>& message)
-    {
-        return parseUInt32(message.data() + 8);
-    }
-
-    [[nodiscard]] uint16_t getWnc(const std::vector<uint8_t>& message)
-    {
-        return parseUInt16(message.data() + 12);
-    }
-
 } // namespace parsing_utilities
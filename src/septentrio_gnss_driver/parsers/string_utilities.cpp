@@ -31,12 +31,16 @@
 // ROSaic includes
 #include <septentrio_gnss_driver/parsers/string_utilities.hpp>
 // C++ library includes
+#include <algorithm>
+#include <array>
 #include <cerrno>
+#include <charconv>
 #include <cmath>
 #include <cstdlib>
 #include <iomanip>
 #include <limits>
 #include <sstream>
+#include <type_traits>
 
 /**
  * @file string_utilities.cpp
@@ -45,118 +49,110 @@
  */
 
 namespace string_utilities {
-    /**
-     * It checks whether an error occurred (via errno) and whether junk characters
-     * exist within "string", and returns true if the latter two tests are negative
-     * and the string is non-empty, false otherwise.
-     */
-    [[nodiscard]] bool toDouble(const std::string& string, double& value)
-    {
-        if (string.empty())
+    namespace {
+        /**
+         * Uses std::from_chars where the standard library supports floating point
+         * conversion, otherwise falls back to strtod / strtof on a terminated copy
+         * of the field.
+         */
+        template <typename T>
+        [[nodiscard]] bool toFloatingPoint(std::string_view string, T& value)
         {
-            return false;
+            if (string.empty())
+            {
+                return false;
+            }
+
+            T value_new;
+#if defined(__cpp_lib_to_chars)
+            const char* end = string.data() + string.size();
+            auto [ptr, ec] = std::from_chars(string.data(), end, value_new);
+            if (ec != std::errc() || ptr != end)
+            {
+                return false;
+            }
+#else
+            std::array<char, 64> buffer;
+            if (string.size() >= buffer.size())
+            {
+                return false;
+            }
+            std::copy(string.begin(), string.end(), buffer.begin());
+            buffer[string.size()] = '\0';
+
+            char* end;
+            errno = 0;
+            if constexpr (std::is_same_v<T, float>)
+                value_new = std::strtof(buffer.data(), &end);
+            else
+                value_new = std::strtod(buffer.data(), &end);
+
+            if (errno != 0 || end != buffer.data() + string.size())
+            {
+                return false;
+            }
+#endif
+            value = value_new;
+            return true;
         }
 
-        char* end;
-        errno = 0;
-
-        double value_new = std::strtod(string.c_str(), &end);
-
-        if (errno != 0 || end != string.c_str() + string.length())
+        template <typename T>
+        [[nodiscard]] bool toInteger(std::string_view string, T& value,
+                                     int32_t base)
         {
-            return false;
+            const char* end = string.data() + string.size();
+            T value_new;
+            auto [ptr, ec] = std::from_chars(string.data(), end, value_new, base);
+            if (string.empty() || ec != std::errc() || ptr != end)
+            {
+                return false;
+            }
+
+            value = value_new;
+            return true;
         }
+    } // namespace
 
-        value = value_new;
-        return true;
+    /**
+     * It checks whether the conversion failed or went out of range and whether junk
+     * characters exist within "string", and returns true if the latter two tests
+     * are negative and the string is non-empty, false otherwise.
+     */
+    [[nodiscard]] bool toDouble(std::string_view string, double& value)
+    {
+        return toFloatingPoint(string, value);
     }
 
     /**
-     * It checks whether an error occurred (via errno) and whether junk characters
-     * exist within "string", and returns true if the latter two tests are negative
-     * and the string is non-empty, false otherwise.
+     * It checks whether the conversion failed or went out of range and whether junk
+     * characters exist within "string", and returns true if the latter two tests
+     * are negative and the string is non-empty, false otherwise.
      */
-    [[nodiscard]] bool toFloat(const std::string& string, float& value)
+    [[nodiscard]] bool toFloat(std::string_view string, float& value)
     {
-        if (string.empty())
-        {
-            return false;
-        }
-
-        char* end;
-        errno = 0;
-        float value_new = std::strtof(string.c_str(), &end);
-
-        if (errno != 0 || end != string.c_str() + string.length())
-        {
-            return false;
-        }
-
-        value = value_new;
-        return true;
+        return toFloatingPoint(string, value);
     }
 
     /**
-     * It checks whether an error occurred (via errno) and whether junk characters
-     * exist within "string", and returns true if the latter two tests are negative
-     * and the string is non-empty, false otherwise.
+     * It checks whether the conversion failed or went out of range and whether junk
+     * characters exist within "string", and returns true if the latter two tests
+     * are negative and the string is non-empty, false otherwise.
      */
-    [[nodiscard]] bool toInt32(const std::string& string, int32_t& value,
+    [[nodiscard]] bool toInt32(std::string_view string, int32_t& value,
                                int32_t base)
     {
-        if (string.empty())
-        {
-            return false;
-        }
-
-        char* end;
-        errno = 0;
-        int64_t value_new = std::strtol(string.c_str(), &end, base);
-
-        if (errno != 0 || end != string.c_str() + string.length())
-        {
-            return false;
-        }
-
-        if (value_new > std::numeric_limits<int32_t>::max() ||
-            value_new < std::numeric_limits<int32_t>::min())
-        {
-            return false;
-        }
-
-        value = (int32_t)value_new;
-        return true;
+        return toInteger(string, value, base);
     }
 
     /**
-     * It checks whether an error occurred (via errno) and whether junk characters
-     * exist within "string", and returns true if the latter two tests are negative
-     * and the string is non-empty, false otherwise.
+     * It checks whether the conversion failed or went out of range and whether junk
+     * characters exist within "string", and returns true if the latter two tests
+     * are negative and the string is non-empty, false otherwise.
      */
-    [[nodiscard]] bool toUInt32(const std::string& string, uint32_t& value,
+    [[nodiscard]] bool toUInt32(std::string_view string, uint32_t& value,
                                 int32_t base)
     {
-        if (string.empty())
-        {
-            return false;
-        }
-
-        char* end;
-        errno = 0;
-        int64_t value_new = std::strtol(string.c_str(), &end, base);
-
-        if (errno != 0 || end != string.c_str() + string.length())
-        {
-            return false;
-        }
-
-        if (value_new > std::numeric_limits<uint32_t>::max() || value_new < 0)
-        {
-            return false;
-        }
-
-        value = (uint32_t)value_new;
-        return true;
+        return toInteger(string, value, base);
     }
 
     /**
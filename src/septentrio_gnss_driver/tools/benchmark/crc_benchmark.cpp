@@ -0,0 +1,160 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++
+#include <random>
+#include <string>
+#include <vector>
+// ROSaic
+#include <septentrio_gnss_driver/communication/telegram.hpp>
+#include <septentrio_gnss_driver/crc/crc.hpp>
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+/**
+ * @file crc_benchmark.cpp
+ * @brief Times the CRC of SBF blocks over the range of block lengths, of the
+ * implementation used and of each variant, and checks the variants against the
+ * byte-wise reference
+ */
+
+namespace {
+    //! Random buffer of the maximum SBF block size
+    const std::vector<uint8_t>& buffer()
+    {
+        static const std::vector<uint8_t> buf = []() {
+            std::mt19937 random(42);
+            std::vector<uint8_t> buf(MAX_SBF_SIZE);
+            for (auto& byte : buf)
+                byte = static_cast<uint8_t>(random());
+            return buf;
+        }();
+        return buf;
+    }
+
+    //! Largest misalignment checked, covers the 8 byte steps of slicing-by-8
+    const size_t MAX_OFFSET = 7;
+
+    /**
+     * @brief Checks all variants against the byte-wise reference for random
+     * buffers of a given length at every alignment
+     * @return Description of the first mismatch, empty if all match
+     */
+    std::string mismatch(std::mt19937& random, size_t length)
+    {
+        std::vector<uint8_t> buf(length + MAX_OFFSET);
+        for (auto& byte : buf)
+            byte = static_cast<uint8_t>(random());
+        for (size_t offset = 0; offset <= MAX_OFFSET; ++offset)
+        {
+            const uint8_t* data = buf.data() + offset;
+            uint16_t reference = crc::variant::bytewise(data, length);
+            if ((crc::variant::sliced(data, length) != reference) ||
+                (crc::variant::clmul(data, length) != reference) ||
+                (crc::compute16CCITT(data, length) != reference))
+                return "CRC differs from reference at length " +
+                       std::to_string(length) + ", offset " +
+                       std::to_string(offset);
+        }
+        return std::string();
+    }
+
+    /**
+     * @brief Times a CRC implementation, the length in bytes is the argument
+     * @param[in] crc Implementation to be timed
+     */
+    void runCrc(benchmark::State& state,
+                uint16_t (*crc)(const uint8_t* buf, size_t buf_length))
+    {
+        const uint8_t* buf = buffer().data();
+        size_t length = state.range(0);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(crc(buf, length));
+        state.SetBytesProcessed(state.iterations() * length);
+    }
+} // namespace
+
+//! As used by the driver, by carry-less multiplication if supported
+static void BM_Compute16CCITT(benchmark::State& state)
+{
+    runCrc(state, crc::compute16CCITT);
+}
+BENCHMARK(BM_Compute16CCITT)->RangeMultiplier(4)->Range(16, MAX_SBF_SIZE);
+
+//! Reference all other implementations are checked against
+static void BM_CrcBytewise(benchmark::State& state)
+{
+    runCrc(state, crc::variant::bytewise);
+}
+BENCHMARK(BM_CrcBytewise)->RangeMultiplier(4)->Range(16, MAX_SBF_SIZE);
+
+static void BM_CrcSliced(benchmark::State& state)
+{
+    runCrc(state, crc::variant::sliced);
+}
+BENCHMARK(BM_CrcSliced)->RangeMultiplier(4)->Range(16, MAX_SBF_SIZE);
+
+static void BM_CrcClmul(benchmark::State& state)
+{
+    if (!crc::variant::clmulSupported())
+    {
+        state.SkipWithError("Carry-less multiplication is not supported");
+        return;
+    }
+    runCrc(state, crc::variant::clmul);
+}
+BENCHMARK(BM_CrcClmul)->RangeMultiplier(4)->Range(16, MAX_SBF_SIZE);
+
+/**
+ * Not timed but fails if any variant differs from the reference, for every length
+ * up to several times the carry-less multiplication threshold, covering all
+ * residues of its folding steps, and for random lengths up to MAX_SBF_SIZE
+ */
+static void BM_CrcBitExactness(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::mt19937 random(1);
+        std::uniform_int_distribution<size_t> lengths(1025, MAX_SBF_SIZE);
+        std::string error;
+        for (size_t length = 0; (length <= 1024) && error.empty(); ++length)
+            error = mismatch(random, length);
+        for (size_t i = 0; (i < 200) && error.empty(); ++i)
+            error = mismatch(random, lengths(random));
+        if (error.empty())
+            error = mismatch(random, MAX_SBF_SIZE);
+        if (!error.empty())
+        {
+            state.SkipWithError(error.c_str());
+            return;
+        }
+    }
+}
+BENCHMARK(BM_CrcBitExactness)->Iterations(1)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,375 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++
+#include <cstring>
+#include <functional>
+#include <memory>
+// ROSaic
+#include <septentrio_gnss_driver/communication/message_handler.hpp>
+#include <septentrio_gnss_driver/tools/stub_node.hpp>
+#include <septentrio_gnss_driver/tools/synthetic_sbf.hpp>
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+/**
+ * @file message_handler_benchmark.cpp
+ * @brief Times the assembly of the ROS messages combining several SBF blocks and
+ * the processing of whole epochs by the message handler of a stub node. Messages
+ * are recorded instead of published, the recording is part of the timing.
+ */
+
+/**
+ * @class MessageHandlerBenchmark
+ * @brief Calls the private assemblers of a MessageHandler
+ */
+class MessageHandlerBenchmark
+{
+public:
+    static void assembleNavSatFix(io::MessageHandler& handler)
+    {
+        handler.assembleNavSatFix();
+    }
+    static void assembleGpsFix(io::MessageHandler& handler)
+    {
+        handler.assembleGpsFix();
+    }
+    static void assemblePoseWithCovarianceStamped(io::MessageHandler& handler)
+    {
+        handler.assemblePoseWithCovarianceStamped();
+    }
+    //! The telegram of the epoch is consumed by each assembly
+    static void assembleDiagnosticArray(io::MessageHandler& handler,
+                                        const std::shared_ptr<Telegram>& telegram)
+    {
+        handler.diagnosticsTelegram_ = telegram;
+        handler.assembleDiagnosticArray();
+    }
+    static void assembleOsnmaDiagnosticArray(io::MessageHandler& handler)
+    {
+        handler.assembleOsnmaDiagnosticArray();
+    }
+    static void assembleAimAndDiagnosticArray(io::MessageHandler& handler)
+    {
+        handler.assembleAimAndDiagnosticArray();
+    }
+    static void assembleImu(io::MessageHandler& handler) { handler.assembleImu(); }
+    static void assembleLocalizationUtm(io::MessageHandler& handler)
+    {
+        handler.assembleLocalizationUtm();
+    }
+    static void assembleLocalizationEcef(io::MessageHandler& handler)
+    {
+        handler.assembleLocalizationEcef();
+    }
+    static void assembleTwist(io::MessageHandler& handler, bool fromIns)
+    {
+        handler.assembleTwist(fromIns);
+    }
+    static void assembleTimeReference(io::MessageHandler& handler,
+                                      const std::shared_ptr<Telegram>& telegram)
+    {
+        handler.assembleTimeReference(telegram);
+    }
+};
+
+namespace {
+    using namespace synthetic_sbf;
+
+    //! Time of week of the first epoch in ms
+    const uint32_t TOW = 345600000;
+    //! Reception time of the telegrams
+    const Timestamp STAMP = 1700000000000000000ull;
+    //! Recorded messages after which the recording is discarded
+    const size_t MAX_RECORDED = 1024;
+
+    //! One epoch of all blocks consumed by the assemblers of the receiver type
+    std::vector<std::vector<uint8_t>> epoch(bool ins, uint32_t tow)
+    {
+        std::vector<std::vector<uint8_t>> blocks = {
+            pvt(4007, tow, 0.8743, 0.0762, 120.0),
+            covariance(5906, tow),
+            attEuler(tow),
+            attCovEuler(tow),
+            covariance(5908, tow),
+            measEpoch(tow, 32, 2),
+            channelStatus(tow, 32, 1),
+            dop(tow),
+            receiverStatus(tow, 4),
+            qualityInd(tow, 8),
+            galAuthStatus(tow),
+            rfStatus(tow, 3)};
+        if (ins)
+        {
+            blocks.push_back(insNav(4225, tow, 4.2e6, 0.5e6, 4.7e6));
+            blocks.push_back(insNavGeod(tow));
+            blocks.push_back(extSensorMeas(tow));
+        }
+        return blocks;
+    }
+
+    /**
+     * @class Assembly
+     * @brief Message handler of a stub node, set up for the outputs enabled by
+     * the configuration and fed with one epoch, recording its messages
+     */
+    class Assembly
+    {
+    public:
+        Assembly(bool ins, const std::function<void(Settings&)>& configure) :
+            ins_(ins), telegram_(std::make_shared<Telegram>())
+        {
+            Settings& settings = node_.mutableSettings();
+            settings.septentrio_receiver_type = ins ? "ins" : "gnss";
+            configure(settings);
+            handler_ = std::make_unique<io::MessageHandler>(&node_);
+            handler_->setupSbfConsumers();
+            handler_->setupEpochAggregator();
+            handler_->setRecorder(&recorder_);
+
+            telegram_->type = telegram_type::SBF;
+            telegram_->stamp = STAMP;
+            for (const auto& block : epoch(ins, TOW))
+                feed(block);
+        }
+
+        //! Processes a block as if it was received
+        void feed(const std::vector<uint8_t>& block)
+        {
+            telegram_->message = block;
+            handler_->parseSbf(telegram_);
+        }
+
+        //! Discards the recording once in a while to bound the memory
+        void drain()
+        {
+            if (recorder_.size() > MAX_RECORDED)
+                recorder_.clear();
+        }
+
+        [[nodiscard]] bool ins() const { return ins_; }
+
+        [[nodiscard]] io::MessageHandler& handler() { return *handler_; }
+
+        [[nodiscard]] const std::shared_ptr<Telegram>& telegram() const
+        {
+            return telegram_;
+        }
+
+    private:
+        bool ins_;
+        StubNode node_;
+        MessageRecorder recorder_;
+        std::unique_ptr<io::MessageHandler> handler_;
+        std::shared_ptr<Telegram> telegram_;
+    };
+
+    /**
+     * @brief Times an assembler repeatedly assembling from the same epoch
+     * @param[in] assembly Handler holding the last blocks of the epoch
+     * @param[in] assemble Assembler invoked with the handler
+     */
+    template <typename Assemble>
+    void runAssembler(benchmark::State& state, Assembly&& assembly,
+                      Assemble assemble)
+    {
+        for (auto _ : state)
+        {
+            assemble(assembly.handler());
+            assembly.drain();
+        }
+    }
+} // namespace
+
+static void BM_AssembleNavSatFix(benchmark::State& state)
+{
+    runAssembler(state, Assembly(state.range(0), [](Settings& settings) {
+                     settings.publish_navsatfix = true;
+                 }),
+                 MessageHandlerBenchmark::assembleNavSatFix);
+}
+BENCHMARK(BM_AssembleNavSatFix)->ArgName("ins")->Arg(0)->Arg(1);
+
+static void BM_AssembleGpsFix(benchmark::State& state)
+{
+    runAssembler(state, Assembly(state.range(0), [](Settings& settings) {
+                     settings.publish_gpsfix = true;
+                 }),
+                 MessageHandlerBenchmark::assembleGpsFix);
+}
+BENCHMARK(BM_AssembleGpsFix)->ArgName("ins")->Arg(0)->Arg(1);
+
+static void BM_AssemblePoseWithCovarianceStamped(benchmark::State& state)
+{
+    runAssembler(state, Assembly(state.range(0), [](Settings& settings) {
+                     settings.publish_pose = true;
+                 }),
+                 MessageHandlerBenchmark::assemblePoseWithCovarianceStamped);
+}
+BENCHMARK(BM_AssemblePoseWithCovarianceStamped)->ArgName("ins")->Arg(0)->Arg(1);
+
+static void BM_AssembleTwist(benchmark::State& state)
+{
+    bool ins = state.range(0);
+    runAssembler(state, Assembly(ins, [](Settings& settings) {
+                     settings.publish_twist = true;
+                 }),
+                 [ins](io::MessageHandler& handler) {
+                     MessageHandlerBenchmark::assembleTwist(handler, ins);
+                 });
+}
+BENCHMARK(BM_AssembleTwist)->ArgName("ins")->Arg(0)->Arg(1);
+
+static void BM_AssembleDiagnosticArray(benchmark::State& state)
+{
+    Assembly assembly(false, [](Settings& settings) {
+        settings.publish_diagnostics = true;
+    });
+    std::shared_ptr<Telegram> telegram = assembly.telegram();
+    runAssembler(state, std::move(assembly),
+                 [telegram](io::MessageHandler& handler) {
+                     MessageHandlerBenchmark::assembleDiagnosticArray(handler,
+                                                                      telegram);
+                 });
+}
+BENCHMARK(BM_AssembleDiagnosticArray);
+
+static void BM_AssembleOsnmaDiagnosticArray(benchmark::State& state)
+{
+    runAssembler(state, Assembly(false, [](Settings& settings) {
+                     settings.publish_galauthstatus = true;
+                 }),
+                 MessageHandlerBenchmark::assembleOsnmaDiagnosticArray);
+}
+BENCHMARK(BM_AssembleOsnmaDiagnosticArray);
+
+static void BM_AssembleAimAndDiagnosticArray(benchmark::State& state)
+{
+    runAssembler(state, Assembly(false, [](Settings& settings) {
+                     settings.publish_aimplusstatus = true;
+                 }),
+                 MessageHandlerBenchmark::assembleAimAndDiagnosticArray);
+}
+BENCHMARK(BM_AssembleAimAndDiagnosticArray);
+
+static void BM_AssembleImu(benchmark::State& state)
+{
+    runAssembler(state, Assembly(true, [](Settings& settings) {
+                     settings.publish_imu = true;
+                 }),
+                 MessageHandlerBenchmark::assembleImu);
+}
+BENCHMARK(BM_AssembleImu);
+
+static void BM_AssembleLocalizationUtm(benchmark::State& state)
+{
+    runAssembler(state, Assembly(true, [](Settings& settings) {
+                     settings.publish_localization = true;
+                 }),
+                 MessageHandlerBenchmark::assembleLocalizationUtm);
+}
+BENCHMARK(BM_AssembleLocalizationUtm);
+
+static void BM_AssembleLocalizationEcef(benchmark::State& state)
+{
+    runAssembler(state, Assembly(true, [](Settings& settings) {
+                     settings.publish_localization_ecef = true;
+                 }),
+                 MessageHandlerBenchmark::assembleLocalizationEcef);
+}
+BENCHMARK(BM_AssembleLocalizationEcef);
+
+static void BM_AssembleTimeReference(benchmark::State& state)
+{
+    Assembly assembly(false,
+                      [](Settings& settings) { settings.publish_gpst = true; });
+    auto telegram = std::make_shared<Telegram>(*assembly.telegram());
+    telegram->message = pvt(4007, TOW, 0.8743, 0.0762, 120.0);
+    runAssembler(state, std::move(assembly),
+                 [&telegram](io::MessageHandler& handler) {
+                     MessageHandlerBenchmark::assembleTimeReference(handler,
+                                                                    telegram);
+                 });
+}
+BENCHMARK(BM_AssembleTimeReference);
+
+static void BM_ParseNmea(benchmark::State& state)
+{
+    Assembly assembly(false,
+                      [](Settings& settings) { settings.publish_gpgga = true; });
+    auto telegram = std::make_shared<Telegram>();
+    telegram->type = telegram_type::NMEA;
+    telegram->stamp = STAMP;
+    telegram->message = gpgga(TOW);
+    for (auto _ : state)
+    {
+        assembly.handler().parseNmea(telegram);
+        assembly.drain();
+    }
+}
+BENCHMARK(BM_ParseNmea);
+
+/**
+ * Parses a whole epoch with all composite outputs enabled, so that blocks are
+ * parsed, aggregated and assembled as when reading from the Rx
+ */
+static void BM_ParseSbfEpoch(benchmark::State& state)
+{
+    bool ins = state.range(0);
+    Assembly assembly(ins, [](Settings& settings) {
+        settings.publish_navsatfix = true;
+        settings.publish_gpsfix = true;
+        settings.publish_pose = true;
+        settings.publish_twist = true;
+        settings.publish_diagnostics = true;
+        settings.publish_localization = true;
+        settings.publish_localization_ecef = true;
+    });
+    std::vector<std::vector<uint8_t>> blocks = epoch(ins, TOW);
+    size_t bytes = 0;
+    for (const auto& block : blocks)
+        bytes += block.size();
+
+    uint32_t tow = TOW;
+    for (auto _ : state)
+    {
+        // Next epoch, the CRC is not checked by the handler
+        tow += 100;
+        for (auto& block : blocks)
+        {
+            std::memcpy(block.data() + 8, &tow, sizeof(tow));
+            assembly.feed(block);
+        }
+        assembly.drain();
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.SetItemsProcessed(state.iterations() * blocks.size());
+}
+BENCHMARK(BM_ParseSbfEpoch)->ArgName("ins")->Arg(0)->Arg(1);
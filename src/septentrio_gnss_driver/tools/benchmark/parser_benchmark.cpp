@@ -0,0 +1,359 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic
+#include <septentrio_gnss_driver/parsers/sbf_blocks.hpp>
+#include <septentrio_gnss_driver/parsers/nmea_parsers/gpgga.hpp>
+#include <septentrio_gnss_driver/parsers/nmea_parsers/gpgsa.hpp>
+#include <septentrio_gnss_driver/parsers/nmea_parsers/gpgsv.hpp>
+#include <septentrio_gnss_driver/parsers/nmea_parsers/gprmc.hpp>
+#include <septentrio_gnss_driver/tools/stub_node.hpp>
+#include <septentrio_gnss_driver/tools/synthetic_sbf.hpp>
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+/**
+ * @file parser_benchmark.cpp
+ * @brief Times each SBF block parser and NMEA sentence parser on synthesized
+ * input, all blocks are parsed successfully
+ */
+
+namespace {
+    using namespace synthetic_sbf;
+
+    //! Time of week of the parsed blocks in ms
+    const uint32_t TOW = 345600000;
+
+    /**
+     * @brief Times a parser repeatedly parsing the same block
+     * @param[in] block Block to be parsed
+     * @param[in] parse Parser invoked with node, begin and end of the block and
+     * the message to be filled
+     */
+    template <typename Msg, typename Parse>
+    void runSbfParser(benchmark::State& state, const std::vector<uint8_t>& block,
+                      Parse parse)
+    {
+        StubNode node;
+        Msg msg;
+        if (!parse(&node, block.begin(), block.end(), msg))
+        {
+            state.SkipWithError("Block is not parsed");
+            return;
+        }
+        for (auto _ : state)
+        {
+            bool parsed = parse(&node, block.begin(), block.end(), msg);
+            benchmark::DoNotOptimize(parsed);
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(state.iterations() * block.size());
+    }
+
+    /**
+     * @brief Times a parser repeatedly parsing the same sentence, including its
+     * tokenization as done by the message handler
+     */
+    template <typename Parser>
+    void runNmeaParser(benchmark::State& state, const std::vector<uint8_t>& sentence)
+    {
+        Parser parser;
+        NMEASentence tokens;
+        try
+        {
+            if (!tokens.tokenize(sentence.data(), sentence.size()))
+            {
+                state.SkipWithError("Sentence is not tokenized");
+                return;
+            }
+            auto msg = parser.parseASCII(tokens, "gnss", false, 0);
+            benchmark::DoNotOptimize(msg);
+        } catch (ParseException& e)
+        {
+            state.SkipWithError(e.what());
+            return;
+        }
+        for (auto _ : state)
+        {
+            bool tokenized = tokens.tokenize(sentence.data(), sentence.size());
+            benchmark::DoNotOptimize(tokenized);
+            auto msg = parser.parseASCII(tokens, "gnss", false, 0);
+            benchmark::DoNotOptimize(msg);
+        }
+        state.SetBytesProcessed(state.iterations() * sentence.size());
+    }
+} // namespace
+
+static void BM_PVTCartesianParser(benchmark::State& state)
+{
+    runSbfParser<PVTCartesianMsg>(
+        state, pvt(4006, TOW, 4.2e6, 0.5e6, 4.7e6),
+        [](auto node, auto it, auto end, auto& msg) {
+            return PVTCartesianParser(node, it, end, msg);
+        });
+}
+BENCHMARK(BM_PVTCartesianParser);
+
+static void BM_PVTGeodeticParser(benchmark::State& state)
+{
+    runSbfParser<PVTGeodeticMsg>(
+        state, pvt(4007, TOW, 0.8743, 0.0762, 120.0),
+        [](auto node, auto it, auto end, auto& msg) {
+            return PVTGeodeticParser(node, it, end, msg);
+        });
+}
+BENCHMARK(BM_PVTGeodeticParser);
+
+static void BM_PosCovCartesianParser(benchmark::State& state)
+{
+    runSbfParser<PosCovCartesianMsg>(
+        state, covariance(5905, TOW), [](auto node, auto it, auto end, auto& msg) {
+            return PosCovCartesianParser(node, it, end, msg);
+        });
+}
+BENCHMARK(BM_PosCovCartesianParser);
+
+static void BM_PosCovGeodeticParser(benchmark::State& state)
+{
+    runSbfParser<PosCovGeodeticMsg>(
+        state, covariance(5906, TOW), [](auto node, auto it, auto end, auto& msg) {
+            return PosCovGeodeticParser(node, it, end, msg);
+        });
+}
+BENCHMARK(BM_PosCovGeodeticParser);
+
+static void BM_VelCovCartesianParser(benchmark::State& state)
+{
+    runSbfParser<VelCovCartesianMsg>(
+        state, covariance(5907, TOW), [](auto node, auto it, auto end, auto& msg) {
+            return VelCovCartesianParser(node, it, end, msg);
+        });
+}
+BENCHMARK(BM_VelCovCartesianParser);
+
+static void BM_VelCovGeodeticParser(benchmark::State& state)
+{
+    runSbfParser<VelCovGeodeticMsg>(
+        state, covariance(5908, TOW), [](auto node, auto it, auto end, auto& msg) {
+            return VelCovGeodeticParser(node, it, end, msg);
+        });
+}
+BENCHMARK(BM_VelCovGeodeticParser);
+
+static void BM_AttEulerParser(benchmark::State& state)
+{
+    runSbfParser<AttEulerMsg>(state, attEuler(TOW),
+                              [](auto node, auto it, auto end, auto& msg) {
+                                  return AttEulerParser(node, it, end, msg, true);
+                              });
+}
+BENCHMARK(BM_AttEulerParser);
+
+static void BM_AttCovEulerParser(benchmark::State& state)
+{
+    runSbfParser<AttCovEulerMsg>(
+        state, attCovEuler(TOW), [](auto node, auto it, auto end, auto& msg) {
+            return AttCovEulerParser(node, it, end, msg, true);
+        });
+}
+BENCHMARK(BM_AttCovEulerParser);
+
+static void BM_DOPParser(benchmark::State& state)
+{
+    runSbfParser<Dop>(state, dop(TOW), [](auto node, auto it, auto end, auto& msg) {
+        return DOPParser(node, it, end, msg);
+    });
+}
+BENCHMARK(BM_DOPParser);
+
+static void BM_INSNavCartParser(benchmark::State& state)
+{
+    runSbfParser<INSNavCartMsg>(
+        state, insNav(4225, TOW, 4.2e6, 0.5e6, 4.7e6),
+        [](auto node, auto it, auto end, auto& msg) {
+            return INSNavCartParser(node, it, end, msg, true);
+        });
+}
+BENCHMARK(BM_INSNavCartParser);
+
+static void BM_INSNavGeodParser(benchmark::State& state)
+{
+    runSbfParser<INSNavGeodMsg>(
+        state, insNavGeod(TOW), [](auto node, auto it, auto end, auto& msg) {
+            return INSNavGeodParser(node, it, end, msg, true);
+        });
+}
+BENCHMARK(BM_INSNavGeodParser);
+
+//! Channels as argument, two signals each
+static void BM_MeasEpochParser(benchmark::State& state)
+{
+    runSbfParser<MeasEpochMsg>(
+        state, measEpoch(TOW, static_cast<uint8_t>(state.range(0)), 2),
+        [](auto node, auto it, auto end, auto& msg) {
+            return MeasEpochParser(node, it, end, msg);
+        });
+}
+BENCHMARK(BM_MeasEpochParser)->Arg(8)->Arg(32)->Arg(64);
+
+//! Channels as argument, one state each
+static void BM_ChannelStatusParser(benchmark::State& state)
+{
+    runSbfParser<ChannelStatus>(
+        state, channelStatus(TOW, static_cast<uint8_t>(state.range(0)), 1),
+        [](auto node, auto it, auto end, auto& msg) {
+            return ChannelStatusParser(node, it, end, msg);
+        });
+}
+BENCHMARK(BM_ChannelStatusParser)->Arg(8)->Arg(32)->Arg(64);
+
+static void BM_ReceiverStatusParser(benchmark::State& state)
+{
+    runSbfParser<ReceiverStatus>(
+        state, receiverStatus(TOW, 4), [](auto node, auto it, auto end, auto& msg) {
+            return ReceiverStatusParser(node, it, end, msg);
+        });
+}
+BENCHMARK(BM_ReceiverStatusParser);
+
+static void BM_QualityIndParser(benchmark::State& state)
+{
+    runSbfParser<QualityInd>(
+        state, qualityInd(TOW, 8), [](auto node, auto it, auto end, auto& msg) {
+            return QualityIndParser(node, it, end, msg);
+        });
+}
+BENCHMARK(BM_QualityIndParser);
+
+static void BM_GalAuthStatusParser(benchmark::State& state)
+{
+    runSbfParser<GalAuthStatusMsg>(
+        state, galAuthStatus(TOW), [](auto node, auto it, auto end, auto& msg) {
+            return GalAuthStatusParser(node, it, end, msg);
+        });
+}
+BENCHMARK(BM_GalAuthStatusParser);
+
+static void BM_RfStatusParser(benchmark::State& state)
+{
+    runSbfParser<RfStatusMsg>(
+        state, rfStatus(TOW, 3), [](auto node, auto it, auto end, auto& msg) {
+            return RfStatusParser(node, it, end, msg);
+        });
+}
+BENCHMARK(BM_RfStatusParser);
+
+static void BM_ExtSensorMeasParser(benchmark::State& state)
+{
+    runSbfParser<ExtSensorMeasMsg>(
+        state, extSensorMeas(TOW), [](auto node, auto it, auto end, auto& msg) {
+            bool hasImuMeas;
+            return ExtSensorMeasParser(node, it, end, msg, true, hasImuMeas);
+        });
+}
+BENCHMARK(BM_ExtSensorMeasParser);
+
+static void BM_ReceiverTimeParser(benchmark::State& state)
+{
+    runSbfParser<ReceiverTimeMsg>(
+        state, zeroed(5914, 0, TOW, 8), [](auto node, auto it, auto end, auto& msg) {
+            return ReceiverTimeParser(node, it, end, msg);
+        });
+}
+BENCHMARK(BM_ReceiverTimeParser);
+
+static void BM_BaseVectorCartParser(benchmark::State& state)
+{
+    runSbfParser<BaseVectorCartMsg>(
+        state, baseVector(4043, TOW), [](auto node, auto it, auto end, auto& msg) {
+            return BaseVectorCartParser(node, it, end, msg);
+        });
+}
+BENCHMARK(BM_BaseVectorCartParser);
+
+static void BM_BaseVectorGeodParser(benchmark::State& state)
+{
+    runSbfParser<BaseVectorGeodMsg>(
+        state, baseVector(4028, TOW), [](auto node, auto it, auto end, auto& msg) {
+            return BaseVectorGeodParser(node, it, end, msg);
+        });
+}
+BENCHMARK(BM_BaseVectorGeodParser);
+
+static void BM_ReceiverSetupParser(benchmark::State& state)
+{
+    runSbfParser<ReceiverSetup>(
+        state, zeroed(5902, 0, TOW, 274), [](auto node, auto it, auto end, auto& msg) {
+            return ReceiverSetupParser(node, it, end, msg);
+        });
+}
+BENCHMARK(BM_ReceiverSetupParser);
+
+static void BM_IMUSetupParser(benchmark::State& state)
+{
+    runSbfParser<IMUSetupMsg>(
+        state, zeroed(4224, 0, TOW, 28), [](auto node, auto it, auto end, auto& msg) {
+            return IMUSetupParser(node, it, end, msg, true);
+        });
+}
+BENCHMARK(BM_IMUSetupParser);
+
+static void BM_VelSensorSetupParser(benchmark::State& state)
+{
+    runSbfParser<VelSensorSetupMsg>(
+        state, zeroed(4244, 0, TOW, 16), [](auto node, auto it, auto end, auto& msg) {
+            return VelSensorSetupParser(node, it, end, msg, true);
+        });
+}
+BENCHMARK(BM_VelSensorSetupParser);
+
+static void BM_GpggaParser(benchmark::State& state)
+{
+    runNmeaParser<GpggaParser>(state, gpgga(TOW));
+}
+BENCHMARK(BM_GpggaParser);
+
+static void BM_GprmcParser(benchmark::State& state)
+{
+    runNmeaParser<GprmcParser>(state, gprmc(TOW));
+}
+BENCHMARK(BM_GprmcParser);
+
+static void BM_GpgsaParser(benchmark::State& state)
+{
+    runNmeaParser<GpgsaParser>(state, gpgsa());
+}
+BENCHMARK(BM_GpgsaParser);
+
+static void BM_GpgsvParser(benchmark::State& state)
+{
+    runNmeaParser<GpgsvParser>(state, gagsv());
+}
+BENCHMARK(BM_GpgsvParser);
@@ -0,0 +1,741 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C
+#include <dirent.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+// C++
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ROS, only initialized to read back the diagnostics of the driver
+#include <diagnostic_msgs/DiagnosticArray.h>
+#include <ros/ros.h>
+// ROSaic
+#include <septentrio_gnss_driver/tools/synthetic_sbf.hpp>
+
+/**
+ * @file sbf_load_generator.cpp
+ * @brief Streams synthetic SBF blocks and NMEA sentences at a configurable rate
+ * via TCP, UDP or a pseudo terminal into the driver, to find the highest rate it
+ * sustains. Optionally reads back the latency statistics of the driver.
+ */
+
+namespace {
+
+    //! Largest UDP payload sent, blocks larger than this are sent alone
+    static const size_t UDP_PAYLOAD_SIZE = 1400;
+
+    std::atomic<bool> stop(false);
+
+    void onSignal(int) { stop = true; }
+
+    struct Options
+    {
+        std::string transport = "tcp:28784";
+        std::vector<std::string> blocks = {"pvtgeodetic", "measepoch"};
+        double rate = 10.0;
+        uint32_t channels = 32;
+        uint32_t signals = 2;
+        double duration = 0.0;
+        double ramp = 1.0;
+        double step = 10.0;
+        double report = 1.0;
+        int pid = 0;
+        //! Topic of the diagnostics of the driver, empty to run without ROS
+        std::string diagnostics;
+        //! Dropped telegrams beyond which the run fails, negative to never fail
+        int64_t maxDropped = -1;
+    };
+
+    void usage()
+    {
+        std::cout
+            << "Usage: sbf_load_generator [options]\n"
+               "  --transport tcp:<port> | udp:<host>:<port> | pty   (tcp:28784)\n"
+               "  --blocks <list>      comma separated of pvtgeodetic, pvtcartesian,\n"
+               "                       insnavgeod, measepoch, gpgga\n"
+               "                       (pvtgeodetic,measepoch)\n"
+               "  --rate <Hz>          epochs per second, each with all blocks (10)\n"
+               "  --channels <n>       Type1 sub-blocks of MeasEpoch (32)\n"
+               "  --signals <n>        Type2 sub-blocks per channel (2)\n"
+               "  --duration <s>       0 to run until interrupted (0)\n"
+               "  --ramp <factor>      rate is multiplied by this every step (1)\n"
+               "  --step <s>           duration of each rate step (10)\n"
+               "  --report <s>         period of the reports (1)\n"
+               "  --pid <pid>          process whose CPU usage per thread is reported\n"
+               "  --diagnostics <topic>  diagnostics of the driver, e.g. /diagnostics,\n"
+               "                       whose latency statistics are reported\n"
+               "  --max-dropped <n>    fail if the driver dropped more telegrams and\n"
+               "                       messages, needs --diagnostics\n";
+    }
+
+    //! Arguments without those of ROS, e.g. set by roslaunch
+    [[nodiscard]] bool parseOptions(const std::vector<std::string>& args,
+                                    Options& options)
+    {
+        for (size_t i = 1; i < args.size(); ++i)
+        {
+            const std::string& arg = args[i];
+            if ((arg == "-h") || (arg == "--help") || (i + 1 == args.size()))
+                return false;
+            const std::string& value = args[++i];
+            try
+            {
+                if (arg == "--transport")
+                    options.transport = value;
+                else if (arg == "--blocks")
+                {
+                    options.blocks.clear();
+                    std::stringstream list(value);
+                    std::string block;
+                    while (std::getline(list, block, ','))
+                        options.blocks.push_back(block);
+                } else if (arg == "--rate")
+                    options.rate = std::stod(value);
+                else if (arg == "--channels")
+                    options.channels = std::stoul(value);
+                else if (arg == "--signals")
+                    options.signals = std::stoul(value);
+                else if (arg == "--duration")
+                    options.duration = std::stod(value);
+                else if (arg == "--ramp")
+                    options.ramp = std::stod(value);
+                else if (arg == "--step")
+                    options.step = std::stod(value);
+                else if (arg == "--report")
+                    options.report = std::stod(value);
+                else if (arg == "--pid")
+                    options.pid = std::stoi(value);
+                else if (arg == "--diagnostics")
+                    options.diagnostics = value;
+                else if (arg == "--max-dropped")
+                    options.maxDropped = std::stoll(value);
+                else
+                    return false;
+            } catch (const std::exception&)
+            {
+                return false;
+            }
+        }
+        return (options.rate > 0.0) && (options.report > 0.0) &&
+               (options.step > 0.0) && (options.ramp > 0.0) &&
+               (options.channels <= 255) && (options.signals <= 255) &&
+               ((options.maxDropped < 0) || !options.diagnostics.empty());
+    }
+
+    /**
+     * @class Transport
+     * @brief Endpoint the driver reads from, writes block until the driver has
+     * taken the data, so that not keeping up shows as lag of the generator
+     */
+    class Transport
+    {
+    public:
+        ~Transport()
+        {
+            if (fd_ >= 0)
+                close(fd_);
+            if (listenFd_ >= 0)
+                close(listenFd_);
+        }
+
+        [[nodiscard]] bool open(const std::string& spec)
+        {
+            if (spec.compare(0, 4, "tcp:") == 0)
+                return openTcp(spec.substr(4));
+            if (spec.compare(0, 4, "udp:") == 0)
+                return openUdp(spec.substr(4));
+            if (spec == "pty")
+                return openPty();
+            std::cerr << "Unknown transport " << spec << "\n";
+            return false;
+        }
+
+        /**
+         * @brief Writes the blocks of one epoch
+         * @return Whether the driver is still connected
+         */
+        [[nodiscard]] bool write(const std::vector<std::vector<uint8_t>>& blocks)
+        {
+            if (udp_)
+                return writeDatagrams(blocks);
+            buffer_.clear();
+            for (const auto& block : blocks)
+                buffer_.insert(buffer_.end(), block.begin(), block.end());
+            if (pty_)
+                discardInput();
+            return writeAll(buffer_.data(), buffer_.size());
+        }
+
+    private:
+        [[nodiscard]] bool openTcp(const std::string& port)
+        {
+            listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+            int reuse = 1;
+            setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_ANY);
+            address.sin_port = htons(static_cast<uint16_t>(std::stoi(port)));
+            if ((bind(listenFd_, reinterpret_cast<sockaddr*>(&address),
+                      sizeof(address)) != 0) ||
+                (listen(listenFd_, 1) != 0))
+            {
+                std::cerr << "Could not listen on TCP port " << port << ": "
+                          << std::strerror(errno) << "\n";
+                return false;
+            }
+            std::cout << "Waiting for the driver to connect to tcp://<host>:"
+                      << port << std::endl;
+            fd_ = accept(listenFd_, nullptr, nullptr);
+            if (fd_ < 0)
+            {
+                std::cerr << "Accepting failed: " << std::strerror(errno) << "\n";
+                return false;
+            }
+            return true;
+        }
+
+        [[nodiscard]] bool openUdp(const std::string& destination)
+        {
+            size_t colon = destination.rfind(':');
+            if (colon == std::string::npos)
+            {
+                std::cerr << "UDP destination has to be <host>:<port>\n";
+                return false;
+            }
+            addrinfo hints{};
+            hints.ai_family = AF_INET;
+            hints.ai_socktype = SOCK_DGRAM;
+            addrinfo* result = nullptr;
+            if (getaddrinfo(destination.substr(0, colon).c_str(),
+                            destination.substr(colon + 1).c_str(), &hints,
+                            &result) != 0)
+            {
+                std::cerr << "Could not resolve " << destination << "\n";
+                return false;
+            }
+            fd_ = socket(result->ai_family, result->ai_socktype,
+                         result->ai_protocol);
+            bool connected =
+                (fd_ >= 0) && (connect(fd_, result->ai_addr, result->ai_addrlen) == 0);
+            freeaddrinfo(result);
+            if (!connected)
+            {
+                std::cerr << "Could not open UDP socket: " << std::strerror(errno)
+                          << "\n";
+                return false;
+            }
+            udp_ = true;
+            std::cout << "Sending to udp://" << destination << "\n";
+            return true;
+        }
+
+        [[nodiscard]] bool openPty()
+        {
+            fd_ = posix_openpt(O_RDWR | O_NOCTTY);
+            if ((fd_ < 0) || (grantpt(fd_) != 0) || (unlockpt(fd_) != 0))
+            {
+                std::cerr << "Could not open pseudo terminal: "
+                          << std::strerror(errno) << "\n";
+                return false;
+            }
+            termios tty;
+            tcgetattr(fd_, &tty);
+            cfmakeraw(&tty);
+            tcsetattr(fd_, TCSANOW, &tty);
+            pty_ = true;
+            std::cout << "Waiting for the driver to open serial:" << ptsname(fd_)
+                      << std::endl;
+            // Once the other end has been closed, the master reports a hang-up
+            // until it is opened again
+            close(::open(ptsname(fd_), O_RDWR | O_NOCTTY));
+            pollfd output{fd_, POLLOUT, 0};
+            while (!stop && (poll(&output, 1, 100) >= 0) &&
+                   (output.revents & POLLHUP))
+                ;
+            return !stop;
+        }
+
+        [[nodiscard]] bool writeAll(const uint8_t* data, size_t size)
+        {
+            while (size > 0)
+            {
+                ssize_t written = pty_ ? ::write(fd_, data, size)
+                                       : ::send(fd_, data, size, MSG_NOSIGNAL);
+                if (written < 0)
+                {
+                    if ((errno == EINTR) && !stop)
+                        continue;
+                    // The pseudo terminal reports EIO until the driver opens it
+                    if (pty_ && (errno == EIO))
+                        return true;
+                    std::cerr << "Writing failed: " << std::strerror(errno) << "\n";
+                    return false;
+                }
+                data += written;
+                size -= written;
+            }
+            return true;
+        }
+
+        [[nodiscard]] bool
+        writeDatagrams(const std::vector<std::vector<uint8_t>>& blocks)
+        {
+            buffer_.clear();
+            for (const auto& block : blocks)
+            {
+                if (!buffer_.empty() &&
+                    (buffer_.size() + block.size() > UDP_PAYLOAD_SIZE))
+                {
+                    if (!sendDatagram())
+                        return false;
+                }
+                buffer_.insert(buffer_.end(), block.begin(), block.end());
+            }
+            return buffer_.empty() || sendDatagram();
+        }
+
+        [[nodiscard]] bool sendDatagram()
+        {
+            ssize_t sent = ::send(fd_, buffer_.data(), buffer_.size(), 0);
+            buffer_.clear();
+            // Nobody listening yet
+            if ((sent < 0) && (errno != ECONNREFUSED))
+            {
+                std::cerr << "Sending failed: " << std::strerror(errno) << "\n";
+                return false;
+            }
+            return true;
+        }
+
+        //! Commands of the driver are not answered, they must not fill the pty
+        void discardInput()
+        {
+            uint8_t discard[4096];
+            pollfd input{fd_, POLLIN, 0};
+            while ((poll(&input, 1, 0) > 0) && (input.revents & POLLIN) &&
+                   (read(fd_, discard, sizeof(discard)) > 0))
+                ;
+        }
+
+        int fd_ = -1;
+        int listenFd_ = -1;
+        bool udp_ = false;
+        bool pty_ = false;
+        std::vector<uint8_t> buffer_;
+    };
+
+    /**
+     * @class ThreadCpu
+     * @brief Samples the CPU time of each thread of a process from /proc
+     */
+    class ThreadCpu
+    {
+    public:
+        explicit ThreadCpu(int pid) : pid_(pid), ticks_(sysconf(_SC_CLK_TCK)) {}
+
+        /**
+         * @brief Reports the CPU usage of each thread since the last call
+         * @param[in] elapsed Seconds since the last call
+         */
+        void report(double elapsed)
+        {
+            std::string tasks = "/proc/" + std::to_string(pid_) + "/task";
+            DIR* dir = opendir(tasks.c_str());
+            if (!dir)
+                return;
+            std::map<int, std::pair<std::string, uint64_t>> current;
+            while (dirent* entry = readdir(dir))
+            {
+                if (entry->d_name[0] == '.')
+                    continue;
+                std::ifstream stat(tasks + "/" + entry->d_name + "/stat");
+                std::string line;
+                if (!std::getline(stat, line))
+                    continue;
+                // The name may contain spaces, the fields follow its parenthesis
+                size_t open = line.find('(');
+                size_t close = line.rfind(')');
+                if ((open == std::string::npos) || (close == std::string::npos))
+                    continue;
+                std::stringstream fields(line.substr(close + 2));
+                std::string field;
+                uint64_t utime = 0;
+                uint64_t stime = 0;
+                // Fields 14 and 15 of stat, counted from the state as field 3
+                for (int i = 3; (i <= 15) && (fields >> field); ++i)
+                {
+                    if (i == 14)
+                        utime = std::stoull(field);
+                    else if (i == 15)
+                        stime = std::stoull(field);
+                }
+                current[std::atoi(entry->d_name)] = {
+                    line.substr(open + 1, close - open - 1), utime + stime};
+            }
+            closedir(dir);
+
+            std::cout << "  CPU per thread:";
+            for (const auto& [tid, thread] : current)
+            {
+                auto last = last_.find(tid);
+                uint64_t before = (last != last_.end()) ? last->second.second : 0;
+                double percent =
+                    100.0 * (thread.second - before) / ticks_ / elapsed;
+                std::cout << " " << thread.first << "[" << tid << "] "
+                          << std::fixed << std::setprecision(1) << percent << "%";
+            }
+            std::cout << "\n";
+            last_ = std::move(current);
+        }
+
+    private:
+        int pid_;
+        double ticks_;
+        std::map<int, std::pair<std::string, uint64_t>> last_;
+    };
+
+    /**
+     * @class DriverDiagnostics
+     * @brief Collects the latency statistics the driver publishes as status
+     * "septentrio_driver: Latency" on its diagnostics, cf. latency_statistics
+     */
+    class DriverDiagnostics
+    {
+    public:
+        explicit DriverDiagnostics(const std::string& topic) : spinner_(1)
+        {
+            ros::NodeHandle nh;
+            subscriber_ =
+                nh.subscribe(topic, 10, &DriverDiagnostics::onDiagnostics, this);
+            spinner_.start();
+        }
+
+        ~DriverDiagnostics() { spinner_.stop(); }
+
+        //! Waits for the statistics covering the end of the run
+        void awaitReport(std::chrono::seconds timeout)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            uint64_t reports = reports_;
+            received_.wait_for(lock, timeout,
+                               [this, reports] { return reports_ > reports; });
+        }
+
+        //! Prints the statistics received since the last call
+        void report()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (latest_.empty())
+                return;
+            std::cout << "  Driver:";
+            for (const auto& value : latest_)
+                std::cout << " " << value.key << " " << value.value << ";";
+            std::cout << "\n";
+            latest_.clear();
+        }
+
+        /**
+         * @brief Prints the worst percentiles of each statistic over the run and
+         * the final counters of the driver
+         * @return Telegrams and messages dropped by the driver, negative if no
+         * statistics were received
+         */
+        int64_t summarize()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (reports_ == 0)
+            {
+                std::cout << "Received no latency statistics from the driver, is "
+                             "latency_statistics/period_s set?\n";
+                return -1;
+            }
+            std::cout << "Driver latencies over " << reports_
+                      << " reports as n, worst p99 and max:\n";
+            for (const auto& [key, worst] : worst_)
+                std::cout << "  " << key << ": n=" << worst.count
+                          << " p99=" << worst.p99 << "us max=" << worst.max
+                          << "us\n";
+            std::cout << "Driver counters:";
+            for (const auto& [key, value] : counters_)
+                std::cout << " " << key << " " << value << ";";
+            std::cout << "\n";
+            int64_t dropped = 0;
+            for (const char* key : {"queue dropped", "publish dropped"})
+            {
+                auto counter = counters_.find(key);
+                if (counter != counters_.end())
+                    dropped += std::stoll(counter->second);
+            }
+            return dropped;
+        }
+
+    private:
+        struct Worst
+        {
+            uint64_t count = 0;
+            uint64_t p99 = 0;
+            uint64_t max = 0;
+        };
+
+        void onDiagnostics(const diagnostic_msgs::DiagnosticArray::ConstPtr& msg)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& status : msg->status)
+            {
+                if (status.name != "septentrio_driver: Latency")
+                    continue;
+                ++reports_;
+                latest_ = status.values;
+                for (const auto& value : status.values)
+                {
+                    // Latencies as "n=<n> p50=<us>us p99=<us>us max=<us>us"
+                    unsigned long long n, p50, p99, max;
+                    if (std::sscanf(value.value.c_str(),
+                                    "n=%llu p50=%lluus p99=%lluus max=%lluus", &n,
+                                    &p50, &p99, &max) == 4)
+                    {
+                        Worst& worst = worst_[value.key];
+                        worst.count += n;
+                        worst.p99 = std::max<uint64_t>(worst.p99, p99);
+                        worst.max = std::max<uint64_t>(worst.max, max);
+                    } else
+                        counters_[value.key] = value.value;
+                }
+                received_.notify_all();
+            }
+        }
+
+        std::mutex mutex_;
+        std::condition_variable received_;
+        //! Statistics of the latest report not yet printed
+        std::vector<diagnostic_msgs::KeyValue> latest_;
+        uint64_t reports_ = 0;
+        std::map<std::string, Worst> worst_;
+        //! Latest values of the statistics that are no latencies
+        std::map<std::string, std::string> counters_;
+        ros::AsyncSpinner spinner_;
+        ros::Subscriber subscriber_;
+    };
+
+    [[nodiscard]] std::vector<std::vector<uint8_t>>
+    generateEpoch(const Options& options, uint32_t tow)
+    {
+        using namespace synthetic_sbf;
+        std::vector<std::vector<uint8_t>> blocks;
+        for (const auto& name : options.blocks)
+        {
+            if (name == "pvtgeodetic")
+                blocks.push_back(pvt(4007, tow, 0.8743, 0.0762, 120.0));
+            else if (name == "pvtcartesian")
+                blocks.push_back(pvt(4006, tow, 4027893.6, 307045.6, 4919474.9));
+            else if (name == "insnavgeod")
+                blocks.push_back(insNavGeod(tow));
+            else if (name == "measepoch")
+                blocks.push_back(
+                    measEpoch(tow, static_cast<uint8_t>(options.channels),
+                              static_cast<uint8_t>(options.signals)));
+            else if (name == "gpgga")
+                blocks.push_back(gpgga(tow));
+        }
+        return blocks;
+    }
+} // namespace
+
+/**
+ * Generates one epoch of blocks per period and writes it. Blocks of an epoch share
+ * their time of week, which advances by the period, so the driver aggregates and
+ * decimates them as those of an Rx. If a write blocks beyond the start of the next
+ * period, the driver does not keep up and the lag grows. ROS is only initialized
+ * if the diagnostics of the driver are to be read back.
+ */
+int main(int argc, char** argv)
+{
+    std::vector<std::string> args;
+    ros::removeROSArgs(argc, argv, args);
+    Options options;
+    if (!parseOptions(args, options))
+    {
+        usage();
+        return 1;
+    }
+    for (const auto& name : options.blocks)
+    {
+        if (generateEpoch(Options{"", {name}}, 0).empty())
+        {
+            std::cerr << "Unknown block " << name << "\n";
+            return 1;
+        }
+    }
+    std::unique_ptr<DriverDiagnostics> diagnostics;
+    if (!options.diagnostics.empty())
+    {
+        ros::init(argc, argv, "sbf_load_generator",
+                  ros::init_options::AnonymousName |
+                      ros::init_options::NoSigintHandler);
+        diagnostics.reset(new DriverDiagnostics(options.diagnostics));
+    }
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    Transport transport;
+    if (!transport.open(options.transport))
+        return 1;
+    std::unique_ptr<ThreadCpu> threadCpu;
+    if (options.pid != 0)
+        threadCpu.reset(new ThreadCpu(options.pid));
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    Clock::time_point next = start;
+    Clock::time_point nextReport = start + std::chrono::duration_cast<Clock::duration>(
+                                               std::chrono::duration<double>(
+                                                   options.report));
+    Clock::time_point nextStep = start + std::chrono::duration_cast<Clock::duration>(
+                                             std::chrono::duration<double>(
+                                                 options.step));
+    Clock::time_point lastReport = start;
+    double rate = options.rate;
+    // Time of week in ms, starting at noon
+    double tow = 43200000.0;
+    uint64_t epochs = 0;
+    uint64_t blocks = 0;
+    uint64_t bytes = 0;
+    uint64_t reportEpochs = 0;
+    uint64_t reportBytes = 0;
+    double maxLag = 0.0;
+    double reportMaxLag = 0.0;
+
+    while (!stop)
+    {
+        std::this_thread::sleep_until(next);
+        std::vector<std::vector<uint8_t>> epoch =
+            generateEpoch(options, static_cast<uint32_t>(tow));
+        if (!transport.write(epoch))
+            break;
+        Clock::time_point now = Clock::now();
+
+        ++epochs;
+        ++reportEpochs;
+        blocks += epoch.size();
+        for (const auto& block : epoch)
+        {
+            bytes += block.size();
+            reportBytes += block.size();
+        }
+        double lag = std::chrono::duration<double>(now - next).count();
+        reportMaxLag = std::max(reportMaxLag, lag);
+        maxLag = std::max(maxLag, lag);
+
+        if (now >= nextReport)
+        {
+            double elapsed = std::chrono::duration<double>(now - lastReport).count();
+            std::cout << std::fixed << std::setprecision(1) << "t "
+                      << std::chrono::duration<double>(now - start).count()
+                      << " s, target " << rate << " Hz, sent "
+                      << reportEpochs / elapsed << " Hz, "
+                      << reportEpochs * epoch.size() / elapsed << " blocks/s, "
+                      << std::setprecision(3) << reportBytes / elapsed / 1e6
+                      << " MB/s, max lag " << reportMaxLag * 1e3 << " ms\n";
+            if (threadCpu)
+                threadCpu->report(elapsed);
+            if (diagnostics)
+                diagnostics->report();
+            std::cout.flush();
+            lastReport = now;
+            nextReport += std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(options.report));
+            reportEpochs = 0;
+            reportBytes = 0;
+            reportMaxLag = 0.0;
+        }
+        if ((options.duration > 0.0) &&
+            (std::chrono::duration<double>(now - start).count() >= options.duration))
+            break;
+        if ((options.ramp != 1.0) && (now >= nextStep))
+        {
+            rate *= options.ramp;
+            nextStep += std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(options.step));
+        }
+
+        tow += 1000.0 / rate;
+        next += std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / rate));
+        // Do not catch up in a burst after falling behind
+        if (next < now)
+            next = now;
+    }
+
+    double duration =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << std::fixed << std::setprecision(1) << "Sent " << epochs
+              << " epochs, " << blocks << " blocks, " << bytes << " bytes in "
+              << duration << " s: " << epochs / duration << " Hz, "
+              << blocks / duration << " blocks/s, max lag " << maxLag * 1e3
+              << " ms\n";
+    if (!diagnostics)
+        return 0;
+    diagnostics->awaitReport(std::chrono::seconds(5));
+    int64_t dropped = diagnostics->summarize();
+    if (dropped < 0)
+        return 2;
+    if ((options.maxDropped >= 0) && (dropped > options.maxDropped))
+    {
+        std::cout << "Driver dropped " << dropped
+                  << " telegrams and messages, more than " << options.maxDropped
+                  << "\n";
+        return 3;
+    }
+    return 0;
+}